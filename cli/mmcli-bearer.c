@@ -248,6 +248,14 @@ print_bearer_info (MMBearer *bearer)
         gchar *duration = NULL;
         gchar *bytes_rx = NULL;
         gchar *bytes_tx = NULL;
+        gchar *rate_rx = NULL;
+        gchar *rate_tx = NULL;
+        gchar *reconnect_time = NULL;
+        gchar *time_to_registered = NULL;
+        gchar *time_to_connected = NULL;
+        gchar *time_to_ip = NULL;
+        gchar *retries = NULL;
+        gchar *polls_avoided = NULL;
 
         if (stats) {
             guint64 val;
@@ -261,11 +269,43 @@ print_bearer_info (MMBearer *bearer)
             val = mm_bearer_stats_get_tx_bytes (stats);
             if (val)
                 bytes_tx = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_rx_rate (stats);
+            if (val)
+                rate_rx = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_tx_rate (stats);
+            if (val)
+                rate_tx = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_reconnect_time (stats);
+            if (val)
+                reconnect_time = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_time_to_registered (stats);
+            if (val)
+                time_to_registered = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_time_to_connected (stats);
+            if (val)
+                time_to_connected = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_time_to_ip (stats);
+            if (val)
+                time_to_ip = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_retries (stats);
+            if (val)
+                retries = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_polls_avoided (stats);
+            if (val)
+                polls_avoided = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
         }
 
         mmcli_output_string_take (MMC_F_BEARER_STATS_DURATION, duration);
         mmcli_output_string_take (MMC_F_BEARER_STATS_BYTES_RX, bytes_rx);
         mmcli_output_string_take (MMC_F_BEARER_STATS_BYTES_TX, bytes_tx);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_RATE_RX,  rate_rx);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_RATE_TX,  rate_tx);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_RECONNECT_TIME, reconnect_time);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_TIME_TO_REGISTERED, time_to_registered);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_TIME_TO_CONNECTED,  time_to_connected);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_TIME_TO_IP,         time_to_ip);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_RETRIES,            retries);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_POLLS_AVOIDED,      polls_avoided);
     }
 
     mmcli_output_dump ();
@@ -25,8 +25,13 @@
 #include <stdlib.h>
 #include <locale.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <gio/gio.h>
 
 #define _LIBMM_INSIDE_MMCLI
@@ -65,6 +70,8 @@ static gboolean get_flag;
 static gchar *set_supl_server_str;
 static gchar *inject_assistance_data_str;
 static gchar *set_gps_refresh_rate_str;
+static gboolean set_enable_gps_high_rate_flag;
+static gboolean set_disable_gps_high_rate_flag;
 
 static GOptionEntry entries[] = {
     { "location-status", 0, 0, G_OPTION_ARG_NONE, &status_flag,
@@ -135,6 +142,14 @@ static GOptionEntry entries[] = {
       "Set GPS refresh rate in seconds, or 0 disable the explicit rate.",
       "[RATE]"
     },
+    { "location-set-enable-gps-high-rate", 0, 0, G_OPTION_ARG_NONE, &set_enable_gps_high_rate_flag,
+      "Enable signaling of every GPS fix in DBus.",
+      NULL
+    },
+    { "location-set-disable-gps-high-rate", 0, 0, G_OPTION_ARG_NONE, &set_disable_gps_high_rate_flag,
+      "Disable signaling of every GPS fix in DBus.",
+      NULL
+    },
     { "location-set-enable-signal", 0, 0, G_OPTION_ARG_NONE, &set_enable_signal_flag,
       "Enable location update signaling in DBus property.",
       NULL
@@ -185,6 +200,11 @@ mmcli_modem_location_options_enabled (void)
         exit (EXIT_FAILURE);
     }
 
+    if (set_enable_gps_high_rate_flag && set_disable_gps_high_rate_flag) {
+        g_printerr ("error: cannot enable and disable GPS high rate mode\n");
+        exit (EXIT_FAILURE);
+    }
+
     n_actions = (status_flag +
                  !!(enable_3gpp_flag +
                     disable_3gpp_flag +
@@ -203,7 +223,9 @@ mmcli_modem_location_options_enabled (void)
                  get_flag +
                  !!set_supl_server_str +
                  !!inject_assistance_data_str +
-                 !!set_gps_refresh_rate_str);
+                 !!set_gps_refresh_rate_str +
+                 set_enable_gps_high_rate_flag +
+                 set_disable_gps_high_rate_flag);
 
     if (n_actions > 1) {
         g_printerr ("error: too many Location actions requested\n");
@@ -262,6 +284,7 @@ print_location_status (void)
     gchar        *capabilities;
     gchar        *enabled;
     gchar        *gps_refresh_rate = NULL;
+    const gchar  *gps_high_rate = NULL;
     const gchar  *gps_supl_server = NULL;
     gchar        *gps_assistance = NULL;
     const gchar **gps_assistance_servers = NULL;
@@ -278,6 +301,7 @@ print_location_status (void)
 
         rate = mm_modem_location_get_gps_refresh_rate (ctx->modem_location);
         gps_refresh_rate = g_strdup_printf ("%u", rate);
+        gps_high_rate = mm_modem_location_get_gps_high_rate (ctx->modem_location) ? "yes" : "no";
 
         /* If A-GPS supported, show SUPL server setup */
         if (mm_modem_location_get_capabilities (ctx->modem_location) & MM_MODEM_LOCATION_SOURCE_AGPS)
@@ -295,6 +319,7 @@ print_location_status (void)
     mmcli_output_string_list_take  (MMC_F_LOCATION_ENABLED,                enabled);
     mmcli_output_string            (MMC_F_LOCATION_SIGNALS,                mm_modem_location_signals_location (ctx->modem_location) ? "yes" : "no");
     mmcli_output_string_take_typed (MMC_F_LOCATION_GPS_REFRESH_RATE,       gps_refresh_rate, "seconds");
+    mmcli_output_string            (MMC_F_LOCATION_GPS_HIGH_RATE,          gps_high_rate);
     mmcli_output_string            (MMC_F_LOCATION_GPS_SUPL_SERVER,        gps_supl_server);
     mmcli_output_string_list_take  (MMC_F_LOCATION_GPS_ASSISTANCE,         gps_assistance);
     mmcli_output_string_array      (MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS, gps_assistance_servers, TRUE);
@@ -354,34 +379,47 @@ set_supl_server_ready (MMModemLocation *modem_location,
 }
 
 static gboolean
-parse_inject_assistance_data (guint8 **o_data,
-                              gsize   *o_data_size)
+parse_inject_assistance_data (gint *o_fd)
 {
-    gboolean  result = FALSE;
-    GFile    *file = NULL;
-    gchar    *data;
-    gsize     data_size;
-    GError   *error = NULL;
-
+    gboolean     result = FALSE;
+    GFile       *file = NULL;
+    gchar       *path = NULL;
+    gint         fd = -1;
+    struct stat  st;
+
+    /* The file is given to the daemon as a file descriptor, so it must be
+     * a local regular file */
     file = g_file_new_for_commandline_arg (inject_assistance_data_str);
+    path = g_file_get_path (file);
+    if (!path) {
+        g_printerr ("error: file is not local\n");
+        goto out;
+    }
 
-    if (!g_file_load_contents (file, NULL, &data, &data_size, NULL, &error)) {
-        g_printerr ("error: cannot load file contents: %s\n", error->message);
+    fd = g_open (path, O_RDONLY, 0);
+    if (fd < 0) {
+        g_printerr ("error: cannot open file: %s\n", g_strerror (errno));
         goto out;
     }
 
-    if (data_size == 0) {
+    if (fstat (fd, &st) < 0 || !S_ISREG (st.st_mode)) {
+        g_printerr ("error: not a regular file\n");
+        goto out;
+    }
+
+    if (st.st_size == 0) {
         g_printerr ("error: file is empty\n");
         goto out;
     }
 
-    *o_data = (guint8 *)data;
-    *o_data_size = data_size;
+    *o_fd = fd;
+    fd = -1;
     result = TRUE;
 
 out:
-    if (error)
-        g_error_free (error);
+    if (fd >= 0)
+        close (fd);
+    g_free (path);
     g_object_unref (file);
     return result;
 }
@@ -406,7 +444,7 @@ inject_assistance_data_ready (MMModemLocation *modem_location,
     gboolean operation_result;
     GError *error = NULL;
 
-    operation_result = mm_modem_location_inject_assistance_data_finish (modem_location, result, &error);
+    operation_result = mm_modem_location_inject_assistance_data_fd_finish (modem_location, result, &error);
     inject_assistance_data_process_reply (operation_result, error);
 
     mmcli_async_operation_done ();
@@ -438,6 +476,32 @@ set_gps_refresh_rate_ready (MMModemLocation *modem_location,
     mmcli_async_operation_done ();
 }
 
+static void
+set_gps_high_rate_process_reply (gboolean result,
+                                 const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't set GPS high rate mode: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_print ("successfully set GPS high rate mode\n");
+}
+
+static void
+set_gps_high_rate_ready (MMModemLocation *modem_location,
+                         GAsyncResult    *result)
+{
+    gboolean operation_result;
+    GError *error = NULL;
+
+    operation_result = mm_modem_location_set_gps_high_rate_finish (modem_location, result, &error);
+    set_gps_high_rate_process_reply (operation_result, error);
+
+    mmcli_async_operation_done ();
+}
+
 static MMModemLocationSource
 build_sources_from_flags (void)
 {
@@ -644,22 +708,21 @@ get_modem_ready (GObject      *source,
 
     /* Request to inject assistance data? */
     if (inject_assistance_data_str) {
-        guint8 *data;
-        gsize   data_size;
+        gint fd;
 
-        if (!parse_inject_assistance_data (&data, &data_size)) {
+        if (!parse_inject_assistance_data (&fd)) {
             g_printerr ("error: couldn't inject assistance data: invalid parameters given: '%s'\n",
                         inject_assistance_data_str);
             exit (EXIT_FAILURE);
         }
 
         g_debug ("Asynchronously injecting assistance data...");
-        mm_modem_location_inject_assistance_data (ctx->modem_location,
-                                                  data, data_size,
-                                                  ctx->cancellable,
-                                                  (GAsyncReadyCallback)inject_assistance_data_ready,
-                                                  NULL);
-        g_free (data);
+        mm_modem_location_inject_assistance_data_fd (ctx->modem_location,
+                                                     fd,
+                                                     ctx->cancellable,
+                                                     (GAsyncReadyCallback)inject_assistance_data_ready,
+                                                     NULL);
+        close (fd);
         return;
     }
 
@@ -681,6 +744,17 @@ get_modem_ready (GObject      *source,
         return;
     }
 
+    /* Request to enable or disable GPS high rate mode? */
+    if (set_enable_gps_high_rate_flag || set_disable_gps_high_rate_flag) {
+        g_debug ("Asynchronously setting GPS high rate mode...");
+        mm_modem_location_set_gps_high_rate (ctx->modem_location,
+                                             set_enable_gps_high_rate_flag,
+                                             ctx->cancellable,
+                                             (GAsyncReadyCallback)set_gps_high_rate_ready,
+                                             NULL);
+        return;
+    }
+
     g_warn_if_reached ();
 }
 
@@ -787,23 +861,22 @@ mmcli_modem_location_run_synchronous (GDBusConnection *connection)
 
     /* Request to inject assistance data? */
     if (inject_assistance_data_str) {
-        gboolean  result;
-        guint8   *data;
-        gsize     data_size;
+        gboolean result;
+        gint     fd;
 
-        if (!parse_inject_assistance_data (&data, &data_size)) {
+        if (!parse_inject_assistance_data (&fd)) {
             g_printerr ("error: couldn't inject assistance data: invalid parameters given: '%s'\n",
                         inject_assistance_data_str);
             exit (EXIT_FAILURE);
         }
 
         g_debug ("Synchronously setting assistance data...");
-        result = mm_modem_location_inject_assistance_data_sync (ctx->modem_location,
-                                                                data, data_size,
-                                                                NULL,
-                                                                &error);
+        result = mm_modem_location_inject_assistance_data_fd_sync (ctx->modem_location,
+                                                                   fd,
+                                                                   NULL,
+                                                                   &error);
         inject_assistance_data_process_reply (result, error);
-        g_free (data);
+        close (fd);
         return;
     }
 
@@ -827,5 +900,18 @@ mmcli_modem_location_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to enable or disable GPS high rate mode? */
+    if (set_enable_gps_high_rate_flag || set_disable_gps_high_rate_flag) {
+        gboolean result;
+
+        g_debug ("Synchronously setting GPS high rate mode...");
+        result = mm_modem_location_set_gps_high_rate_sync (ctx->modem_location,
+                                                           set_enable_gps_high_rate_flag,
+                                                           NULL,
+                                                           &error);
+        set_gps_high_rate_process_reply (result, error);
+        return;
+    }
+
     g_warn_if_reached ();
 }
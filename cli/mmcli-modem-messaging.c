@@ -24,6 +24,7 @@
 #include <stdlib.h>
 #include <locale.h>
 #include <string.h>
+#include <errno.h>
 
 #include <glib.h>
 #include <gio/gio.h>
@@ -48,9 +49,14 @@ static Context *ctx;
 /* Options */
 static gboolean status_flag;
 static gboolean list_flag;
+static gchar *list_range_str;
+static gchar *list_since_str;
 static gchar *create_str;
 static gchar *create_with_data_str;
 static gchar *delete_str;
+static gchar *send_str;
+static gchar *delete_messages_str;
+static gboolean delete_all_flag;
 
 static GOptionEntry entries[] = {
     { "messaging-status", 0, 0, G_OPTION_ARG_NONE, &status_flag,
@@ -61,6 +67,14 @@ static GOptionEntry entries[] = {
       "List SMS messages available in a given modem",
       NULL
     },
+    { "messaging-list-sms-range", 0, 0, G_OPTION_ARG_STRING, &list_range_str,
+      "List a page of the SMS messages available in a given modem, oldest first",
+      "[OFFSET,COUNT]"
+    },
+    { "messaging-list-sms-since", 0, 0, G_OPTION_ARG_STRING, &list_since_str,
+      "List SMS messages available in a given modem with a timestamp equal to or later than the given UNIX time",
+      "[TIMESTAMP]"
+    },
     { "messaging-create-sms", 0, 0, G_OPTION_ARG_STRING, &create_str,
       "Create a new SMS in a given modem",
       "[\"key=value,...\"]"
@@ -73,6 +87,18 @@ static GOptionEntry entries[] = {
       "Delete a SMS from a given modem",
       "[PATH|INDEX]"
     },
+    { "messaging-send-sms", 0, 0, G_OPTION_ARG_STRING, &send_str,
+      "Send several SMS from a given modem in a single batch",
+      "[PATH|INDEX,...]"
+    },
+    { "messaging-delete-messages", 0, 0, G_OPTION_ARG_STRING, &delete_messages_str,
+      "Delete several SMS from a given modem in a single batch",
+      "[PATH|INDEX,...]"
+    },
+    { "messaging-delete-all-sms", 0, 0, G_OPTION_ARG_NONE, &delete_all_flag,
+      "Delete all SMS from a given modem",
+      NULL
+    },
     { NULL }
 };
 
@@ -102,8 +128,13 @@ mmcli_modem_messaging_options_enabled (void)
 
     n_actions = (status_flag +
                  list_flag +
+                 !!list_range_str +
+                 !!list_since_str +
                  !!create_str +
-                 !!delete_str);
+                 !!delete_str +
+                 !!send_str +
+                 !!delete_messages_str +
+                 delete_all_flag);
 
     if (n_actions > 1) {
         g_printerr ("error: too many Messaging actions requested\n");
@@ -116,7 +147,7 @@ mmcli_modem_messaging_options_enabled (void)
         exit (EXIT_FAILURE);
     }
 
-    if (status_flag)
+    if (status_flag || list_range_str || list_since_str || send_str || delete_messages_str || delete_all_flag)
         mmcli_force_sync_operation ();
 
     checked = TRUE;
@@ -359,7 +390,7 @@ get_modem_ready (GObject      *source,
 
     ensure_modem_messaging ();
 
-    if (status_flag)
+    if (status_flag || send_str || delete_messages_str || delete_all_flag)
         g_assert_not_reached ();
 
     /* Request to list SMS? */
@@ -419,6 +450,40 @@ mmcli_modem_messaging_run_asynchronous (GDBusConnection *connection,
                      NULL);
 }
 
+static GPtrArray *
+get_sms_paths_sync (GDBusConnection *connection,
+                    const gchar *str)
+{
+    gchar **items;
+    GPtrArray *paths;
+    guint i;
+
+    items = g_strsplit (str, ",", -1);
+    paths = g_ptr_array_new_with_free_func (g_free);
+    for (i = 0; items[i]; i++) {
+        MMSms *sms;
+        MMObject *obj = NULL;
+
+        sms = mmcli_get_sms_sync (connection,
+                                  g_strstrip (items[i]),
+                                  NULL,
+                                  &obj);
+        if (!g_str_equal (mm_object_get_path (obj), mm_modem_messaging_get_path (ctx->modem_messaging))) {
+            g_printerr ("error: SMS '%s' not owned by modem '%s'",
+                        mm_sms_get_path (sms),
+                        mm_modem_messaging_get_path (ctx->modem_messaging));
+            exit (EXIT_FAILURE);
+        }
+        g_ptr_array_add (paths, mm_sms_dup_path (sms));
+        g_object_unref (sms);
+        g_object_unref (obj);
+    }
+    g_ptr_array_add (paths, NULL);
+    g_strfreev (items);
+
+    return paths;
+}
+
 void
 mmcli_modem_messaging_run_synchronous (GDBusConnection *connection)
 {
@@ -454,6 +519,49 @@ mmcli_modem_messaging_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to list a page of the SMS? */
+    if (list_range_str) {
+        GList *result;
+        gchar **split;
+        guint offset = 0;
+        guint count = 0;
+
+        split = g_strsplit (list_range_str, ",", -1);
+        if (g_strv_length (split) != 2 ||
+            !mm_get_uint_from_str (split[0], &offset) ||
+            !mm_get_uint_from_str (split[1], &count)) {
+            g_printerr ("error: couldn't parse SMS range: '%s'\n",
+                        list_range_str);
+            exit (EXIT_FAILURE);
+        }
+        g_strfreev (split);
+
+        g_debug ("Synchronously listing SMS messages in range...");
+        result = mm_modem_messaging_list_range_sync (ctx->modem_messaging, offset, count, NULL, &error);
+        list_process_reply (result, error);
+        return;
+    }
+
+    /* Request to list the SMS received after a given time? */
+    if (list_since_str) {
+        GList *result;
+        guint64 timestamp;
+        gchar *end = NULL;
+
+        errno = 0;
+        timestamp = g_ascii_strtoull (list_since_str, &end, 10);
+        if (!list_since_str[0] || errno || !end || end[0]) {
+            g_printerr ("error: couldn't parse SMS timestamp: '%s'\n",
+                        list_since_str);
+            exit (EXIT_FAILURE);
+        }
+
+        g_debug ("Synchronously listing SMS messages since %" G_GUINT64_FORMAT "...", timestamp);
+        result = mm_modem_messaging_list_since_sync (ctx->modem_messaging, timestamp, NULL, &error);
+        list_process_reply (result, error);
+        return;
+    }
+
     /* Request to create a new SMS? */
     if (create_str) {
         MMSms *sms;
@@ -501,5 +609,73 @@ mmcli_modem_messaging_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to send several SMS? */
+    if (send_str) {
+        gboolean result;
+        GPtrArray *paths;
+
+        paths = get_sms_paths_sync (connection, send_str);
+
+        g_debug ("Synchronously sending %u SMS...", paths->len - 1);
+        result = mm_modem_messaging_send_messages_sync (ctx->modem_messaging,
+                                                        (const gchar *const *)paths->pdata,
+                                                        NULL,
+                                                        &error);
+        g_ptr_array_unref (paths);
+
+        if (!result) {
+            g_printerr ("error: couldn't send SMS: '%s'\n",
+                        error ? error->message : "unknown error");
+            exit (EXIT_FAILURE);
+        }
+
+        g_print ("successfully sent the SMS\n");
+        return;
+    }
+
+    /* Request to delete all SMS? */
+    if (delete_all_flag) {
+        guint n_deleted = 0;
+
+        g_debug ("Synchronously deleting all SMS...");
+        if (!mm_modem_messaging_delete_all_sync (ctx->modem_messaging,
+                                                 &n_deleted,
+                                                 NULL,
+                                                 &error)) {
+            g_printerr ("error: couldn't delete all SMS: '%s'\n",
+                        error ? error->message : "unknown error");
+            exit (EXIT_FAILURE);
+        }
+
+        g_print ("successfully deleted %u SMS\n", n_deleted);
+        return;
+    }
+
+    /* Request to delete several SMS? */
+    if (delete_messages_str) {
+        gboolean result;
+        GPtrArray *paths;
+        guint n_deleted = 0;
+
+        paths = get_sms_paths_sync (connection, delete_messages_str);
+
+        g_debug ("Synchronously deleting %u SMS...", paths->len - 1);
+        result = mm_modem_messaging_delete_messages_sync (ctx->modem_messaging,
+                                                          (const gchar *const *)paths->pdata,
+                                                          &n_deleted,
+                                                          NULL,
+                                                          &error);
+
+        if (!result) {
+            g_printerr ("error: couldn't delete SMS: '%s'\n",
+                        error ? error->message : "unknown error");
+            exit (EXIT_FAILURE);
+        }
+
+        g_print ("successfully deleted %u of %u SMS\n", n_deleted, paths->len - 1);
+        g_ptr_array_unref (paths);
+        return;
+    }
+
     g_warn_if_reached ();
 }
@@ -47,6 +47,8 @@ static Context *ctx;
 /* Options */
 static gboolean get_flag;
 static gchar *setup_str;
+static gboolean get_history_flag;
+static gchar *setup_history_str;
 
 static GOptionEntry entries[] = {
     { "signal-setup", 0, 0, G_OPTION_ARG_STRING, &setup_str,
@@ -57,6 +59,14 @@ static GOptionEntry entries[] = {
       "Get all extended signal quality information",
       NULL
     },
+    { "signal-setup-history", 0, 0, G_OPTION_ARG_STRING, &setup_history_str,
+      "Setup extended signal information history",
+      "[Size]"
+    },
+    { "signal-get-history", 0, 0, G_OPTION_ARG_NONE, &get_history_flag,
+      "Get extended signal quality information history",
+      NULL
+    },
     { NULL }
 };
 
@@ -85,14 +95,16 @@ mmcli_modem_signal_options_enabled (void)
         return !!n_actions;
 
     n_actions = (!!setup_str +
-                 get_flag);
+                 get_flag +
+                 !!setup_history_str +
+                 get_history_flag);
 
     if (n_actions > 1) {
         g_printerr ("error: too many Signal actions requested\n");
         exit (EXIT_FAILURE);
     }
 
-    if (get_flag)
+    if (get_flag || get_history_flag)
         mmcli_force_sync_operation ();
 
     checked = TRUE;
@@ -222,6 +234,104 @@ print_signal_info (void)
     mmcli_output_dump ();
 }
 
+static gchar **
+build_history_tech_info (GVariant *history,
+                         const gchar *tech)
+{
+    GVariant     *tech_dict;
+    GVariantIter  iter;
+    const gchar  *key;
+    GVariant     *value_dict;
+    GPtrArray    *array;
+
+    tech_dict = g_variant_lookup_value (history, tech, G_VARIANT_TYPE ("a{sv}"));
+    if (!tech_dict)
+        return NULL;
+
+    array = g_ptr_array_new ();
+    g_variant_iter_init (&iter, tech_dict);
+    while (g_variant_iter_next (&iter, "{&s@v}", &key, &value_dict)) {
+        GVariant *stats;
+        guint     samples = 0;
+        gdouble   min = 0, max = 0, mean = 0, p50 = 0, p90 = 0, p95 = 0;
+
+        stats = g_variant_get_variant (value_dict);
+        g_variant_lookup (stats, "samples", "u", &samples);
+        g_variant_lookup (stats, "min",     "d", &min);
+        g_variant_lookup (stats, "max",     "d", &max);
+        g_variant_lookup (stats, "mean",    "d", &mean);
+        g_variant_lookup (stats, "p50",     "d", &p50);
+        g_variant_lookup (stats, "p90",     "d", &p90);
+        g_variant_lookup (stats, "p95",     "d", &p95);
+        g_ptr_array_add (array,
+                         g_strdup_printf ("%s: min %.2lf, max %.2lf, mean %.2lf, p50 %.2lf, p90 %.2lf, p95 %.2lf (%u samples)",
+                                          key, min, max, mean, p50, p90, p95, samples));
+        g_variant_unref (stats);
+        g_variant_unref (value_dict);
+    }
+    g_variant_unref (tech_dict);
+
+    g_ptr_array_add (array, NULL);
+    return (gchar **) g_ptr_array_free (array, FALSE);
+}
+
+static void
+print_signal_history (GVariant *history)
+{
+    guint samples = 0;
+
+    g_variant_lookup (history, "samples", "u", &samples);
+
+    mmcli_output_string_take (MMC_F_SIGNAL_HISTORY_SIZE,    g_strdup_printf ("%u", mm_modem_signal_get_history_size (ctx->modem_signal)));
+    mmcli_output_string_take (MMC_F_SIGNAL_HISTORY_SAMPLES, g_strdup_printf ("%u", samples));
+    mmcli_output_string_array_take (MMC_F_SIGNAL_HISTORY_CDMA1X, build_history_tech_info (history, "cdma"), TRUE);
+    mmcli_output_string_array_take (MMC_F_SIGNAL_HISTORY_EVDO,   build_history_tech_info (history, "evdo"), TRUE);
+    mmcli_output_string_array_take (MMC_F_SIGNAL_HISTORY_GSM,    build_history_tech_info (history, "gsm"),  TRUE);
+    mmcli_output_string_array_take (MMC_F_SIGNAL_HISTORY_UMTS,   build_history_tech_info (history, "umts"), TRUE);
+    mmcli_output_string_array_take (MMC_F_SIGNAL_HISTORY_LTE,    build_history_tech_info (history, "lte"),  TRUE);
+    mmcli_output_dump ();
+}
+
+static void
+get_history_process_reply (GVariant     *history,
+                           const GError *error)
+{
+    if (!history) {
+        g_printerr ("error: couldn't get extended signal information history: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    print_signal_history (history);
+    g_variant_unref (history);
+}
+
+static void
+setup_history_process_reply (gboolean      result,
+                             const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't setup extended signal information history: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_print ("Successfully setup extended signal information history\n");
+}
+
+static void
+setup_history_ready (MMModemSignal *modem,
+                     GAsyncResult  *result)
+{
+    gboolean res;
+    GError *error = NULL;
+
+    res = mm_modem_signal_setup_history_finish (modem, result, &error);
+    setup_history_process_reply (res, error);
+
+    mmcli_async_operation_done ();
+}
+
 static void
 setup_process_reply (gboolean      result,
                      const GError *error)
@@ -261,7 +371,7 @@ get_modem_ready (GObject      *source,
 
     ensure_modem_signal ();
 
-    if (get_flag)
+    if (get_flag || get_history_flag)
         g_assert_not_reached ();
 
     /* Request to setup? */
@@ -282,6 +392,24 @@ get_modem_ready (GObject      *source,
         return;
     }
 
+    /* Request to setup history? */
+    if (setup_history_str) {
+        guint size;
+
+        if (!mm_get_uint_from_str (setup_history_str, &size)) {
+            g_printerr ("error: invalid history size value '%s'", setup_history_str);
+            exit (EXIT_FAILURE);
+        }
+
+        g_debug ("Asynchronously setting up extended signal quality information history...");
+        mm_modem_signal_setup_history (ctx->modem_signal,
+                                       size,
+                                       ctx->cancellable,
+                                       (GAsyncReadyCallback)setup_history_ready,
+                                       NULL);
+        return;
+    }
+
     g_warn_if_reached ();
 }
 
@@ -345,6 +473,34 @@ mmcli_modem_signal_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to get signal history? */
+    if (get_history_flag) {
+        GVariant *history;
+
+        g_debug ("Synchronously getting extended signal quality information history...");
+        history = mm_modem_signal_get_history_sync (ctx->modem_signal, NULL, &error);
+        get_history_process_reply (history, error);
+        return;
+    }
+
+    /* Request to setup history? */
+    if (setup_history_str) {
+        guint size;
+        gboolean result;
+
+        if (!mm_get_uint_from_str (setup_history_str, &size)) {
+            g_printerr ("error: invalid history size value '%s'", setup_history_str);
+            exit (EXIT_FAILURE);
+        }
+
+        g_debug ("Synchronously setting up extended signal quality information history...");
+        result = mm_modem_signal_setup_history_sync (ctx->modem_signal,
+                                                     size,
+                                                     NULL,
+                                                     &error);
+        setup_history_process_reply (result, error);
+        return;
+    }
 
     g_warn_if_reached ();
 }
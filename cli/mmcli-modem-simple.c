@@ -33,6 +33,7 @@
 
 #include "mmcli.h"
 #include "mmcli-common.h"
+#include "mmcli-output.h"
 
 /* Context */
 typedef struct {
@@ -46,6 +47,7 @@ static Context *ctx;
 /* Options */
 static gchar *connect_str;
 static gboolean disconnect_flag;
+static gboolean get_connection_histograms_flag;
 
 static GOptionEntry entries[] = {
     { "simple-connect", 0, 0, G_OPTION_ARG_STRING, &connect_str,
@@ -56,6 +58,10 @@ static GOptionEntry entries[] = {
       "Disconnect all connected bearers.",
       NULL
     },
+    { "simple-get-connection-histograms", 0, 0, G_OPTION_ARG_NONE, &get_connection_histograms_flag,
+      "Get the distribution of connection setup times.",
+      NULL
+    },
     { NULL }
 };
 
@@ -84,7 +90,8 @@ mmcli_modem_simple_options_enabled (void)
         return !!n_actions;
 
     n_actions = (!!connect_str +
-                 disconnect_flag);
+                 disconnect_flag +
+                 get_connection_histograms_flag);
 
     if (n_actions > 1) {
         g_printerr ("error: too many Simple actions requested\n");
@@ -96,6 +103,9 @@ mmcli_modem_simple_options_enabled (void)
     if (connect_str)
         mmcli_force_async_operation ();
 
+    if (get_connection_histograms_flag)
+        mmcli_force_sync_operation ();
+
     checked = TRUE;
     return !!n_actions;
 }
@@ -189,6 +199,74 @@ disconnect_ready (MMModemSimple  *modem_simple,
     mmcli_async_operation_done ();
 }
 
+static gchar **
+build_histogram_info (GVariant    *histograms,
+                      const gchar *key)
+{
+    GVariant      *limits;
+    GVariant      *counts;
+    const guint32 *limit_values;
+    const guint32 *count_values;
+    gsize          n_limits = 0;
+    gsize          n_counts = 0;
+    GPtrArray     *array;
+    gsize          i;
+
+    limits = g_variant_lookup_value (histograms, "bucket-limits", G_VARIANT_TYPE ("au"));
+    counts = g_variant_lookup_value (histograms, key, G_VARIANT_TYPE ("au"));
+    if (!limits || !counts) {
+        if (limits)
+            g_variant_unref (limits);
+        if (counts)
+            g_variant_unref (counts);
+        return NULL;
+    }
+
+    limit_values = g_variant_get_fixed_array (limits, &n_limits, sizeof (guint32));
+    count_values = g_variant_get_fixed_array (counts, &n_counts, sizeof (guint32));
+
+    array = g_ptr_array_new ();
+    for (i = 0; i < n_counts; i++) {
+        if (!count_values[i])
+            continue;
+        if (i < n_limits)
+            g_ptr_array_add (array, g_strdup_printf ("<= %u ms: %u", limit_values[i], count_values[i]));
+        else if (n_limits > 0)
+            g_ptr_array_add (array, g_strdup_printf ("> %u ms: %u", limit_values[n_limits - 1], count_values[i]));
+    }
+    g_variant_unref (limits);
+    g_variant_unref (counts);
+
+    g_ptr_array_add (array, NULL);
+    return (gchar **) g_ptr_array_free (array, FALSE);
+}
+
+static void
+get_connection_histograms_process_reply (GVariant     *histograms,
+                                         const GError *error)
+{
+    guint connections = 0;
+    guint retries = 0;
+
+    if (!histograms) {
+        g_printerr ("error: couldn't get connection histograms: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_variant_lookup (histograms, "connections", "u", &connections);
+    g_variant_lookup (histograms, "retries",     "u", &retries);
+
+    mmcli_output_string_take (MMC_F_SIMPLE_CONNECTIONS, g_strdup_printf ("%u", connections));
+    mmcli_output_string_take (MMC_F_SIMPLE_RETRIES,     g_strdup_printf ("%u", retries));
+    mmcli_output_string_array_take (MMC_F_SIMPLE_TIME_TO_REGISTERED, build_histogram_info (histograms, "time-to-registered"), TRUE);
+    mmcli_output_string_array_take (MMC_F_SIMPLE_TIME_TO_CONNECTED,  build_histogram_info (histograms, "time-to-connected"),  TRUE);
+    mmcli_output_string_array_take (MMC_F_SIMPLE_TIME_TO_IP,         build_histogram_info (histograms, "time-to-ip"),         TRUE);
+    mmcli_output_dump ();
+
+    g_variant_unref (histograms);
+}
+
 static void
 get_modem_ready (GObject      *source,
                  GAsyncResult *result,
@@ -203,6 +281,9 @@ get_modem_ready (GObject      *source,
 
     ensure_modem_simple ();
 
+    if (get_connection_histograms_flag)
+        g_assert_not_reached ();
+
     /* Request to connect the modem? */
     if (connect_str) {
         GError *error = NULL;
@@ -292,5 +373,15 @@ mmcli_modem_simple_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to get connection histograms? */
+    if (get_connection_histograms_flag) {
+        GVariant *histograms;
+
+        g_debug ("Synchronously getting connection histograms...");
+        histograms = mm_modem_simple_get_connection_histograms_sync (ctx->modem_simple, NULL, &error);
+        get_connection_histograms_process_reply (histograms, error);
+        return;
+    }
+
     g_warn_if_reached ();
 }
@@ -57,6 +57,8 @@ static SectionInfo section_infos[] = {
     [MMC_S_MODEM_SIGNAL_GSM]        = { "GSM"                },
     [MMC_S_MODEM_SIGNAL_UMTS]       = { "UMTS"               },
     [MMC_S_MODEM_SIGNAL_LTE]        = { "LTE"                },
+    [MMC_S_MODEM_SIGNAL_HISTORY]    = { "History"            },
+    [MMC_S_MODEM_SIMPLE_CONNECTION] = { "Connection times"   },
     [MMC_S_MODEM_OMA]               = { "OMA"                },
     [MMC_S_MODEM_OMA_CURRENT]       = { "Current session"    },
     [MMC_S_MODEM_OMA_PENDING]       = { "Pending sessions"   },
@@ -166,6 +168,18 @@ static FieldInfo field_infos[] = {
     [MMC_F_SIGNAL_LTE_RSRQ]                   = { "modem.signal.lte.rsrq",                           "rsrq",                     MMC_S_MODEM_SIGNAL_LTE,        },
     [MMC_F_SIGNAL_LTE_RSRP]                   = { "modem.signal.lte.rsrp",                           "rsrp",                     MMC_S_MODEM_SIGNAL_LTE,        },
     [MMC_F_SIGNAL_LTE_SNR]                    = { "modem.signal.lte.snr",                            "s/n",                      MMC_S_MODEM_SIGNAL_LTE,        },
+    [MMC_F_SIGNAL_HISTORY_SIZE]               = { "modem.signal.history.size",                       "size",                     MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_SAMPLES]            = { "modem.signal.history.samples",                    "samples",                  MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_CDMA1X]             = { "modem.signal.history.cdma1x",                     "cdma1x",                   MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_EVDO]               = { "modem.signal.history.evdo",                       "evdo",                     MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_GSM]                = { "modem.signal.history.gsm",                        "gsm",                      MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_UMTS]               = { "modem.signal.history.umts",                       "umts",                     MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIGNAL_HISTORY_LTE]                = { "modem.signal.history.lte",                        "lte",                      MMC_S_MODEM_SIGNAL_HISTORY,    },
+    [MMC_F_SIMPLE_CONNECTIONS]                = { "modem.simple.connection.connections",             "connections",              MMC_S_MODEM_SIMPLE_CONNECTION, },
+    [MMC_F_SIMPLE_RETRIES]                    = { "modem.simple.connection.retries",                 "retries",                  MMC_S_MODEM_SIMPLE_CONNECTION, },
+    [MMC_F_SIMPLE_TIME_TO_REGISTERED]         = { "modem.simple.connection.time-to-registered",      "time to registered",       MMC_S_MODEM_SIMPLE_CONNECTION, },
+    [MMC_F_SIMPLE_TIME_TO_CONNECTED]          = { "modem.simple.connection.time-to-connected",       "time to connected",        MMC_S_MODEM_SIMPLE_CONNECTION, },
+    [MMC_F_SIMPLE_TIME_TO_IP]                 = { "modem.simple.connection.time-to-ip",              "time to ip",               MMC_S_MODEM_SIMPLE_CONNECTION, },
     [MMC_F_OMA_FEATURES]                      = { "modem.oma.features",                              "features",                 MMC_S_MODEM_OMA,               },
     [MMC_F_OMA_CURRENT_TYPE]                  = { "modem.oma.current.type",                          "type",                     MMC_S_MODEM_OMA_CURRENT,       },
     [MMC_F_OMA_CURRENT_STATE]                 = { "modem.oma.current.state",                         "state",                    MMC_S_MODEM_OMA_CURRENT,       },
@@ -174,6 +188,7 @@ static FieldInfo field_infos[] = {
     [MMC_F_LOCATION_ENABLED]                  = { "modem.location.enabled",                          "enabled",                  MMC_S_MODEM_LOCATION,          },
     [MMC_F_LOCATION_SIGNALS]                  = { "modem.location.signals",                          "signals",                  MMC_S_MODEM_LOCATION,          },
     [MMC_F_LOCATION_GPS_REFRESH_RATE]         = { "modem.location.gps.refresh-rate",                 "refresh rate",             MMC_S_MODEM_LOCATION_GPS,      },
+    [MMC_F_LOCATION_GPS_HIGH_RATE]            = { "modem.location.gps.high-rate",                    "high rate",                MMC_S_MODEM_LOCATION_GPS,      },
     [MMC_F_LOCATION_GPS_SUPL_SERVER]          = { "modem.location.gps.supl-server",                  "a-gps supl server",        MMC_S_MODEM_LOCATION_GPS,      },
     [MMC_F_LOCATION_GPS_ASSISTANCE]           = { "modem.location.gps.assistance",                   "supported assistance",     MMC_S_MODEM_LOCATION_GPS,      },
     [MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS]   = { "modem.location.gps.assistance-servers",           "assistance servers",       MMC_S_MODEM_LOCATION_GPS,      },
@@ -222,6 +237,14 @@ static FieldInfo field_infos[] = {
     [MMC_F_BEARER_STATS_DURATION]             = { "bearer.stats.duration",                           "duration",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_BYTES_RX]             = { "bearer.stats.bytes-rx",                           "bytes rx",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_BYTES_TX]             = { "bearer.stats.bytes-tx",                           "bytes tx",                 MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_RATE_RX]              = { "bearer.stats.rate-rx",                            "rate rx",                  MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_RATE_TX]              = { "bearer.stats.rate-tx",                            "rate tx",                  MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_RECONNECT_TIME]       = { "bearer.stats.reconnect-time",                     "reconnect time",           MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_TIME_TO_REGISTERED]   = { "bearer.stats.time-to-registered",                 "time to registered",       MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_TIME_TO_CONNECTED]    = { "bearer.stats.time-to-connected",                  "time to connected",        MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_TIME_TO_IP]           = { "bearer.stats.time-to-ip",                         "time to ip",               MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_RETRIES]              = { "bearer.stats.retries",                            "retries",                  MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_POLLS_AVOIDED]        = { "bearer.stats.polls-avoided",                      "polls avoided",            MMC_S_BEARER_STATS,            },
     [MMC_F_CALL_GENERAL_DBUS_PATH]            = { "call.dbus-path",                                  "dbus path",                MMC_S_CALL_GENERAL,            },
     [MMC_F_CALL_PROPERTIES_NUMBER]            = { "call.properties.number",                          "number",                   MMC_S_CALL_PROPERTIES,         },
     [MMC_F_CALL_PROPERTIES_DIRECTION]         = { "call.properties.direction",                       "direction",                MMC_S_CALL_PROPERTIES,         },
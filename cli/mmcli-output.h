@@ -54,6 +54,8 @@ typedef enum {
     MMC_S_MODEM_SIGNAL_GSM,
     MMC_S_MODEM_SIGNAL_UMTS,
     MMC_S_MODEM_SIGNAL_LTE,
+    MMC_S_MODEM_SIGNAL_HISTORY,
+    MMC_S_MODEM_SIMPLE_CONNECTION,
     MMC_S_MODEM_OMA,
     MMC_S_MODEM_OMA_CURRENT,
     MMC_S_MODEM_OMA_PENDING,
@@ -176,6 +178,19 @@ typedef enum {
     MMC_F_SIGNAL_LTE_RSRQ,
     MMC_F_SIGNAL_LTE_RSRP,
     MMC_F_SIGNAL_LTE_SNR,
+    MMC_F_SIGNAL_HISTORY_SIZE,
+    MMC_F_SIGNAL_HISTORY_SAMPLES,
+    MMC_F_SIGNAL_HISTORY_CDMA1X,
+    MMC_F_SIGNAL_HISTORY_EVDO,
+    MMC_F_SIGNAL_HISTORY_GSM,
+    MMC_F_SIGNAL_HISTORY_UMTS,
+    MMC_F_SIGNAL_HISTORY_LTE,
+    /* Simple connection section */
+    MMC_F_SIMPLE_CONNECTIONS,
+    MMC_F_SIMPLE_RETRIES,
+    MMC_F_SIMPLE_TIME_TO_REGISTERED,
+    MMC_F_SIMPLE_TIME_TO_CONNECTED,
+    MMC_F_SIMPLE_TIME_TO_IP,
     /* OMA section */
     MMC_F_OMA_FEATURES,
     MMC_F_OMA_CURRENT_TYPE,
@@ -186,6 +201,7 @@ typedef enum {
     MMC_F_LOCATION_ENABLED,
     MMC_F_LOCATION_SIGNALS,
     MMC_F_LOCATION_GPS_REFRESH_RATE,
+    MMC_F_LOCATION_GPS_HIGH_RATE,
     MMC_F_LOCATION_GPS_SUPL_SERVER,
     MMC_F_LOCATION_GPS_ASSISTANCE,
     MMC_F_LOCATION_GPS_ASSISTANCE_SERVERS,
@@ -238,6 +254,14 @@ typedef enum {
     MMC_F_BEARER_STATS_DURATION,
     MMC_F_BEARER_STATS_BYTES_RX,
     MMC_F_BEARER_STATS_BYTES_TX,
+    MMC_F_BEARER_STATS_RATE_RX,
+    MMC_F_BEARER_STATS_RATE_TX,
+    MMC_F_BEARER_STATS_RECONNECT_TIME,
+    MMC_F_BEARER_STATS_TIME_TO_REGISTERED,
+    MMC_F_BEARER_STATS_TIME_TO_CONNECTED,
+    MMC_F_BEARER_STATS_TIME_TO_IP,
+    MMC_F_BEARER_STATS_RETRIES,
+    MMC_F_BEARER_STATS_POLLS_AVOIDED,
     MMC_F_CALL_GENERAL_DBUS_PATH,
     MMC_F_CALL_PROPERTIES_NUMBER,
     MMC_F_CALL_PROPERTIES_DIRECTION,
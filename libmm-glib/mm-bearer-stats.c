@@ -37,11 +37,27 @@ G_DEFINE_TYPE (MMBearerStats, mm_bearer_stats, G_TYPE_OBJECT)
 #define PROPERTY_DURATION "duration"
 #define PROPERTY_RX_BYTES "rx-bytes"
 #define PROPERTY_TX_BYTES "tx-bytes"
+#define PROPERTY_RX_RATE  "rx-rate"
+#define PROPERTY_TX_RATE  "tx-rate"
+#define PROPERTY_RECONNECT_TIME "reconnect-time"
+#define PROPERTY_TIME_TO_REGISTERED "time-to-registered"
+#define PROPERTY_TIME_TO_CONNECTED  "time-to-connected"
+#define PROPERTY_TIME_TO_IP         "time-to-ip"
+#define PROPERTY_RETRIES            "retries"
+#define PROPERTY_POLLS_AVOIDED      "polls-avoided"
 
 struct _MMBearerStatsPrivate {
     guint   duration;
     guint64 rx_bytes;
     guint64 tx_bytes;
+    guint64 rx_rate;
+    guint64 tx_rate;
+    guint   reconnect_time;
+    guint   time_to_registered;
+    guint   time_to_connected;
+    guint   time_to_ip;
+    guint   retries;
+    guint   polls_avoided;
 };
 
 /*****************************************************************************/
@@ -127,6 +143,232 @@ mm_bearer_stats_set_tx_bytes (MMBearerStats *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_bearer_stats_get_rx_rate:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the average download rate measured between the last two stats updates,
+ * in bytes per second.
+ *
+ * Returns: a #guint64.
+ */
+guint64
+mm_bearer_stats_get_rx_rate (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->rx_rate;
+}
+
+void
+mm_bearer_stats_set_rx_rate (MMBearerStats *self,
+                             guint64 rate)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->rx_rate = rate;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_tx_rate:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the average upload rate measured between the last two stats updates,
+ * in bytes per second.
+ *
+ * Returns: a #guint64.
+ */
+guint64
+mm_bearer_stats_get_tx_rate (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->tx_rate;
+}
+
+void
+mm_bearer_stats_set_tx_rate (MMBearerStats *self,
+                             guint64 rate)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->tx_rate = rate;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_reconnect_time:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the time it took to connect the bearer again after a previous
+ * connection, in milliseconds.
+ *
+ * Returns: a #guint, or 0 if this is the first connection of the bearer.
+ */
+guint
+mm_bearer_stats_get_reconnect_time (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->reconnect_time;
+}
+
+void
+mm_bearer_stats_set_reconnect_time (MMBearerStats *self,
+                                    guint reconnect_time)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->reconnect_time = reconnect_time;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_time_to_registered:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the time between the connection request and the modem being registered
+ * in the network, in milliseconds.
+ *
+ * Returns: a #guint, or 0 if the connection wasn't requested with the
+ * Simple interface.
+ */
+guint
+mm_bearer_stats_get_time_to_registered (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->time_to_registered;
+}
+
+void
+mm_bearer_stats_set_time_to_registered (MMBearerStats *self,
+                                        guint time_to_registered)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->time_to_registered = time_to_registered;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_time_to_connected:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the time between the connection request and the data connection being
+ * activated in the network, in milliseconds.
+ *
+ * Returns: a #guint.
+ */
+guint
+mm_bearer_stats_get_time_to_connected (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->time_to_connected;
+}
+
+void
+mm_bearer_stats_set_time_to_connected (MMBearerStats *self,
+                                       guint time_to_connected)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->time_to_connected = time_to_connected;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_time_to_ip:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the time between the connection request and the IP configuration
+ * being available, in milliseconds.
+ *
+ * Returns: a #guint.
+ */
+guint
+mm_bearer_stats_get_time_to_ip (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->time_to_ip;
+}
+
+void
+mm_bearer_stats_set_time_to_ip (MMBearerStats *self,
+                                guint time_to_ip)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->time_to_ip = time_to_ip;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_retries:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the number of failed connection attempts and network registration
+ * retries before the connection was established.
+ *
+ * Returns: a #guint.
+ */
+guint
+mm_bearer_stats_get_retries (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->retries;
+}
+
+void
+mm_bearer_stats_set_retries (MMBearerStats *self,
+                             guint retries)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->retries = retries;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_bearer_stats_get_polls_avoided:
+ * @self: a #MMBearerStats.
+ *
+ * Gets the number of connection status queries that were not sent to the
+ * modem during the current connection, because the modem reports connection
+ * status changes by itself.
+ *
+ * Returns: a #guint.
+ */
+guint
+mm_bearer_stats_get_polls_avoided (MMBearerStats *self)
+{
+    g_return_val_if_fail (MM_IS_BEARER_STATS (self), 0);
+
+    return self->priv->polls_avoided;
+}
+
+void
+mm_bearer_stats_set_polls_avoided (MMBearerStats *self,
+                                   guint polls_avoided)
+{
+    g_return_if_fail (MM_IS_BEARER_STATS (self));
+
+    self->priv->polls_avoided = polls_avoided;
+}
+
+/*****************************************************************************/
+
 GVariant *
 mm_bearer_stats_get_dictionary (MMBearerStats *self)
 {
@@ -149,6 +391,44 @@ mm_bearer_stats_get_dictionary (MMBearerStats *self)
                             "{sv}",
                             PROPERTY_TX_BYTES,
                             g_variant_new_uint64 (self->priv->tx_bytes));
+    g_variant_builder_add  (&builder,
+                            "{sv}",
+                            PROPERTY_RX_RATE,
+                            g_variant_new_uint64 (self->priv->rx_rate));
+    g_variant_builder_add  (&builder,
+                            "{sv}",
+                            PROPERTY_TX_RATE,
+                            g_variant_new_uint64 (self->priv->tx_rate));
+    if (self->priv->reconnect_time)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_RECONNECT_TIME,
+                                g_variant_new_uint32 (self->priv->reconnect_time));
+    if (self->priv->time_to_registered)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_TIME_TO_REGISTERED,
+                                g_variant_new_uint32 (self->priv->time_to_registered));
+    if (self->priv->time_to_connected)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_TIME_TO_CONNECTED,
+                                g_variant_new_uint32 (self->priv->time_to_connected));
+    if (self->priv->time_to_ip)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_TIME_TO_IP,
+                                g_variant_new_uint32 (self->priv->time_to_ip));
+    if (self->priv->retries)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_RETRIES,
+                                g_variant_new_uint32 (self->priv->retries));
+    if (self->priv->polls_avoided)
+        g_variant_builder_add  (&builder,
+                                "{sv}",
+                                PROPERTY_POLLS_AVOIDED,
+                                g_variant_new_uint32 (self->priv->polls_avoided));
     return g_variant_builder_end (&builder);
 }
 
@@ -191,6 +471,38 @@ mm_bearer_stats_new_from_dictionary (GVariant *dictionary,
             mm_bearer_stats_set_tx_bytes (
                 self,
                 g_variant_get_uint64 (value));
+        } else if (g_str_equal (key, PROPERTY_RX_RATE)) {
+            mm_bearer_stats_set_rx_rate (
+                self,
+                g_variant_get_uint64 (value));
+        } else if (g_str_equal (key, PROPERTY_TX_RATE)) {
+            mm_bearer_stats_set_tx_rate (
+                self,
+                g_variant_get_uint64 (value));
+        } else if (g_str_equal (key, PROPERTY_RECONNECT_TIME)) {
+            mm_bearer_stats_set_reconnect_time (
+                self,
+                g_variant_get_uint32 (value));
+        } else if (g_str_equal (key, PROPERTY_TIME_TO_REGISTERED)) {
+            mm_bearer_stats_set_time_to_registered (
+                self,
+                g_variant_get_uint32 (value));
+        } else if (g_str_equal (key, PROPERTY_TIME_TO_CONNECTED)) {
+            mm_bearer_stats_set_time_to_connected (
+                self,
+                g_variant_get_uint32 (value));
+        } else if (g_str_equal (key, PROPERTY_TIME_TO_IP)) {
+            mm_bearer_stats_set_time_to_ip (
+                self,
+                g_variant_get_uint32 (value));
+        } else if (g_str_equal (key, PROPERTY_RETRIES)) {
+            mm_bearer_stats_set_retries (
+                self,
+                g_variant_get_uint32 (value));
+        } else if (g_str_equal (key, PROPERTY_POLLS_AVOIDED)) {
+            mm_bearer_stats_set_polls_avoided (
+                self,
+                g_variant_get_uint32 (value));
         }
         g_free (key);
         g_variant_unref (value);
@@ -64,6 +64,14 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMBearerStats, g_object_unref)
 guint   mm_bearer_stats_get_duration (MMBearerStats *self);
 guint64 mm_bearer_stats_get_rx_bytes (MMBearerStats *self);
 guint64 mm_bearer_stats_get_tx_bytes (MMBearerStats *self);
+guint64 mm_bearer_stats_get_rx_rate  (MMBearerStats *self);
+guint64 mm_bearer_stats_get_tx_rate  (MMBearerStats *self);
+guint   mm_bearer_stats_get_reconnect_time (MMBearerStats *self);
+guint   mm_bearer_stats_get_time_to_registered (MMBearerStats *self);
+guint   mm_bearer_stats_get_time_to_connected  (MMBearerStats *self);
+guint   mm_bearer_stats_get_time_to_ip         (MMBearerStats *self);
+guint   mm_bearer_stats_get_retries            (MMBearerStats *self);
+guint   mm_bearer_stats_get_polls_avoided      (MMBearerStats *self);
 
 /*****************************************************************************/
 /* ModemManager/libmm-glib/mmcli specific methods */
@@ -79,6 +87,14 @@ MMBearerStats *mm_bearer_stats_new_from_dictionary (GVariant *dictionary,
 void mm_bearer_stats_set_duration (MMBearerStats *self, guint duration);
 void mm_bearer_stats_set_rx_bytes (MMBearerStats *self, guint64 rx_bytes);
 void mm_bearer_stats_set_tx_bytes (MMBearerStats *self, guint64 tx_bytes);
+void mm_bearer_stats_set_rx_rate  (MMBearerStats *self, guint64 rx_rate);
+void mm_bearer_stats_set_tx_rate  (MMBearerStats *self, guint64 tx_rate);
+void mm_bearer_stats_set_reconnect_time (MMBearerStats *self, guint reconnect_time);
+void mm_bearer_stats_set_time_to_registered (MMBearerStats *self, guint time_to_registered);
+void mm_bearer_stats_set_time_to_connected  (MMBearerStats *self, guint time_to_connected);
+void mm_bearer_stats_set_time_to_ip         (MMBearerStats *self, guint time_to_ip);
+void mm_bearer_stats_set_retries            (MMBearerStats *self, guint retries);
+void mm_bearer_stats_set_polls_avoided      (MMBearerStats *self, guint polls_avoided);
 
 GVariant *mm_bearer_stats_get_dictionary (MMBearerStats *self);
 
@@ -1570,17 +1570,27 @@ mm_sms_delivery_state_get_string_extended (guint delivery_state)
 
 /* From hostap, Copyright (c) 2002-2005, Jouni Malinen <jkmaline@cc.hut.fi> */
 
-static gint
-hex2num (gchar c)
-{
-    if (c >= '0' && c <= '9')
-        return c - '0';
-    if (c >= 'a' && c <= 'f')
-        return c - 'a' + 10;
-    if (c >= 'A' && c <= 'F')
-        return c - 'A' + 10;
-    return -1;
-}
+/* Nibble value of each ASCII char, or -1 if not a hex digit */
+static const gint8 hex_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+#define hex2num(c) ((gint) hex_values[(guint8)(c)])
 
 gint
 mm_utils_hex2byte (const gchar *hex)
@@ -1611,16 +1621,22 @@ mm_utils_hexstr2bin (const gchar *hex, gsize *out_len)
     /* Length must be a multiple of 2 */
     g_return_val_if_fail ((len % 2) == 0, NULL);
 
-    opos = buf = g_malloc0 ((len / 2) + 1);
+    opos = buf = g_malloc ((len / 2) + 1);
     for (i = 0; i < len; i += 2) {
-        a = mm_utils_hex2byte (ipos);
-        if (a < 0) {
+        gint b;
+
+        /* Both nibbles are looked up before checking, so that a single
+         * test catches an invalid char in either */
+        a = hex2num (ipos[0]);
+        b = hex2num (ipos[1]);
+        if ((a | b) < 0) {
             g_free (buf);
             return NULL;
         }
-        *opos++ = a;
+        *opos++ = (a << 4) | b;
         ipos += 2;
     }
+    *opos = '\0';
     *out_len = len / 2;
     return buf;
 }
@@ -1640,13 +1656,8 @@ mm_utils_ishexstr (const gchar *hex)
 
     for (i = 0; i < len; i++) {
         /* Non-hex char? */
-        if (hex[i] >= '0' && hex[i] <= '9')
-            continue;
-        if (hex[i] >= 'a' && hex[i] <= 'f')
-            continue;
-        if (hex[i] >= 'A' && hex[i] <= 'F')
-            continue;
-        return FALSE;
+        if (hex2num (hex[i]) < 0)
+            return FALSE;
     }
 
     return TRUE;
@@ -1655,15 +1666,19 @@ mm_utils_ishexstr (const gchar *hex)
 gchar *
 mm_utils_bin2hexstr (const guint8 *bin, gsize len)
 {
-    GString *ret;
+    static const gchar hex_digits[] = "0123456789ABCDEF";
+    gchar *ret;
     gsize i;
 
     g_return_val_if_fail (bin != NULL, NULL);
 
-    ret = g_string_sized_new (len * 2 + 1);
-    for (i = 0; i < len; i++)
-        g_string_append_printf (ret, "%.2X", bin[i]);
-    return g_string_free (ret, FALSE);
+    ret = g_malloc (len * 2 + 1);
+    for (i = 0; i < len; i++) {
+        ret[2 * i]     = hex_digits[bin[i] >> 4];
+        ret[2 * i + 1] = hex_digits[bin[i] & 0x0F];
+    }
+    ret[len * 2] = '\0';
+    return ret;
 }
 
 gboolean
@@ -1683,3 +1698,61 @@ mm_utils_check_for_single_value (guint32 value)
 
     return TRUE;
 }
+
+/*****************************************************************************/
+/* NMEA sentence tokenizer */
+
+gboolean
+mm_nmea_sentence_parse (MMNmeaSentence *sentence,
+                        const gchar    *trace)
+{
+    const gchar *p;
+    const gchar *end;
+    gchar       *out;
+    guint8       checksum = 0;
+    gsize        len;
+
+    g_return_val_if_fail (sentence != NULL, FALSE);
+
+    if (!trace || trace[0] != '$')
+        return FALSE;
+
+    /* Line terminators are not part of the sentence */
+    len = strcspn (trace, "\r\n");
+    if (len >= sizeof (sentence->buffer))
+        return FALSE;
+    end = trace + len;
+    sentence->length = len;
+
+    /* Split fields in place, computing the checksum along the way: it's the
+     * XOR of all chars between '$' and '*' */
+    out = sentence->buffer;
+    sentence->n_fields = 1;
+    sentence->fields[0] = out;
+    for (p = trace; p < end && *p != '*'; p++) {
+        if (p != trace)
+            checksum ^= (guint8) *p;
+        if (*p == ',') {
+            if (sentence->n_fields == MM_NMEA_SENTENCE_MAX_FIELDS)
+                return FALSE;
+            *out++ = '\0';
+            sentence->fields[sentence->n_fields++] = out;
+        } else
+            *out++ = *p;
+    }
+    *out = '\0';
+
+    /* Checksum is optional, but if given it must match */
+    if (p < end) {
+        gint expected;
+
+        if (end - p != 3)
+            return FALSE;
+        expected = mm_utils_hex2byte (p + 1);
+        if (expected < 0 || (guint8) expected != checksum)
+            return FALSE;
+    }
+
+    /* We need at least the sentence type and one data field */
+    return (sentence->n_fields > 1 && sentence->fields[0][1] != '\0');
+}
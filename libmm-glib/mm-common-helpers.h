@@ -174,6 +174,21 @@ gboolean  mm_utils_ishexstr   (const gchar *hex);
 
 gboolean  mm_utils_check_for_single_value (guint32 value);
 
+/* NMEA sentence tokenizer; fields are split in place in the buffer, the first
+ * one being the sentence type including the leading '$' (e.g. "$GPGGA") */
+#define MM_NMEA_SENTENCE_MAX_LENGTH 256
+#define MM_NMEA_SENTENCE_MAX_FIELDS 48
+
+typedef struct {
+    gchar  buffer[MM_NMEA_SENTENCE_MAX_LENGTH];
+    gchar *fields[MM_NMEA_SENTENCE_MAX_FIELDS];
+    guint  n_fields;
+    gsize  length;
+} MMNmeaSentence;
+
+gboolean  mm_nmea_sentence_parse (MMNmeaSentence *sentence,
+                                  const gchar    *trace);
+
 #if GLIB_CHECK_VERSION(2, 44, 0)
 #define mm_autoptr g_autoptr
 #else
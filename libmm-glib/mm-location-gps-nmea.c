@@ -36,94 +36,134 @@
 
 G_DEFINE_TYPE (MMLocationGpsNmea, mm_location_gps_nmea, G_TYPE_OBJECT);
 
+/* Maximum number of different trace types kept; when full, the least recently
+ * updated one is replaced */
+#define N_TRACE_SLOTS        32
+#define TRACE_TYPE_MAX_SIZE  16
+
+typedef struct {
+    gchar    type[TRACE_TYPE_MAX_SIZE];
+    GString *trace;
+    guint64  last_update;
+} TraceSlot;
+
 struct _MMLocationGpsNmeaPrivate {
-    GHashTable *traces;
-    GRegex *sequence_regex;
+    TraceSlot slots[N_TRACE_SLOTS];
+    guint     n_slots;
+    guint64   n_updates;
+
+    /* Compilation of all traces, rebuilt only when any trace changes */
+    GString  *full;
+    gboolean  full_outdated;
 };
 
 /*****************************************************************************/
 
-static gboolean
-check_append_or_replace (MMLocationGpsNmea *self,
-                         const gchar *trace)
+static TraceSlot *
+find_trace_slot (MMLocationGpsNmea *self,
+                 const gchar       *trace_type)
+{
+    guint i;
+
+    for (i = 0; i < self->priv->n_slots; i++) {
+        if (g_str_equal (self->priv->slots[i].type, trace_type))
+            return &self->priv->slots[i];
+    }
+    return NULL;
+}
+
+static TraceSlot *
+find_or_create_trace_slot (MMLocationGpsNmea *self,
+                           const gchar       *trace_type)
 {
-    /* By default, replace */
-    gboolean append_or_replace = FALSE;
-    GMatchInfo *match_info = NULL;
-
-    if (G_UNLIKELY (!self->priv->sequence_regex))
-        self->priv->sequence_regex = g_regex_new ("\\$GPGSV,(\\d),(\\d).*",
-                                                  G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                                                  0,
-                                                  NULL);
-
-    if (g_regex_match (self->priv->sequence_regex, trace, 0, &match_info)) {
-        guint index;
-
-        /* If we don't have the first element of a sequence, append */
-        if (mm_get_uint_from_match_info (match_info, 2, &index) && index != 1)
-            append_or_replace = TRUE;
+    TraceSlot *slot;
+    guint      i;
+
+    if (strlen (trace_type) >= TRACE_TYPE_MAX_SIZE)
+        return NULL;
+
+    slot = find_trace_slot (self, trace_type);
+    if (slot)
+        return slot;
+
+    if (self->priv->n_slots < N_TRACE_SLOTS) {
+        slot = &self->priv->slots[self->priv->n_slots++];
+        slot->trace = g_string_sized_new (MM_NMEA_SENTENCE_MAX_LENGTH);
+    } else {
+        /* Reuse the least recently updated slot */
+        slot = &self->priv->slots[0];
+        for (i = 1; i < N_TRACE_SLOTS; i++) {
+            if (self->priv->slots[i].last_update < slot->last_update)
+                slot = &self->priv->slots[i];
+        }
+        g_string_truncate (slot->trace, 0);
     }
-    g_match_info_free (match_info);
 
-    return append_or_replace;
+    g_strlcpy (slot->type, trace_type, TRACE_TYPE_MAX_SIZE);
+    return slot;
 }
 
 static gboolean
-location_gps_nmea_take_trace (MMLocationGpsNmea *self,
-                              gchar *trace)
+is_sequence_continuation (const MMNmeaSentence *sentence)
 {
-    gchar *i;
-    gchar *trace_type;
+    guint index;
 
-    i = strchr (trace, ',');
-    if (!i || i == trace) {
-        g_free (trace);
+    /* Only GSV traces are part of a SEQUENCE: $xxGSV,<total>,<index>,... */
+    if (!g_str_has_suffix (sentence->fields[0], "GSV") || sentence->n_fields < 3)
         return FALSE;
-    }
 
-    trace_type = g_malloc (i - trace + 1);
-    memcpy (trace_type, trace, i - trace);
-    trace_type[i - trace] = '\0';
+    /* If we don't have the first element of a sequence, append */
+    return (mm_get_uint_from_str (sentence->fields[2], &index) && index != 1);
+}
 
-    /* Some traces are part of a SEQUENCE; so we need to decide whether we
-     * completely replace the previous trace, or we append the new one to
-     * the already existing list */
-    if (check_append_or_replace (self, trace)) {
-        /* Append */
-        const gchar *previous;
-
-        previous = g_hash_table_lookup (self->priv->traces, trace_type);
-        if (previous) {
-            gchar *sequence;
-
-            /* Skip the trace if we already have it there */
-            if (strstr (previous, trace)) {
-                g_free (trace_type);
-                g_free (trace);
-                return TRUE;
-            }
-
-            sequence = g_strdup_printf ("%s%s%s",
-                                        previous,
-                                        g_str_has_suffix (previous, "\r\n") ? "" : "\r\n",
-                                        trace);
-            g_free (trace);
-            trace = sequence;
-        }
+static gboolean
+trace_slot_contains (TraceSlot   *slot,
+                     const gchar *trace,
+                     gsize        trace_len)
+{
+    const gchar *line;
+    gsize        line_len;
+
+    line = slot->trace->str;
+    while (*line) {
+        line_len = strcspn (line, "\r\n");
+        if (line_len == trace_len && !memcmp (line, trace, trace_len))
+            return TRUE;
+        line += line_len;
+        line += strspn (line, "\r\n");
     }
-
-    g_hash_table_replace (self->priv->traces,
-                          trace_type,
-                          trace);
-    return TRUE;
+    return FALSE;
 }
 
 gboolean
 mm_location_gps_nmea_add_trace (MMLocationGpsNmea *self,
                                 const gchar *trace)
 {
-    return location_gps_nmea_take_trace (self, g_strdup (trace));
+    MMNmeaSentence  sentence;
+    TraceSlot      *slot;
+
+    if (!mm_nmea_sentence_parse (&sentence, trace))
+        return FALSE;
+
+    slot = find_or_create_trace_slot (self, sentence.fields[0]);
+    if (!slot)
+        return FALSE;
+
+    /* Some traces are part of a SEQUENCE; so we need to decide whether we
+     * completely replace the previous trace, or we append the new one to
+     * the already existing list */
+    if (slot->trace->len > 0 && is_sequence_continuation (&sentence)) {
+        /* Skip the trace if we already have it there */
+        if (trace_slot_contains (slot, trace, sentence.length))
+            return TRUE;
+        g_string_append (slot->trace, "\r\n");
+    } else
+        g_string_truncate (slot->trace, 0);
+
+    g_string_append_len (slot->trace, trace, sentence.length);
+    slot->last_update = ++self->priv->n_updates;
+    self->priv->full_outdated = TRUE;
+    return TRUE;
 }
 
 /*****************************************************************************/
@@ -141,20 +181,34 @@ const gchar *
 mm_location_gps_nmea_get_trace (MMLocationGpsNmea *self,
                                 const gchar *trace_type)
 {
-    return (const gchar *)g_hash_table_lookup (self->priv->traces, trace_type);
+    TraceSlot *slot;
+
+    slot = find_trace_slot (self, trace_type);
+    return ((slot && slot->trace->len > 0) ? slot->trace->str : NULL);
 }
 
 /*****************************************************************************/
 
-static void
-build_full_foreach (const gchar *trace_type,
-                    const gchar *trace,
-                    GString **built)
+static const gchar *
+peek_full (MMLocationGpsNmea *self)
 {
-    if ((*built)->len == 0 || g_str_has_suffix ((*built)->str, "\r\n"))
-        g_string_append (*built, trace);
-    else
-        g_string_append_printf (*built, "\r\n%s", trace);
+    guint i;
+
+    if (!self->priv->full_outdated)
+        return self->priv->full->str;
+
+    g_string_truncate (self->priv->full, 0);
+    for (i = 0; i < self->priv->n_slots; i++) {
+        if (!self->priv->slots[i].trace->len)
+            continue;
+        if (self->priv->full->len > 0)
+            g_string_append (self->priv->full, "\r\n");
+        g_string_append_len (self->priv->full,
+                             self->priv->slots[i].trace->str,
+                             self->priv->slots[i].trace->len);
+    }
+    self->priv->full_outdated = FALSE;
+    return self->priv->full->str;
 }
 
 /**
@@ -168,13 +222,7 @@ build_full_foreach (const gchar *trace_type,
 gchar *
 mm_location_gps_nmea_build_full (MMLocationGpsNmea *self)
 {
-    GString *built;
-
-    built = g_string_new ("");
-    g_hash_table_foreach (self->priv->traces,
-                          (GHFunc)build_full_foreach,
-                          &built);
-    return g_string_free (built, FALSE);
+    return g_strdup (peek_full (self));
 }
 
 /*****************************************************************************/
@@ -183,13 +231,10 @@ GVariant *
 mm_location_gps_nmea_get_string_variant (MMLocationGpsNmea *self)
 {
     GVariant *variant = NULL;
-    gchar *built;
 
     g_return_val_if_fail (MM_IS_LOCATION_GPS_NMEA (self), NULL);
 
-    built = mm_location_gps_nmea_build_full (self);
-    variant = g_variant_new_string (built);
-    g_free (built);
+    variant = g_variant_new_string (peek_full (self));
 
     return variant;
 }
@@ -201,8 +246,7 @@ mm_location_gps_nmea_new_from_string_variant (GVariant *string,
                                               GError **error)
 {
     MMLocationGpsNmea *self = NULL;
-    gchar **split;
-    guint i;
+    const gchar *str;
 
     if (!g_variant_is_of_type (string, G_VARIANT_TYPE_STRING)) {
         g_set_error (error,
@@ -213,27 +257,17 @@ mm_location_gps_nmea_new_from_string_variant (GVariant *string,
         return NULL;
     }
 
-    split = g_strsplit (g_variant_get_string (string, NULL), "\r\n", -1);
-    if (!split) {
-        g_set_error (error,
-                     MM_CORE_ERROR,
-                     MM_CORE_ERROR_INVALID_ARGS,
-                     "Invalid GPS NMEA location string: '%s'",
-                     g_variant_get_string (string, NULL));
-        return NULL;
-    }
-
     /* Create new location object */
     self = mm_location_gps_nmea_new ();
 
-    for (i = 0; split[i]; i++) {
-        location_gps_nmea_take_trace (self, split[i]);
+    /* Traces are parsed in place, each one up to the next line terminator */
+    str = g_variant_get_string (string, NULL);
+    while (*str) {
+        mm_location_gps_nmea_add_trace (self, str);
+        str += strcspn (str, "\r\n");
+        str += strspn (str, "\r\n");
     }
 
-    /* Note that the strings in the array of strings were already taken
-     * or freed */
-    g_free (split);
-
     return self;
 }
 
@@ -253,20 +287,18 @@ mm_location_gps_nmea_init (MMLocationGpsNmea *self)
                                               MM_TYPE_LOCATION_GPS_NMEA,
                                               MMLocationGpsNmeaPrivate);
 
-    self->priv->traces = g_hash_table_new_full (g_str_hash,
-                                                g_str_equal,
-                                                g_free,
-                                                g_free);
+    self->priv->full = g_string_sized_new (N_TRACE_SLOTS * MM_NMEA_SENTENCE_MAX_LENGTH / 2);
 }
 
 static void
 finalize (GObject *object)
 {
     MMLocationGpsNmea *self = MM_LOCATION_GPS_NMEA (object);
+    guint i;
 
-    g_hash_table_destroy (self->priv->traces);
-    if (self->priv->sequence_regex)
-        g_regex_unref (self->priv->sequence_regex);
+    for (i = 0; i < self->priv->n_slots; i++)
+        g_string_free (self->priv->slots[i].trace, TRUE);
+    g_string_free (self->priv->full, TRUE);
 
     G_OBJECT_CLASS (mm_location_gps_nmea_parent_class)->finalize (object);
 }
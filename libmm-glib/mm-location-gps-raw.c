@@ -42,7 +42,6 @@ G_DEFINE_TYPE (MMLocationGpsRaw, mm_location_gps_raw, G_TYPE_OBJECT);
 #define PROPERTY_ALTITUDE  "altitude"
 
 struct _MMLocationGpsRawPrivate {
-    GRegex   *gga_regex;
     gboolean  prefer_gngga;
 
     gchar   *utc_time;
@@ -129,59 +128,48 @@ mm_location_gps_raw_get_altitude (MMLocationGpsRaw *self)
 /*****************************************************************************/
 
 static gboolean
-get_longitude_or_latitude_from_match_info (GMatchInfo *match_info,
-                                           guint32 match_index,
-                                           gdouble *out)
+get_longitude_or_latitude_from_str (gchar   *s,
+                                    gdouble *out)
 {
     gchar *aux;
-    gchar *s;
-    gboolean ret = FALSE;
     gdouble minutes;
     gdouble degrees;
 
-    s = g_match_info_fetch (match_info, match_index);
-    if (!s)
-        goto out;
-
     /* 4533.35 is 45 degrees and 33.35 minutes */
 
     aux = strchr (s, '.');
     if (!aux || ((aux - s) < 3))
-        goto out;
+        return FALSE;
 
     aux -= 2;
     if (!mm_get_double_from_str (aux, &minutes))
-        goto out;
+        return FALSE;
 
     aux[0] = '\0';
     if (!mm_get_double_from_str (s, &degrees))
-        goto out;
+        return FALSE;
 
     /* Include the minutes as part of the degrees */
     *out = degrees + (minutes / 60.0);
-    ret = TRUE;
-
-out:
-    g_free (s);
-
-    return ret;
+    return TRUE;
 }
 
 gboolean
 mm_location_gps_raw_add_trace (MMLocationGpsRaw *self,
                                const gchar *trace)
 {
-    GMatchInfo *match_info = NULL;
+    MMNmeaSentence sentence;
+    gsize          utc_time_len;
 
     /* Current implementation works only with $GPGGA and $GNGGA traces */
     do {
-        if (g_str_has_prefix (trace, "$GPGGA")) {
+        if (g_str_has_prefix (trace, "$GPGGA,")) {
             if (self->priv->prefer_gngga)
                 /* Ignore GPGGA, prefer GNGGA */
                 return FALSE;
             break;
         }
-        if (g_str_has_prefix (trace, "$GNGGA")) {
+        if (g_str_has_prefix (trace, "$GNGGA,")) {
             if (!self->priv->prefer_gngga)
                 self->priv->prefer_gngga = TRUE;
             break;
@@ -190,6 +178,9 @@ mm_location_gps_raw_add_trace (MMLocationGpsRaw *self,
         return FALSE;
     } while (0);
 
+    if (!mm_nmea_sentence_parse (&sentence, trace))
+        return FALSE;
+
     /*
      * $GPGGA,hhmmss.ss,llll.ll,a,yyyyy.yy,a,x,xx,x.x,x.x,M,x.x,M,x.x,xxxx*hh
      * 1    = UTC of Position
@@ -209,47 +200,37 @@ mm_location_gps_raw_add_trace (MMLocationGpsRaw *self,
      * 14   = Diff. reference station ID#
      * 15   = Checksum
      */
-    if (G_UNLIKELY (!self->priv->gga_regex))
-        self->priv->gga_regex = g_regex_new ("\\$G(?:P|N)GGA,(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*),(.*)\\*(.*).*",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE,
-                                             0,
-                                             NULL);
-
-    if (g_regex_match (self->priv->gga_regex, trace, 0, &match_info)) {
-        /* UTC time */
+    if (sentence.n_fields < 15)
+        return TRUE;
+
+    /* UTC time; reuse the previous buffer as the format is fixed length */
+    utc_time_len = strlen (sentence.fields[1]);
+    if (self->priv->utc_time && strlen (self->priv->utc_time) == utc_time_len)
+        memcpy (self->priv->utc_time, sentence.fields[1], utc_time_len);
+    else {
         g_free (self->priv->utc_time);
-        self->priv->utc_time = g_match_info_fetch (match_info, 1);
-
-        /* Latitude */
-        self->priv->latitude = MM_LOCATION_LATITUDE_UNKNOWN;
-        if (get_longitude_or_latitude_from_match_info (match_info, 2, &self->priv->latitude)) {
-            gchar *str;
-
-            /* N/S */
-            str = g_match_info_fetch (match_info, 3);
-            if (str && str[0] == 'S')
-                self->priv->latitude *= -1;
-            g_free (str);
-        }
-
-        /* Longitude */
-        self->priv->longitude = MM_LOCATION_LONGITUDE_UNKNOWN;
-        if (get_longitude_or_latitude_from_match_info (match_info, 4, &self->priv->longitude)) {
-            gchar *str;
+        self->priv->utc_time = g_strdup (sentence.fields[1]);
+    }
 
-            /* N/S */
-            str = g_match_info_fetch (match_info, 5);
-            if (str && str[0] == 'W')
-                self->priv->longitude *= -1;
-            g_free (str);
-        }
+    /* Latitude */
+    self->priv->latitude = MM_LOCATION_LATITUDE_UNKNOWN;
+    if (get_longitude_or_latitude_from_str (sentence.fields[2], &self->priv->latitude)) {
+        /* N/S */
+        if (sentence.fields[3][0] == 'S')
+            self->priv->latitude *= -1;
+    }
 
-        /* Altitude */
-        self->priv->altitude = MM_LOCATION_ALTITUDE_UNKNOWN;
-        mm_get_double_from_match_info (match_info, 9, &self->priv->altitude);
+    /* Longitude */
+    self->priv->longitude = MM_LOCATION_LONGITUDE_UNKNOWN;
+    if (get_longitude_or_latitude_from_str (sentence.fields[4], &self->priv->longitude)) {
+        /* E/W */
+        if (sentence.fields[5][0] == 'W')
+            self->priv->longitude *= -1;
     }
 
-    g_match_info_free (match_info);
+    /* Altitude */
+    self->priv->altitude = MM_LOCATION_ALTITUDE_UNKNOWN;
+    mm_get_double_from_str (sentence.fields[9], &self->priv->altitude);
 
     return TRUE;
 }
@@ -384,9 +365,6 @@ finalize (GObject *object)
 {
     MMLocationGpsRaw *self = MM_LOCATION_GPS_RAW (object);
 
-    if (self->priv->gga_regex)
-        g_regex_unref (self->priv->gga_regex);
-
     g_free (self->priv->utc_time);
 
     G_OBJECT_CLASS (mm_location_gps_raw_parent_class)->finalize (object);
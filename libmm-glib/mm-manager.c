@@ -888,6 +888,164 @@ mm_manager_uninhibit_device_sync (MMManager     *manager,
 
 /*****************************************************************************/
 
+static GVariant *
+build_snapshot_options (const gchar  *since_instance,
+                        guint64       since_generation,
+                        const gchar **interfaces)
+{
+    GVariantBuilder builder;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    if (since_instance && since_generation) {
+        g_variant_builder_add (&builder, "{sv}", "since-instance", g_variant_new_string (since_instance));
+        g_variant_builder_add (&builder, "{sv}", "since-generation", g_variant_new_uint64 (since_generation));
+    }
+    if (interfaces)
+        g_variant_builder_add (&builder, "{sv}", "interfaces", g_variant_new_strv (interfaces, -1));
+    return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+/**
+ * mm_manager_get_snapshot_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_manager_get_snapshot().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_get_snapshot().
+ *
+ * Returns: (transfer full): a #GVariant of type "a{sv}" with the snapshot, or %NULL if @error is set. The returned value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_manager_get_snapshot_finish (MMManager     *manager,
+                                GAsyncResult  *res,
+                                GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_snapshot_ready (MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy,
+                    GAsyncResult                       *res,
+                    GTask                              *task)
+{
+    GError   *error = NULL;
+    GVariant *snapshot = NULL;
+
+    if (!mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot_finish (
+            manager_iface_proxy,
+            &snapshot,
+            res,
+            &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, snapshot, (GDestroyNotify) g_variant_unref);
+    g_object_unref (task);
+}
+
+/**
+ * mm_manager_get_snapshot:
+ * @manager: A #MMManager.
+ * @since_instance: (allow-none): the daemon instance of a previous snapshot, or %NULL to request a full snapshot.
+ * @since_generation: the generation of a previous snapshot, or 0 to request a full snapshot.
+ * @interfaces: (allow-none) (array zero-terminated=1): the names of the interfaces to report, or %NULL to use the default ones.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously requests a snapshot of the properties of all the modem and
+ * bearer objects. If @since_instance and @since_generation are given, only
+ * the properties changed since that generation are reported, unless they were
+ * given by a previous instance of the daemon or the daemon can no longer build
+ * the delta, in which case a full snapshot is given. Deltas are only
+ * meaningful if @interfaces is the same as in the previous snapshot.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_get_snapshot_finish() to get the result of the operation.
+ *
+ * See mm_manager_get_snapshot_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_manager_get_snapshot (MMManager           *manager,
+                         const gchar         *since_instance,
+                         guint64              since_generation,
+                         const gchar        **interfaces,
+                         GCancellable        *cancellable,
+                         GAsyncReadyCallback  callback,
+                         gpointer             user_data)
+{
+    GTask    *task;
+    GError   *inner_error = NULL;
+    GVariant *options;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+
+    if (!ensure_modem_manager1_proxy (manager, &inner_error)) {
+        g_task_return_error (task, inner_error);
+        g_object_unref (task);
+        return;
+    }
+
+    options = build_snapshot_options (since_instance, since_generation, interfaces);
+    mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot (
+        manager->priv->manager_iface_proxy,
+        options,
+        cancellable,
+        (GAsyncReadyCallback)get_snapshot_ready,
+        task);
+    g_variant_unref (options);
+}
+
+/**
+ * mm_manager_get_snapshot_sync:
+ * @manager: A #MMManager.
+ * @since_instance: (allow-none): the daemon instance of a previous snapshot, or %NULL to request a full snapshot.
+ * @since_generation: the generation of a previous snapshot, or 0 to request a full snapshot.
+ * @interfaces: (allow-none) (array zero-terminated=1): the names of the interfaces to report, or %NULL to use the default ones.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously requests a snapshot of the properties of all the modem and
+ * bearer objects.
+ *
+ * The calling thread is blocked until a reply is received.
+ *
+ * See mm_manager_get_snapshot() for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): a #GVariant of type "a{sv}" with the snapshot, or %NULL if @error is set. The returned value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_manager_get_snapshot_sync (MMManager     *manager,
+                              const gchar   *since_instance,
+                              guint64        since_generation,
+                              const gchar  **interfaces,
+                              GCancellable  *cancellable,
+                              GError       **error)
+{
+    GVariant *options;
+    GVariant *snapshot = NULL;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    if (!ensure_modem_manager1_proxy (manager, error))
+        return NULL;
+
+    options = build_snapshot_options (since_instance, since_generation, interfaces);
+    mm_gdbus_org_freedesktop_modem_manager1_call_get_snapshot_sync (
+        manager->priv->manager_iface_proxy,
+        options,
+        &snapshot,
+        cancellable,
+        error);
+    g_variant_unref (options);
+    return snapshot;
+}
+
+/*****************************************************************************/
+
 static void
 register_dbus_errors (void)
 {
@@ -154,6 +154,23 @@ gboolean mm_manager_uninhibit_device_sync   (MMManager           *manager,
                                              GCancellable        *cancellable,
                                              GError             **error);
 
+void      mm_manager_get_snapshot        (MMManager            *manager,
+                                          const gchar          *since_instance,
+                                          guint64               since_generation,
+                                          const gchar         **interfaces,
+                                          GCancellable         *cancellable,
+                                          GAsyncReadyCallback   callback,
+                                          gpointer              user_data);
+GVariant *mm_manager_get_snapshot_finish (MMManager            *manager,
+                                          GAsyncResult         *res,
+                                          GError              **error);
+GVariant *mm_manager_get_snapshot_sync   (MMManager            *manager,
+                                          const gchar          *since_instance,
+                                          guint64               since_generation,
+                                          const gchar         **interfaces,
+                                          GCancellable         *cancellable,
+                                          GError              **error);
+
 G_END_DECLS
 
 #endif /* _MM_MANAGER_H_ */
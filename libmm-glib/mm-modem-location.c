@@ -22,6 +22,7 @@
  */
 
 #include <gio/gio.h>
+#include <gio/gunixfdlist.h>
 
 #include "mm-helpers.h"
 #include "mm-errors-types.h"
@@ -409,6 +410,140 @@ mm_modem_location_inject_assistance_data_sync (MMModemLocation  *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_location_inject_assistance_data_fd_finish:
+ * @self: A #MMModemLocation.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_location_inject_assistance_data_fd().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_location_inject_assistance_data_fd().
+ *
+ * Returns: %TRUE if the injection was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_location_inject_assistance_data_fd_finish (MMModemLocation  *self,
+                                                    GAsyncResult     *res,
+                                                    GError          **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), FALSE);
+
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+inject_assistance_data_fd_ready (MmGdbusModemLocation *proxy,
+                                 GAsyncResult         *res,
+                                 GTask                *task)
+{
+    GError *error = NULL;
+
+    if (!mm_gdbus_modem_location_call_inject_assistance_data_fd_finish (proxy, NULL, res, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+/**
+ * mm_modem_location_inject_assistance_data_fd:
+ * @self: A #MMModemLocation.
+ * @fd: File descriptor of a regular file with the data to inject.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Aynchronously injects assistance data to the GNSS module, passing the
+ * file descriptor to the daemon instead of the file contents.
+ *
+ * The file descriptor is duplicated, so the caller keeps ownership of @fd.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_location_inject_assistance_data_fd_finish() to get the result of the operation.
+ *
+ * See mm_modem_location_inject_assistance_data_fd_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_location_inject_assistance_data_fd (MMModemLocation     *self,
+                                             gint                 fd,
+                                             GCancellable        *cancellable,
+                                             GAsyncReadyCallback  callback,
+                                             gpointer             user_data)
+{
+    GUnixFDList *fd_list;
+    GTask       *task;
+    GError      *error = NULL;
+    gint         idx;
+
+    g_return_if_fail (MM_IS_MODEM_LOCATION (self));
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    fd_list = g_unix_fd_list_new ();
+    idx = g_unix_fd_list_append (fd_list, fd, &error);
+    if (idx < 0) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        g_object_unref (fd_list);
+        return;
+    }
+
+    mm_gdbus_modem_location_call_inject_assistance_data_fd (MM_GDBUS_MODEM_LOCATION (self),
+                                                            idx,
+                                                            fd_list,
+                                                            cancellable,
+                                                            (GAsyncReadyCallback)inject_assistance_data_fd_ready,
+                                                            task);
+    g_object_unref (fd_list);
+}
+
+/**
+ * mm_modem_location_inject_assistance_data_fd_sync:
+ * @self: A #MMModemLocation.
+ * @fd: File descriptor of a regular file with the data to inject.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously injects assistance data to the GNSS module, passing the
+ * file descriptor to the daemon instead of the file contents.
+ *
+ * The file descriptor is duplicated, so the caller keeps ownership of @fd.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_location_inject_assistance_data_fd()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if the injection was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_location_inject_assistance_data_fd_sync (MMModemLocation  *self,
+                                                  gint              fd,
+                                                  GCancellable     *cancellable,
+                                                  GError          **error)
+{
+    GUnixFDList *fd_list;
+    gboolean     result;
+    gint         idx;
+
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), FALSE);
+
+    fd_list = g_unix_fd_list_new ();
+    idx = g_unix_fd_list_append (fd_list, fd, error);
+    if (idx < 0) {
+        g_object_unref (fd_list);
+        return FALSE;
+    }
+
+    result = mm_gdbus_modem_location_call_inject_assistance_data_fd_sync (MM_GDBUS_MODEM_LOCATION (self),
+                                                                          idx,
+                                                                          fd_list,
+                                                                          NULL,
+                                                                          cancellable,
+                                                                          error);
+    g_object_unref (fd_list);
+    return result;
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_location_set_gps_refresh_rate_finish:
  * @self: A #MMModemLocation.
@@ -494,6 +629,91 @@ mm_modem_location_set_gps_refresh_rate_sync (MMModemLocation *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_location_set_gps_high_rate_finish:
+ * @self: A #MMModemLocation.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_location_set_gps_high_rate().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_location_set_gps_high_rate().
+ *
+ * Returns: %TRUE if setting the GPS high rate mode was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_location_set_gps_high_rate_finish (MMModemLocation *self,
+                                            GAsyncResult *res,
+                                            GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), FALSE);
+
+    return mm_gdbus_modem_location_call_set_gps_high_rate_finish (MM_GDBUS_MODEM_LOCATION (self), res, error);
+}
+
+/**
+ * mm_modem_location_set_gps_high_rate:
+ * @self: A #MMModemLocation.
+ * @enable: %TRUE to emit every GPS fix, %FALSE otherwise.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously enables or disables the GPS high rate mode.
+ *
+ * In high rate mode, every GPS fix reported by the modem is emitted in the
+ * #MmGdbusModemLocation::gps-fix signal, while the location property keeps
+ * being updated at the configured GPS refresh rate.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_location_set_gps_high_rate_finish() to get the result of the operation.
+ *
+ * See mm_modem_location_set_gps_high_rate_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_location_set_gps_high_rate (MMModemLocation *self,
+                                     gboolean enable,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_LOCATION (self));
+
+    mm_gdbus_modem_location_call_set_gps_high_rate (MM_GDBUS_MODEM_LOCATION (self),
+                                                    enable,
+                                                    cancellable,
+                                                    callback,
+                                                    user_data);
+}
+
+/**
+ * mm_modem_location_set_gps_high_rate_sync:
+ * @self: A #MMModemLocation.
+ * @enable: %TRUE to emit every GPS fix, %FALSE otherwise.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously enables or disables the GPS high rate mode.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_location_set_gps_high_rate()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if setting the GPS high rate mode was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_location_set_gps_high_rate_sync (MMModemLocation *self,
+                                          gboolean enable,
+                                          GCancellable *cancellable,
+                                          GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), FALSE);
+
+    return mm_gdbus_modem_location_call_set_gps_high_rate_sync (MM_GDBUS_MODEM_LOCATION (self),
+                                                                enable,
+                                                                cancellable,
+                                                                error);
+}
+
+/*****************************************************************************/
+
 static gboolean
 build_locations (GVariant *dictionary,
                  MMLocation3gpp **location_3gpp,
@@ -1047,6 +1267,24 @@ mm_modem_location_get_gps_refresh_rate (MMModemLocation *self)
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_location_get_gps_high_rate:
+ * @self: A #MMModemLocation.
+ *
+ * Gets whether every GPS fix is emitted in the #MmGdbusModemLocation::gps-fix signal.
+ *
+ * Returns: %TRUE if the GPS high rate mode is enabled, %FALSE otherwise.
+ */
+gboolean
+mm_modem_location_get_gps_high_rate (MMModemLocation *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_LOCATION (self), FALSE);
+
+    return mm_gdbus_modem_location_get_gps_high_rate (MM_GDBUS_MODEM_LOCATION (self));
+}
+
+/*****************************************************************************/
+
 static void
 mm_modem_location_init (MMModemLocation *self)
 {
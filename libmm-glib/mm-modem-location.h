@@ -88,7 +88,8 @@ gchar       *mm_modem_location_dup_supl_server (MMModemLocation *self);
 const gchar **mm_modem_location_get_assistance_data_servers (MMModemLocation *self);
 gchar       **mm_modem_location_dup_assistance_data_servers (MMModemLocation *self);
 
-guint mm_modem_location_get_gps_refresh_rate (MMModemLocation *self);
+guint    mm_modem_location_get_gps_refresh_rate (MMModemLocation *self);
+gboolean mm_modem_location_get_gps_high_rate    (MMModemLocation *self);
 
 void     mm_modem_location_setup        (MMModemLocation *self,
                                          MMModemLocationSource sources,
@@ -133,6 +134,19 @@ gboolean mm_modem_location_inject_assistance_data_sync   (MMModemLocation      *
                                                           GCancellable         *cancellable,
                                                           GError              **error);
 
+void     mm_modem_location_inject_assistance_data_fd        (MMModemLocation      *self,
+                                                             gint                  fd,
+                                                             GCancellable         *cancellable,
+                                                             GAsyncReadyCallback   callback,
+                                                             gpointer              user_data);
+gboolean mm_modem_location_inject_assistance_data_fd_finish (MMModemLocation      *self,
+                                                             GAsyncResult         *res,
+                                                             GError              **error);
+gboolean mm_modem_location_inject_assistance_data_fd_sync   (MMModemLocation      *self,
+                                                             gint                  fd,
+                                                             GCancellable         *cancellable,
+                                                             GError              **error);
+
 void     mm_modem_location_set_gps_refresh_rate        (MMModemLocation *self,
                                                         guint rate,
                                                         GCancellable *cancellable,
@@ -146,6 +160,19 @@ gboolean mm_modem_location_set_gps_refresh_rate_sync   (MMModemLocation *self,
                                                         GCancellable *cancellable,
                                                         GError **error);
 
+void     mm_modem_location_set_gps_high_rate        (MMModemLocation *self,
+                                                     gboolean enable,
+                                                     GCancellable *cancellable,
+                                                     GAsyncReadyCallback callback,
+                                                     gpointer user_data);
+gboolean mm_modem_location_set_gps_high_rate_finish (MMModemLocation *self,
+                                                     GAsyncResult *res,
+                                                     GError **error);
+gboolean mm_modem_location_set_gps_high_rate_sync   (MMModemLocation *self,
+                                                     gboolean enable,
+                                                     GCancellable *cancellable,
+                                                     GError **error);
+
 void            mm_modem_location_get_3gpp        (MMModemLocation *self,
                                                    GCancellable *cancellable,
                                                    GAsyncReadyCallback callback,
@@ -45,6 +45,7 @@ struct _MMModemMessagingPrivate {
     /* Supported Storage */
     GMutex supported_storages_mutex;
     guint supported_storages_id;
+    gboolean supported_storages_stale;
     GArray *supported_storages;
 };
 
@@ -96,15 +97,12 @@ supported_storages_updated (MMModemMessaging *self,
 {
     g_mutex_lock (&self->priv->supported_storages_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->supported_storages)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->supported_storages) {
             g_array_unref (self->priv->supported_storages);
-
-        dictionary = mm_gdbus_modem_messaging_get_supported_storages (MM_GDBUS_MODEM_MESSAGING (self));
-        self->priv->supported_storages = (dictionary ?
-                                          mm_common_sms_storages_variant_to_garray (dictionary) :
-                                          NULL);
+            self->priv->supported_storages = NULL;
+        }
+        self->priv->supported_storages_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->supported_storages_mutex);
 }
@@ -116,8 +114,19 @@ ensure_internal_supported_storages (MMModemMessaging *self,
     g_mutex_lock (&self->priv->supported_storages_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->supported_storages_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->supported_storages_id =
+                g_signal_connect (self,
+                                  "notify::supported-storages",
+                                  G_CALLBACK (supported_storages_updated),
+                                  NULL);
+            self->priv->supported_storages_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->supported_storages_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_messaging_dup_supported_storages (MM_GDBUS_MODEM_MESSAGING (self));
@@ -125,13 +134,7 @@ ensure_internal_supported_storages (MMModemMessaging *self,
                 self->priv->supported_storages = mm_common_sms_storages_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->supported_storages_id =
-                g_signal_connect (self,
-                                  "notify::supported-storages",
-                                  G_CALLBACK (supported_storages_updated),
-                                  NULL);
+            self->priv->supported_storages_stale = FALSE;
         }
 
         if (dup && self->priv->supported_storages)
@@ -222,6 +225,7 @@ typedef struct {
     gchar **sms_paths;
     GList *sms_objects;
     guint i;
+    gboolean keep_order;
 } ListSmsContext;
 
 static void
@@ -290,6 +294,8 @@ list_build_object_ready (GDBusConnection *connection,
         GList *sms_objects;
 
         sms_objects = g_list_copy_deep (ctx->sms_objects, (GCopyFunc)g_object_ref, NULL);
+        if (ctx->keep_order)
+            sms_objects = g_list_reverse (sms_objects);
         g_task_return_pointer (task, sms_objects, (GDestroyNotify)sms_object_list_free);
         g_object_unref (task);
         return;
@@ -364,6 +370,40 @@ mm_modem_messaging_list (MMModemMessaging *self,
     create_next_sms (task);
 }
 
+/* Objects are returned in reverse order */
+static GList *
+create_sms_objects_sync (MMModemMessaging *self,
+                         gchar **sms_paths,
+                         GCancellable *cancellable,
+                         GError **error)
+{
+    GList *sms_objects = NULL;
+    guint i;
+
+    for (i = 0; sms_paths && sms_paths[i]; i++) {
+        GObject *sms;
+
+        sms = g_initable_new (MM_TYPE_SMS,
+                              cancellable,
+                              error,
+                              "g-flags",          G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START,
+                              "g-name",           MM_DBUS_SERVICE,
+                              "g-connection",     g_dbus_proxy_get_connection (G_DBUS_PROXY (self)),
+                              "g-object-path",    sms_paths[i],
+                              "g-interface-name", "org.freedesktop.ModemManager1.Sms",
+                              NULL);
+        if (!sms) {
+            sms_object_list_free (sms_objects);
+            return NULL;
+        }
+
+        /* Keep the object */
+        sms_objects = g_list_prepend (sms_objects, sms);
+    }
+
+    return sms_objects;
+}
+
 /**
  * mm_modem_messaging_list_sync:
  * @self: A #MMModemMessaging.
@@ -382,9 +422,8 @@ mm_modem_messaging_list_sync (MMModemMessaging *self,
                               GCancellable *cancellable,
                               GError **error)
 {
-    GList *sms_objects = NULL;
+    GList *sms_objects;
     gchar **sms_paths = NULL;
-    guint i;
 
     g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
 
@@ -394,28 +433,258 @@ mm_modem_messaging_list_sync (MMModemMessaging *self,
     if (!sms_paths)
         return NULL;
 
-    for (i = 0; sms_paths[i]; i++) {
-        GObject *sms;
+    sms_objects = create_sms_objects_sync (self, sms_paths, cancellable, error);
+    g_strfreev (sms_paths);
+    return sms_objects;
+}
 
-        sms = g_initable_new (MM_TYPE_SMS,
-                                 cancellable,
-                                 error,
-                                 "g-flags",          G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START,
-                                 "g-name",           MM_DBUS_SERVICE,
-                                 "g-connection",     g_dbus_proxy_get_connection (G_DBUS_PROXY (self)),
-                                 "g-object-path",    sms_paths[i],
-                                 "g-interface-name", "org.freedesktop.ModemManager1.Sms",
-                              NULL);
-        if (!sms) {
-            sms_object_list_free (sms_objects);
-            g_strfreev (sms_paths);
-            return NULL;
-        }
+/*****************************************************************************/
 
-        /* Keep the object */
-        sms_objects = g_list_prepend (sms_objects, sms);
+static void
+list_paths_ready (MMModemMessaging *self,
+                  GAsyncResult *res,
+                  GTask *task)
+{
+    ListSmsContext *ctx;
+    GError *error = NULL;
+    gboolean success;
+
+    ctx = g_task_get_task_data (task);
+
+    if (g_task_get_source_tag (task) == mm_modem_messaging_list_range)
+        success = mm_gdbus_modem_messaging_call_list_range_finish (MM_GDBUS_MODEM_MESSAGING (self),
+                                                                   &ctx->sms_paths,
+                                                                   res,
+                                                                   &error);
+    else
+        success = mm_gdbus_modem_messaging_call_list_since_finish (MM_GDBUS_MODEM_MESSAGING (self),
+                                                                   &ctx->sms_paths,
+                                                                   res,
+                                                                   &error);
+    if (!success) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
     }
 
+    /* If no SMS, just end here. */
+    if (!ctx->sms_paths || !ctx->sms_paths[0]) {
+        g_task_return_pointer (task, NULL, NULL);
+        g_object_unref (task);
+        return;
+    }
+
+    ctx->i = 0;
+    create_next_sms (task);
+}
+
+static GTask *
+list_paths_task_new (MMModemMessaging *self,
+                     gpointer source_tag,
+                     GCancellable *cancellable,
+                     GAsyncReadyCallback callback,
+                     gpointer user_data)
+{
+    ListSmsContext *ctx;
+    GTask *task;
+
+    ctx = g_slice_new0 (ListSmsContext);
+    ctx->keep_order = TRUE;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+    g_task_set_source_tag (task, source_tag);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)list_sms_context_free);
+    return task;
+}
+
+/**
+ * mm_modem_messaging_list_range_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_messaging_list_range().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_list_range().
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms objects, oldest first, or #NULL if either not found or @error is set. The returned value should be freed with g_list_free_full() using g_object_unref() as #GDestroyNotify function.
+ */
+GList *
+mm_modem_messaging_list_range_finish (MMModemMessaging *self,
+                                      GAsyncResult *res,
+                                      GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+/**
+ * mm_modem_messaging_list_range:
+ * @self: A #MMModemMessaging.
+ * @offset: Number of messages to skip.
+ * @count: Maximum number of messages to list, or 0 to list all the remaining ones.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously lists a page of the #MMSms objects in the modem, sorted in
+ * the order they were added, oldest first.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_messaging_list_range_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_list_range_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_messaging_list_range (MMModemMessaging *self,
+                               guint offset,
+                               guint count,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    task = list_paths_task_new (self, mm_modem_messaging_list_range, cancellable, callback, user_data);
+    mm_gdbus_modem_messaging_call_list_range (MM_GDBUS_MODEM_MESSAGING (self),
+                                              offset,
+                                              count,
+                                              cancellable,
+                                              (GAsyncReadyCallback)list_paths_ready,
+                                              task);
+}
+
+/**
+ * mm_modem_messaging_list_range_sync:
+ * @self: A #MMModemMessaging.
+ * @offset: Number of messages to skip.
+ * @count: Maximum number of messages to list, or 0 to list all the remaining ones.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously lists a page of the #MMSms objects in the modem, sorted in
+ * the order they were added, oldest first.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_messaging_list_range()
+ * for the asynchronous version of this method.
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms objects, oldest first, or #NULL if either not found or @error is set. The returned value should be freed with g_list_free_full() using g_object_unref() as #GDestroyNotify function.
+ */
+GList *
+mm_modem_messaging_list_range_sync (MMModemMessaging *self,
+                                    guint offset,
+                                    guint count,
+                                    GCancellable *cancellable,
+                                    GError **error)
+{
+    GList *sms_objects;
+    gchar **sms_paths = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    if (!mm_gdbus_modem_messaging_call_list_range_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                        offset,
+                                                        count,
+                                                        &sms_paths,
+                                                        cancellable,
+                                                        error))
+        return NULL;
+
+    sms_objects = g_list_reverse (create_sms_objects_sync (self, sms_paths, cancellable, error));
+    g_strfreev (sms_paths);
+    return sms_objects;
+}
+
+/**
+ * mm_modem_messaging_list_since_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_messaging_list_since().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_list_since().
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms objects, oldest first, or #NULL if either not found or @error is set. The returned value should be freed with g_list_free_full() using g_object_unref() as #GDestroyNotify function.
+ */
+GList *
+mm_modem_messaging_list_since_finish (MMModemMessaging *self,
+                                      GAsyncResult *res,
+                                      GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+/**
+ * mm_modem_messaging_list_since:
+ * @self: A #MMModemMessaging.
+ * @timestamp: Time in seconds since the UNIX epoch.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously lists the #MMSms objects in the modem with a timestamp
+ * equal to or later than @timestamp.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_messaging_list_since_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_list_since_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_messaging_list_since (MMModemMessaging *self,
+                               guint64 timestamp,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    task = list_paths_task_new (self, mm_modem_messaging_list_since, cancellable, callback, user_data);
+    mm_gdbus_modem_messaging_call_list_since (MM_GDBUS_MODEM_MESSAGING (self),
+                                              timestamp,
+                                              cancellable,
+                                              (GAsyncReadyCallback)list_paths_ready,
+                                              task);
+}
+
+/**
+ * mm_modem_messaging_list_since_sync:
+ * @self: A #MMModemMessaging.
+ * @timestamp: Time in seconds since the UNIX epoch.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously lists the #MMSms objects in the modem with a timestamp
+ * equal to or later than @timestamp.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_messaging_list_since()
+ * for the asynchronous version of this method.
+ *
+ * Returns: (element-type ModemManager.Sms) (transfer full): A list of #MMSms objects, oldest first, or #NULL if either not found or @error is set. The returned value should be freed with g_list_free_full() using g_object_unref() as #GDestroyNotify function.
+ */
+GList *
+mm_modem_messaging_list_since_sync (MMModemMessaging *self,
+                                    guint64 timestamp,
+                                    GCancellable *cancellable,
+                                    GError **error)
+{
+    GList *sms_objects;
+    gchar **sms_paths = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), NULL);
+
+    if (!mm_gdbus_modem_messaging_call_list_since_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                        timestamp,
+                                                        &sms_paths,
+                                                        cancellable,
+                                                        error))
+        return NULL;
+
+    sms_objects = g_list_reverse (create_sms_objects_sync (self, sms_paths, cancellable, error));
     g_strfreev (sms_paths);
     return sms_objects;
 }
@@ -667,6 +936,272 @@ mm_modem_messaging_delete_sync (MMModemMessaging *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_messaging_delete_messages_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_messaging_delete_messages().
+ * @n_deleted: (out) (allow-none): Return location for the number of messages deleted, or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_delete_messages().
+ *
+ * Returns: %TRUE if any of the messages was deleted, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_delete_messages_finish (MMModemMessaging *self,
+                                           GAsyncResult *res,
+                                           guint *n_deleted,
+                                           GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_delete_messages_finish (MM_GDBUS_MODEM_MESSAGING (self), n_deleted, res, error);
+}
+
+/**
+ * mm_modem_messaging_delete_messages:
+ * @self: A #MMModemMessaging.
+ * @sms: (array zero-terminated=1): %NULL-terminated array of paths of the #MMSms objects to delete.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously deletes the given #MMSms objects from the modem, selecting
+ * each storage only once.
+ *
+ * Messages which cannot be deleted are kept; the operation only fails if
+ * none of them could be deleted.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_messaging_delete_messages_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_delete_messages_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_messaging_delete_messages (MMModemMessaging *self,
+                                    const gchar *const *sms,
+                                    GCancellable *cancellable,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    mm_gdbus_modem_messaging_call_delete_messages (MM_GDBUS_MODEM_MESSAGING (self),
+                                                   sms,
+                                                   cancellable,
+                                                   callback,
+                                                   user_data);
+}
+
+/**
+ * mm_modem_messaging_delete_messages_sync:
+ * @self: A #MMModemMessaging.
+ * @sms: (array zero-terminated=1): %NULL-terminated array of paths of the #MMSms objects to delete.
+ * @n_deleted: (out) (allow-none): Return location for the number of messages deleted, or %NULL.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously deletes the given #MMSms objects from the modem, selecting
+ * each storage only once.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_messaging_delete_messages()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if any of the messages was deleted, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_delete_messages_sync (MMModemMessaging *self,
+                                         const gchar *const *sms,
+                                         guint *n_deleted,
+                                         GCancellable *cancellable,
+                                         GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_delete_messages_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                               sms,
+                                                               n_deleted,
+                                                               cancellable,
+                                                               error);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_messaging_delete_all_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_messaging_delete_all().
+ * @n_deleted: (out) (allow-none): Return location for the number of messages deleted, or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_delete_all().
+ *
+ * Returns: %TRUE if the messages were deleted, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_delete_all_finish (MMModemMessaging *self,
+                                      GAsyncResult *res,
+                                      guint *n_deleted,
+                                      GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_delete_all_finish (MM_GDBUS_MODEM_MESSAGING (self), n_deleted, res, error);
+}
+
+/**
+ * mm_modem_messaging_delete_all:
+ * @self: A #MMModemMessaging.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously deletes all the #MMSms objects from the modem, clearing each
+ * storage in a single operation if the modem supports it.
+ *
+ * Any message in the storages not exposed as a #MMSms object, e.g. one that
+ * could not be parsed, is also removed from the modem.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_messaging_delete_all_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_delete_all_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_messaging_delete_all (MMModemMessaging *self,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    mm_gdbus_modem_messaging_call_delete_all (MM_GDBUS_MODEM_MESSAGING (self),
+                                              cancellable,
+                                              callback,
+                                              user_data);
+}
+
+/**
+ * mm_modem_messaging_delete_all_sync:
+ * @self: A #MMModemMessaging.
+ * @n_deleted: (out) (allow-none): Return location for the number of messages deleted, or %NULL.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously deletes all the #MMSms objects from the modem, clearing each
+ * storage in a single operation if the modem supports it.
+ *
+ * Any message in the storages not exposed as a #MMSms object, e.g. one that
+ * could not be parsed, is also removed from the modem.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_messaging_delete_all()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if the messages were deleted, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_delete_all_sync (MMModemMessaging *self,
+                                    guint *n_deleted,
+                                    GCancellable *cancellable,
+                                    GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_delete_all_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                          n_deleted,
+                                                          cancellable,
+                                                          error);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_messaging_send_messages_finish:
+ * @self: A #MMModemMessaging.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_messaging_send_messages().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_messaging_send_messages().
+ *
+ * Returns: %TRUE if all the messages were sent, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_send_messages_finish (MMModemMessaging *self,
+                                         GAsyncResult *res,
+                                         GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_send_messages_finish (MM_GDBUS_MODEM_MESSAGING (self), res, error);
+}
+
+/**
+ * mm_modem_messaging_send_messages:
+ * @self: A #MMModemMessaging.
+ * @sms: (array zero-terminated=1): %NULL-terminated array of paths of the #MMSms objects to send.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously sends the given #MMSms objects in a single batch, in the
+ * given order, keeping the link to the SMS relay open between them if the
+ * modem supports it.
+ *
+ * The operation stops at the first message that cannot be sent.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_messaging_send_messages_finish() to get the result of the operation.
+ *
+ * See mm_modem_messaging_send_messages_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_messaging_send_messages (MMModemMessaging *self,
+                                  const gchar *const *sms,
+                                  GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_MESSAGING (self));
+
+    mm_gdbus_modem_messaging_call_send_messages (MM_GDBUS_MODEM_MESSAGING (self),
+                                                 sms,
+                                                 cancellable,
+                                                 callback,
+                                                 user_data);
+}
+
+/**
+ * mm_modem_messaging_send_messages_sync:
+ * @self: A #MMModemMessaging.
+ * @sms: (array zero-terminated=1): %NULL-terminated array of paths of the #MMSms objects to send.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously sends the given #MMSms objects in a single batch, in the
+ * given order, keeping the link to the SMS relay open between them if the
+ * modem supports it.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_messaging_send_messages()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if all the messages were sent, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_messaging_send_messages_sync (MMModemMessaging *self,
+                                       const gchar *const *sms,
+                                       GCancellable *cancellable,
+                                       GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_MESSAGING (self), FALSE);
+
+    return mm_gdbus_modem_messaging_call_send_messages_sync (MM_GDBUS_MODEM_MESSAGING (self),
+                                                             sms,
+                                                             cancellable,
+                                                             error);
+}
+
+/*****************************************************************************/
+
 static void
 mm_modem_messaging_init (MMModemMessaging *self)
 {
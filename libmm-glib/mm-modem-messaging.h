@@ -106,6 +106,34 @@ GList *mm_modem_messaging_list_sync   (MMModemMessaging *self,
                                        GCancellable *cancellable,
                                        GError **error);
 
+void   mm_modem_messaging_list_range        (MMModemMessaging *self,
+                                             guint offset,
+                                             guint count,
+                                             GCancellable *cancellable,
+                                             GAsyncReadyCallback callback,
+                                             gpointer user_data);
+GList *mm_modem_messaging_list_range_finish (MMModemMessaging *self,
+                                             GAsyncResult *res,
+                                             GError **error);
+GList *mm_modem_messaging_list_range_sync   (MMModemMessaging *self,
+                                             guint offset,
+                                             guint count,
+                                             GCancellable *cancellable,
+                                             GError **error);
+
+void   mm_modem_messaging_list_since        (MMModemMessaging *self,
+                                             guint64 timestamp,
+                                             GCancellable *cancellable,
+                                             GAsyncReadyCallback callback,
+                                             gpointer user_data);
+GList *mm_modem_messaging_list_since_finish (MMModemMessaging *self,
+                                             GAsyncResult *res,
+                                             GError **error);
+GList *mm_modem_messaging_list_since_sync   (MMModemMessaging *self,
+                                             guint64 timestamp,
+                                             GCancellable *cancellable,
+                                             GError **error);
+
 void     mm_modem_messaging_delete        (MMModemMessaging *self,
                                            const gchar *sms,
                                            GCancellable *cancellable,
@@ -119,6 +147,47 @@ gboolean mm_modem_messaging_delete_sync   (MMModemMessaging *self,
                                            GCancellable *cancellable,
                                            GError **error);
 
+void     mm_modem_messaging_delete_messages        (MMModemMessaging *self,
+                                                    const gchar *const *sms,
+                                                    GCancellable *cancellable,
+                                                    GAsyncReadyCallback callback,
+                                                    gpointer user_data);
+gboolean mm_modem_messaging_delete_messages_finish (MMModemMessaging *self,
+                                                    GAsyncResult *res,
+                                                    guint *n_deleted,
+                                                    GError **error);
+gboolean mm_modem_messaging_delete_messages_sync   (MMModemMessaging *self,
+                                                    const gchar *const *sms,
+                                                    guint *n_deleted,
+                                                    GCancellable *cancellable,
+                                                    GError **error);
+
+void     mm_modem_messaging_delete_all        (MMModemMessaging *self,
+                                               GCancellable *cancellable,
+                                               GAsyncReadyCallback callback,
+                                               gpointer user_data);
+gboolean mm_modem_messaging_delete_all_finish (MMModemMessaging *self,
+                                               GAsyncResult *res,
+                                               guint *n_deleted,
+                                               GError **error);
+gboolean mm_modem_messaging_delete_all_sync   (MMModemMessaging *self,
+                                               guint *n_deleted,
+                                               GCancellable *cancellable,
+                                               GError **error);
+
+void     mm_modem_messaging_send_messages        (MMModemMessaging *self,
+                                                  const gchar *const *sms,
+                                                  GCancellable *cancellable,
+                                                  GAsyncReadyCallback callback,
+                                                  gpointer user_data);
+gboolean mm_modem_messaging_send_messages_finish (MMModemMessaging *self,
+                                                  GAsyncResult *res,
+                                                  GError **error);
+gboolean mm_modem_messaging_send_messages_sync   (MMModemMessaging *self,
+                                                  const gchar *const *sms,
+                                                  GCancellable *cancellable,
+                                                  GError **error);
+
 G_END_DECLS
 
 #endif /* _MM_MODEM_MESSAGING_H_ */
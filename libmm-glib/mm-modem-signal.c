@@ -176,6 +176,182 @@ mm_modem_signal_setup_sync (MMModemSignal *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_signal_setup_history_finish:
+ * @self: A #MMModemSignal.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_signal_setup_history().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_signal_setup_history().
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_signal_setup_history_finish (MMModemSignal *self,
+                                      GAsyncResult *res,
+                                      GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), FALSE);
+
+    return mm_gdbus_modem_signal_call_setup_history_finish (MM_GDBUS_MODEM_SIGNAL (self), res, error);
+}
+
+/**
+ * mm_modem_signal_setup_history:
+ * @self: A #MMModemSignal.
+ * @size: Maximum number of samples to keep in the history, or 0 to disable it.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously setups the history of extended signal quality information.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_signal_setup_history_finish() to get the result of the operation.
+ *
+ * See mm_modem_signal_setup_history_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_signal_setup_history (MMModemSignal *self,
+                               guint size,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_SIGNAL (self));
+
+    mm_gdbus_modem_signal_call_setup_history (MM_GDBUS_MODEM_SIGNAL (self), size, cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_signal_setup_history_sync:
+ * @self: A #MMModemSignal.
+ * @size: Maximum number of samples to keep in the history, or 0 to disable it.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously setups the history of extended signal quality information.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_signal_setup_history()
+ * for the asynchronous version of this method.
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ */
+gboolean
+mm_modem_signal_setup_history_sync (MMModemSignal *self,
+                                    guint size,
+                                    GCancellable *cancellable,
+                                    GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), FALSE);
+
+    return mm_gdbus_modem_signal_call_setup_history_sync (MM_GDBUS_MODEM_SIGNAL (self), size, cancellable, error);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_history_finish:
+ * @self: A #MMModemSignal.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_signal_get_history().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_signal_get_history().
+ *
+ * Returns: (transfer full): a dictionary with the signal history, as described in the
+ * GetHistory() method of the Signal interface, or %NULL if @error is set. The returned
+ * value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_modem_signal_get_history_finish (MMModemSignal *self,
+                                    GAsyncResult *res,
+                                    GError **error)
+{
+    GVariant *history = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), NULL);
+
+    if (!mm_gdbus_modem_signal_call_get_history_finish (MM_GDBUS_MODEM_SIGNAL (self), &history, res, error))
+        return NULL;
+    return history;
+}
+
+/**
+ * mm_modem_signal_get_history:
+ * @self: A #MMModemSignal.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously gets the history of extended signal quality information, including
+ * the aggregated statistics of each value.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_signal_get_history_finish() to get the result of the operation.
+ *
+ * See mm_modem_signal_get_history_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_signal_get_history (MMModemSignal *self,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback,
+                             gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_SIGNAL (self));
+
+    mm_gdbus_modem_signal_call_get_history (MM_GDBUS_MODEM_SIGNAL (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_signal_get_history_sync:
+ * @self: A #MMModemSignal.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously gets the history of extended signal quality information, including
+ * the aggregated statistics of each value.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_signal_get_history()
+ * for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): a dictionary with the signal history, as described in the
+ * GetHistory() method of the Signal interface, or %NULL if @error is set. The returned
+ * value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_modem_signal_get_history_sync (MMModemSignal *self,
+                                  GCancellable *cancellable,
+                                  GError **error)
+{
+    GVariant *history = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), NULL);
+
+    if (!mm_gdbus_modem_signal_call_get_history_sync (MM_GDBUS_MODEM_SIGNAL (self), &history, cancellable, error))
+        return NULL;
+    return history;
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_history_size:
+ * @self: A #MMModemSignal.
+ *
+ * Gets the maximum number of samples kept in the signal history.
+ *
+ * Returns: the history size, or 0 if disabled.
+ */
+guint
+mm_modem_signal_get_history_size (MMModemSignal *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), 0);
+
+    return mm_gdbus_modem_signal_get_history_size (MM_GDBUS_MODEM_SIGNAL (self));
+}
+
+/*****************************************************************************/
+
 /**
  * mm_modem_signal_get_rate:
  * @self: A #MMModemSignal.
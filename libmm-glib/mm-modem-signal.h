@@ -71,6 +71,7 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMModemSignal, g_object_unref)
 const gchar *mm_modem_signal_get_path (MMModemSignal *self);
 gchar       *mm_modem_signal_dup_path (MMModemSignal *self);
 guint        mm_modem_signal_get_rate (MMModemSignal *self);
+guint        mm_modem_signal_get_history_size (MMModemSignal *self);
 
 void     mm_modem_signal_setup        (MMModemSignal *self,
                                        guint rate,
@@ -85,6 +86,30 @@ gboolean mm_modem_signal_setup_sync   (MMModemSignal *self,
                                        GCancellable *cancellable,
                                        GError **error);
 
+void     mm_modem_signal_setup_history        (MMModemSignal *self,
+                                               guint size,
+                                               GCancellable *cancellable,
+                                               GAsyncReadyCallback callback,
+                                               gpointer user_data);
+gboolean mm_modem_signal_setup_history_finish (MMModemSignal *self,
+                                               GAsyncResult *res,
+                                               GError **error);
+gboolean mm_modem_signal_setup_history_sync   (MMModemSignal *self,
+                                               guint size,
+                                               GCancellable *cancellable,
+                                               GError **error);
+
+void      mm_modem_signal_get_history        (MMModemSignal *self,
+                                              GCancellable *cancellable,
+                                              GAsyncReadyCallback callback,
+                                              gpointer user_data);
+GVariant *mm_modem_signal_get_history_finish (MMModemSignal *self,
+                                              GAsyncResult *res,
+                                              GError **error);
+GVariant *mm_modem_signal_get_history_sync   (MMModemSignal *self,
+                                              GCancellable *cancellable,
+                                              GError **error);
+
 MMSignal *mm_modem_signal_get_cdma (MMModemSignal *self);
 MMSignal *mm_modem_signal_peek_cdma (MMModemSignal *self);
 
@@ -416,6 +416,90 @@ mm_modem_simple_get_status_sync (MMModemSimple *self,
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_simple_get_connection_histograms_finish:
+ * @self: A #MMModemSimple.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to mm_modem_simple_get_connection_histograms().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_simple_get_connection_histograms().
+ *
+ * Returns: (transfer full): a dictionary with the connection time histograms, as described
+ * in the GetConnectionHistograms() method of the Simple interface, or %NULL if @error is set.
+ * The returned value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_modem_simple_get_connection_histograms_finish (MMModemSimple *self,
+                                                  GAsyncResult *res,
+                                                  GError **error)
+{
+    GVariant *histograms = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIMPLE (self), NULL);
+
+    if (!mm_gdbus_modem_simple_call_get_connection_histograms_finish (MM_GDBUS_MODEM_SIMPLE (self), &histograms, res, error))
+        return NULL;
+    return histograms;
+}
+
+/**
+ * mm_modem_simple_get_connection_histograms:
+ * @self: A #MMModemSimple.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously gets the distribution of the times taken by the successful
+ * connection attempts of the modem.
+ *
+ * When the operation is finished, @callback will be invoked in the <link linkend="g-main-context-push-thread-default">thread-default main loop</link> of the thread you are calling this method from.
+ * You can then call mm_modem_simple_get_connection_histograms_finish() to get the result of the operation.
+ *
+ * See mm_modem_simple_get_connection_histograms_sync() for the synchronous, blocking version of this method.
+ */
+void
+mm_modem_simple_get_connection_histograms (MMModemSimple *self,
+                                           GCancellable *cancellable,
+                                           GAsyncReadyCallback callback,
+                                           gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_SIMPLE (self));
+
+    mm_gdbus_modem_simple_call_get_connection_histograms (MM_GDBUS_MODEM_SIMPLE (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_simple_get_connection_histograms_sync:
+ * @self: A #MMModemSimple.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously gets the distribution of the times taken by the successful
+ * connection attempts of the modem.
+ *
+ * The calling thread is blocked until a reply is received. See mm_modem_simple_get_connection_histograms()
+ * for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): a dictionary with the connection time histograms, as described
+ * in the GetConnectionHistograms() method of the Simple interface, or %NULL if @error is set.
+ * The returned value should be freed with g_variant_unref().
+ */
+GVariant *
+mm_modem_simple_get_connection_histograms_sync (MMModemSimple *self,
+                                                GCancellable *cancellable,
+                                                GError **error)
+{
+    GVariant *histograms = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIMPLE (self), NULL);
+
+    if (!mm_gdbus_modem_simple_call_get_connection_histograms_sync (MM_GDBUS_MODEM_SIMPLE (self), &histograms, cancellable, error))
+        return NULL;
+    return histograms;
+}
+
+/*****************************************************************************/
+
 static void
 mm_modem_simple_init (MMModemSimple *self)
 {
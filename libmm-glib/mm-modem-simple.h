@@ -109,6 +109,18 @@ MMSimpleStatus *mm_modem_simple_get_status_finish (MMModemSimple *self,
 MMSimpleStatus *mm_modem_simple_get_status_sync   (MMModemSimple *self,
                                                    GCancellable *cancellable,
                                                    GError **error);
+
+void      mm_modem_simple_get_connection_histograms        (MMModemSimple *self,
+                                                            GCancellable *cancellable,
+                                                            GAsyncReadyCallback callback,
+                                                            gpointer user_data);
+GVariant *mm_modem_simple_get_connection_histograms_finish (MMModemSimple *self,
+                                                            GAsyncResult *res,
+                                                            GError **error);
+GVariant *mm_modem_simple_get_connection_histograms_sync   (MMModemSimple *self,
+                                                            GCancellable *cancellable,
+                                                            GError **error);
+
 G_END_DECLS
 
 #endif /* _MM_MODEM_SIMPLE_H_ */
@@ -47,6 +47,7 @@ struct _MMModemPrivate {
     /* Ports */
     GMutex ports_mutex;
     guint ports_id;
+    gboolean ports_stale;
     GArray *ports;
 
     /* UnlockRetries */
@@ -57,21 +58,25 @@ struct _MMModemPrivate {
     /* Supported Modes */
     GMutex supported_modes_mutex;
     guint supported_modes_id;
+    gboolean supported_modes_stale;
     GArray *supported_modes;
 
     /* Supported Capabilities */
     GMutex supported_capabilities_mutex;
     guint supported_capabilities_id;
+    gboolean supported_capabilities_stale;
     GArray *supported_capabilities;
 
     /* Supported Bands */
     GMutex supported_bands_mutex;
     guint supported_bands_id;
+    gboolean supported_bands_stale;
     GArray *supported_bands;
 
     /* Current Bands */
     GMutex current_bands_mutex;
     guint current_bands_id;
+    gboolean current_bands_stale;
     GArray *current_bands;
 };
 
@@ -164,15 +169,12 @@ supported_capabilities_updated (MMModem *self,
 {
     g_mutex_lock (&self->priv->supported_capabilities_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->supported_capabilities)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->supported_capabilities) {
             g_array_unref (self->priv->supported_capabilities);
-
-        dictionary = mm_gdbus_modem_get_supported_capabilities (MM_GDBUS_MODEM (self));
-        self->priv->supported_capabilities = (dictionary ?
-                                              mm_common_capability_combinations_variant_to_garray (dictionary) :
-                                              NULL);
+            self->priv->supported_capabilities = NULL;
+        }
+        self->priv->supported_capabilities_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->supported_capabilities_mutex);
 }
@@ -187,8 +189,19 @@ ensure_internal_supported_capabilities (MMModem *self,
     g_mutex_lock (&self->priv->supported_capabilities_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->supported_capabilities_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->supported_capabilities_id =
+                g_signal_connect (self,
+                                  "notify::supported-capabilities",
+                                  G_CALLBACK (supported_capabilities_updated),
+                                  NULL);
+            self->priv->supported_capabilities_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->supported_capabilities_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_dup_supported_capabilities (MM_GDBUS_MODEM (self));
@@ -196,13 +209,7 @@ ensure_internal_supported_capabilities (MMModem *self,
                 self->priv->supported_capabilities = mm_common_capability_combinations_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->supported_capabilities_id =
-                g_signal_connect (self,
-                                  "notify::supported-capabilities",
-                                  G_CALLBACK (supported_capabilities_updated),
-                                  NULL);
+            self->priv->supported_capabilities_stale = FALSE;
         }
 
         if (!self->priv->supported_capabilities)
@@ -774,15 +781,12 @@ ports_updated (MMModem *self,
 {
     g_mutex_lock (&self->priv->ports_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->ports)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->ports) {
             g_array_unref (self->priv->ports);
-
-        dictionary = mm_gdbus_modem_get_ports (MM_GDBUS_MODEM (self));
-        self->priv->ports = (dictionary ?
-                             mm_common_ports_variant_to_garray (dictionary) :
-                             NULL);
+            self->priv->ports = NULL;
+        }
+        self->priv->ports_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->ports_mutex);
 }
@@ -798,8 +802,19 @@ ensure_internal_ports (MMModem *self,
     g_mutex_lock (&self->priv->ports_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->ports_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->ports_id =
+                g_signal_connect (self,
+                                  "notify::ports",
+                                  G_CALLBACK (ports_updated),
+                                  NULL);
+            self->priv->ports_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->ports_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_dup_ports (MM_GDBUS_MODEM (self));
@@ -807,13 +822,7 @@ ensure_internal_ports (MMModem *self,
                 self->priv->ports = mm_common_ports_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->ports_id =
-                g_signal_connect (self,
-                                  "notify::ports",
-                                  G_CALLBACK (ports_updated),
-                                  NULL);
+            self->priv->ports_stale = FALSE;
         }
 
         if (!self->priv->ports)
@@ -1232,15 +1241,12 @@ supported_modes_updated (MMModem *self,
 {
     g_mutex_lock (&self->priv->supported_modes_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->supported_modes)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->supported_modes) {
             g_array_unref (self->priv->supported_modes);
-
-        dictionary = mm_gdbus_modem_get_supported_modes (MM_GDBUS_MODEM (self));
-        self->priv->supported_modes = (dictionary ?
-                                       mm_common_mode_combinations_variant_to_garray (dictionary) :
-                                       NULL);
+            self->priv->supported_modes = NULL;
+        }
+        self->priv->supported_modes_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->supported_modes_mutex);
 }
@@ -1255,8 +1261,19 @@ ensure_internal_supported_modes (MMModem *self,
     g_mutex_lock (&self->priv->supported_modes_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->supported_modes_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->supported_modes_id =
+                g_signal_connect (self,
+                                  "notify::supported-modes",
+                                  G_CALLBACK (supported_modes_updated),
+                                  NULL);
+            self->priv->supported_modes_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->supported_modes_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_dup_supported_modes (MM_GDBUS_MODEM (self));
@@ -1264,13 +1281,7 @@ ensure_internal_supported_modes (MMModem *self,
                 self->priv->supported_modes = mm_common_mode_combinations_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->supported_modes_id =
-                g_signal_connect (self,
-                                  "notify::supported-modes",
-                                  G_CALLBACK (supported_modes_updated),
-                                  NULL);
+            self->priv->supported_modes_stale = FALSE;
         }
 
         if (!self->priv->supported_modes)
@@ -1388,15 +1399,12 @@ supported_bands_updated (MMModem *self,
 {
     g_mutex_lock (&self->priv->supported_bands_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->supported_bands)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->supported_bands) {
             g_array_unref (self->priv->supported_bands);
-
-        dictionary = mm_gdbus_modem_get_supported_bands (MM_GDBUS_MODEM (self));
-        self->priv->supported_bands = (dictionary ?
-                                       mm_common_bands_variant_to_garray (dictionary) :
-                                       NULL);
+            self->priv->supported_bands = NULL;
+        }
+        self->priv->supported_bands_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->supported_bands_mutex);
 }
@@ -1411,8 +1419,19 @@ ensure_internal_supported_bands (MMModem *self,
     g_mutex_lock (&self->priv->supported_bands_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->supported_bands_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->supported_bands_id =
+                g_signal_connect (self,
+                                  "notify::supported-bands",
+                                  G_CALLBACK (supported_bands_updated),
+                                  NULL);
+            self->priv->supported_bands_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->supported_bands_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_dup_supported_bands (MM_GDBUS_MODEM (self));
@@ -1420,13 +1439,7 @@ ensure_internal_supported_bands (MMModem *self,
                 self->priv->supported_bands = mm_common_bands_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->supported_bands_id =
-                g_signal_connect (self,
-                                  "notify::supported-bands",
-                                  G_CALLBACK (supported_bands_updated),
-                                  NULL);
+            self->priv->supported_bands_stale = FALSE;
         }
 
         if (!self->priv->supported_bands)
@@ -1510,15 +1523,12 @@ current_bands_updated (MMModem *self,
 {
     g_mutex_lock (&self->priv->current_bands_mutex);
     {
-        GVariant *dictionary;
-
-        if (self->priv->current_bands)
+        /* Only drop the decoded array, it will be rebuilt on the next access */
+        if (self->priv->current_bands) {
             g_array_unref (self->priv->current_bands);
-
-        dictionary = mm_gdbus_modem_get_current_bands (MM_GDBUS_MODEM (self));
-        self->priv->current_bands = (dictionary ?
-                                     mm_common_bands_variant_to_garray (dictionary) :
-                                     NULL);
+            self->priv->current_bands = NULL;
+        }
+        self->priv->current_bands_stale = TRUE;
     }
     g_mutex_unlock (&self->priv->current_bands_mutex);
 }
@@ -1533,8 +1543,19 @@ ensure_internal_current_bands (MMModem *self,
     g_mutex_lock (&self->priv->current_bands_mutex);
     {
         /* If this is the first time ever asking for the array, setup the
-         * update listener and the initial array, if any. */
+         * update listener. */
         if (!self->priv->current_bands_id) {
+            /* No need to clear this signal connection when freeing self */
+            self->priv->current_bands_id =
+                g_signal_connect (self,
+                                  "notify::current-bands",
+                                  G_CALLBACK (current_bands_updated),
+                                  NULL);
+            self->priv->current_bands_stale = TRUE;
+        }
+
+        /* Decode the array if the property changed since the last access */
+        if (self->priv->current_bands_stale) {
             GVariant *dictionary;
 
             dictionary = mm_gdbus_modem_dup_current_bands (MM_GDBUS_MODEM (self));
@@ -1542,13 +1563,7 @@ ensure_internal_current_bands (MMModem *self,
                 self->priv->current_bands = mm_common_bands_variant_to_garray (dictionary);
                 g_variant_unref (dictionary);
             }
-
-            /* No need to clear this signal connection when freeing self */
-            self->priv->current_bands_id =
-                g_signal_connect (self,
-                                  "notify::current-bands",
-                                  G_CALLBACK (current_bands_updated),
-                                  NULL);
+            self->priv->current_bands_stale = FALSE;
         }
 
         if (!self->priv->current_bands)
@@ -0,0 +1,229 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <libmm-glib.h>
+#include <string.h>
+
+#define GPGGA   "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*76"
+#define GNGGA   "$GNGGA,092751.000,5321.6802,S,00630.3372,E,1,8,1.03,61.7,M,55.2,M,,*66"
+#define GPRMC   "$GPRMC,092750.000,A,5321.6802,N,00630.3372,W,0.02,31.66,280511,,,A*43"
+#define GPGSV_1 "$GPGSV,3,1,11,10,63,137,17,07,61,098,15,05,59,290,20,08,54,157,30*70"
+#define GPGSV_2 "$GPGSV,3,2,11,02,39,223,19,13,28,070,17,26,23,252,,04,14,186,14*79"
+#define GPGSV_3 "$GPGSV,3,3,11,29,09,301,24,16,09,020,,36,,,*76"
+
+/*****************************************************************************/
+
+static void
+test_nmea_sentence_parse (void)
+{
+    MMNmeaSentence sentence;
+
+    g_assert (mm_nmea_sentence_parse (&sentence, GPGGA));
+    g_assert_cmpuint (sentence.n_fields, ==, 15);
+    g_assert_cmpuint (sentence.length, ==, strlen (GPGGA));
+    g_assert_cmpstr (sentence.fields[0], ==, "$GPGGA");
+    g_assert_cmpstr (sentence.fields[1], ==, "092750.000");
+    g_assert_cmpstr (sentence.fields[9], ==, "61.7");
+    g_assert_cmpstr (sentence.fields[14], ==, "");
+
+    /* Line terminators are ignored */
+    g_assert (mm_nmea_sentence_parse (&sentence, GPRMC "\r\n"));
+    g_assert_cmpuint (sentence.length, ==, strlen (GPRMC));
+
+    /* Checksum is optional */
+    g_assert (mm_nmea_sentence_parse (&sentence, "$GPGSA,A,3,10,07,05,02,29,04,08,13,,,,,1.72,1.03,1.38"));
+    g_assert_cmpuint (sentence.n_fields, ==, 18);
+
+    /* But must be valid if given */
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*77"));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*7"));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,*ZZ"));
+
+    /* Invalid sentences */
+    g_assert (!mm_nmea_sentence_parse (&sentence, ""));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$"));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$GPGGA"));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "GPGGA,092750.000"));
+    g_assert (!mm_nmea_sentence_parse (&sentence, "$,092750.000"));
+}
+
+/*****************************************************************************/
+
+static void
+test_nmea_traces (void)
+{
+    MMLocationGpsNmea *nmea;
+    gchar             *full;
+
+    nmea = mm_location_gps_nmea_new ();
+
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGGA));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPRMC "\r\n"));
+    g_assert (!mm_location_gps_nmea_add_trace (nmea, "$GPGGA,bad*00"));
+
+    g_assert_cmpstr (mm_location_gps_nmea_get_trace (nmea, "$GPGGA"), ==, GPGGA);
+    g_assert_cmpstr (mm_location_gps_nmea_get_trace (nmea, "$GPRMC"), ==, GPRMC);
+    g_assert (mm_location_gps_nmea_get_trace (nmea, "$GPGSV") == NULL);
+
+    /* Traces are kept in the order they were first seen */
+    full = mm_location_gps_nmea_build_full (nmea);
+    g_assert_cmpstr (full, ==, GPGGA "\r\n" GPRMC);
+    g_free (full);
+
+    /* Newer trace of the same type replaces the previous one */
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GNGGA));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, "$GPGGA,092751.000,,,,,0,0,,,M,,M,,"));
+    full = mm_location_gps_nmea_build_full (nmea);
+    g_assert_cmpstr (full, ==, "$GPGGA,092751.000,,,,,0,0,,,M,,M,,\r\n" GPRMC "\r\n" GNGGA);
+    g_free (full);
+
+    g_object_unref (nmea);
+}
+
+static void
+test_nmea_sequence (void)
+{
+    MMLocationGpsNmea *nmea;
+
+    nmea = mm_location_gps_nmea_new ();
+
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_1));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_2));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_2));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_3));
+    g_assert_cmpstr (mm_location_gps_nmea_get_trace (nmea, "$GPGSV"), ==, GPGSV_1 "\r\n" GPGSV_2 "\r\n" GPGSV_3);
+
+    /* A new sequence starts */
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_1));
+    g_assert_cmpstr (mm_location_gps_nmea_get_trace (nmea, "$GPGSV"), ==, GPGSV_1);
+
+    g_object_unref (nmea);
+}
+
+static void
+test_nmea_string_variant (void)
+{
+    MMLocationGpsNmea *nmea;
+    MMLocationGpsNmea *copy;
+    GVariant          *variant;
+    gchar             *full;
+    GError            *error = NULL;
+
+    nmea = mm_location_gps_nmea_new ();
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGGA));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_1));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPGSV_2));
+    g_assert (mm_location_gps_nmea_add_trace (nmea, GPRMC));
+
+    variant = mm_location_gps_nmea_get_string_variant (nmea);
+    g_assert_cmpstr (g_variant_get_string (variant, NULL), ==, GPGGA "\r\n" GPGSV_1 "\r\n" GPGSV_2 "\r\n" GPRMC);
+
+    copy = mm_location_gps_nmea_new_from_string_variant (variant, &error);
+    g_assert_no_error (error);
+    g_assert (copy);
+    g_assert_cmpstr (mm_location_gps_nmea_get_trace (copy, "$GPGSV"), ==, GPGSV_1 "\r\n" GPGSV_2);
+    full = mm_location_gps_nmea_build_full (copy);
+    g_assert_cmpstr (full, ==, g_variant_get_string (variant, NULL));
+    g_free (full);
+
+    g_variant_unref (variant);
+    g_object_unref (copy);
+    g_object_unref (nmea);
+}
+
+/*****************************************************************************/
+
+static void
+test_raw_gga (void)
+{
+    MMLocationGpsRaw *raw;
+
+    raw = mm_location_gps_raw_new ();
+
+    g_assert (!mm_location_gps_raw_add_trace (raw, GPRMC));
+    g_assert (mm_location_gps_raw_add_trace (raw, GPGGA));
+    g_assert_cmpstr (mm_location_gps_raw_get_utc_time (raw), ==, "092750.000");
+    g_assert_cmpfloat (ABS (mm_location_gps_raw_get_latitude (raw) - 53.361336667), <, 1e-6);
+    g_assert_cmpfloat (ABS (mm_location_gps_raw_get_longitude (raw) + 6.50562), <, 1e-6);
+    g_assert_cmpfloat (ABS (mm_location_gps_raw_get_altitude (raw) - 61.7), <, 1e-6);
+
+    /* Once GNGGA is seen, GPGGA is ignored */
+    g_assert (mm_location_gps_raw_add_trace (raw, GNGGA));
+    g_assert (!mm_location_gps_raw_add_trace (raw, GPGGA));
+    g_assert_cmpstr (mm_location_gps_raw_get_utc_time (raw), ==, "092751.000");
+    g_assert_cmpfloat (ABS (mm_location_gps_raw_get_latitude (raw) + 53.361336667), <, 1e-6);
+    g_assert_cmpfloat (ABS (mm_location_gps_raw_get_longitude (raw) - 6.50562), <, 1e-6);
+
+    g_object_unref (raw);
+}
+
+/*****************************************************************************/
+
+#define BENCHMARK_ITERATIONS 100000
+
+static void
+test_benchmark (void)
+{
+    static const gchar *traces[] = { GPGGA, GPRMC, GPGSV_1, GPGSV_2, GPGSV_3 };
+    MMLocationGpsNmea  *nmea;
+    MMLocationGpsRaw   *raw;
+    GVariant           *variant;
+    gdouble             elapsed;
+    guint               i;
+
+    nmea = mm_location_gps_nmea_new ();
+    raw = mm_location_gps_raw_new ();
+
+    /* Emulates the daemon flow: every trace is added to both the NMEA and RAW
+     * objects, and the NMEA string variant is built once per full fix */
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        const gchar *trace;
+
+        trace = traces[i % G_N_ELEMENTS (traces)];
+        mm_location_gps_nmea_add_trace (nmea, trace);
+        mm_location_gps_raw_add_trace (raw, trace);
+        if ((i % G_N_ELEMENTS (traces)) == (G_N_ELEMENTS (traces) - 1)) {
+            variant = mm_location_gps_nmea_get_string_variant (nmea);
+            g_variant_unref (variant);
+        }
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "%u NMEA traces processed in %.3lf seconds", BENCHMARK_ITERATIONS, elapsed);
+    g_test_message ("%.0lf traces/s", BENCHMARK_ITERATIONS / elapsed);
+
+    g_object_unref (raw);
+    g_object_unref (nmea);
+}
+
+/*****************************************************************************/
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/Location/nmea-sentence-parse", test_nmea_sentence_parse);
+    g_test_add_func ("/MM/Location/gps-nmea/traces",         test_nmea_traces);
+    g_test_add_func ("/MM/Location/gps-nmea/sequence",       test_nmea_sequence);
+    g_test_add_func ("/MM/Location/gps-nmea/string-variant", test_nmea_string_variant);
+    g_test_add_func ("/MM/Location/gps-raw/gga",             test_raw_gga);
+
+    if (g_test_perf ())
+        g_test_add_func ("/MM/Location/benchmark", test_benchmark);
+
+    return g_test_run ();
+}
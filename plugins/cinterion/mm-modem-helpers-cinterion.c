@@ -28,6 +28,7 @@
 #include "mm-errors-types.h"
 #include "mm-modem-helpers-cinterion.h"
 #include "mm-modem-helpers.h"
+#include "mm-regex.h"
 
 /* Setup relationship between the 3G band bitmask in the modem and the bitmask
  * in ModemManager. */
@@ -99,7 +100,7 @@ mm_cinterion_parse_scfg_test (const gchar *response,
                               GArray **supported_bands,
                               GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SCFG:\\s*\"Radio/Band\",\\((?:\")?([0-9]*)(?:\")?-(?:\")?([0-9]*)(?:\")?.*\\)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     GArray *bands = NULL;
@@ -109,12 +110,7 @@ mm_cinterion_parse_scfg_test (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SCFG:\\s*\"Radio/Band\",\\((?:\")?([0-9]*)(?:\")?-(?:\")?([0-9]*)(?:\")?.*\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         gchar *maxbandstr;
         guint maxband = 0;
@@ -148,7 +144,6 @@ mm_cinterion_parse_scfg_test (const gchar *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (!bands)
         inner_error = g_error_new (MM_CORE_ERROR,
@@ -188,7 +183,7 @@ mm_cinterion_parse_scfg_response (const gchar *response,
                                   GArray **current_bands,
                                   GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SCFG:\\s*\"Radio/Band\",\\s*\"?([0-9a-fA-F]*)\"?", 0, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     GArray *bands = NULL;
@@ -198,10 +193,7 @@ mm_cinterion_parse_scfg_response (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SCFG:\\s*\"Radio/Band\",\\s*\"?([0-9a-fA-F]*)\"?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, NULL)) {
+    if (mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, NULL)) {
         gchar *currentstr;
         guint current = 0;
 
@@ -234,7 +226,6 @@ mm_cinterion_parse_scfg_response (const gchar *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (!bands)
         inner_error = g_error_new (MM_CORE_ERROR,
@@ -269,7 +260,7 @@ mm_cinterion_parse_cnmi_test (const gchar *response,
                               GArray **supported_bfr,
                               GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CNMI:\\s*\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     GArray *tmp_supported_mode = NULL;
@@ -283,12 +274,7 @@ mm_cinterion_parse_cnmi_test (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\+CNMI:\\s*\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\),\\((.*)\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         if (supported_mode) {
             gchar *str;
@@ -340,7 +326,6 @@ mm_cinterion_parse_cnmi_test (const gchar *response,
 out:
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_clear_pointer (&tmp_supported_mode, g_array_unref);
@@ -429,7 +414,7 @@ mm_cinterion_parse_sind_response (const gchar *response,
                                   guint *value,
                                   GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     guint errors = 0;
 
@@ -438,10 +423,7 @@ mm_cinterion_parse_sind_response (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, NULL)) {
+    if (mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, NULL)) {
         if (description) {
             *description = mm_get_string_unquoted_from_match_info (match_info, 1);
             if (*description == NULL)
@@ -455,7 +437,6 @@ mm_cinterion_parse_sind_response (const gchar *response,
         errors++;
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (errors > 0) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Failed parsing ^SIND response");
@@ -501,7 +482,7 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
                                    guint         cid,
                                    GError      **error)
 {
-    GRegex                   *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo               *match_info;
     GError                   *inner_error = NULL;
     MMBearerConnectionStatus  status;
@@ -519,12 +500,8 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
         return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
-    r = g_regex_new ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
     status = MM_BEARER_CONNECTION_STATUS_UNKNOWN;
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
         guint read_state;
         guint read_cid;
@@ -549,7 +526,6 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN)
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
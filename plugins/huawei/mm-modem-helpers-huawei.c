@@ -24,6 +24,7 @@
 
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
+#include "mm-regex.h"
 #include "mm-modem-helpers-huawei.h"
 
 /*****************************************************************************/
@@ -37,7 +38,11 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
                                       gboolean *ipv6_connected,
                                       GError **error)
 {
-    GRegex *r;
+    static MMRegex fields_regex = MM_REGEX_INIT ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d),([^,]*),([^,]*),([^,\\r\\n]*)(?:\\r\\n)?"
+                                                 "(?:\\^NDISSTAT:|\\^NDISSTATQRY:)?\\s*,?(\\d)?,?([^,]*)?,?([^,]*)?,?([^,\\r\\n]*)?(?:\\r\\n)?",
+                                                 G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
+    static MMRegex single_regex = MM_REGEX_INIT ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d)(?:\\r\\n)?",
+                                                 G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
 
@@ -69,13 +74,7 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
 
     /* If multiple fields available, try first parsing method */
     if (strchr (response, ',')) {
-        r = g_regex_new ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d),([^,]*),([^,]*),([^,\\r\\n]*)(?:\\r\\n)?"
-                         "(?:\\^NDISSTAT:|\\^NDISSTATQRY:)?\\s*,?(\\d)?,?([^,]*)?,?([^,]*)?,?([^,\\r\\n]*)?(?:\\r\\n)?",
-                         G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                         0, NULL);
-        g_assert (r != NULL);
-
-        g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+        mm_regex_match_full (&fields_regex, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (!inner_error && g_match_info_matches (match_info)) {
             guint ip_type_field = 4;
 
@@ -108,16 +107,10 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
         }
 
         g_match_info_free (match_info);
-        g_regex_unref (r);
     }
     /* No separate IPv4/IPv6 info given just connected/not connected */
     else {
-        r = g_regex_new ("\\^NDISSTAT(?:QRY)?(?:Qry)?:\\s*(\\d)(?:\\r\\n)?",
-                         G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                         0, NULL);
-        g_assert (r != NULL);
-
-        g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+        mm_regex_match_full (&single_regex, response, strlen (response), 0, 0, &match_info, &inner_error);
         if (!inner_error && g_match_info_matches (match_info)) {
             guint connected;
 
@@ -134,7 +127,6 @@ mm_huawei_parse_ndisstatqry_response (const gchar *response,
         }
 
         g_match_info_free (match_info);
-        g_regex_unref (r);
     }
 
     if (!ipv4_available && !ipv6_available) {
@@ -209,7 +201,7 @@ mm_huawei_parse_dhcp_response (const char *reply,
                                GError **error)
 {
     gboolean matched;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^DHCP:\\s*(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),.*$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
 
@@ -230,10 +222,7 @@ mm_huawei_parse_dhcp_response (const char *reply,
      * actually 10.10.1.1.
      */
 
-    r = g_regex_new ("\\^DHCP:\\s*(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),(?:0[xX])?([0-9a-fA-F]+),.*$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
+    matched = mm_regex_match_full (&r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
         if (match_error) {
             g_propagate_error (error, match_error);
@@ -258,7 +247,6 @@ mm_huawei_parse_dhcp_response (const char *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
     return matched;
 }
 
@@ -277,7 +265,7 @@ mm_huawei_parse_sysinfo_response (const char *reply,
                                   GError **error)
 {
     gboolean matched;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SYSINFO:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),?(\\d+)?,?(\\d+)?$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
 
@@ -295,10 +283,7 @@ mm_huawei_parse_sysinfo_response (const char *reply,
      */
 
     /* Can't just use \d here since sometimes you get "^SYSINFO:2,1,0,3,1,,3" */
-    r = g_regex_new ("\\^SYSINFO:\\s*(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),?(\\d+)?,?(\\d+)?$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
+    matched = mm_regex_match_full (&r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
         if (match_error) {
             g_propagate_error (error, match_error);
@@ -324,7 +309,6 @@ mm_huawei_parse_sysinfo_response (const char *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
     return matched;
 }
 
@@ -342,7 +326,7 @@ mm_huawei_parse_sysinfoex_response (const char *reply,
                                     GError **error)
 {
     gboolean matched;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^SYSINFOEX:\\s*(\\d+),(\\d+),(\\d+),(\\d+),?(\\d*),(\\d+),\"?([^\"]*)\"?,(\\d+),\"?([^\"]*)\"?$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
 
@@ -362,10 +346,7 @@ mm_huawei_parse_sysinfoex_response (const char *reply,
 
     /* ^SYSINFOEX:2,3,0,1,,3,"WCDMA",41,"HSPA+" */
 
-    r = g_regex_new ("\\^SYSINFOEX:\\s*(\\d+),(\\d+),(\\d+),(\\d+),?(\\d*),(\\d+),\"?([^\"]*)\"?,(\\d+),\"?([^\"]*)\"?$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    matched = g_regex_match_full (r, reply, -1, 0, 0, &match_info, &match_error);
+    matched = mm_regex_match_full (&r, reply, -1, 0, 0, &match_info, &match_error);
     if (!matched) {
         if (match_error) {
             g_propagate_error (error, match_error);
@@ -388,7 +369,6 @@ mm_huawei_parse_sysinfoex_response (const char *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
     return matched;
 }
 
@@ -1191,7 +1171,7 @@ gboolean mm_huawei_parse_nwtime_response (const gchar *response,
                                           MMNetworkTimezone **tzp,
                                           GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^NWTIME:\\s*(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d*)([\\-\\+\\d]+),(\\d+)$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
     guint year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, dt = 0;
@@ -1200,10 +1180,7 @@ gboolean mm_huawei_parse_nwtime_response (const gchar *response,
 
     g_assert (iso8601p || tzp); /* at least one */
 
-    r = g_regex_new ("\\^NWTIME:\\s*(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d*)([\\-\\+\\d]+),(\\d+)$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
+    if (!mm_regex_match_full (&r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
             g_propagate_error (error, match_error);
             g_prefix_error (error, "Could not parse ^NWTIME results: ");
@@ -1255,7 +1232,6 @@ gboolean mm_huawei_parse_nwtime_response (const gchar *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return ret;
 }
@@ -1268,7 +1244,7 @@ gboolean mm_huawei_parse_time_response (const gchar *response,
                                         MMNetworkTimezone **tzp,
                                         GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^TIME:\\s*(\\d+)/(\\d+)/(\\d+)\\s*(\\d+):(\\d+):(\\d*)$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
     guint year, month, day, hour, minute, second;
@@ -1286,10 +1262,7 @@ gboolean mm_huawei_parse_time_response (const gchar *response,
     }
 
     /* Already in ISO-8601 format, but verify just to be sure */
-    r = g_regex_new ("\\^TIME:\\s*(\\d+)/(\\d+)/(\\d+)\\s*(\\d+):(\\d+):(\\d*)$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
+    if (!mm_regex_match_full (&r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
             g_propagate_error (error, match_error);
             g_prefix_error (error, "Could not parse ^TIME results: ");
@@ -1326,7 +1299,6 @@ gboolean mm_huawei_parse_time_response (const gchar *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return ret;
 }
@@ -1344,16 +1316,13 @@ mm_huawei_parse_hcsq_response (const gchar *response,
                                guint *out_value5,
                                GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^HCSQ:\\s*\"([a-zA-Z]*)\",(\\d+),?(\\d+)?,?(\\d+)?,?(\\d+)?,?(\\d+)?$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
     gboolean ret = FALSE;
     char *s;
 
-    r = g_regex_new ("\\^HCSQ:\\s*\"([a-zA-Z]*)\",(\\d+),?(\\d+)?,?(\\d+)?,?(\\d+)?,?(\\d+)?$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
+    if (!mm_regex_match_full (&r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
             g_propagate_error (error, match_error);
             g_prefix_error (error, "Could not parse ^HCSQ results: ");
@@ -1396,7 +1365,6 @@ mm_huawei_parse_hcsq_response (const gchar *response,
 
 done:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return ret;
 }
@@ -1410,17 +1378,14 @@ mm_huawei_parse_cvoice_response (const gchar  *response,
                                  guint        *out_bits,
                                  GError      **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\^CVOICE:\\s*(\\d)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)$", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
     guint supported = 0, hz = 0, bits = 0;
     gboolean ret = FALSE;
 
     /* ^CVOICE: <0=supported,1=unsupported>,<hz>,<bits>,<unknown> */
-    r = g_regex_new ("\\^CVOICE:\\s*(\\d)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*(\\d+)$", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
+    if (!mm_regex_match_full (&r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
             g_propagate_error (error, match_error);
             g_prefix_error (error, "Could not parse ^CVOICE results: ");
@@ -1458,7 +1423,6 @@ mm_huawei_parse_cvoice_response (const gchar  *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return ret;
 }
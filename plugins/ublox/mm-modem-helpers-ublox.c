@@ -18,6 +18,7 @@
 
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
+#include "mm-regex.h"
 #include "mm-modem-helpers-ublox.h"
 
 /*****************************************************************************/
@@ -31,7 +32,7 @@ mm_ublox_parse_upincnt_response (const gchar  *response,
                                  guint        *out_puk2_attempts,
                                  GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UPINCNT: (\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       pin_attempts = 0;
@@ -48,10 +49,7 @@ mm_ublox_parse_upincnt_response (const gchar  *response,
     /* Response may be e.g.:
      * +UPINCNT: 3,3,10,10
      */
-    r = g_regex_new ("\\+UPINCNT: (\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         if (!mm_get_uint_from_match_info (match_info, 1, &pin_attempts)) {
             inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
@@ -79,7 +77,6 @@ mm_ublox_parse_upincnt_response (const gchar  *response,
 out:
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -107,7 +104,7 @@ mm_ublox_parse_uusbconf_response (const gchar        *response,
                                   MMUbloxUsbProfile  *out_profile,
                                   GError            **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UUSBCONF: (\\d+),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     MMUbloxUsbProfile profile = MM_UBLOX_USB_PROFILE_UNKNOWN;
@@ -122,10 +119,7 @@ mm_ublox_parse_uusbconf_response (const gchar        *response,
      * Note: we don't rely on the PID; assuming future new modules will
      * have a different PID but they may keep the profile names.
      */
-    r = g_regex_new ("\\+UUSBCONF: (\\d+),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         gchar *profile_name;
 
@@ -144,7 +138,6 @@ mm_ublox_parse_uusbconf_response (const gchar        *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -169,7 +162,7 @@ mm_ublox_parse_ubmconf_response (const gchar            *response,
                                  MMUbloxNetworkingMode  *out_mode,
                                  GError                **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UBMCONF: (\\d+)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     MMUbloxNetworkingMode mode = MM_UBLOX_NETWORKING_MODE_UNKNOWN;
@@ -180,10 +173,7 @@ mm_ublox_parse_ubmconf_response (const gchar            *response,
      * +UBMCONF: 1
      * +UBMCONF: 2
      */
-    r = g_regex_new ("\\+UBMCONF: (\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         guint mode_id = 0;
 
@@ -204,7 +194,6 @@ mm_ublox_parse_ubmconf_response (const gchar            *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -234,7 +223,7 @@ mm_ublox_parse_uipaddr_response (const gchar  *response,
                                  gchar       **out_ipv6_link_local_address,
                                  GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UIPADDR: (\\d+),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       cid = 0;
@@ -251,10 +240,7 @@ mm_ublox_parse_uipaddr_response (const gchar  *response,
      *
      * We assume only ONE line is returned; because we request +UIPADDR with a specific N CID.
      */
-    r = g_regex_new ("\\+UIPADDR: (\\d+),([^,]*),([^,]*),([^,]*),([^,]*),([^,]*)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -290,7 +276,6 @@ mm_ublox_parse_uipaddr_response (const gchar  *response,
 out:
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_free (if_name);
@@ -1541,7 +1526,7 @@ GArray *
 mm_ublox_parse_uact_response (const gchar  *response,
                               GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     GArray     *nums = NULL;
@@ -1551,11 +1536,7 @@ mm_ublox_parse_uact_response (const gchar  *response,
      * AT+UACT?
      * +UACT: ,,,900,1800,1,8,101,103,107,108,120,138
      */
-    r = g_regex_new ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         gchar *bandstr;
 
@@ -1565,7 +1546,6 @@ mm_ublox_parse_uact_response (const gchar  *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -1617,7 +1597,7 @@ mm_ublox_parse_uact_test (const gchar  *response,
                           GArray      **bands4g_out,
                           GError      **error)
 {
-    GRegex       *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo   *match_info;
     GError       *inner_error = NULL;
     const gchar  *bands2g_str = NULL;
@@ -1634,11 +1614,7 @@ mm_ublox_parse_uact_test (const gchar  *response,
      * AT+UACT=?
      * +UACT: ,,,(900,1800),(1,8),(101,103,107,108,120),(138)
      */
-    r = g_regex_new ("\\+UACT: ([^,]*),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -1679,7 +1655,6 @@ mm_ublox_parse_uact_test (const gchar  *response,
 out:
     g_strfreev (split);
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         if (bands2g)
@@ -1744,7 +1719,7 @@ mm_ublox_parse_urat_read_response (const gchar  *response,
                                    MMModemMode  *out_preferred,
                                    GError      **error)
 {
-    GRegex      *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+URAT: (\\d+)(?:,(\\d+))?(?:\\r\\n)?", 0, 0);
     GMatchInfo  *match_info;
     GError      *inner_error = NULL;
     MMModemMode  allowed = MM_MODEM_MODE_NONE;
@@ -1758,10 +1733,7 @@ mm_ublox_parse_urat_read_response (const gchar  *response,
      * +URAT: 1,2
      * +URAT: 1
      */
-    r = g_regex_new ("\\+URAT: (\\d+)(?:,(\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         guint  value = 0;
 
@@ -1810,7 +1782,6 @@ out:
     g_free (preferred_str);
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -1964,7 +1935,7 @@ mm_ublox_parse_ugcntrd_response_for_cid (const gchar  *response,
                                          guint        *out_total_rx_bytes,
                                          GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+UGCNTRD:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info = NULL;
     GError     *inner_error = NULL;
     guint       session_tx_bytes = 0;
@@ -1977,17 +1948,13 @@ mm_ublox_parse_ugcntrd_response_for_cid (const gchar  *response,
      *  +UGCNTRD: 31,2704,1819,2724,1839
      * We assume only ONE line is returned.
      */
-    r = g_regex_new ("\\+UGCNTRD:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
     /* Report invalid CID given */
     if (!in_cid) {
         inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Invalid CID given");
         goto out;
     }
 
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
         guint cid = 0;
 
@@ -2029,7 +1996,6 @@ mm_ublox_parse_ugcntrd_response_for_cid (const gchar  *response,
 out:
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -17,6 +17,7 @@
 
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
+#include "mm-regex.h"
 #include "mm-modem-helpers-xmm.h"
 #include "mm-signal.h"
 
@@ -363,7 +364,7 @@ mm_xmm_parse_xact_query_response (const gchar             *response,
                                   GArray                 **bands_out,
                                   GError                 **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+XACT: (\\d+),([^,]*),([^,]*),(.*)(?:\\r\\n)?", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     GArray     *bands = NULL;
@@ -384,11 +385,7 @@ mm_xmm_parse_xact_query_response (const gchar             *response,
      * Note: the first 3 fields corresponde to allowed and preferred modes. Only the
      * first one of those 3 first fields is mandatory, the other two may be empty.
      */
-    r = g_regex_new ("\\+XACT: (\\d+),([^,]*),([^,]*),(.*)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         if (mode_out) {
             guint xmm_mode;
@@ -450,7 +447,6 @@ mm_xmm_parse_xact_query_response (const gchar             *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         if (bands)
@@ -608,7 +604,7 @@ mm_xmm_parse_xcesq_query_response (const gchar  *response,
                                    gint         *out_rssnr,
                                    GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+XCESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(-?\\d+)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       rxlev = 99;
@@ -633,10 +629,7 @@ mm_xmm_parse_xcesq_query_response (const gchar  *response,
      * +XCESQ: 0,99,99,46,31,255,255,255
      * +XCESQ: 0,99,99,255,255,17,45,-2
      */
-    r = g_regex_new ("\\+XCESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(-?\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         /* Ignore "n" value */
         if (!mm_get_uint_from_match_info (match_info, 2, &rxlev)) {
@@ -672,7 +665,6 @@ mm_xmm_parse_xcesq_query_response (const gchar  *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -956,7 +948,7 @@ mm_xmm_parse_xlcsslp_query_response (const gchar  *response,
                                      gchar       **supl_address,
                                      GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+XLCSSLP:\\s*(\\d+),([^,]*),(\\d+)(?:\\r\\n)?", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     gchar      *address = NULL;
@@ -967,11 +959,7 @@ mm_xmm_parse_xlcsslp_query_response (const gchar  *response,
      *  +XLCSSLP:1,"www.spirent-lcs.com",7275
      */
 
-    r = g_regex_new ("\\+XLCSSLP:\\s*(\\d+),([^,]*),(\\d+)(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         guint  type;
 
@@ -994,7 +982,6 @@ mm_xmm_parse_xlcsslp_query_response (const gchar  *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -29,6 +29,11 @@
 #include "mm-base-manager.h"
 #include "mm-log.h"
 #include "mm-context.h"
+#include "mm-regex.h"
+
+#if defined WITH_QMI
+# include "mm-port-qmi.h"
+#endif
 
 #if defined WITH_SYSTEMD_SUSPEND_RESUME
 # include "mm-sleep-monitor.h"
@@ -151,6 +156,15 @@ main (int argc, char *argv[])
         exit (1);
     }
 
+#if defined WITH_QMI
+    mm_port_qmi_set_state_dir (mm_context_get_qmi_state_dir ());
+#endif
+
+    /* Writes to an SMS sink FIFO whose reader went away raise SIGPIPE; unlike
+     * with sockets, there is no per-call flag to avoid it */
+    if (mm_context_get_sms_sink ())
+        signal (SIGPIPE, SIG_IGN);
+
     g_unix_signal_add (SIGTERM, quit_cb, NULL);
     g_unix_signal_add (SIGINT, quit_cb, NULL);
 
@@ -215,6 +229,8 @@ main (int argc, char *argv[])
 
     g_bus_unown_name (name_id);
 
+    mm_regex_registry_dump_stats ();
+
     mm_info ("ModemManager is shut down");
 
     mm_log_shutdown ();
@@ -32,23 +32,29 @@
 #include "mm-iface-modem.h"
 #include "mm-iface-modem-3gpp.h"
 #include "mm-iface-modem-cdma.h"
+#include "mm-iface-modem-simple.h"
 #include "mm-base-bearer.h"
 #include "mm-base-modem-at.h"
 #include "mm-base-modem.h"
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
 #include "mm-bearer-stats.h"
+#include "mm-context.h"
 
 /* We require up to 20s to get a proper IP when using PPP */
 #define BEARER_IP_TIMEOUT_DEFAULT 20
 
 #define BEARER_DEFERRED_UNREGISTRATION_TIMEOUT 15
 
+/* Default stats refresh rate; also used when querying the modem */
 #define BEARER_STATS_UPDATE_TIMEOUT 30
 
 /* Initial connectivity check after 30s, then each 5s */
 #define BEARER_CONNECTION_MONITOR_INITIAL_TIMEOUT 30
 #define BEARER_CONNECTION_MONITOR_TIMEOUT          5
+/* If the modem reports disconnections by itself, only check each 60s, just in
+ * case an indication gets lost */
+#define BEARER_CONNECTION_MONITOR_WATCHDOG_TIMEOUT 60
 
 G_DEFINE_TYPE (MMBaseBearer, mm_base_bearer, MM_GDBUS_TYPE_BEARER_SKELETON)
 
@@ -96,6 +102,12 @@ struct _MMBaseBearerPrivate {
     guint connection_monitor_id;
     /* Flag to specify whether connection monitoring is supported or not */
     gboolean load_connection_status_unsupported;
+    /* Flag to specify whether the modem reports disconnections with indications */
+    gboolean connection_status_indications;
+    /* When the watchdog check last run, if the monitor runs as watchdog */
+    gint64 connection_monitor_watchdog_time;
+    /* Connection status checks not run thanks to the indications */
+    guint connection_monitor_polls_avoided;
 
     /*-- 3GPP specific --*/
     guint deferred_3gpp_unregistration_id;
@@ -120,6 +132,29 @@ struct _MMBaseBearerPrivate {
     GTimer *duration_timer;
     /* Flag to specify whether reloading stats is supported or not */
     gboolean reload_stats_unsupported;
+    /* Network interface from which kernel stats are read, if any */
+    gchar *stats_iface;
+    /* Kernel counters of the interface when the connection was established */
+    guint64 stats_rx_bytes_base;
+    guint64 stats_tx_bytes_base;
+    /* Time of the last stats update, used to compute rates */
+    gdouble stats_last_update_time;
+    /* When the ongoing connection attempt started, and whether the bearer
+     * was ever connected, to report reconnection times */
+    gint64 connect_start_time;
+    gboolean connected_once;
+
+    /* Trace of the ongoing connection attempt, in monotonic time */
+    gint64 trace_start;
+    gint64 trace_registered;
+    gint64 trace_activated;
+    guint trace_registration_retries;
+    gboolean trace_registration_pending;
+    MMBearerConnectionPhase trace_phase;
+    gint64 trace_phase_start;
+    gint64 trace_phase_duration[MM_BEARER_CONNECTION_PHASE_LAST];
+    /* Failed connection attempts since the last successful one */
+    guint connection_failures;
 };
 
 /*****************************************************************************/
@@ -148,6 +183,21 @@ mm_base_bearer_export (MMBaseBearer *self)
 
 /*****************************************************************************/
 
+static void bearer_update_interface_stats (MMBaseBearer *self);
+
+static void
+connection_monitor_update_polls_avoided (MMBaseBearer *self,
+                                         guint         polls_avoided)
+{
+    self->priv->connection_monitor_polls_avoided += polls_avoided;
+    self->priv->connection_monitor_watchdog_time = g_get_monotonic_time ();
+
+    if (self->priv->stats) {
+        mm_bearer_stats_set_polls_avoided (self->priv->stats, self->priv->connection_monitor_polls_avoided);
+        bearer_update_interface_stats (self);
+    }
+}
+
 static void
 connection_monitor_stop (MMBaseBearer *self)
 {
@@ -155,6 +205,17 @@ connection_monitor_stop (MMBaseBearer *self)
         g_source_remove (self->priv->connection_monitor_id);
         self->priv->connection_monitor_id = 0;
     }
+
+    /* Account the checks that would have run since the last watchdog one */
+    if (self->priv->connection_monitor_watchdog_time) {
+        connection_monitor_update_polls_avoided (
+            self,
+            (guint) ((g_get_monotonic_time () - self->priv->connection_monitor_watchdog_time) /
+                     (BEARER_CONNECTION_MONITOR_TIMEOUT * G_USEC_PER_SEC)));
+        self->priv->connection_monitor_watchdog_time = 0;
+        mm_dbg ("Connection status checks avoided in bearer '%s': %u",
+                self->priv->path, self->priv->connection_monitor_polls_avoided);
+    }
 }
 
 static void
@@ -199,14 +260,43 @@ connection_monitor_cb (MMBaseBearer *self)
     return G_SOURCE_CONTINUE;
 }
 
+static gboolean
+watchdog_connection_monitor_cb (MMBaseBearer *self)
+{
+    /* Only one of the checks that would have run in the interval is done */
+    connection_monitor_update_polls_avoided (
+        self,
+        BEARER_CONNECTION_MONITOR_WATCHDOG_TIMEOUT / BEARER_CONNECTION_MONITOR_TIMEOUT - 1);
+    return connection_monitor_cb (self);
+}
+
 static gboolean
 initial_connection_monitor_cb (MMBaseBearer *self)
 {
+    gboolean indications_unreliable = FALSE;
+
     MM_BASE_BEARER_GET_CLASS (self)->load_connection_status (
         self,
         (GAsyncReadyCallback)load_connection_status_ready,
         NULL);
 
+    /* If the modem reports disconnections by itself, only keep a watchdog
+     * check, unless the plugin told us the indications can't be trusted */
+    if (self->priv->connection_status_indications)
+        g_object_get (self->priv->modem,
+                      MM_IFACE_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE, &indications_unreliable,
+                      NULL);
+
+    if (self->priv->connection_status_indications && !indications_unreliable) {
+        mm_dbg ("Connection status of bearer '%s' reported with indications: checking each %us",
+                self->priv->path, BEARER_CONNECTION_MONITOR_WATCHDOG_TIMEOUT);
+        self->priv->connection_monitor_watchdog_time = g_get_monotonic_time ();
+        self->priv->connection_monitor_id = g_timeout_add_seconds (BEARER_CONNECTION_MONITOR_WATCHDOG_TIMEOUT,
+                                                                   (GSourceFunc) watchdog_connection_monitor_cb,
+                                                                   self);
+        return G_SOURCE_REMOVE;
+    }
+
     /* Add new monitor timeout at a higher rate */
     self->priv->connection_monitor_id = g_timeout_add_seconds (BEARER_CONNECTION_MONITOR_TIMEOUT,
                                                                (GSourceFunc) connection_monitor_cb,
@@ -229,6 +319,7 @@ connection_monitor_start (MMBaseBearer *self)
 
     /* Schedule initial check */
     g_assert (!self->priv->connection_monitor_id);
+    self->priv->connection_monitor_polls_avoided = 0;
     self->priv->connection_monitor_id = g_timeout_add_seconds (BEARER_CONNECTION_MONITOR_INITIAL_TIMEOUT,
                                                                (GSourceFunc) initial_connection_monitor_cb,
                                                                self);
@@ -265,6 +356,91 @@ bearer_stats_stop (MMBaseBearer *self)
         g_source_remove (self->priv->stats_update_id);
         self->priv->stats_update_id = 0;
     }
+
+    g_clear_pointer (&self->priv->stats_iface, g_free);
+}
+
+static void
+bearer_stats_update (MMBaseBearer *self,
+                     guint64       rx_bytes,
+                     guint64       tx_bytes)
+{
+    gdouble elapsed;
+    gdouble interval;
+    guint64 rx_rate = 0;
+    guint64 tx_rate = 0;
+
+    elapsed  = g_timer_elapsed (self->priv->duration_timer, NULL);
+    interval = elapsed - self->priv->stats_last_update_time;
+
+    /* Rates are computed against the previous update; counters going
+     * backwards (e.g. modem counters reset) won't report any rate */
+    if (self->priv->stats_last_update_time > 0 && interval > 0) {
+        if (rx_bytes >= mm_bearer_stats_get_rx_bytes (self->priv->stats))
+            rx_rate = (guint64) ((rx_bytes - mm_bearer_stats_get_rx_bytes (self->priv->stats)) / interval);
+        if (tx_bytes >= mm_bearer_stats_get_tx_bytes (self->priv->stats))
+            tx_rate = (guint64) ((tx_bytes - mm_bearer_stats_get_tx_bytes (self->priv->stats)) / interval);
+    }
+    self->priv->stats_last_update_time = elapsed;
+
+    mm_bearer_stats_set_duration (self->priv->stats, (guint32) elapsed);
+    mm_bearer_stats_set_tx_bytes (self->priv->stats, tx_bytes);
+    mm_bearer_stats_set_rx_bytes (self->priv->stats, rx_bytes);
+    mm_bearer_stats_set_tx_rate  (self->priv->stats, tx_rate);
+    mm_bearer_stats_set_rx_rate  (self->priv->stats, rx_rate);
+    bearer_update_interface_stats (self);
+}
+
+static gboolean
+load_kernel_stats_counter (const gchar *iface,
+                           const gchar *counter,
+                           guint64     *value)
+{
+    gchar    *path;
+    gchar    *contents = NULL;
+    gboolean  ret = FALSE;
+
+    path = g_strdup_printf ("/sys/class/net/%s/statistics/%s", iface, counter);
+    if (g_file_get_contents (path, &contents, NULL, NULL)) {
+        *value = g_ascii_strtoull (contents, NULL, 10);
+        ret = TRUE;
+    }
+    g_free (contents);
+    g_free (path);
+    return ret;
+}
+
+static gboolean
+load_kernel_stats (const gchar *iface,
+                   guint64     *rx_bytes,
+                   guint64     *tx_bytes)
+{
+    return (load_kernel_stats_counter (iface, "rx_bytes", rx_bytes) &&
+            load_kernel_stats_counter (iface, "tx_bytes", tx_bytes));
+}
+
+static gboolean
+kernel_stats_update_cb (MMBaseBearer *self)
+{
+    guint64 rx_bytes = 0;
+    guint64 tx_bytes = 0;
+
+    if (!load_kernel_stats (self->priv->stats_iface, &rx_bytes, &tx_bytes)) {
+        mm_dbg ("Couldn't read kernel stats of interface '%s'", self->priv->stats_iface);
+        return G_SOURCE_CONTINUE;
+    }
+
+    /* The kernel counters live as long as the network interface; if they
+     * went backwards the interface was recreated, so restart from zero */
+    if (rx_bytes < self->priv->stats_rx_bytes_base || tx_bytes < self->priv->stats_tx_bytes_base) {
+        self->priv->stats_rx_bytes_base = 0;
+        self->priv->stats_tx_bytes_base = 0;
+    }
+
+    bearer_stats_update (self,
+                         rx_bytes - self->priv->stats_rx_bytes_base,
+                         tx_bytes - self->priv->stats_tx_bytes_base);
+    return G_SOURCE_CONTINUE;
 }
 
 static void
@@ -292,11 +468,12 @@ reload_stats_ready (MMBaseBearer *self,
         g_error_free (error);
     }
 
+    /* The bearer may have been disconnected while the request was ongoing */
+    if (!self->priv->stats || !self->priv->duration_timer)
+        return;
+
     /* We only update stats if they were retrieved properly */
-    mm_bearer_stats_set_duration (self->priv->stats, (guint32) g_timer_elapsed (self->priv->duration_timer, NULL));
-    mm_bearer_stats_set_tx_bytes (self->priv->stats, tx_bytes);
-    mm_bearer_stats_set_rx_bytes (self->priv->stats, rx_bytes);
-    bearer_update_interface_stats (self);
+    bearer_stats_update (self, rx_bytes, tx_bytes);
 }
 
 static gboolean
@@ -314,25 +491,51 @@ stats_update_cb (MMBaseBearer *self)
     }
 
     /* Otherwise, just update duration and we're done */
-    mm_bearer_stats_set_duration (self->priv->stats, (guint32) g_timer_elapsed (self->priv->duration_timer, NULL));
-    mm_bearer_stats_set_tx_bytes (self->priv->stats, 0);
-    mm_bearer_stats_set_rx_bytes (self->priv->stats, 0);
-    bearer_update_interface_stats (self);
+    bearer_stats_update (self, 0, 0);
     return G_SOURCE_CONTINUE;
 }
 
 static void
-bearer_stats_start (MMBaseBearer *self)
+bearer_stats_start (MMBaseBearer *self,
+                    MMPort       *data)
 {
+    guint rate;
+
     /* Allocate new stats object. If there was one already created from a
      * previous run, deallocate it */
     g_assert (!self->priv->stats);
     self->priv->stats = mm_bearer_stats_new ();
+    self->priv->stats_last_update_time = 0;
 
     /* Start duration timer */
     g_assert (!self->priv->duration_timer);
     self->priv->duration_timer = g_timer_new ();
 
+    /* If the bearer is bound to a network interface, the kernel already keeps
+     * exact byte counters for it, so we prefer those over querying the modem.
+     * The counters are not reset on connection, so keep the initial values
+     * as base. */
+    g_assert (!self->priv->stats_iface);
+    if (data &&
+        mm_port_get_subsys (data) == MM_PORT_SUBSYS_NET &&
+        load_kernel_stats (mm_port_get_device (data),
+                           &self->priv->stats_rx_bytes_base,
+                           &self->priv->stats_tx_bytes_base)) {
+        self->priv->stats_iface = g_strdup (mm_port_get_device (data));
+
+        rate = mm_context_get_bearer_stats_rate ();
+        if (!rate)
+            rate = BEARER_STATS_UPDATE_TIMEOUT;
+        mm_dbg ("Bearer stats loaded from interface '%s' every %us", self->priv->stats_iface, rate);
+
+        g_assert (!self->priv->stats_update_id);
+        self->priv->stats_update_id = g_timeout_add_seconds (rate,
+                                                             (GSourceFunc) kernel_stats_update_cb,
+                                                             self);
+        kernel_stats_update_cb (self);
+        return;
+    }
+
     /* Schedule */
     g_assert (!self->priv->stats_update_id);
     self->priv->stats_update_id = g_timeout_add_seconds (BEARER_STATS_UPDATE_TIMEOUT,
@@ -382,13 +585,13 @@ bearer_update_status (MMBaseBearer *self,
 
 static void
 bearer_update_status_connected (MMBaseBearer *self,
-                                const gchar *interface,
+                                MMPort *data,
                                 MMBearerIpConfig *ipv4_config,
                                 MMBearerIpConfig *ipv6_config)
 {
     mm_gdbus_bearer_set_connected (MM_GDBUS_BEARER (self), TRUE);
     mm_gdbus_bearer_set_suspended (MM_GDBUS_BEARER (self), FALSE);
-    mm_gdbus_bearer_set_interface (MM_GDBUS_BEARER (self), interface);
+    mm_gdbus_bearer_set_interface (MM_GDBUS_BEARER (self), data ? mm_port_get_device (data) : NULL);
     mm_gdbus_bearer_set_ip4_config (
         MM_GDBUS_BEARER (self),
         mm_bearer_ip_config_get_dictionary (ipv4_config));
@@ -397,7 +600,7 @@ bearer_update_status_connected (MMBaseBearer *self,
         mm_bearer_ip_config_get_dictionary (ipv6_config));
 
     /* Start statistics */
-    bearer_stats_start (self);
+    bearer_stats_start (self, data);
 
     /* Start connection monitor, if supported */
     connection_monitor_start (self);
@@ -659,6 +862,158 @@ reset_signal_handlers (MMBaseBearer *self)
     }
 }
 
+/*****************************************************************************/
+/* Connection setup trace */
+
+static const gchar *connection_phase_str[] = {
+    [MM_BEARER_CONNECTION_PHASE_REGISTRATION] = "registration",
+    [MM_BEARER_CONNECTION_PHASE_SETUP]        = "setup",
+    [MM_BEARER_CONNECTION_PHASE_ACTIVATION]   = "activation",
+    [MM_BEARER_CONNECTION_PHASE_IP_CONFIG]    = "IP config",
+};
+
+static void
+connection_trace_reset (MMBaseBearer *self,
+                        gint64        start)
+{
+    self->priv->trace_start = start;
+    self->priv->trace_registered = 0;
+    self->priv->trace_activated = 0;
+    self->priv->trace_registration_retries = 0;
+    self->priv->trace_registration_pending = FALSE;
+    self->priv->trace_phase = MM_BEARER_CONNECTION_PHASE_LAST;
+    memset (self->priv->trace_phase_duration, 0, sizeof (self->priv->trace_phase_duration));
+}
+
+static void
+connection_trace_close_phase (MMBaseBearer *self,
+                              gint64        now)
+{
+    if (self->priv->trace_phase == MM_BEARER_CONNECTION_PHASE_LAST)
+        return;
+
+    self->priv->trace_phase_duration[self->priv->trace_phase] += (now - self->priv->trace_phase_start);
+    if (self->priv->trace_phase == MM_BEARER_CONNECTION_PHASE_ACTIVATION)
+        self->priv->trace_activated = now;
+    self->priv->trace_phase = MM_BEARER_CONNECTION_PHASE_LAST;
+}
+
+void
+mm_base_bearer_trace_connection_phase (MMBaseBearer            *self,
+                                       MMBearerConnectionPhase  phase)
+{
+    gint64 now;
+
+    g_return_if_fail (phase < MM_BEARER_CONNECTION_PHASE_LAST);
+
+    /* Only traced while connecting */
+    if (self->priv->status != MM_BEARER_STATUS_CONNECTING)
+        return;
+
+    now = g_get_monotonic_time ();
+    connection_trace_close_phase (self, now);
+    self->priv->trace_phase = phase;
+    self->priv->trace_phase_start = now;
+}
+
+void
+mm_base_bearer_trace_registration (MMBaseBearer *self,
+                                   gint64        request_time,
+                                   gint64        registered_time,
+                                   guint         retries)
+{
+    connection_trace_reset (self, request_time);
+    self->priv->trace_registered = registered_time;
+    self->priv->trace_registration_retries = retries;
+    self->priv->trace_phase_duration[MM_BEARER_CONNECTION_PHASE_REGISTRATION] = registered_time - request_time;
+    self->priv->trace_registration_pending = TRUE;
+}
+
+static void
+connection_trace_start (MMBaseBearer *self,
+                        gboolean      with_registration)
+{
+    /* Keep the registration info reported right before connecting */
+    if (!with_registration)
+        connection_trace_reset (self, g_get_monotonic_time ());
+}
+
+static void
+connection_trace_finish (MMBaseBearer *self,
+                         gboolean      success)
+{
+    GString *str;
+    gint64   now;
+    guint    i;
+
+    now = g_get_monotonic_time ();
+    connection_trace_close_phase (self, now);
+
+    if (!success)
+        self->priv->connection_failures++;
+
+    str = g_string_new ("");
+    for (i = 0; i < MM_BEARER_CONNECTION_PHASE_LAST; i++) {
+        if (!self->priv->trace_phase_duration[i])
+            continue;
+        g_string_append_printf (str, "%s%s %" G_GINT64_FORMAT "ms",
+                                str->len ? ", " : "",
+                                connection_phase_str[i],
+                                self->priv->trace_phase_duration[i] / 1000);
+    }
+    mm_dbg ("Bearer '%s' connection %s after %" G_GINT64_FORMAT "ms (%s)",
+            self->priv->path,
+            success ? "established" : "failed",
+            (now - self->priv->trace_start) / 1000,
+            str->len ? str->str : "no phases traced");
+    g_string_free (str, TRUE);
+}
+
+/* Fill in the connection time related stats, once connected */
+static void
+bearer_stats_set_connection_times (MMBaseBearer *self)
+{
+    gint64 now;
+    guint  time_to_registered = 0;
+    guint  time_to_connected;
+    guint  time_to_ip;
+    guint  retries;
+
+    now = g_get_monotonic_time ();
+
+    if (self->priv->connected_once) {
+        guint reconnect_time;
+
+        reconnect_time = (guint) ((now - self->priv->connect_start_time) / 1000);
+        mm_dbg ("Bearer '%s' reconnected in %ums", self->priv->path, reconnect_time);
+        mm_bearer_stats_set_reconnect_time (self->priv->stats, reconnect_time);
+    }
+    self->priv->connected_once = TRUE;
+
+    if (self->priv->trace_registered)
+        time_to_registered = (guint) ((self->priv->trace_registered - self->priv->trace_start) / 1000);
+    /* If the implementation didn't report the activation phase, there is no
+     * way to tell connection and IP setup apart */
+    time_to_connected = (guint) (((self->priv->trace_activated ? self->priv->trace_activated : now) - self->priv->trace_start) / 1000);
+    time_to_ip = (guint) ((now - self->priv->trace_start) / 1000);
+    retries = self->priv->connection_failures + self->priv->trace_registration_retries;
+    self->priv->connection_failures = 0;
+
+    mm_bearer_stats_set_time_to_registered (self->priv->stats, time_to_registered);
+    mm_bearer_stats_set_time_to_connected  (self->priv->stats, time_to_connected);
+    mm_bearer_stats_set_time_to_ip         (self->priv->stats, time_to_ip);
+    mm_bearer_stats_set_retries            (self->priv->stats, retries);
+    bearer_update_interface_stats (self);
+
+    /* Aggregate in the modem */
+    if (MM_IS_IFACE_MODEM_SIMPLE (self->priv->modem))
+        mm_iface_modem_simple_report_connection_times (MM_IFACE_MODEM_SIMPLE (self->priv->modem),
+                                                       self->priv->trace_registered ? time_to_registered : G_MAXUINT,
+                                                       time_to_connected,
+                                                       time_to_ip,
+                                                       retries);
+}
+
 /*****************************************************************************/
 /* CONNECT */
 
@@ -705,6 +1060,7 @@ connect_ready (MMBaseBearer *self,
 
     /* NOTE: connect() implementations *MUST* handle cancellations themselves */
     result = MM_BASE_BEARER_GET_CLASS (self)->connect_finish (self, res, &error);
+    connection_trace_finish (self, !!result);
     if (!result) {
         mm_dbg ("Couldn't connect bearer '%s': '%s'",
                 self->priv->path,
@@ -733,10 +1089,12 @@ connect_ready (MMBaseBearer *self,
         /* Update bearer and interface status */
         bearer_update_status_connected (
             self,
-            mm_port_get_device (mm_bearer_connect_result_peek_data (result)),
+            mm_bearer_connect_result_peek_data (result),
             mm_bearer_connect_result_peek_ipv4_config (result),
             mm_bearer_connect_result_peek_ipv6_config (result));
         mm_bearer_connect_result_unref (result);
+
+        bearer_stats_set_connection_times (self);
     }
 
     if (launch_disconnect) {
@@ -763,6 +1121,11 @@ mm_base_bearer_connect (MMBaseBearer *self,
                         gpointer user_data)
 {
     GTask *task;
+    gboolean with_registration;
+
+    /* Registration info only applies to the attempt right after it */
+    with_registration = self->priv->trace_registration_pending;
+    self->priv->trace_registration_pending = FALSE;
 
     if (!MM_BASE_BEARER_GET_CLASS (self)->connect) {
         g_assert (!MM_BASE_BEARER_GET_CLASS (self)->connect_finish);
@@ -846,7 +1209,12 @@ mm_base_bearer_connect (MMBaseBearer *self,
     /* Connecting! */
     mm_dbg ("Connecting bearer '%s'", self->priv->path);
     self->priv->connect_cancellable = g_cancellable_new ();
+    self->priv->connect_start_time = g_get_monotonic_time ();
+    connection_trace_start (self, with_registration);
+    self->priv->connection_status_indications = FALSE;
     bearer_update_status (self, MM_BEARER_STATUS_CONNECTING);
+    /* Implementations refine the phase as they go */
+    mm_base_bearer_trace_connection_phase (self, MM_BEARER_CONNECTION_PHASE_SETUP);
     bearer_reset_interface_stats (self);
     MM_BASE_BEARER_GET_CLASS (self)->connect (
         self,
@@ -1263,6 +1631,25 @@ mm_base_bearer_report_connection_status (MMBaseBearer *self,
     return MM_BASE_BEARER_GET_CLASS (self)->report_connection_status (self, status);
 }
 
+/*****************************************************************************/
+
+void
+mm_base_bearer_set_connection_status_indications (MMBaseBearer *self,
+                                                  gboolean      enabled)
+{
+    self->priv->connection_status_indications = enabled;
+
+    /* If the indications can no longer be trusted while only running the
+     * watchdog check, go back to polling right away */
+    if (!enabled && self->priv->connection_monitor_watchdog_time) {
+        connection_monitor_stop (self);
+        self->priv->connection_monitor_id = g_timeout_add_seconds (BEARER_CONNECTION_MONITOR_TIMEOUT,
+                                                                   (GSourceFunc) connection_monitor_cb,
+                                                                   self);
+        connection_monitor_cb (self);
+    }
+}
+
 static void
 set_property (GObject *object,
               guint prop_id,
@@ -1381,6 +1768,7 @@ mm_base_bearer_init (MMBaseBearer *self)
     self->priv->reason_3gpp = CONNECTION_FORBIDDEN_REASON_NONE;
     self->priv->reason_cdma = CONNECTION_FORBIDDEN_REASON_NONE;
     self->priv->default_ip_family = MM_BEARER_IP_FAMILY_IPV4;
+    self->priv->trace_phase = MM_BEARER_CONNECTION_PHASE_LAST;
 
     /* Set defaults */
     mm_gdbus_bearer_set_interface   (MM_GDBUS_BEARER (self), NULL);
@@ -157,4 +157,34 @@ void mm_base_bearer_disconnect_force (MMBaseBearer *self);
 void mm_base_bearer_report_connection_status (MMBaseBearer *self,
                                               MMBearerConnectionStatus status);
 
+/* Implementations tell whether the modem reports disconnections of the
+ * ongoing connection attempt by itself, e.g. with unsolicited messages. If
+ * so, the connection status is only checked now and then as a watchdog.
+ * Disabling them while connected goes back to the regular polling. */
+void mm_base_bearer_set_connection_status_indications (MMBaseBearer *self,
+                                                       gboolean      enabled);
+
+/* Connection setup tracing. Implementations report when each phase of the
+ * connection attempt is entered; a phase ends when the next one is entered
+ * or when the attempt finishes. Phases may be entered several times (e.g.
+ * once per IP family), their durations are accumulated. */
+typedef enum {
+    MM_BEARER_CONNECTION_PHASE_REGISTRATION,
+    MM_BEARER_CONNECTION_PHASE_SETUP,
+    MM_BEARER_CONNECTION_PHASE_ACTIVATION,
+    MM_BEARER_CONNECTION_PHASE_IP_CONFIG,
+    MM_BEARER_CONNECTION_PHASE_LAST
+} MMBearerConnectionPhase;
+
+void mm_base_bearer_trace_connection_phase (MMBaseBearer            *self,
+                                            MMBearerConnectionPhase  phase);
+
+/* Registration happens before the connection attempt starts; the time when
+ * the connection was requested is taken as start of the trace of the next
+ * connection attempt. Times are given in monotonic time. */
+void mm_base_bearer_trace_registration (MMBaseBearer *self,
+                                        gint64        request_time,
+                                        gint64        registered_time,
+                                        guint         retries);
+
 #endif /* MM_BASE_BEARER_H */
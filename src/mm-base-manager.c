@@ -44,6 +44,9 @@
 #include "mm-auth.h"
 #include "mm-plugin.h"
 #include "mm-filter.h"
+#include "mm-iface-modem.h"
+#include "mm-bearer-list.h"
+#include "mm-snapshot.h"
 #include "mm-log.h"
 
 static void initable_iface_init (GInitableIface *iface);
@@ -89,6 +92,8 @@ struct _MMBaseManagerPrivate {
     GDBusObjectManagerServer *object_manager;
     /* The map of inhibited devices */
     GHashTable *inhibited_devices;
+    /* Property state reported in snapshots */
+    MMSnapshot *snapshot;
 
     /* The Test interface support */
     MmGdbusTest *test_skeleton;
@@ -786,6 +791,104 @@ handle_set_logging (MmGdbusOrgFreedesktopModemManager1 *manager,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Snapshot */
+
+static void
+snapshot_add_bearer (MMBaseBearer *bearer,
+                     MMSnapshot   *snapshot)
+{
+    const gchar *path;
+    GList       *skeletons;
+
+    /* Bearers are exported on their own, not in the object manager */
+    path = g_dbus_interface_skeleton_get_object_path (G_DBUS_INTERFACE_SKELETON (bearer));
+    if (!path)
+        return;
+
+    skeletons = g_list_prepend (NULL, bearer);
+    mm_snapshot_add_object (snapshot, path, skeletons);
+    g_list_free (skeletons);
+}
+
+static gboolean
+handle_get_snapshot (MmGdbusOrgFreedesktopModemManager1 *manager,
+                     GDBusMethodInvocation *invocation,
+                     GVariant *options)
+{
+    MMBaseManager  *self = MM_BASE_MANAGER (manager);
+    GVariantIter    iter;
+    gchar          *key;
+    GVariant       *value;
+    guint64         since_generation = 0;
+    gchar          *since_instance = NULL;
+    gchar         **interfaces = NULL;
+    GError         *error = NULL;
+    GList          *objects;
+    GList          *l;
+
+    g_variant_iter_init (&iter, options);
+    while (!error && g_variant_iter_next (&iter, "{sv}", &key, &value)) {
+        if (g_str_equal (key, "since-generation") && g_variant_is_of_type (value, G_VARIANT_TYPE_UINT64))
+            since_generation = g_variant_get_uint64 (value);
+        else if (g_str_equal (key, "since-instance") && g_variant_is_of_type (value, G_VARIANT_TYPE_STRING)) {
+            g_free (since_instance);
+            since_instance = g_variant_dup_string (value, NULL);
+        } else if (g_str_equal (key, "interfaces") && g_variant_is_of_type (value, G_VARIANT_TYPE_STRING_ARRAY)) {
+            g_strfreev (interfaces);
+            interfaces = g_variant_dup_strv (value, NULL);
+        } else
+            error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                                 "Invalid snapshot option: '%s' (%s)",
+                                 key, g_variant_get_type_string (value));
+        g_variant_unref (value);
+        g_free (key);
+    }
+
+    if (error) {
+        g_dbus_method_invocation_take_error (invocation, error);
+        g_free (since_instance);
+        g_strfreev (interfaces);
+        return TRUE;
+    }
+
+    mm_snapshot_begin (self->priv->snapshot, (const gchar * const *) interfaces);
+
+    objects = g_dbus_object_manager_get_objects (G_DBUS_OBJECT_MANAGER (self->priv->object_manager));
+    for (l = objects; l; l = g_list_next (l)) {
+        GDBusObject  *object = l->data;
+        GList        *skeletons;
+        MMBearerList *bearer_list = NULL;
+
+        skeletons = g_dbus_object_get_interfaces (object);
+        mm_snapshot_add_object (self->priv->snapshot, g_dbus_object_get_object_path (object), skeletons);
+        g_list_free_full (skeletons, g_object_unref);
+
+        if (!MM_IS_IFACE_MODEM (object))
+            continue;
+
+        g_object_get (object,
+                      MM_IFACE_MODEM_BEARER_LIST, &bearer_list,
+                      NULL);
+        if (bearer_list) {
+            mm_bearer_list_foreach (bearer_list,
+                                    (MMBearerListForeachFunc)snapshot_add_bearer,
+                                    self->priv->snapshot);
+            g_object_unref (bearer_list);
+        }
+    }
+    g_list_free_full (objects, g_object_unref);
+
+    mm_gdbus_org_freedesktop_modem_manager1_complete_get_snapshot (
+        manager,
+        invocation,
+        mm_snapshot_end (self->priv->snapshot, since_instance, since_generation));
+
+    g_free (since_instance);
+    g_strfreev (interfaces);
+    return TRUE;
+}
+
 /*****************************************************************************/
 /* Manual scan */
 
@@ -1466,12 +1569,16 @@ mm_base_manager_init (MMBaseManager *manager)
     /* Setup Object Manager Server */
     priv->object_manager = g_dbus_object_manager_server_new (MM_DBUS_PATH);
 
+    /* Setup snapshot support */
+    priv->snapshot = mm_snapshot_new ();
+
     /* Enable processing of input DBus messages */
     g_object_connect (manager,
                       "signal::handle-set-logging",         G_CALLBACK (handle_set_logging),         NULL,
                       "signal::handle-scan-devices",        G_CALLBACK (handle_scan_devices),        NULL,
                       "signal::handle-report-kernel-event", G_CALLBACK (handle_report_kernel_event), NULL,
                       "signal::handle-inhibit-device",      G_CALLBACK (handle_inhibit_device),      NULL,
+                      "signal::handle-get-snapshot",        G_CALLBACK (handle_get_snapshot),        NULL,
                       NULL);
 }
 
@@ -1538,6 +1645,8 @@ finalize (GObject *object)
     g_hash_table_destroy (priv->inhibited_devices);
     g_hash_table_destroy (priv->devices);
 
+    mm_snapshot_free (priv->snapshot);
+
 #if defined WITH_UDEV
     if (priv->udev)
         g_object_unref (priv->udev);
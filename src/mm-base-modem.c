@@ -89,6 +89,8 @@ struct _MMBaseModemPrivate {
     MMPortSerialAt *secondary;
     MMPortSerialQcdm *qcdm;
     GList *data;
+    /* Data ports being used by ongoing connection attempts */
+    GList *reserved_data;
 
     /* GPS-enabled modems will have an AT port for control, and a raw serial
      * port to receive all GPS traces */
@@ -823,9 +825,10 @@ mm_base_modem_peek_best_data_port (MMBaseModem *self,
 
     g_return_val_if_fail (MM_IS_BASE_MODEM (self), NULL);
 
-    /* Return first not-connected data port */
+    /* Return first not-connected and not-reserved data port */
     for (l = self->priv->data; l; l = g_list_next (l)) {
         if (!mm_port_get_connected ((MMPort *)l->data) &&
+            !g_list_find (self->priv->reserved_data, l->data) &&
             (mm_port_get_port_type ((MMPort *)l->data) == type ||
              type == MM_PORT_TYPE_UNKNOWN)) {
             return (MMPort *)l->data;
@@ -835,6 +838,29 @@ mm_base_modem_peek_best_data_port (MMBaseModem *self,
     return NULL;
 }
 
+MMPort *
+mm_base_modem_reserve_best_data_port (MMBaseModem *self,
+                                      MMPortType type)
+{
+    MMPort *port;
+
+    port = mm_base_modem_peek_best_data_port (self, type);
+    if (!port)
+        return NULL;
+
+    self->priv->reserved_data = g_list_prepend (self->priv->reserved_data, port);
+    return g_object_ref (port);
+}
+
+void
+mm_base_modem_release_data_port (MMBaseModem *self,
+                                 MMPort *port)
+{
+    g_return_if_fail (MM_IS_BASE_MODEM (self));
+
+    self->priv->reserved_data = g_list_remove (self->priv->reserved_data, port);
+}
+
 GList *
 mm_base_modem_get_data_ports (MMBaseModem *self)
 {
@@ -1573,6 +1599,8 @@ dispose (GObject *object)
     g_clear_object (&self->priv->secondary);
     g_list_free_full (self->priv->data, g_object_unref);
     self->priv->data = NULL;
+    g_list_free (self->priv->reserved_data);
+    self->priv->reserved_data = NULL;
     g_clear_object (&self->priv->qcdm);
     g_clear_object (&self->priv->gps_control);
     g_clear_object (&self->priv->gps);
@@ -150,6 +150,13 @@ MMPortSerialAt   *mm_base_modem_get_best_at_port      (MMBaseModem *self, GError
 MMPort           *mm_base_modem_get_best_data_port    (MMBaseModem *self, MMPortType type);
 GList            *mm_base_modem_get_data_ports        (MMBaseModem *self);
 
+/* Connection attempts running in parallel must not end up using the same
+ * data port: a reserved port is not returned as best data port until it is
+ * released, which should be done once the port is flagged as connected or
+ * the attempt fails. */
+MMPort           *mm_base_modem_reserve_best_data_port (MMBaseModem *self, MMPortType type);
+void              mm_base_modem_release_data_port      (MMBaseModem *self, MMPort *port);
+
 MMModemPortInfo *mm_base_modem_get_port_infos         (MMBaseModem *self,
                                                        guint *n_port_infos);
 
@@ -66,6 +66,11 @@ struct _MMBaseSmsPrivate {
     /* List of SMS parts */
     guint max_parts;
     GList *parts;
+    /* Multipart messages being received also keep their parts in an array
+     * indexed by sequence, so that taking a new part doesn't need to walk
+     * the list. Parts are owned by the list. */
+    MMSmsPart **part_slots;
+    guint n_parts;
 
     /* Set to true when all needed parts were received,
      * parsed and assembled */
@@ -490,27 +495,20 @@ handle_store (MMBaseSms *self,
 }
 
 /*****************************************************************************/
-/* Send SMS (DBus call handling) */
+/* Send SMS */
 
-typedef struct {
-    MMBaseSms *self;
-    MMBaseModem *modem;
-    GDBusMethodInvocation *invocation;
-} HandleSendContext;
-
-static void
-handle_send_context_free (HandleSendContext *ctx)
+gboolean
+mm_base_sms_send_finish (MMBaseSms *self,
+                         GAsyncResult *res,
+                         GError **error)
 {
-    g_object_unref (ctx->invocation);
-    g_object_unref (ctx->modem);
-    g_object_unref (ctx->self);
-    g_free (ctx);
+    return g_task_propagate_boolean (G_TASK (res), error);
 }
 
 static void
-handle_send_ready (MMBaseSms *self,
-                   GAsyncResult *res,
-                   HandleSendContext *ctx)
+send_ready (MMBaseSms *self,
+            GAsyncResult *res,
+            GTask *task)
 {
     GError *error = NULL;
 
@@ -518,24 +516,26 @@ handle_send_ready (MMBaseSms *self,
         /* On error, clear up the parts we generated */
         g_list_free_full (self->priv->parts, (GDestroyNotify)mm_sms_part_free);
         self->priv->parts = NULL;
-        g_dbus_method_invocation_take_error (ctx->invocation, error);
-    } else {
-        /* Transition from Unknown->Sent or Stored->Sent */
-        if (mm_gdbus_sms_get_state (MM_GDBUS_SMS (ctx->self)) == MM_SMS_STATE_UNKNOWN ||
-            mm_gdbus_sms_get_state (MM_GDBUS_SMS (ctx->self)) == MM_SMS_STATE_STORED) {
-            GList *l;
-
-            /* Update state */
-            mm_gdbus_sms_set_state (MM_GDBUS_SMS (ctx->self), MM_SMS_STATE_SENT);
-            /* Grab last message reference */
-            l = g_list_last (mm_base_sms_get_parts (ctx->self));
-            mm_gdbus_sms_set_message_reference (MM_GDBUS_SMS (ctx->self),
-                                                mm_sms_part_get_message_reference ((MMSmsPart *)l->data));
-        }
-        mm_gdbus_sms_complete_send (MM_GDBUS_SMS (ctx->self), ctx->invocation);
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
     }
 
-    handle_send_context_free (ctx);
+    /* Transition from Unknown->Sent or Stored->Sent */
+    if (mm_gdbus_sms_get_state (MM_GDBUS_SMS (self)) == MM_SMS_STATE_UNKNOWN ||
+        mm_gdbus_sms_get_state (MM_GDBUS_SMS (self)) == MM_SMS_STATE_STORED) {
+        GList *l;
+
+        /* Update state */
+        mm_gdbus_sms_set_state (MM_GDBUS_SMS (self), MM_SMS_STATE_SENT);
+        /* Grab last message reference */
+        l = g_list_last (mm_base_sms_get_parts (self));
+        mm_gdbus_sms_set_message_reference (MM_GDBUS_SMS (self),
+                                            mm_sms_part_get_message_reference ((MMSmsPart *)l->data));
+    }
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
 }
 
 static gboolean
@@ -566,63 +566,111 @@ prepare_sms_to_be_sent (MMBaseSms *self,
     return TRUE;
 }
 
-static void
-handle_send_auth_ready (MMBaseModem *modem,
-                        GAsyncResult *res,
-                        HandleSendContext *ctx)
+void
+mm_base_sms_send (MMBaseSms *self,
+                  GAsyncReadyCallback callback,
+                  gpointer user_data)
 {
     MMSmsState state;
     GError *error = NULL;
+    GTask *task;
 
-    if (!mm_base_modem_authorize_finish (modem, res, &error)) {
-        g_dbus_method_invocation_take_error (ctx->invocation, error);
-        handle_send_context_free (ctx);
-        return;
-    }
+    task = g_task_new (self, NULL, callback, user_data);
 
     /* We can only send SMS created by the user */
-    state = mm_gdbus_sms_get_state (MM_GDBUS_SMS (ctx->self));
+    state = mm_gdbus_sms_get_state (MM_GDBUS_SMS (self));
     if (state == MM_SMS_STATE_RECEIVED ||
         state == MM_SMS_STATE_RECEIVING) {
-        g_dbus_method_invocation_return_error (ctx->invocation,
-                                               MM_CORE_ERROR,
-                                               MM_CORE_ERROR_FAILED,
-                                               "This SMS was received, cannot send it");
-        handle_send_context_free (ctx);
+        g_task_return_new_error (task,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "This SMS was received, cannot send it");
+        g_object_unref (task);
         return;
     }
 
     /* Don't allow sending the same SMS multiple times, we would lose the message reference */
     if (state == MM_SMS_STATE_SENT) {
-        g_dbus_method_invocation_return_error (ctx->invocation,
-                                               MM_CORE_ERROR,
-                                               MM_CORE_ERROR_FAILED,
-                                               "This SMS was already sent, cannot send it again");
-        handle_send_context_free (ctx);
+        g_task_return_new_error (task,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "This SMS was already sent, cannot send it again");
+        g_object_unref (task);
         return;
     }
 
     /* Prepare the SMS to be sent, creating the PDU list if required */
-    if (!prepare_sms_to_be_sent (ctx->self, &error)) {
-        g_dbus_method_invocation_take_error (ctx->invocation, error);
-        handle_send_context_free (ctx);
+    if (!prepare_sms_to_be_sent (self, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
         return;
     }
 
     /* Check if we do support doing it */
-    if (!MM_BASE_SMS_GET_CLASS (ctx->self)->send ||
-        !MM_BASE_SMS_GET_CLASS (ctx->self)->send_finish) {
-        g_dbus_method_invocation_return_error (ctx->invocation,
-                                               MM_CORE_ERROR,
-                                               MM_CORE_ERROR_UNSUPPORTED,
-                                               "Sending SMS is not supported by this modem");
+    if (!MM_BASE_SMS_GET_CLASS (self)->send ||
+        !MM_BASE_SMS_GET_CLASS (self)->send_finish) {
+        g_task_return_new_error (task,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_UNSUPPORTED,
+                                 "Sending SMS is not supported by this modem");
+        g_object_unref (task);
+        return;
+    }
+
+    MM_BASE_SMS_GET_CLASS (self)->send (self,
+                                        (GAsyncReadyCallback)send_ready,
+                                        task);
+}
+
+/*****************************************************************************/
+/* Send SMS (DBus call handling) */
+
+typedef struct {
+    MMBaseSms *self;
+    MMBaseModem *modem;
+    GDBusMethodInvocation *invocation;
+} HandleSendContext;
+
+static void
+handle_send_context_free (HandleSendContext *ctx)
+{
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->modem);
+    g_object_unref (ctx->self);
+    g_free (ctx);
+}
+
+static void
+handle_send_ready (MMBaseSms *self,
+                   GAsyncResult *res,
+                   HandleSendContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_base_sms_send_finish (self, res, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else
+        mm_gdbus_sms_complete_send (MM_GDBUS_SMS (ctx->self), ctx->invocation);
+
+    handle_send_context_free (ctx);
+}
+
+static void
+handle_send_auth_ready (MMBaseModem *modem,
+                        GAsyncResult *res,
+                        HandleSendContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_base_modem_authorize_finish (modem, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
         handle_send_context_free (ctx);
         return;
     }
 
-    MM_BASE_SMS_GET_CLASS (ctx->self)->send (ctx->self,
-                                             (GAsyncReadyCallback)handle_send_ready,
-                                             ctx);
+    mm_base_sms_send (ctx->self,
+                      (GAsyncReadyCallback)handle_send_ready,
+                      ctx);
 }
 
 static gboolean
@@ -736,7 +784,7 @@ mm_base_sms_get_multipart_reference (MMBaseSms *self)
 gboolean
 mm_base_sms_multipart_is_complete (MMBaseSms *self)
 {
-    return (g_list_length (self->priv->parts) == self->priv->max_parts);
+    return (self->priv->n_parts == self->priv->max_parts);
 }
 
 gboolean
@@ -1031,6 +1079,7 @@ typedef struct {
     gboolean need_unlock;
     gboolean from_storage;
     gboolean use_pdu_mode;
+    gboolean need_link_release;
     GList *current;
     gchar *msg_data;
 } SmsSendContext;
@@ -1041,6 +1090,8 @@ sms_send_context_free (SmsSendContext *ctx)
     /* Unlock mem2 storage if we had the lock */
     if (ctx->need_unlock)
         mm_broadband_modem_unlock_sms_storages (MM_BROADBAND_MODEM (ctx->modem), FALSE, TRUE);
+    if (ctx->need_link_release)
+        mm_iface_modem_messaging_release_sms_link (MM_IFACE_MODEM_MESSAGING (ctx->modem));
     g_object_unref (ctx->modem);
     g_free (ctx->msg_data);
     g_free (ctx);
@@ -1281,6 +1332,13 @@ sms_send (MMBaseSms *self,
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)sms_send_context_free);
 
+    /* Ask the modem to keep the link open between the parts of a
+     * multipart message */
+    if (self->priv->parts && self->priv->parts->next) {
+        mm_iface_modem_messaging_hold_sms_link (MM_IFACE_MODEM_MESSAGING (self->priv->modem));
+        ctx->need_link_release = TRUE;
+    }
+
     /* If the SMS is STORED, try to send from storage */
     ctx->from_storage = (mm_base_sms_get_storage (self) != MM_SMS_STORAGE_UNKNOWN);
     if (ctx->from_storage) {
@@ -1456,6 +1514,203 @@ sms_delete (MMBaseSms *self,
 
 /*****************************************************************************/
 
+typedef struct {
+    MMBaseModem *modem;
+    gboolean need_unlock;
+    GPtrArray *parts;
+    gboolean whole_storage;
+    guint i;
+    guint n_failed;
+} SmsDeleteMultiplePartsContext;
+
+static void
+sms_delete_multiple_parts_context_free (SmsDeleteMultiplePartsContext *ctx)
+{
+    if (ctx->need_unlock)
+        mm_broadband_modem_unlock_sms_storages (MM_BROADBAND_MODEM (ctx->modem), TRUE, FALSE);
+    g_ptr_array_unref (ctx->parts);
+    g_object_unref (ctx->modem);
+    g_free (ctx);
+}
+
+static gboolean
+sms_delete_parts_finish (MMBaseSms *self,
+                         GAsyncResult *res,
+                         GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void delete_multiple_next_part (GTask *task);
+
+static void
+delete_multiple_part_ready (MMBaseModem *modem,
+                            GAsyncResult *res,
+                            GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+    part = g_ptr_array_index (ctx->parts, ctx->i);
+
+    /* Parts that couldn't be deleted keep their index */
+    mm_base_modem_at_command_finish (modem, res, &error);
+    if (error) {
+        ctx->n_failed++;
+        mm_dbg ("Couldn't delete SMS part with index %u: '%s'",
+                mm_sms_part_get_index (part),
+                error->message);
+        g_error_free (error);
+    } else
+        mm_sms_part_set_index (part, SMS_PART_INVALID_INDEX);
+
+    ctx->i++;
+    delete_multiple_next_part (task);
+}
+
+static void
+delete_multiple_next_part (GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    MMSmsPart *part;
+    gchar *cmd;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Skip non-stored parts */
+    while (ctx->i < ctx->parts->len &&
+           mm_sms_part_get_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, ctx->i)) == SMS_PART_INVALID_INDEX)
+        ctx->i++;
+
+    if (ctx->i == ctx->parts->len) {
+        if (ctx->n_failed > 0)
+            g_task_return_new_error (task,
+                                     MM_CORE_ERROR,
+                                     MM_CORE_ERROR_FAILED,
+                                     "Couldn't delete %u SMS parts",
+                                     ctx->n_failed);
+        else
+            g_task_return_boolean (task, TRUE);
+
+        g_object_unref (task);
+        return;
+    }
+
+    part = g_ptr_array_index (ctx->parts, ctx->i);
+    cmd = g_strdup_printf ("+CMGD=%d", mm_sms_part_get_index (part));
+    mm_base_modem_at_command (ctx->modem,
+                              cmd,
+                              10,
+                              FALSE,
+                              (GAsyncReadyCallback)delete_multiple_part_ready,
+                              task);
+    g_free (cmd);
+}
+
+static void
+delete_all_ready (MMBaseModem *modem,
+                  GAsyncResult *res,
+                  GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    GError *error = NULL;
+    guint i;
+
+    ctx = g_task_get_task_data (task);
+
+    if (!mm_base_modem_at_command_finish (modem, res, &error)) {
+        /* Delete flags are optional, go part by part instead */
+        mm_dbg ("Couldn't delete all SMS parts at once: '%s'", error->message);
+        g_error_free (error);
+        delete_multiple_next_part (task);
+        return;
+    }
+
+    for (i = 0; i < ctx->parts->len; i++)
+        mm_sms_part_set_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, i), SMS_PART_INVALID_INDEX);
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+delete_parts_lock_sms_storages_ready (MMBroadbandModem *modem,
+                                      GAsyncResult *res,
+                                      GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    GError *error = NULL;
+
+    if (!mm_broadband_modem_lock_sms_storages_finish (modem, res, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    ctx = g_task_get_task_data (task);
+
+    /* We are now locked. Whatever result we have here, we need to make sure
+     * we unlock the storages before finishing. */
+    ctx->need_unlock = TRUE;
+
+    /* Delete flag 4 removes all messages in mem1; the index is ignored */
+    if (ctx->whole_storage && ctx->parts->len > 0) {
+        gchar *cmd;
+
+        cmd = g_strdup_printf ("+CMGD=%d,4",
+                               mm_sms_part_get_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, 0)));
+        mm_base_modem_at_command (ctx->modem,
+                                  cmd,
+                                  30,
+                                  FALSE,
+                                  (GAsyncReadyCallback)delete_all_ready,
+                                  task);
+        g_free (cmd);
+        return;
+    }
+
+    delete_multiple_next_part (task);
+}
+
+static void
+sms_delete_parts (MMBaseSms *self,
+                  MMSmsStorage storage,
+                  GPtrArray *parts,
+                  gboolean whole_storage,
+                  GAsyncReadyCallback callback,
+                  gpointer user_data)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    GTask *task;
+
+    ctx = g_new0 (SmsDeleteMultiplePartsContext, 1);
+    ctx->modem = g_object_ref (self->priv->modem);
+    ctx->parts = g_ptr_array_ref (parts);
+    ctx->whole_storage = whole_storage;
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)sms_delete_multiple_parts_context_free);
+
+    if (storage == MM_SMS_STORAGE_UNKNOWN) {
+        mm_dbg ("Not removing non-stored SMS parts");
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
+
+    /* The storage is locked once for all the parts */
+    mm_broadband_modem_lock_sms_storages (
+        MM_BROADBAND_MODEM (self->priv->modem),
+        storage,
+        MM_SMS_STORAGE_UNKNOWN, /* none required for mem2 */
+        (GAsyncReadyCallback)delete_parts_lock_sms_storages_ready,
+        task);
+}
+
+/*****************************************************************************/
+
 gboolean
 mm_base_sms_delete_finish (MMBaseSms *self,
                            GAsyncResult *res,
@@ -1496,6 +1751,40 @@ mm_base_sms_delete (MMBaseSms *self,
                              "Deleting SMS is not supported by this modem");
 }
 
+gboolean
+mm_base_sms_delete_parts_finish (MMBaseSms *self,
+                                 GAsyncResult *res,
+                                 GError **error)
+{
+    if (MM_BASE_SMS_GET_CLASS (self)->delete_parts_finish)
+        return MM_BASE_SMS_GET_CLASS (self)->delete_parts_finish (self, res, error);
+
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+void
+mm_base_sms_delete_parts (MMBaseSms *self,
+                          MMSmsStorage storage,
+                          GPtrArray *parts,
+                          gboolean whole_storage,
+                          GAsyncReadyCallback callback,
+                          gpointer user_data)
+{
+    if (MM_BASE_SMS_GET_CLASS (self)->delete_parts &&
+        MM_BASE_SMS_GET_CLASS (self)->delete_parts_finish) {
+        MM_BASE_SMS_GET_CLASS (self)->delete_parts (self, storage, parts, whole_storage, callback, user_data);
+        return;
+    }
+
+    g_task_report_new_error (self,
+                             callback,
+                             user_data,
+                             mm_base_sms_delete_parts,
+                             MM_CORE_ERROR,
+                             MM_CORE_ERROR_UNSUPPORTED,
+                             "Deleting SMS is not supported by this modem");
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -1635,18 +1924,13 @@ assemble_sms (MMBaseSms *self,
 
 /*****************************************************************************/
 
-static guint
-cmp_sms_part_sequence (MMSmsPart *a,
-                       MMSmsPart *b)
-{
-    return (mm_sms_part_get_concat_sequence (a) - mm_sms_part_get_concat_sequence (b));
-}
-
 gboolean
 mm_base_sms_multipart_take_part (MMBaseSms *self,
                                  MMSmsPart *part,
                                  GError **error)
 {
+    guint sequence;
+
     if (!self->priv->is_multipart) {
         g_set_error (error,
                      MM_CORE_ERROR,
@@ -1655,44 +1939,52 @@ mm_base_sms_multipart_take_part (MMBaseSms *self,
         return FALSE;
     }
 
-    if (g_list_length (self->priv->parts) >= self->priv->max_parts) {
+    if (self->priv->n_parts >= self->priv->max_parts) {
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
                      "Already took %u parts, cannot take more",
-                     g_list_length (self->priv->parts));
+                     self->priv->n_parts);
         return FALSE;
     }
 
-    if (g_list_find_custom (self->priv->parts,
-                            part,
-                            (GCompareFunc)cmp_sms_part_sequence)) {
+    sequence = mm_sms_part_get_concat_sequence (part);
+    if (sequence < 1 || sequence > self->priv->max_parts) {
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
-                     "Cannot take part, sequence %u already taken",
-                     mm_sms_part_get_concat_sequence (part));
+                     "Cannot take part with sequence %u, maximum is %u",
+                     sequence,
+                     self->priv->max_parts);
         return FALSE;
     }
 
-    if (mm_sms_part_get_concat_sequence (part) > self->priv->max_parts) {
+    if (!self->priv->part_slots)
+        self->priv->part_slots = g_new0 (MMSmsPart *, self->priv->max_parts);
+
+    if (self->priv->part_slots[sequence - 1]) {
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
-                     "Cannot take part with sequence %u, maximum is %u",
-                     mm_sms_part_get_concat_sequence (part),
-                     self->priv->max_parts);
+                     "Cannot take part, sequence %u already taken",
+                     sequence);
         return FALSE;
     }
 
-    /* Insert sorted by concat sequence */
-    self->priv->parts = g_list_insert_sorted (self->priv->parts,
-                                              part,
-                                              (GCompareFunc)cmp_sms_part_sequence);
+    self->priv->part_slots[sequence - 1] = part;
+    self->priv->n_parts++;
+    self->priv->parts = g_list_prepend (self->priv->parts, part);
 
     /* We only populate contents when the multipart SMS is complete */
     if (mm_base_sms_multipart_is_complete (self)) {
         GError *inner_error = NULL;
+        guint   i;
+
+        /* Leave the list of parts sorted by sequence */
+        g_list_free (self->priv->parts);
+        self->priv->parts = NULL;
+        for (i = self->priv->max_parts; i > 0; i--)
+            self->priv->parts = g_list_prepend (self->priv->parts, self->priv->part_slots[i - 1]);
 
         if (!assemble_sms (self, &inner_error)) {
             /* We DO NOT propagate the error. The part was properly taken
@@ -1745,10 +2037,10 @@ mm_base_sms_singlepart_new (MMBaseModem *modem,
          * take it, and therefore the caller is responsible for freeing it. */
         self->priv->parts = g_list_remove (self->priv->parts, part);
         g_clear_object (&self);
-    } else
-        /* Only export once properly created */
-        mm_base_sms_export (self);
+    }
 
+    /* Not exported here; the SMS list decides whether the message is
+     * exposed in D-Bus or delivered directly to the SMS sink */
     return self;
 }
 
@@ -1786,14 +2078,10 @@ mm_base_sms_multipart_new (MMBaseModem *modem,
     if (!mm_base_sms_multipart_take_part (self, first_part, error))
         g_clear_object (&self);
 
-    /* We do export uncomplete multipart messages, in order to be able to
-     *  request removal of all parts of those multipart SMS that will never
-     *  get completed.
-     * Only the STATE of the SMS object will be valid in the exported DBus
-     *  interface.*/
-    if (self)
-        mm_base_sms_export (self);
-
+    /* Not exported here either. Uncomplete multipart messages are usually
+     * exported by the SMS list, in order to be able to request removal of all
+     * parts of those multipart SMS that will never get completed; only the
+     * STATE of the SMS object will be valid in the exported DBus interface. */
     return self;
 }
 
@@ -1972,6 +2260,7 @@ finalize (GObject *object)
     MMBaseSms *self = MM_BASE_SMS (object);
 
     g_list_free_full (self->priv->parts, (GDestroyNotify)mm_sms_part_free);
+    g_free (self->priv->part_slots);
     g_free (self->priv->path);
 
     G_OBJECT_CLASS (mm_base_sms_parent_class)->finalize (object);
@@ -2013,6 +2302,8 @@ mm_base_sms_class_init (MMBaseSmsClass *klass)
     klass->send_finish = sms_send_finish;
     klass->delete = sms_delete;
     klass->delete_finish = sms_delete_finish;
+    klass->delete_parts = sms_delete_parts;
+    klass->delete_parts_finish = sms_delete_parts_finish;
 
     properties[PROP_CONNECTION] =
         g_param_spec_object (MM_BASE_SMS_CONNECTION,
@@ -77,6 +77,20 @@ struct _MMBaseSmsClass {
     gboolean (* delete_finish) (MMBaseSms *self,
                                 GAsyncResult *res,
                                 GError **error);
+
+    /* Delete several stored parts from the same storage, not necessarily
+     * from this SMS. If whole_storage is set, the storage may be cleared in
+     * a single request, removing also any message not given in parts.
+     * Deleted parts get their index reset. */
+    void (* delete_parts) (MMBaseSms *self,
+                           MMSmsStorage storage,
+                           GPtrArray *parts,
+                           gboolean whole_storage,
+                           GAsyncReadyCallback callback,
+                           gpointer user_data);
+    gboolean (* delete_parts_finish) (MMBaseSms *self,
+                                      GAsyncResult *res,
+                                      GError **error);
 };
 
 GType mm_base_sms_get_type (void);
@@ -116,6 +130,13 @@ guint        mm_base_sms_get_multipart_reference (MMBaseSms *self);
 gboolean     mm_base_sms_multipart_is_complete   (MMBaseSms *self);
 gboolean     mm_base_sms_multipart_is_assembled  (MMBaseSms *self);
 
+void     mm_base_sms_send          (MMBaseSms *self,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data);
+gboolean mm_base_sms_send_finish   (MMBaseSms *self,
+                                    GAsyncResult *res,
+                                    GError **error);
+
 void     mm_base_sms_delete        (MMBaseSms *self,
                                     GAsyncReadyCallback callback,
                                     gpointer user_data);
@@ -123,4 +144,14 @@ gboolean mm_base_sms_delete_finish (MMBaseSms *self,
                                     GAsyncResult *res,
                                     GError **error);
 
+void     mm_base_sms_delete_parts        (MMBaseSms *self,
+                                          MMSmsStorage storage,
+                                          GPtrArray *parts,
+                                          gboolean whole_storage,
+                                          GAsyncReadyCallback callback,
+                                          gpointer user_data);
+gboolean mm_base_sms_delete_parts_finish (MMBaseSms *self,
+                                          GAsyncResult *res,
+                                          GError **error);
+
 #endif /* MM_BASE_SMS_H */
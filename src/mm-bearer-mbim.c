@@ -31,6 +31,8 @@
 #include "mm-port-enums-types.h"
 #include "mm-bearer-mbim.h"
 #include "mm-log.h"
+#include "mm-context.h"
+#include "mm-netlink.h"
 
 G_DEFINE_TYPE (MMBearerMbim, mm_bearer_mbim, MM_TYPE_BASE_BEARER)
 
@@ -47,6 +49,8 @@ struct _MMBearerMbimPrivate {
     guint32 session_id;
 
     MMPort *data;
+    /* Whether the network interface was configured by us */
+    gboolean data_configured;
 };
 
 /*****************************************************************************/
@@ -54,7 +58,6 @@ struct _MMBearerMbimPrivate {
 static gboolean
 peek_ports (gpointer self,
             MbimDevice **o_device,
-            MMPort **o_data,
             GAsyncReadyCallback callback,
             gpointer user_data)
 {
@@ -84,26 +87,6 @@ peek_ports (gpointer self,
         *o_device = mm_port_mbim_peek_device (port);
     }
 
-    if (o_data) {
-        MMPort *port;
-
-        /* Grab a data port */
-        port = mm_base_modem_peek_best_data_port (modem, MM_PORT_TYPE_NET);
-        if (!port) {
-            g_task_report_new_error (self,
-                                     callback,
-                                     user_data,
-                                     peek_ports,
-                                     MM_CORE_ERROR,
-                                     MM_CORE_ERROR_NOT_FOUND,
-                                     "No valid data port found to launch connection");
-            g_object_unref (modem);
-            return FALSE;
-        }
-
-        *o_data = port;
-    }
-
     g_object_unref (modem);
     return TRUE;
 }
@@ -190,7 +173,7 @@ reload_stats (MMBaseBearer *self,
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_ports (self, &device, NULL, callback, user_data))
+    if (!peek_ports (self, &device, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
@@ -220,6 +203,7 @@ typedef enum {
 
 typedef struct {
     MbimDevice *device;
+    MMBaseModem *modem;
     MMBearerProperties *properties;
     ConnectStep step;
     MMPort *data;
@@ -232,7 +216,9 @@ connect_context_free (ConnectContext *ctx)
 {
     if (ctx->connect_result)
         mm_bearer_connect_result_unref (ctx->connect_result);
+    mm_base_modem_release_data_port (ctx->modem, ctx->data);
     g_object_unref (ctx->data);
+    g_object_unref (ctx->modem);
     g_object_unref (ctx->properties);
     g_object_unref (ctx->device);
     g_slice_free (ConnectContext, ctx);
@@ -981,6 +967,7 @@ connect_context_step (GTask *task)
         }
 
         mm_dbg ("Launching %s connection with APN '%s'...", mbim_context_ip_type_get_string (ctx->ip_type), apn);
+        mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (self), MM_BEARER_CONNECTION_PHASE_ACTIVATION);
         message = (mbim_message_connect_set_new (
                        self->priv->session_id,
                        MBIM_ACTIVATION_COMMAND_ACTIVATE,
@@ -1012,6 +999,7 @@ connect_context_step (GTask *task)
         GError *error = NULL;
 
         mm_dbg ("Querying IP configuration...");
+        mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (self), MM_BEARER_CONNECTION_PHASE_IP_CONFIG);
         message = (mbim_message_ip_configuration_query_new (
                        self->priv->session_id,
                        MBIM_IP_CONFIGURATION_AVAILABLE_FLAG_NONE, /* ipv4configurationavailable */
@@ -1053,6 +1041,22 @@ connect_context_step (GTask *task)
         g_assert (self->priv->data == NULL);
         self->priv->data = g_object_ref (ctx->data);
 
+        /* MBIM network interfaces are always raw-IP, so they can be
+         * configured right away with the static settings; failing to do so
+         * isn't fatal, the settings are exposed anyway */
+        if (mm_context_get_configure_data_interfaces ()) {
+            GError *error = NULL;
+
+            if (!mm_netlink_configure_interface (mm_port_get_device (ctx->data),
+                                                 mm_bearer_connect_result_peek_ipv4_config (ctx->connect_result),
+                                                 mm_bearer_connect_result_peek_ipv6_config (ctx->connect_result),
+                                                 &error)) {
+                mm_warn ("Couldn't configure network interface: %s", error->message);
+                g_error_free (error);
+            }
+            self->priv->data_configured = TRUE;
+        }
+
         /* Set operation result */
         g_task_return_pointer (
             task,
@@ -1078,7 +1082,7 @@ _connect (MMBaseBearer *self,
     const gchar *apn;
     GTask *task;
 
-    if (!peek_ports (self, &device, &data, callback, user_data))
+    if (!peek_ports (self, &device, callback, user_data))
         return;
 
     g_object_get (self,
@@ -1103,7 +1107,21 @@ _connect (MMBaseBearer *self,
         return;
     }
 
-    g_object_unref (modem);
+    /* Grab a data port, not to be used by other connection attempts that may
+     * be running in parallel */
+    data = mm_base_modem_reserve_best_data_port (modem, MM_PORT_TYPE_NET);
+    if (!data) {
+        g_task_report_new_error (
+            self,
+            callback,
+            user_data,
+            _connect,
+            MM_CORE_ERROR,
+            MM_CORE_ERROR_NOT_FOUND,
+            "No valid data port found to launch connection");
+        g_object_unref (modem);
+        return;
+    }
 
     mm_dbg ("Launching connection with data port (%s/%s)",
             mm_port_subsys_get_string (mm_port_get_subsys (data)),
@@ -1111,7 +1129,8 @@ _connect (MMBaseBearer *self,
 
     ctx = g_slice_new0 (ConnectContext);
     ctx->device = g_object_ref (device);;
-    ctx->data = g_object_ref (data);
+    ctx->modem = modem;
+    ctx->data = data;
     ctx->step = CONNECT_STEP_FIRST;
 
     g_object_get (self,
@@ -1159,6 +1178,15 @@ static void
 reset_bearer_connection (MMBearerMbim *self)
 {
     if (self->priv->data) {
+        if (self->priv->data_configured) {
+            GError *error = NULL;
+
+            if (!mm_netlink_reset_interface (mm_port_get_device (self->priv->data), &error)) {
+                mm_warn ("Couldn't reset network interface: %s", error->message);
+                g_error_free (error);
+            }
+            self->priv->data_configured = FALSE;
+        }
         mm_port_set_connected (self->priv->data, FALSE);
         g_clear_object (&self->priv->data);
     }
@@ -1331,7 +1359,7 @@ disconnect (MMBaseBearer *_self,
         return;
     }
 
-    if (!peek_ports (self, &device, NULL, callback, user_data))
+    if (!peek_ports (self, &device, callback, user_data))
         return;
 
     mm_dbg ("Launching disconnection on data port (%s/%s)",
@@ -33,6 +33,8 @@
 #include "mm-port-enums-types.h"
 #include "mm-log.h"
 #include "mm-modem-helpers.h"
+#include "mm-context.h"
+#include "mm-netlink.h"
 
 G_DEFINE_TYPE (MMBearerQmi, mm_bearer_qmi, MM_TYPE_BASE_BEARER)
 
@@ -51,6 +53,8 @@ struct _MMBearerQmiPrivate {
     MMPort *data;
     guint32 packet_data_handle_ipv4;
     guint32 packet_data_handle_ipv6;
+    /* Whether the network interface was configured by us */
+    gboolean data_configured;
 };
 
 /*****************************************************************************/
@@ -394,23 +398,40 @@ typedef enum {
     CONNECT_STEP_FIRST,
     CONNECT_STEP_OPEN_QMI_PORT,
     CONNECT_STEP_IP_METHOD,
-    CONNECT_STEP_IPV4,
-    CONNECT_STEP_WDS_CLIENT_IPV4,
-    CONNECT_STEP_IP_FAMILY_IPV4,
-    CONNECT_STEP_ENABLE_INDICATIONS_IPV4,
-    CONNECT_STEP_START_NETWORK_IPV4,
-    CONNECT_STEP_GET_CURRENT_SETTINGS_IPV4,
-    CONNECT_STEP_IPV6,
-    CONNECT_STEP_WDS_CLIENT_IPV6,
-    CONNECT_STEP_IP_FAMILY_IPV6,
-    CONNECT_STEP_ENABLE_INDICATIONS_IPV6,
-    CONNECT_STEP_START_NETWORK_IPV6,
-    CONNECT_STEP_GET_CURRENT_SETTINGS_IPV6,
+    CONNECT_STEP_IP_FAMILIES,
     CONNECT_STEP_LAST
 } ConnectStep;
 
+typedef enum {
+    CONNECT_FAMILY_STEP_FIRST,
+    CONNECT_FAMILY_STEP_WDS_CLIENT,
+    CONNECT_FAMILY_STEP_IP_FAMILY,
+    CONNECT_FAMILY_STEP_ENABLE_INDICATIONS,
+    CONNECT_FAMILY_STEP_START_NETWORK,
+    CONNECT_FAMILY_STEP_GET_CURRENT_SETTINGS,
+    CONNECT_FAMILY_STEP_LAST
+} ConnectFamilyStep;
+
+/* IPv4 and IPv6 are set up in parallel, each one with its own WDS client.
+ * While running, each family setup holds a reference to the connection
+ * task. */
+typedef struct {
+    GTask *task;
+    gboolean ipv6;
+    ConnectFamilyStep step;
+    QmiClientWds *client;
+    gboolean default_ip_family_set;
+    guint packet_service_status_indication_id;
+    guint event_report_indication_id;
+    guint32 packet_data_handle;
+    MMBearerIpConfig *config;
+    GError *error;
+    gboolean activating;
+} ConnectFamilyContext;
+
 typedef struct {
     MMBearerQmi *self;
+    MMBaseModem *modem;
     ConnectStep step;
     MMPort *data;
     MMPortQmi *qmi;
@@ -419,29 +440,44 @@ typedef struct {
     gchar *apn;
     QmiWdsAuthentication auth;
     gboolean no_ip_family_preference;
-    gboolean default_ip_family_set;
 
     MMBearerIpMethod ip_method;
 
     gboolean ipv4;
-    gboolean running_ipv4;
-    QmiClientWds *client_ipv4;
-    guint packet_service_status_ipv4_indication_id;
-    guint event_report_ipv4_indication_id;
-    guint32 packet_data_handle_ipv4;
-    MMBearerIpConfig *ipv4_config;
-    GError *error_ipv4;
-
     gboolean ipv6;
-    gboolean running_ipv6;
-    QmiClientWds *client_ipv6;
-    guint packet_service_status_ipv6_indication_id;
-    guint event_report_ipv6_indication_id;
-    guint32 packet_data_handle_ipv6;
-    MMBearerIpConfig *ipv6_config;
-    GError *error_ipv6;
+    ConnectFamilyContext *family_ipv4;
+    ConnectFamilyContext *family_ipv6;
+    guint families_running;
+    /* Families running Start Network; the activation phase only ends once
+     * all of them are done */
+    guint families_activating;
 } ConnectContext;
 
+static void
+connect_family_context_free (ConnectFamilyContext *family,
+                             MMBearerQmi          *self)
+{
+    if (!family)
+        return;
+
+    if (family->packet_service_status_indication_id) {
+        common_setup_cleanup_packet_service_status_unsolicited_events (self,
+                                                                       family->client,
+                                                                       FALSE,
+                                                                       &family->packet_service_status_indication_id);
+    }
+    if (family->event_report_indication_id) {
+        cleanup_event_report_unsolicited_events (self,
+                                                 family->client,
+                                                 &family->event_report_indication_id);
+    }
+
+    g_clear_error (&family->error);
+    g_clear_object (&family->client);
+    g_clear_object (&family->config);
+    g_slice_free (ConnectFamilyContext, family);
+}
+
 static void
 connect_context_free (ConnectContext *ctx)
 {
@@ -449,37 +485,16 @@ connect_context_free (ConnectContext *ctx)
     g_free (ctx->user);
     g_free (ctx->password);
 
-    if (ctx->packet_service_status_ipv4_indication_id) {
-        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv4,
-                                                                       FALSE,
-                                                                       &ctx->packet_service_status_ipv4_indication_id);
-    }
-    if (ctx->event_report_ipv4_indication_id) {
-        cleanup_event_report_unsolicited_events (ctx->self,
-                                                 ctx->client_ipv4,
-                                                 &ctx->event_report_ipv4_indication_id);
-    }
-    if (ctx->packet_service_status_ipv6_indication_id) {
-        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv6,
-                                                                       FALSE,
-                                                                       &ctx->packet_service_status_ipv6_indication_id);
-    }
-    if (ctx->event_report_ipv6_indication_id) {
-        cleanup_event_report_unsolicited_events (ctx->self,
-                                                 ctx->client_ipv6,
-                                                 &ctx->event_report_ipv6_indication_id);
-    }
+    connect_family_context_free (ctx->family_ipv4, ctx->self);
+    connect_family_context_free (ctx->family_ipv6, ctx->self);
+
+    /* Once connected the port is flagged as such, so the reservation is no
+     * longer needed either way */
+    mm_base_modem_release_data_port (ctx->modem, ctx->data);
 
-    g_clear_error (&ctx->error_ipv4);
-    g_clear_error (&ctx->error_ipv6);
-    g_clear_object (&ctx->client_ipv4);
-    g_clear_object (&ctx->client_ipv6);
-    g_clear_object (&ctx->ipv4_config);
-    g_clear_object (&ctx->ipv6_config);
     g_object_unref (ctx->data);
     g_object_unref (ctx->qmi);
+    g_object_unref (ctx->modem);
     g_object_unref (ctx->self);
     g_slice_free (ConnectContext, ctx);
 }
@@ -493,20 +508,16 @@ connect_finish (MMBaseBearer *self,
 }
 
 static void connect_context_step (GTask *task);
+static void connect_family_step (ConnectFamilyContext *family);
 
 static void
 start_network_ready (QmiClientWds *client,
                      GAsyncResult *res,
-                     GTask *task)
+                     ConnectFamilyContext *family)
 {
-    ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsStartNetworkOutput *output;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
     output = qmi_client_wds_start_network_finish (client, res, &error);
     if (output &&
         !qmi_message_wds_start_network_output_get_result (output, &error)) {
@@ -520,10 +531,7 @@ start_network_ready (QmiClientWds *client,
                              QMI_PROTOCOL_ERROR_NO_EFFECT)) {
             g_error_free (error);
             error = NULL;
-            if (ctx->running_ipv4)
-                ctx->packet_data_handle_ipv4 = GLOBAL_PACKET_DATA_HANDLE;
-            else
-                ctx->packet_data_handle_ipv6 = GLOBAL_PACKET_DATA_HANDLE;
+            family->packet_data_handle = GLOBAL_PACKET_DATA_HANDLE;
 
             /* Fall down to a successful connection */
         } else {
@@ -557,35 +565,26 @@ start_network_ready (QmiClientWds *client,
         }
     }
 
-    if (error) {
-        if (ctx->running_ipv4)
-            ctx->error_ipv4 = error;
-        else
-            ctx->error_ipv6 = error;
-    } else {
-        if (ctx->running_ipv4)
-            qmi_message_wds_start_network_output_get_packet_data_handle (output, &ctx->packet_data_handle_ipv4, NULL);
-        else
-            qmi_message_wds_start_network_output_get_packet_data_handle (output, &ctx->packet_data_handle_ipv6, NULL);
-    }
+    if (error)
+        family->error = error;
+    else
+        qmi_message_wds_start_network_output_get_packet_data_handle (output, &family->packet_data_handle, NULL);
 
     if (output)
         qmi_message_wds_start_network_output_unref (output);
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    family->step++;
+    connect_family_step (family);
 }
 
 static QmiMessageWdsStartNetworkInput *
-build_start_network_input (ConnectContext *ctx)
+build_start_network_input (ConnectContext       *ctx,
+                           ConnectFamilyContext *family)
 {
     QmiMessageWdsStartNetworkInput *input;
     gboolean has_user, has_password;
 
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
     input = qmi_message_wds_start_network_input_new ();
 
     if (ctx->apn && ctx->apn[0])
@@ -615,10 +614,10 @@ build_start_network_input (ConnectContext *ctx)
      * TLV if we already set a default IP family preference with "WDS Set IP
      * Family" */
     if (!ctx->no_ip_family_preference &&
-        !ctx->default_ip_family_set) {
+        !family->default_ip_family_set) {
         qmi_message_wds_start_network_input_set_ip_family_preference (
             input,
-            (ctx->running_ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4),
+            (family->ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4),
             NULL);
     }
 
@@ -818,14 +817,13 @@ get_ipv6_config (MMBearerQmi *self,
 static void
 get_current_settings_ready (QmiClientWds *client,
                             GAsyncResult *res,
-                            GTask *task)
+                            ConnectFamilyContext *family)
 {
     ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsGetCurrentSettingsOutput *output;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
+    ctx = g_task_get_task_data (family->task);
 
     output = qmi_client_wds_get_current_settings_finish (client, res, &error);
     if (!output ||
@@ -854,9 +852,9 @@ get_current_settings_ready (QmiClientWds *client,
         }
 
         if (ip_family == QMI_WDS_IP_FAMILY_IPV4)
-            ctx->ipv4_config = get_ipv4_config (ctx->self, ctx->ip_method, output, mtu);
+            family->config = get_ipv4_config (ctx->self, ctx->ip_method, output, mtu);
         else if (ip_family == QMI_WDS_IP_FAMILY_IPV6)
-            ctx->ipv6_config = get_ipv6_config (ctx->self, ctx->ip_method, output, mtu);
+            family->config = get_ipv6_config (ctx->self, ctx->ip_method, output, mtu);
 
         /* Domain names */
         if (qmi_message_wds_get_current_settings_output_get_domain_name_list (output, &array, &error)) {
@@ -880,20 +878,16 @@ get_current_settings_ready (QmiClientWds *client,
         qmi_message_wds_get_current_settings_output_unref (output);
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    family->step++;
+    connect_family_step (family);
 }
 
 static void
-get_current_settings (GTask *task, QmiClientWds *client)
+get_current_settings (ConnectFamilyContext *family)
 {
-    ConnectContext *ctx;
     QmiMessageWdsGetCurrentSettingsInput *input;
     QmiWdsGetCurrentSettingsRequestedSettings requested;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-
     requested = QMI_WDS_GET_CURRENT_SETTINGS_REQUESTED_SETTINGS_DNS_ADDRESS |
                 QMI_WDS_GET_CURRENT_SETTINGS_REQUESTED_SETTINGS_GRANTED_QOS |
                 QMI_WDS_GET_CURRENT_SETTINGS_REQUESTED_SETTINGS_IP_ADDRESS |
@@ -904,28 +898,23 @@ get_current_settings (GTask *task, QmiClientWds *client)
 
     input = qmi_message_wds_get_current_settings_input_new ();
     qmi_message_wds_get_current_settings_input_set_requested_settings (input, requested, NULL);
-    qmi_client_wds_get_current_settings (client,
+    qmi_client_wds_get_current_settings (family->client,
                                          input,
                                          10,
-                                         g_task_get_cancellable (task),
+                                         g_task_get_cancellable (family->task),
                                          (GAsyncReadyCallback)get_current_settings_ready,
-                                         task);
+                                         family);
     qmi_message_wds_get_current_settings_input_unref (input);
 }
 
 static void
 set_ip_family_ready (QmiClientWds *client,
                      GAsyncResult *res,
-                     GTask *task)
+                     ConnectFamilyContext *family)
 {
-    ConnectContext *ctx;
     GError *error = NULL;
     QmiMessageWdsSetIpFamilyOutput *output;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
     output = qmi_client_wds_set_ip_family_finish (client, res, &error);
     if (output) {
         qmi_message_wds_set_ip_family_output_get_result (output, &error);
@@ -936,15 +925,15 @@ set_ip_family_ready (QmiClientWds *client,
         /* Ensure we add the IP family preference TLV */
         mm_dbg ("Couldn't set IP family preference: '%s'", error->message);
         g_error_free (error);
-        ctx->default_ip_family_set = FALSE;
+        family->default_ip_family_set = FALSE;
     } else {
         /* No need to add IP family preference */
-        ctx->default_ip_family_set = TRUE;
+        family->default_ip_family_set = TRUE;
     }
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    family->step++;
+    connect_family_step (family);
 }
 
 static void
@@ -1047,45 +1036,24 @@ connect_enable_indications_ready (QmiClientWds *client,
 }
 
 static void
-connect_enable_indications_ipv4_ready (QmiClientWds *client,
-                                       GAsyncResult *res,
-                                       GTask *task)
-{
-    ConnectContext *ctx;
-
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->event_report_ipv4_indication_id == 0);
-
-    ctx->event_report_ipv4_indication_id =
-        connect_enable_indications_ready (client, res, ctx->self, &ctx->error_ipv4);
-
-    if (!ctx->event_report_ipv4_indication_id)
-        ctx->step = CONNECT_STEP_LAST;
-    else
-        ctx->step++;
-
-    connect_context_step (task);
-}
-
-static void
-connect_enable_indications_ipv6_ready (QmiClientWds *client,
-                                       GAsyncResult *res,
-                                       GTask *task)
+connect_family_enable_indications_ready (QmiClientWds *client,
+                                         GAsyncResult *res,
+                                         ConnectFamilyContext *family)
 {
     ConnectContext *ctx;
 
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->event_report_ipv6_indication_id == 0);
+    ctx = g_task_get_task_data (family->task);
+    g_assert (family->event_report_indication_id == 0);
 
-    ctx->event_report_ipv6_indication_id =
-        connect_enable_indications_ready (client, res, ctx->self, &ctx->error_ipv6);
+    family->event_report_indication_id =
+        connect_enable_indications_ready (client, res, ctx->self, &family->error);
 
-    if (!ctx->event_report_ipv6_indication_id)
-        ctx->step = CONNECT_STEP_LAST;
+    if (!family->event_report_indication_id)
+        family->step = CONNECT_FAMILY_STEP_LAST;
     else
-        ctx->step++;
+        family->step++;
 
-    connect_context_step (task);
+    connect_family_step (family);
 }
 
 static QmiMessageWdsSetEventReportInput *
@@ -1152,33 +1120,23 @@ cleanup_event_report_unsolicited_events (MMBearerQmi *self,
 static void
 qmi_port_allocate_client_ready (MMPortQmi *qmi,
                                 GAsyncResult *res,
-                                GTask *task)
+                                ConnectFamilyContext *family)
 {
-    ConnectContext *ctx;
-    GError *error = NULL;
-
-    ctx = g_task_get_task_data (task);
-    g_assert (ctx->running_ipv4 || ctx->running_ipv6);
-    g_assert (!(ctx->running_ipv4 && ctx->running_ipv6));
-
-    if (!mm_port_qmi_allocate_client_finish (qmi, res, &error)) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+    if (!mm_port_qmi_allocate_client_finish (qmi, res, &family->error)) {
+        family->step = CONNECT_FAMILY_STEP_LAST;
+        connect_family_step (family);
         return;
     }
 
-    if (ctx->running_ipv4)
-        ctx->client_ipv4 = QMI_CLIENT_WDS (mm_port_qmi_get_client (qmi,
-                                                                   QMI_SERVICE_WDS,
-                                                                   MM_PORT_QMI_FLAG_WDS_IPV4));
-    else
-        ctx->client_ipv6 = QMI_CLIENT_WDS (mm_port_qmi_get_client (qmi,
-                                                                   QMI_SERVICE_WDS,
-                                                                   MM_PORT_QMI_FLAG_WDS_IPV6));
+    family->client = QMI_CLIENT_WDS (mm_port_qmi_get_client (qmi,
+                                                             QMI_SERVICE_WDS,
+                                                             family->ipv6 ?
+                                                             MM_PORT_QMI_FLAG_WDS_IPV6 :
+                                                             MM_PORT_QMI_FLAG_WDS_IPV4));
 
     /* Keep on */
-    ctx->step++;
-    connect_context_step (task);
+    family->step++;
+    connect_family_step (family);
 }
 
 static void
@@ -1201,260 +1159,268 @@ qmi_port_open_ready (MMPortQmi *qmi,
     connect_context_step (task);
 }
 
+static ConnectFamilyContext *
+connect_family_context_new (GTask    *task,
+                            gboolean  ipv6)
+{
+    ConnectFamilyContext *family;
+
+    family = g_slice_new0 (ConnectFamilyContext);
+    family->task = g_object_ref (task);
+    family->ipv6 = ipv6;
+    family->step = CONNECT_FAMILY_STEP_FIRST;
+    return family;
+}
+
 static void
-connect_context_step (GTask *task)
+connect_family_complete (ConnectFamilyContext *family)
 {
     ConnectContext *ctx;
-    GCancellable *cancellable;
+    GTask *task;
 
-    /* If cancelled, complete */
-    if (g_task_return_error_if_cancelled (task)) {
+    /* The family setup no longer needs the task; the last one to finish
+     * hands over its reference to the main connection sequence */
+    task = family->task;
+    ctx = g_task_get_task_data (task);
+    g_assert (ctx->families_running > 0);
+    if (--ctx->families_running > 0) {
         g_object_unref (task);
         return;
     }
 
-    ctx = g_task_get_task_data (task);
-    cancellable = g_task_get_cancellable (task);
+    ctx->step++;
+    connect_context_step (task);
+}
 
-    switch (ctx->step) {
-    case CONNECT_STEP_FIRST:
+static void
+connect_family_activation_start (ConnectFamilyContext *family)
+{
+    ConnectContext *ctx;
 
-        g_assert (ctx->ipv4 || ctx->ipv6);
+    ctx = g_task_get_task_data (family->task);
+    if (family->activating)
+        return;
+    family->activating = TRUE;
+    if (ctx->families_activating++ == 0)
+        mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (ctx->self), MM_BEARER_CONNECTION_PHASE_ACTIVATION);
+}
 
-        /* Fall down */
-        ctx->step++;
+static void
+connect_family_activation_done (ConnectFamilyContext *family)
+{
+    ConnectContext *ctx;
 
-    case CONNECT_STEP_OPEN_QMI_PORT:
-        if (!mm_port_qmi_is_open (ctx->qmi)) {
-            mm_port_qmi_open (ctx->qmi,
-                              TRUE,
-                              cancellable,
-                              (GAsyncReadyCallback)qmi_port_open_ready,
-                              task);
-            return;
-        }
+    ctx = g_task_get_task_data (family->task);
+    if (!family->activating)
+        return;
+    family->activating = FALSE;
+    g_assert (ctx->families_activating > 0);
+    if (--ctx->families_activating > 0)
+        return;
 
-        /* If already open, just fall down */
-        ctx->step++;
+    /* IP configuration only starts once all families are activated, and only
+     * if at least one of them succeeded */
+    if ((ctx->family_ipv4 && ctx->family_ipv4->packet_data_handle) ||
+        (ctx->family_ipv6 && ctx->family_ipv6->packet_data_handle))
+        mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (ctx->self), MM_BEARER_CONNECTION_PHASE_IP_CONFIG);
+}
 
-    case CONNECT_STEP_IP_METHOD:
-        /* Once the QMI port is open, we decide the IP method we're going
-         * to request. If the LLP is raw-ip, we force Static IP, because not
-         * all DHCP clients support the raw-ip interfaces; otherwise default
-         * to DHCP as always. */
-        if (mm_port_qmi_llp_is_raw_ip (ctx->qmi))
-            ctx->ip_method = MM_BEARER_IP_METHOD_STATIC;
-        else
-            ctx->ip_method = MM_BEARER_IP_METHOD_DHCP;
+static void
+connect_family_step (ConnectFamilyContext *family)
+{
+    ConnectContext *ctx;
+    GCancellable *cancellable;
+    const gchar *family_str;
 
-        mm_dbg ("Defaulting to use %s IP method", mm_bearer_ip_method_get_string (ctx->ip_method));
+    ctx = g_task_get_task_data (family->task);
+    cancellable = g_task_get_cancellable (family->task);
+    family_str = family->ipv6 ? "IPv6" : "IPv4";
 
-        /* Just fall down */
-        ctx->step++;
+    /* If cancelled, complete; the whole connection attempt is cancelled
+     * once all families are done */
+    if (family->step != CONNECT_FAMILY_STEP_LAST &&
+        g_cancellable_is_cancelled (cancellable))
+        family->step = CONNECT_FAMILY_STEP_LAST;
 
-    case CONNECT_STEP_IPV4:
-        /* If no IPv4 setup needed, jump to IPv6 */
-        if (!ctx->ipv4) {
-            ctx->step = CONNECT_STEP_IPV6;
-            connect_context_step (task);
-            return;
-        }
-
-        /* Start IPv4 setup */
-        mm_dbg ("Running IPv4 connection setup");
-        ctx->running_ipv4 = TRUE;
-        ctx->running_ipv6 = FALSE;
+    switch (family->step) {
+    case CONNECT_FAMILY_STEP_FIRST:
+        mm_dbg ("Running %s connection setup", family_str);
         /* Just fall down */
-        ctx->step++;
+        family->step++;
 
-    case CONNECT_STEP_WDS_CLIENT_IPV4: {
+    case CONNECT_FAMILY_STEP_WDS_CLIENT: {
         QmiClient *client;
+        MMPortQmiFlag flag;
 
-        client = mm_port_qmi_get_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_PORT_QMI_FLAG_WDS_IPV4);
+        flag = family->ipv6 ? MM_PORT_QMI_FLAG_WDS_IPV6 : MM_PORT_QMI_FLAG_WDS_IPV4;
+        client = mm_port_qmi_get_client (ctx->qmi, QMI_SERVICE_WDS, flag);
         if (!client) {
-            mm_dbg ("Allocating IPv4-specific WDS client");
+            mm_dbg ("Allocating %s-specific WDS client", family_str);
             mm_port_qmi_allocate_client (ctx->qmi,
                                          QMI_SERVICE_WDS,
-                                         MM_PORT_QMI_FLAG_WDS_IPV4,
+                                         flag,
                                          cancellable,
                                          (GAsyncReadyCallback)qmi_port_allocate_client_ready,
-                                         task);
+                                         family);
             return;
         }
 
-        ctx->client_ipv4 = QMI_CLIENT_WDS (client);
+        family->client = QMI_CLIENT_WDS (client);
         /* Just fall down */
-        ctx->step++;
+        family->step++;
     }
 
-    case CONNECT_STEP_IP_FAMILY_IPV4:
+    case CONNECT_FAMILY_STEP_IP_FAMILY:
         /* If client is new enough, select IP family */
         if (!ctx->no_ip_family_preference &&
-            qmi_client_check_version (QMI_CLIENT (ctx->client_ipv4), 1, 9)) {
+            qmi_client_check_version (QMI_CLIENT (family->client), 1, 9)) {
             QmiMessageWdsSetIpFamilyInput *input;
 
-            mm_dbg ("Setting default IP family to: IPv4");
+            mm_dbg ("Setting default IP family to: %s", family_str);
             input = qmi_message_wds_set_ip_family_input_new ();
-            qmi_message_wds_set_ip_family_input_set_preference (input, QMI_WDS_IP_FAMILY_IPV4, NULL);
-            qmi_client_wds_set_ip_family (ctx->client_ipv4,
+            qmi_message_wds_set_ip_family_input_set_preference (input,
+                                                                family->ipv6 ? QMI_WDS_IP_FAMILY_IPV6 : QMI_WDS_IP_FAMILY_IPV4,
+                                                                NULL);
+            qmi_client_wds_set_ip_family (family->client,
                                           input,
                                           10,
                                           cancellable,
                                           (GAsyncReadyCallback)set_ip_family_ready,
-                                          task);
+                                          family);
             qmi_message_wds_set_ip_family_input_unref (input);
             return;
         }
 
-        ctx->default_ip_family_set = FALSE;
+        family->default_ip_family_set = FALSE;
 
         /* Just fall down */
-        ctx->step++;
+        family->step++;
 
-    case CONNECT_STEP_ENABLE_INDICATIONS_IPV4:
+    case CONNECT_FAMILY_STEP_ENABLE_INDICATIONS:
         common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv4,
+                                                                       family->client,
                                                                        TRUE,
-                                                                       &ctx->packet_service_status_ipv4_indication_id);
+                                                                       &family->packet_service_status_indication_id);
         setup_event_report_unsolicited_events (ctx->self,
-                                               ctx->client_ipv4,
+                                               family->client,
                                                cancellable,
-                                               (GAsyncReadyCallback) connect_enable_indications_ipv4_ready,
-                                               task);
+                                               (GAsyncReadyCallback) connect_family_enable_indications_ready,
+                                               family);
         return;
 
-    case CONNECT_STEP_START_NETWORK_IPV4: {
+    case CONNECT_FAMILY_STEP_START_NETWORK: {
         QmiMessageWdsStartNetworkInput *input;
 
-        mm_dbg ("Starting IPv4 connection...");
-        input = build_start_network_input (ctx);
-        qmi_client_wds_start_network (ctx->client_ipv4,
+        mm_dbg ("Starting %s connection...", family_str);
+        connect_family_activation_start (family);
+        input = build_start_network_input (ctx, family);
+        qmi_client_wds_start_network (family->client,
                                       input,
                                       45,
                                       cancellable,
                                       (GAsyncReadyCallback)start_network_ready,
-                                      task);
+                                      family);
         qmi_message_wds_start_network_input_unref (input);
         return;
     }
 
-    case CONNECT_STEP_GET_CURRENT_SETTINGS_IPV4: {
+    case CONNECT_FAMILY_STEP_GET_CURRENT_SETTINGS:
+        connect_family_activation_done (family);
         /* Retrieve and print IP configuration */
-        if (ctx->packet_data_handle_ipv4) {
-            mm_dbg ("Getting IPv4 configuration...");
-            get_current_settings (task, ctx->client_ipv4);
+        if (family->packet_data_handle) {
+            mm_dbg ("Getting %s configuration...", family_str);
+            get_current_settings (family);
             return;
         }
         /* Fall through */
-        ctx->step++;
-    }
-
-    case CONNECT_STEP_IPV6:
-        /* If no IPv6 setup needed, jump to last */
-        if (!ctx->ipv6) {
-            ctx->step = CONNECT_STEP_LAST;
-            connect_context_step (task);
-            return;
-        }
-
-        /* Start IPv6 setup */
-        mm_dbg ("Running IPv6 connection setup");
-        ctx->running_ipv4 = FALSE;
-        ctx->running_ipv6 = TRUE;
-        /* Just fall down */
-        ctx->step++;
+        family->step++;
 
-    case CONNECT_STEP_WDS_CLIENT_IPV6: {
-        QmiClient *client;
+    case CONNECT_FAMILY_STEP_LAST:
+        connect_family_activation_done (family);
+        connect_family_complete (family);
+        return;
+    }
+}
 
-        client = mm_port_qmi_get_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_PORT_QMI_FLAG_WDS_IPV6);
-        if (!client) {
-            mm_dbg ("Allocating IPv6-specific WDS client");
-            mm_port_qmi_allocate_client (ctx->qmi,
-                                         QMI_SERVICE_WDS,
-                                         MM_PORT_QMI_FLAG_WDS_IPV6,
-                                         cancellable,
-                                         (GAsyncReadyCallback)qmi_port_allocate_client_ready,
-                                         task);
-            return;
-        }
+static void
+connect_context_step (GTask *task)
+{
+    ConnectContext *ctx;
+    GCancellable *cancellable;
 
-        ctx->client_ipv6 = QMI_CLIENT_WDS (client);
-        /* Just fall down */
-        ctx->step++;
+    /* If cancelled, complete */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
     }
 
-    case CONNECT_STEP_IP_FAMILY_IPV6:
+    ctx = g_task_get_task_data (task);
+    cancellable = g_task_get_cancellable (task);
 
-        g_assert (ctx->no_ip_family_preference == FALSE);
+    switch (ctx->step) {
+    case CONNECT_STEP_FIRST:
 
-        /* If client is new enough, select IP family */
-        if (qmi_client_check_version (QMI_CLIENT (ctx->client_ipv6), 1, 9)) {
-            QmiMessageWdsSetIpFamilyInput *input;
+        g_assert (ctx->ipv4 || ctx->ipv6);
 
-            mm_dbg ("Setting default IP family to: IPv6");
-            input = qmi_message_wds_set_ip_family_input_new ();
-            qmi_message_wds_set_ip_family_input_set_preference (input, QMI_WDS_IP_FAMILY_IPV6, NULL);
-            qmi_client_wds_set_ip_family (ctx->client_ipv6,
-                                          input,
-                                          10,
-                                          cancellable,
-                                          (GAsyncReadyCallback)set_ip_family_ready,
-                                          task);
-            qmi_message_wds_set_ip_family_input_unref (input);
+        /* Fall down */
+        ctx->step++;
+
+    case CONNECT_STEP_OPEN_QMI_PORT:
+        if (!mm_port_qmi_is_open (ctx->qmi)) {
+            mm_port_qmi_open (ctx->qmi,
+                              TRUE,
+                              cancellable,
+                              (GAsyncReadyCallback)qmi_port_open_ready,
+                              task);
             return;
         }
 
-        ctx->default_ip_family_set = FALSE;
+        /* If already open, just fall down */
+        ctx->step++;
+
+    case CONNECT_STEP_IP_METHOD:
+        /* Once the QMI port is open, we decide the IP method we're going
+         * to request. If the LLP is raw-ip, we force Static IP, because not
+         * all DHCP clients support the raw-ip interfaces; otherwise default
+         * to DHCP as always. */
+        if (mm_port_qmi_llp_is_raw_ip (ctx->qmi))
+            ctx->ip_method = MM_BEARER_IP_METHOD_STATIC;
+        else
+            ctx->ip_method = MM_BEARER_IP_METHOD_DHCP;
+
+        mm_dbg ("Defaulting to use %s IP method", mm_bearer_ip_method_get_string (ctx->ip_method));
 
         /* Just fall down */
         ctx->step++;
 
-    case CONNECT_STEP_ENABLE_INDICATIONS_IPV6:
-        common_setup_cleanup_packet_service_status_unsolicited_events (ctx->self,
-                                                                       ctx->client_ipv6,
-                                                                       TRUE,
-                                                                       &ctx->packet_service_status_ipv6_indication_id);
-        setup_event_report_unsolicited_events (ctx->self,
-                                               ctx->client_ipv6,
-                                               cancellable,
-                                               (GAsyncReadyCallback) connect_enable_indications_ipv6_ready,
-                                               task);
+    case CONNECT_STEP_IP_FAMILIES:
+        /* Families may complete right away (e.g. if cancelled), so account
+         * all of them before launching any */
+        if (ctx->ipv4) {
+            ctx->family_ipv4 = connect_family_context_new (task, FALSE);
+            ctx->families_running++;
+        }
+        if (ctx->ipv6) {
+            ctx->family_ipv6 = connect_family_context_new (task, TRUE);
+            ctx->families_running++;
+        }
+        if (ctx->family_ipv4)
+            connect_family_step (ctx->family_ipv4);
+        if (ctx->family_ipv6)
+            connect_family_step (ctx->family_ipv6);
+        /* Each family holds its own reference */
+        g_object_unref (task);
         return;
 
-    case CONNECT_STEP_START_NETWORK_IPV6: {
-        QmiMessageWdsStartNetworkInput *input;
-
-        mm_dbg ("Starting IPv6 connection...");
-        input = build_start_network_input (ctx);
-        qmi_client_wds_start_network (ctx->client_ipv6,
-                                      input,
-                                      45,
-                                      cancellable,
-                                      (GAsyncReadyCallback)start_network_ready,
-                                      task);
-        qmi_message_wds_start_network_input_unref (input);
-        return;
-    }
+    case CONNECT_STEP_LAST: {
+        guint32 packet_data_handle_ipv4;
+        guint32 packet_data_handle_ipv6;
 
-    case CONNECT_STEP_GET_CURRENT_SETTINGS_IPV6: {
-        /* Retrieve and print IP configuration */
-        if (ctx->packet_data_handle_ipv6) {
-            mm_dbg ("Getting IPv6 configuration...");
-            get_current_settings (task, ctx->client_ipv6);
-            return;
-        }
-        /* Fall through */
-        ctx->step++;
-    }
+        packet_data_handle_ipv4 = ctx->family_ipv4 ? ctx->family_ipv4->packet_data_handle : 0;
+        packet_data_handle_ipv6 = ctx->family_ipv6 ? ctx->family_ipv6->packet_data_handle : 0;
 
-    case CONNECT_STEP_LAST:
         /* If one of IPv4 or IPv6 succeeds, we're connected */
-        if (ctx->packet_data_handle_ipv4 || ctx->packet_data_handle_ipv6) {
+        if (packet_data_handle_ipv4 || packet_data_handle_ipv6) {
             /* Port is connected; update the state */
             mm_port_set_connected (MM_PORT (ctx->data), TRUE);
 
@@ -1462,44 +1428,67 @@ connect_context_step (GTask *task)
             g_assert (ctx->self->priv->data == NULL);
             ctx->self->priv->data = g_object_ref (ctx->data);
 
+            /* Disconnections are reported with "Packet Service Status" indications */
+            mm_base_bearer_set_connection_status_indications (MM_BASE_BEARER (ctx->self), TRUE);
+
             g_assert (ctx->self->priv->packet_data_handle_ipv4 == 0);
             g_assert (ctx->self->priv->client_ipv4 == NULL);
-            if (ctx->packet_data_handle_ipv4) {
-                ctx->self->priv->packet_data_handle_ipv4 = ctx->packet_data_handle_ipv4;
-                ctx->self->priv->packet_service_status_ipv4_indication_id = ctx->packet_service_status_ipv4_indication_id;
-                ctx->packet_service_status_ipv4_indication_id = 0;
-                ctx->self->priv->event_report_ipv4_indication_id = ctx->event_report_ipv4_indication_id;
-                ctx->event_report_ipv4_indication_id = 0;
-                ctx->self->priv->client_ipv4 = g_object_ref (ctx->client_ipv4);
+            if (packet_data_handle_ipv4) {
+                ctx->self->priv->packet_data_handle_ipv4 = packet_data_handle_ipv4;
+                ctx->self->priv->packet_service_status_ipv4_indication_id = ctx->family_ipv4->packet_service_status_indication_id;
+                ctx->family_ipv4->packet_service_status_indication_id = 0;
+                ctx->self->priv->event_report_ipv4_indication_id = ctx->family_ipv4->event_report_indication_id;
+                ctx->family_ipv4->event_report_indication_id = 0;
+                ctx->self->priv->client_ipv4 = g_object_ref (ctx->family_ipv4->client);
             }
 
             g_assert (ctx->self->priv->packet_data_handle_ipv6 == 0);
             g_assert (ctx->self->priv->client_ipv6 == NULL);
-            if (ctx->packet_data_handle_ipv6) {
-                ctx->self->priv->packet_data_handle_ipv6 = ctx->packet_data_handle_ipv6;
-                ctx->self->priv->packet_service_status_ipv6_indication_id = ctx->packet_service_status_ipv6_indication_id;
-                ctx->packet_service_status_ipv6_indication_id = 0;
-                ctx->self->priv->event_report_ipv6_indication_id = ctx->event_report_ipv6_indication_id;
-                ctx->event_report_ipv6_indication_id = 0;
-                ctx->self->priv->client_ipv6 = g_object_ref (ctx->client_ipv6);
+            if (packet_data_handle_ipv6) {
+                ctx->self->priv->packet_data_handle_ipv6 = packet_data_handle_ipv6;
+                ctx->self->priv->packet_service_status_ipv6_indication_id = ctx->family_ipv6->packet_service_status_indication_id;
+                ctx->family_ipv6->packet_service_status_indication_id = 0;
+                ctx->self->priv->event_report_ipv6_indication_id = ctx->family_ipv6->event_report_indication_id;
+                ctx->family_ipv6->event_report_indication_id = 0;
+                ctx->self->priv->client_ipv6 = g_object_ref (ctx->family_ipv6->client);
+            }
+
+            /* Raw-IP interfaces can be configured right away with the
+             * static settings; failing to do so isn't fatal, the settings
+             * are exposed anyway */
+            if (mm_context_get_configure_data_interfaces () && mm_port_qmi_llp_is_raw_ip (ctx->qmi)) {
+                GError *error = NULL;
+
+                if (!mm_netlink_configure_interface (mm_port_get_device (ctx->data),
+                                                     packet_data_handle_ipv4 ? ctx->family_ipv4->config : NULL,
+                                                     packet_data_handle_ipv6 ? ctx->family_ipv6->config : NULL,
+                                                     &error)) {
+                    mm_warn ("Couldn't configure network interface: %s", error->message);
+                    g_error_free (error);
+                }
+                ctx->self->priv->data_configured = TRUE;
             }
 
             /* Set operation result */
             g_task_return_pointer (
                 task,
-                mm_bearer_connect_result_new (ctx->data, ctx->ipv4_config, ctx->ipv6_config),
+                mm_bearer_connect_result_new (ctx->data,
+                                              ctx->family_ipv4 ? ctx->family_ipv4->config : NULL,
+                                              ctx->family_ipv6 ? ctx->family_ipv6->config : NULL),
                 (GDestroyNotify)mm_bearer_connect_result_unref);
         } else {
-            GError *error;
+            GError *error = NULL;
 
             /* No connection, set error. If both set, IPv4 error preferred */
-            if (ctx->error_ipv4) {
-                error = ctx->error_ipv4;
-                ctx->error_ipv4 = NULL;
-            } else {
-                error = ctx->error_ipv6;
-                ctx->error_ipv6 = NULL;
-            }
+            if (ctx->family_ipv4 && ctx->family_ipv4->error) {
+                error = ctx->family_ipv4->error;
+                ctx->family_ipv4->error = NULL;
+            } else if (ctx->family_ipv6 && ctx->family_ipv6->error) {
+                error = ctx->family_ipv6->error;
+                ctx->family_ipv6->error = NULL;
+            } else
+                error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                     "Couldn't start network");
 
             g_task_return_error (task, error);
         }
@@ -1507,6 +1496,7 @@ connect_context_step (GTask *task)
         g_object_unref (task);
         return;
     }
+    }
 }
 
 static void
@@ -1529,68 +1519,68 @@ _connect (MMBaseBearer *self,
                   NULL);
     g_assert (modem);
 
-    /* Grab a data port */
-    data = mm_base_modem_get_best_data_port (modem, MM_PORT_TYPE_NET);
-    if (!data) {
+    /* Check whether we have an APN */
+    apn = mm_bearer_properties_get_apn (mm_base_bearer_peek_config (MM_BASE_BEARER (self)));
+
+    /* Is this a 3GPP only modem and no APN was given? If so, error */
+    if (mm_iface_modem_is_3gpp_only (MM_IFACE_MODEM (modem)) && !apn) {
         g_task_report_new_error (
             self,
             callback,
             user_data,
             _connect,
             MM_CORE_ERROR,
-            MM_CORE_ERROR_NOT_FOUND,
-            "No valid data port found to launch connection");
+            MM_CORE_ERROR_INVALID_ARGS,
+            "3GPP connection logic requires APN setting");
         g_object_unref (modem);
         return;
     }
 
-    /* Each data port has a single QMI port associated */
-    qmi = mm_base_modem_get_port_qmi_for_data (modem, data, &error);
-    if (!qmi) {
-        g_task_report_error (
+    /* Is this a 3GPP2 only modem and APN was given? If so, error */
+    if (mm_iface_modem_is_cdma_only (MM_IFACE_MODEM (modem)) && apn) {
+        g_task_report_new_error (
             self,
             callback,
             user_data,
             _connect,
-            error);
-        g_object_unref (data);
+            MM_CORE_ERROR,
+            MM_CORE_ERROR_INVALID_ARGS,
+            "3GPP2 doesn't support APN setting");
         g_object_unref (modem);
         return;
     }
 
-    /* Check whether we have an APN */
-    apn = mm_bearer_properties_get_apn (mm_base_bearer_peek_config (MM_BASE_BEARER (self)));
-
-    /* Is this a 3GPP only modem and no APN was given? If so, error */
-    if (mm_iface_modem_is_3gpp_only (MM_IFACE_MODEM (modem)) && !apn) {
+    /* Grab a data port, not to be used by other connection attempts that may
+     * be running in parallel */
+    data = mm_base_modem_reserve_best_data_port (modem, MM_PORT_TYPE_NET);
+    if (!data) {
         g_task_report_new_error (
             self,
             callback,
             user_data,
             _connect,
             MM_CORE_ERROR,
-            MM_CORE_ERROR_INVALID_ARGS,
-            "3GPP connection logic requires APN setting");
+            MM_CORE_ERROR_NOT_FOUND,
+            "No valid data port found to launch connection");
         g_object_unref (modem);
         return;
     }
 
-    /* Is this a 3GPP2 only modem and APN was given? If so, error */
-    if (mm_iface_modem_is_cdma_only (MM_IFACE_MODEM (modem)) && apn) {
-        g_task_report_new_error (
+    /* Each data port has a single QMI port associated */
+    qmi = mm_base_modem_get_port_qmi_for_data (modem, data, &error);
+    if (!qmi) {
+        g_task_report_error (
             self,
             callback,
             user_data,
             _connect,
-            MM_CORE_ERROR,
-            MM_CORE_ERROR_INVALID_ARGS,
-            "3GPP2 doesn't support APN setting");
+            error);
+        mm_base_modem_release_data_port (modem, data);
+        g_object_unref (data);
         g_object_unref (modem);
         return;
     }
 
-    g_object_unref (modem);
-
     mm_dbg ("Launching connection with QMI port (%s/%s) and data port (%s/%s)",
             mm_port_subsys_get_string (mm_port_get_subsys (MM_PORT (qmi))),
             mm_port_get_device (MM_PORT (qmi)),
@@ -1599,6 +1589,7 @@ _connect (MMBaseBearer *self,
 
     ctx = g_slice_new0 (ConnectContext);
     ctx->self = g_object_ref (self);
+    ctx->modem = modem;
     ctx->qmi = qmi;
     ctx->data = data;
     ctx->step = CONNECT_STEP_FIRST;
@@ -1775,6 +1766,15 @@ reset_bearer_connection (MMBearerQmi *self,
     if (!self->priv->packet_data_handle_ipv4 &&
         !self->priv->packet_data_handle_ipv6) {
         if (self->priv->data) {
+            if (self->priv->data_configured) {
+                GError *error = NULL;
+
+                if (!mm_netlink_reset_interface (mm_port_get_device (self->priv->data), &error)) {
+                    mm_warn ("Couldn't reset network interface: %s", error->message);
+                    g_error_free (error);
+                }
+                self->priv->data_configured = FALSE;
+            }
             /* Port is disconnected; update the state */
             mm_port_set_connected (self->priv->data, FALSE);
             g_clear_object (&self->priv->data);
@@ -267,6 +267,7 @@ cdma_connect_context_dial (GTask *task)
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
+    mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (self), MM_BEARER_CONNECTION_PHASE_ACTIVATION);
     mm_base_modem_at_command_full (ctx->modem,
                                    MM_PORT_SERIAL_AT (ctx->data),
                                    "DT#777",
@@ -600,7 +601,12 @@ dial_3gpp (MMBroadbandBearer *self,
 }
 
 /*****************************************************************************/
-/* 3GPP cid selection (sub-step of the 3GPP Connection sequence) */
+/* 3GPP cid selection (sub-step of the 3GPP Connection sequence)
+ *
+ * The +CGDCONT? and +CGDCONT=? replies are cached in the modem, so
+ * reconnecting to an APN which already has a PDP context defined doesn't
+ * need any command before dialing.
+ */
 
 typedef struct {
     MMBroadbandBearer *self;
@@ -647,33 +653,29 @@ initialize_pdp_context_ready (MMBaseModem  *modem,
     mm_base_modem_at_command_full_finish (modem, res, &error);
     if (error) {
         mm_warn ("Couldn't initialize PDP context with our APN: '%s'", error->message);
+        /* We don't know what's defined in the CID now */
+        mm_broadband_modem_invalidate_pdp_context_list (MM_BROADBAND_MODEM (modem));
         g_task_return_error (task, error);
-    } else
+    } else {
+        mm_broadband_modem_update_pdp_context (MM_BROADBAND_MODEM (modem),
+                                               ctx->cid,
+                                               ctx->ip_family,
+                                               mm_bearer_properties_get_apn (mm_base_bearer_peek_config (MM_BASE_BEARER (ctx->self))));
         g_task_return_int (task, (gssize) ctx->cid);
+    }
     g_object_unref (task);
 }
 
 static void
-find_cid_ready (MMBaseModem  *modem,
-                GAsyncResult *res,
-                GTask        *task)
+initialize_pdp_context (GTask *task)
 {
     gchar                   *apn;
     gchar                   *command;
-    GError                  *error = NULL;
     const gchar             *pdp_type;
     CidSelection3gppContext *ctx;
 
     ctx = (CidSelection3gppContext *) g_task_get_task_data (task);
 
-    mm_base_modem_at_sequence_full_finish (modem, res, NULL, &error);
-    if (error) {
-        mm_warn ("Couldn't find best CID to use: '%s'", error->message);
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
-
     /* Validate requested PDP type */
     pdp_type = mm_3gpp_get_pdp_type_from_ip_family (ctx->ip_family);
     if (!pdp_type) {
@@ -714,42 +716,30 @@ find_cid_ready (MMBaseModem  *modem,
     g_free (command);
 }
 
-static gboolean
-parse_cid_range (MMBaseModem              *modem,
-                 CidSelection3gppContext  *ctx,
-                 const gchar              *command,
-                 const gchar              *response,
-                 gboolean                  last_command,
-                 const GError             *error,
-                 GVariant                **result,
-                 GError                  **result_error)
+static void
+find_cid_ready (MMBaseModem  *modem,
+                GAsyncResult *res,
+                GTask        *task)
 {
-    GError *inner_error = NULL;
-    GList  *formats, *l;
-    guint   cid;
-
-    /* If cancelled, set result error */
-    if (g_cancellable_is_cancelled (ctx->cancellable)) {
-        g_set_error (result_error, MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED,
-                     "Connection setup operation has been cancelled");
-        return FALSE;
-    }
+    GError *error = NULL;
 
+    mm_base_modem_at_sequence_full_finish (modem, res, NULL, &error);
     if (error) {
-        mm_dbg ("Unexpected +CGDCONT error: '%s'", error->message);
-        mm_dbg ("Defaulting to CID=1");
-        ctx->cid = 1;
-        return TRUE;
+        mm_warn ("Couldn't find best CID to use: '%s'", error->message);
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
     }
 
-    formats = mm_3gpp_parse_cgdcont_test_response (response, &inner_error);
-    if (inner_error) {
-        mm_dbg ("Error parsing +CGDCONT test response: '%s'", inner_error->message);
-        mm_dbg ("Defaulting to CID=1");
-        g_error_free (inner_error);
-        ctx->cid = 1;
-        return TRUE;
-    }
+    initialize_pdp_context (task);
+}
+
+static void
+select_cid_from_format_list (CidSelection3gppContext *ctx,
+                             GList                   *formats)
+{
+    GList *l;
+    guint  cid;
 
     cid = 0;
     for (l = formats; l; l = g_list_next (l)) {
@@ -772,31 +762,26 @@ parse_cid_range (MMBaseModem              *modem,
         }
     }
 
-    mm_3gpp_pdp_context_format_list_free (formats);
-
     if (cid == 0) {
         mm_dbg ("Defaulting to CID=1");
         cid = 1;
     }
 
     ctx->cid = cid;
-    return TRUE;
 }
 
 static gboolean
-parse_pdp_list (MMBaseModem             *modem,
-                CidSelection3gppContext *ctx,
-                const gchar             *command,
-                const gchar             *response,
-                gboolean                 last_command,
-                const GError            *error,
-                GVariant               **result,
-                GError                 **result_error)
+parse_cid_range (MMBaseModem              *modem,
+                 CidSelection3gppContext  *ctx,
+                 const gchar              *command,
+                 const gchar              *response,
+                 gboolean                  last_command,
+                 const GError             *error,
+                 GVariant                **result,
+                 GError                  **result_error)
 {
     GError *inner_error = NULL;
-    GList *pdp_list;
-    GList *l;
-    guint cid;
+    GList  *formats;
 
     /* If cancelled, set result error */
     if (g_cancellable_is_cancelled (ctx->cancellable)) {
@@ -805,31 +790,38 @@ parse_pdp_list (MMBaseModem             *modem,
         return FALSE;
     }
 
-    /* Some Android phones don't support querying existing PDP contexts,
-     * but will accept setting the APN.  So if CGDCONT? isn't supported,
-     * just ignore that error and hope for the best. (bgo #637327)
-     */
-    if (g_error_matches (error,
-                         MM_MOBILE_EQUIPMENT_ERROR,
-                         MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED)) {
-        mm_dbg ("Querying PDP context list is unsupported");
-        return FALSE;
+    if (error) {
+        mm_dbg ("Unexpected +CGDCONT error: '%s'", error->message);
+        mm_dbg ("Defaulting to CID=1");
+        ctx->cid = 1;
+        return TRUE;
     }
 
-    if (error) {
-        mm_dbg ("Unexpected +CGDCONT? error: '%s'", error->message);
-        return FALSE;
+    formats = mm_3gpp_parse_cgdcont_test_response (response, &inner_error);
+    if (inner_error) {
+        mm_dbg ("Error parsing +CGDCONT test response: '%s'", inner_error->message);
+        mm_dbg ("Defaulting to CID=1");
+        g_error_free (inner_error);
+        ctx->cid = 1;
+        return TRUE;
     }
 
-    pdp_list = mm_3gpp_parse_cgdcont_read_response (response, &inner_error);
+    /* The supported formats don't change, keep them in the modem */
+    mm_broadband_modem_take_pdp_context_format_list (MM_BROADBAND_MODEM (modem), formats);
+    select_cid_from_format_list (ctx, formats);
+    return TRUE;
+}
+
+static gboolean
+select_cid_from_pdp_list (CidSelection3gppContext *ctx,
+                          GList                   *pdp_list)
+{
+    GList *l;
+    guint  cid;
+
     if (!pdp_list) {
-        if (inner_error) {
-            mm_dbg ("%s", inner_error->message);
-            g_error_free (inner_error);
-        } else {
-            /* No predefined PDP contexts found */
-            mm_dbg ("No PDP contexts found");
-        }
+        /* No predefined PDP contexts found */
+        mm_dbg ("No PDP contexts found");
         return FALSE;
     }
 
@@ -884,7 +876,6 @@ parse_pdp_list (MMBaseModem             *modem,
         if (ctx->max_cid < pdp->cid)
             ctx->max_cid = pdp->cid;
     }
-    mm_3gpp_pdp_context_list_free (pdp_list);
 
     if (cid > 0) {
         ctx->cid = cid;
@@ -894,12 +885,65 @@ parse_pdp_list (MMBaseModem             *modem,
     return FALSE;
 }
 
+static gboolean
+parse_pdp_list (MMBaseModem             *modem,
+                CidSelection3gppContext *ctx,
+                const gchar             *command,
+                const gchar             *response,
+                gboolean                 last_command,
+                const GError            *error,
+                GVariant               **result,
+                GError                 **result_error)
+{
+    GError *inner_error = NULL;
+    GList *pdp_list;
+
+    /* If cancelled, set result error */
+    if (g_cancellable_is_cancelled (ctx->cancellable)) {
+        g_set_error (result_error, MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED,
+                     "Connection setup operation has been cancelled");
+        return FALSE;
+    }
+
+    /* Some Android phones don't support querying existing PDP contexts,
+     * but will accept setting the APN.  So if CGDCONT? isn't supported,
+     * just ignore that error and hope for the best. (bgo #637327)
+     */
+    if (g_error_matches (error,
+                         MM_MOBILE_EQUIPMENT_ERROR,
+                         MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED)) {
+        mm_dbg ("Querying PDP context list is unsupported");
+        return FALSE;
+    }
+
+    if (error) {
+        mm_dbg ("Unexpected +CGDCONT? error: '%s'", error->message);
+        return FALSE;
+    }
+
+    pdp_list = mm_3gpp_parse_cgdcont_read_response (response, &inner_error);
+    if (inner_error) {
+        mm_dbg ("%s", inner_error->message);
+        g_error_free (inner_error);
+        return FALSE;
+    }
+
+    /* The list is now owned by the modem, an empty one is valid as well */
+    mm_broadband_modem_take_pdp_context_list (MM_BROADBAND_MODEM (modem), pdp_list);
+    return select_cid_from_pdp_list (ctx, pdp_list);
+}
+
 static const MMBaseModemAtCommand find_cid_sequence[] = {
     { "+CGDCONT?",  3, FALSE, (MMBaseModemAtResponseProcessor) parse_pdp_list  },
     { "+CGDCONT=?", 3, TRUE,  (MMBaseModemAtResponseProcessor) parse_cid_range },
     { NULL }
 };
 
+static const MMBaseModemAtCommand find_cid_range_sequence[] = {
+    { "+CGDCONT=?", 3, TRUE,  (MMBaseModemAtResponseProcessor) parse_cid_range },
+    { NULL }
+};
+
 static void
 cid_selection_3gpp (MMBroadbandBearer   *self,
                     MMBaseModem         *modem,
@@ -908,8 +952,11 @@ cid_selection_3gpp (MMBroadbandBearer   *self,
                     GAsyncReadyCallback  callback,
                     gpointer             user_data)
 {
-    GTask                   *task;
-    CidSelection3gppContext *ctx;
+    GTask                      *task;
+    CidSelection3gppContext    *ctx;
+    GList                      *pdp_list;
+    GList                      *formats;
+    const MMBaseModemAtCommand *sequence;
 
     ctx = g_slice_new0 (CidSelection3gppContext);
     ctx->self        = g_object_ref (self);
@@ -921,10 +968,29 @@ cid_selection_3gpp (MMBroadbandBearer   *self,
     task = g_task_new (self, cancellable, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify) cid_selection_3gpp_context_free);
 
-    mm_dbg ("Looking for best CID...");
+    sequence = find_cid_sequence;
+    if (mm_broadband_modem_peek_pdp_context_list (MM_BROADBAND_MODEM (modem), &pdp_list)) {
+        mm_dbg ("Looking for best CID in cached PDP contexts...");
+        if (select_cid_from_pdp_list (ctx, pdp_list)) {
+            initialize_pdp_context (task);
+            return;
+        }
+
+        formats = mm_broadband_modem_peek_pdp_context_format_list (MM_BROADBAND_MODEM (modem));
+        if (formats) {
+            select_cid_from_format_list (ctx, formats);
+            initialize_pdp_context (task);
+            return;
+        }
+
+        /* Only the supported formats are needed */
+        sequence = find_cid_range_sequence;
+    } else
+        mm_dbg ("Looking for best CID...");
+
     mm_base_modem_at_sequence_full (ctx->modem,
                                     ctx->primary,
-                                    find_cid_sequence,
+                                    sequence,
                                     ctx, /* also passed as response processor context */
                                     NULL, /* response_processor_context_free */
                                     NULL, /* cancellable */
@@ -938,7 +1004,8 @@ cid_selection_3gpp (MMBroadbandBearer   *self,
  * 3GPP connection procedure of a bearer involves several steps:
  * 1) Get data port from the modem. Default implementation will have only
  *    one single possible data port, but plugins may have more.
- * 2) Decide which PDP context to use
+ * 2) Decide which PDP context to use, from the cached list of contexts if
+ *    available.
  *   2.1) Look for an already existing PDP context with the same APN.
  *   2.2) If none found with the same APN, try to find a PDP context without any
  *        predefined APN.
@@ -1000,8 +1067,11 @@ dial_3gpp_ready (MMBroadbandBearer *self,
 
     ctx->data = MM_BROADBAND_BEARER_GET_CLASS (self)->dial_3gpp_finish (self, res, &error);
     if (!ctx->data) {
-        /* Clear CID when it failed to connect. */
+        /* Clear CID when it failed to connect. The context definition may
+         * have been the reason, so don't trust the cached one any more. */
         self->priv->cid = 0;
+        if (!g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_CANCELLED))
+            mm_broadband_modem_invalidate_pdp_context_list (MM_BROADBAND_MODEM (ctx->modem));
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
@@ -1015,6 +1085,7 @@ dial_3gpp_ready (MMBroadbandBearer *self,
     if (MM_BROADBAND_BEARER_GET_CLASS (self)->get_ip_config_3gpp &&
         MM_BROADBAND_BEARER_GET_CLASS (self)->get_ip_config_3gpp_finish) {
         /* Launch specific IP config retrieval */
+        mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (self), MM_BEARER_CONNECTION_PHASE_IP_CONFIG);
         MM_BROADBAND_BEARER_GET_CLASS (self)->get_ip_config_3gpp (
             self,
             MM_BROADBAND_MODEM (ctx->modem),
@@ -1081,6 +1152,7 @@ cid_selection_3gpp_ready (MMBroadbandBearer *self,
         return;
     }
 
+    mm_base_bearer_trace_connection_phase (MM_BASE_BEARER (self), MM_BEARER_CONNECTION_PHASE_ACTIVATION);
     MM_BROADBAND_BEARER_GET_CLASS (self)->dial_3gpp (self,
                                                      ctx->modem,
                                                      ctx->primary,
@@ -1148,6 +1220,19 @@ connect_succeeded (GTask *task,
      * may already be set as connected, but no big deal. */
     mm_port_set_connected (self->priv->port, TRUE);
 
+    /* Deactivations of the PDP context may be reported with +CGEV */
+    if (connection_type == CONNECTION_TYPE_3GPP && self->priv->cid) {
+        MMBaseModem *modem = NULL;
+
+        g_object_get (self,
+                      MM_BASE_BEARER_MODEM, &modem,
+                      NULL);
+        mm_base_bearer_set_connection_status_indications (
+            MM_BASE_BEARER (self),
+            mm_broadband_modem_get_cgev_deactivations_reliable (MM_BROADBAND_MODEM (modem)));
+        g_object_unref (modem);
+    }
+
     /* Set operation result */
     g_task_return_pointer (task,
                            result,
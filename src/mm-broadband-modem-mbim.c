@@ -158,6 +158,82 @@ peek_device (gpointer self,
     return TRUE;
 }
 
+static gboolean
+peek_port (gpointer             self,
+           MMPortMbim         **o_port,
+           GAsyncReadyCallback  callback,
+           gpointer             user_data)
+{
+    MMPortMbim *port;
+
+    port = mm_base_modem_peek_port_mbim (MM_BASE_MODEM (self));
+    if (!port) {
+        g_task_report_new_error (self,
+                                 callback,
+                                 user_data,
+                                 peek_port,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "Couldn't peek MBIM port");
+        return FALSE;
+    }
+
+    *o_port = port;
+    return TRUE;
+}
+
+/* Drop the shared response of a query whose state was just changed */
+static void
+invalidate_query (gpointer            self,
+                  MbimCidBasicConnect cid)
+{
+    MMPortMbim *port;
+
+    port = mm_base_modem_peek_port_mbim (MM_BASE_MODEM (self));
+    if (port)
+        mm_port_mbim_invalidate_query (port, MBIM_SERVICE_BASIC_CONNECT, cid);
+}
+
+/*****************************************************************************/
+/* Query planning
+ *
+ * The initialization and enabling steps run one after the other, each one
+ * waiting for its own query. The queries known to be needed by those steps
+ * are instead all sent in parallel when the sequence starts, and the steps
+ * get the responses from the port as soon as they are available.
+ */
+
+typedef MbimMessage * (* QueryNewFunc) (GError **error);
+
+static const QueryNewFunc initialization_queries[] = {
+    mbim_message_device_caps_query_new,             /* current capabilities, revisions, equipment id */
+    mbim_message_subscriber_ready_status_query_new, /* unlock required, own numbers, SIM */
+    mbim_message_pin_query_new,                     /* unlock required, unlock retries */
+    mbim_message_radio_state_query_new,             /* power state */
+    mbim_message_home_provider_query_new,           /* SIM */
+};
+
+static const QueryNewFunc enabling_queries[] = {
+    mbim_message_register_state_query_new,          /* registration checks */
+    mbim_message_signal_state_query_new,            /* signal quality */
+};
+
+static void
+prefetch_queries (MMPortMbim         *port,
+                  const QueryNewFunc *queries,
+                  guint               n_queries)
+{
+    guint i;
+
+    for (i = 0; i < n_queries; i++) {
+        MbimMessage *message;
+
+        message = queries[i] (NULL);
+        mm_port_mbim_prefetch_query (port, message, 10);
+        mbim_message_unref (message);
+    }
+}
+
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
 
 static QmiClient *
@@ -208,14 +284,14 @@ typedef struct {
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     MMModemCapability  current_qmi;
 #endif
-    MbimDevice        *device;
+    MMPortMbim        *port;
     MMModemCapability  current_mbim;
 } LoadCurrentCapabilitiesContext;
 
 static void
 load_current_capabilities_context_free (LoadCurrentCapabilitiesContext *ctx)
 {
-    g_object_unref (ctx->device);
+    g_object_unref (ctx->port);
     g_free (ctx);
 }
 
@@ -285,7 +361,7 @@ complete_current_capabilities (GTask *task)
 }
 
 static void
-device_caps_query_ready (MbimDevice *device,
+device_caps_query_ready (MMPortMbim *port,
                          GAsyncResult *res,
                          GTask *task)
 {
@@ -297,7 +373,7 @@ device_caps_query_ready (MbimDevice *device,
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_device_caps_response_parse (
@@ -339,12 +415,11 @@ load_current_capabilities_mbim (GTask *task)
 
     mm_dbg ("loading current capabilities...");
     message = mbim_message_device_caps_query_new (NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)device_caps_query_ready,
-                         task);
+    mm_port_mbim_cached_query (ctx->port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)device_caps_query_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -376,16 +451,16 @@ modem_load_current_capabilities (MMIfaceModem        *self,
                                  GAsyncReadyCallback  callback,
                                  gpointer             user_data)
 {
-    MbimDevice                     *device;
+    MMPortMbim                     *port;
     GTask                          *task;
     LoadCurrentCapabilitiesContext *ctx;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
     ctx = g_new0 (LoadCurrentCapabilitiesContext, 1);
-    ctx->device = g_object_ref (device);
+    ctx->port = g_object_ref (port);
     g_task_set_task_data (task, ctx, (GDestroyNotify) load_current_capabilities_context_free);
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
@@ -882,13 +957,13 @@ modem_load_supported_ip_families (MMIfaceModem *self,
 
 typedef struct {
     guint n_ready_status_checks;
-    MbimDevice *device;
+    MMPortMbim *port;
 } LoadUnlockRequiredContext;
 
 static void
 load_unlock_required_context_free (LoadUnlockRequiredContext *ctx)
 {
-    g_object_unref (ctx->device);
+    g_object_unref (ctx->port);
     g_slice_free (LoadUnlockRequiredContext, ctx);
 }
 
@@ -909,7 +984,7 @@ modem_load_unlock_required_finish (MMIfaceModem *self,
 }
 
 static void
-pin_query_ready (MbimDevice *device,
+pin_query_ready (MMPortMbim *port,
                  GAsyncResult *res,
                  GTask *task)
 {
@@ -918,7 +993,7 @@ pin_query_ready (MbimDevice *device,
     MbimPinType pin_type;
     MbimPinState pin_state;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_response_parse (
@@ -953,7 +1028,7 @@ pin_query_ready (MbimDevice *device,
 static gboolean wait_for_sim_ready (GTask *task);
 
 static void
-unlock_required_subscriber_ready_state_ready (MbimDevice *device,
+unlock_required_subscriber_ready_state_ready (MMPortMbim *port,
                                               GAsyncResult *res,
                                               GTask *task)
 {
@@ -966,7 +1041,7 @@ unlock_required_subscriber_ready_state_ready (MbimDevice *device,
     ctx = g_task_get_task_data (task);
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_subscriber_ready_status_response_parse (
@@ -1022,7 +1097,10 @@ unlock_required_subscriber_ready_state_ready (MbimDevice *device,
                                          "Error waiting for SIM to get initialized");
             g_object_unref (task);
         } else {
-            /* Retry */
+            /* Retry, making sure the state is queried again */
+            mm_port_mbim_invalidate_query (port,
+                                           MBIM_SERVICE_BASIC_CONNECT,
+                                           MBIM_CID_BASIC_CONNECT_SUBSCRIBER_READY_STATUS);
             g_timeout_add_seconds (1, (GSourceFunc)wait_for_sim_ready, task);
         }
     }
@@ -1032,12 +1110,11 @@ unlock_required_subscriber_ready_state_ready (MbimDevice *device,
 
         /* Query which lock is to unlock */
         message = mbim_message_pin_query_new (NULL);
-        mbim_device_command (device,
-                             message,
-                             10,
-                             NULL,
-                             (GAsyncReadyCallback)pin_query_ready,
-                             task);
+        mm_port_mbim_cached_query (port,
+                                   message,
+                                   10,
+                                   (GAsyncReadyCallback)pin_query_ready,
+                                   task);
         mbim_message_unref (message);
     }
     /* Initialized but locked? */
@@ -1059,12 +1136,11 @@ wait_for_sim_ready (GTask *task)
 
     ctx = g_task_get_task_data (task);
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (ctx->device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)unlock_required_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_cached_query (ctx->port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)unlock_required_subscriber_ready_state_ready,
+                               task);
     mbim_message_unref (message);
     return G_SOURCE_REMOVE;
 }
@@ -1075,14 +1151,14 @@ modem_load_unlock_required (MMIfaceModem *self,
                             gpointer user_data)
 {
     LoadUnlockRequiredContext *ctx;
-    MbimDevice *device;
+    MMPortMbim *port;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     ctx = g_slice_new (LoadUnlockRequiredContext);
-    ctx->device = g_object_ref (device);
+    ctx->port = g_object_ref (port);
     ctx->n_ready_status_checks = 10;
 
     task = g_task_new (self, NULL, callback, user_data);
@@ -1103,7 +1179,7 @@ modem_load_unlock_retries_finish (MMIfaceModem *self,
 }
 
 static void
-pin_query_unlock_retries_ready (MbimDevice *device,
+pin_query_unlock_retries_ready (MMPortMbim *port,
                                 GAsyncResult *res,
                                 GTask *task)
 {
@@ -1112,7 +1188,7 @@ pin_query_unlock_retries_ready (MbimDevice *device,
     MbimPinType pin_type;
     guint32 remaining_attempts;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_pin_response_parse (
@@ -1180,22 +1256,21 @@ modem_load_unlock_retries (MMIfaceModem *self,
                            GAsyncReadyCallback callback,
                            gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_pin_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)pin_query_unlock_retries_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)pin_query_unlock_retries_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -1211,7 +1286,7 @@ modem_load_own_numbers_finish (MMIfaceModem *self,
 }
 
 static void
-own_numbers_subscriber_ready_state_ready (MbimDevice *device,
+own_numbers_subscriber_ready_state_ready (MMPortMbim *port,
                                           GAsyncResult *res,
                                           GTask *task)
 {
@@ -1219,7 +1294,7 @@ own_numbers_subscriber_ready_state_ready (MbimDevice *device,
     GError *error = NULL;
     gchar **telephone_numbers;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_subscriber_ready_status_response_parse (
@@ -1246,22 +1321,21 @@ modem_load_own_numbers (MMIfaceModem *self,
                         GAsyncReadyCallback callback,
                         gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)own_numbers_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)own_numbers_subscriber_ready_state_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -1285,7 +1359,7 @@ modem_load_power_state_finish (MMIfaceModem *self,
 }
 
 static void
-radio_state_query_ready (MbimDevice *device,
+radio_state_query_ready (MMPortMbim *port,
                          GAsyncResult *res,
                          GTask *task)
 {
@@ -1294,7 +1368,7 @@ radio_state_query_ready (MbimDevice *device,
     MbimRadioSwitchState hardware_radio_state;
     MbimRadioSwitchState software_radio_state;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_radio_state_response_parse (
@@ -1323,22 +1397,21 @@ modem_load_power_state (MMIfaceModem *self,
                         GAsyncReadyCallback callback,
                         gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_radio_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)radio_state_query_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)radio_state_query_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -1446,6 +1519,10 @@ radio_state_set_up_ready (MbimDevice *device,
     MbimRadioSwitchState software_radio_state;
 
     ctx = g_task_get_task_data (task);
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_RADIO_STATE);
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_REGISTER_STATE);
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_SIGNAL_STATE);
+
     response = mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
@@ -1469,6 +1546,13 @@ radio_state_set_up_ready (MbimDevice *device,
 
     /* Nice! we're done, quick exit */
     if (!error) {
+        MMPortMbim *port;
+
+        /* Radio is on, the enabling steps will need these */
+        port = mm_base_modem_peek_port_mbim (MM_BASE_MODEM (g_task_get_source_object (task)));
+        if (port)
+            prefetch_queries (port, enabling_queries, G_N_ELEMENTS (enabling_queries));
+
         ctx->step = POWER_UP_CONTEXT_STEP_LAST;
         power_up_context_step (task);
         return;
@@ -1594,6 +1678,10 @@ radio_state_set_down_ready (MbimDevice *device,
     MbimMessage *response;
     GError *error = NULL;
 
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_RADIO_STATE);
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_REGISTER_STATE);
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_SIGNAL_STATE);
+
     response = mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
@@ -1646,7 +1734,7 @@ modem_load_signal_quality_finish (MMIfaceModem *self,
 }
 
 static void
-signal_state_query_ready (MbimDevice *device,
+signal_state_query_ready (MMPortMbim *port,
                           GAsyncResult *res,
                           GTask *task)
 {
@@ -1654,7 +1742,7 @@ signal_state_query_ready (MbimDevice *device,
     GError *error = NULL;
     guint32 rssi;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_signal_state_response_parse (
@@ -1685,22 +1773,21 @@ modem_load_signal_quality (MMIfaceModem *self,
                            GAsyncReadyCallback callback,
                            gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_signal_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)signal_state_query_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)signal_state_query_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -2074,6 +2161,9 @@ query_device_services (GTask *task)
     device = mm_port_mbim_peek_device (ctx->mbim);
     g_assert (device);
 
+    /* Get the upcoming initialization steps going in the meantime */
+    prefetch_queries (ctx->mbim, initialization_queries, G_N_ELEMENTS (initialization_queries));
+
     mm_dbg ("querying device services...");
     message = mbim_message_device_services_query_new (NULL);
     mbim_device_command (device,
@@ -3833,7 +3923,7 @@ atds_location_query_ready (MbimDevice   *device,
 }
 
 static void
-register_state_query_ready (MbimDevice   *device,
+register_state_query_ready (MMPortMbim   *port,
                             GAsyncResult *res,
                             GTask        *task)
 {
@@ -3845,7 +3935,7 @@ register_state_query_ready (MbimDevice   *device,
     gchar                *provider_id;
     gchar                *provider_name;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (!response ||
         !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
         !mbim_message_register_state_response_parse (
@@ -3877,7 +3967,7 @@ register_state_query_ready (MbimDevice   *device,
 
         message = mbim_message_atds_location_query_new (NULL);
 
-        mbim_device_command (device,
+        mbim_device_command (mm_port_mbim_peek_device (port),
                              message,
                              10,
                              NULL,
@@ -3903,22 +3993,21 @@ modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
                                     GAsyncReadyCallback  callback,
                                     gpointer             user_data)
 {
-    MbimDevice  *device;
+    MMPortMbim  *port;
     MbimMessage *message;
     GTask       *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_register_state_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)register_state_query_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)register_state_query_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -3946,6 +4035,8 @@ register_state_set_ready (MbimDevice *device,
     GError *error = NULL;
     MbimNwError nw_error;
 
+    invalidate_query (g_task_get_source_object (task), MBIM_CID_BASIC_CONNECT_REGISTER_STATE);
+
     response = mbim_device_command_finish (device, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
@@ -5389,6 +5480,8 @@ iface_modem_messaging_init (MMIfaceModemMessaging *iface)
     iface->setup_sms_format_finish = NULL;
     iface->set_default_storage = NULL;
     iface->set_default_storage_finish = NULL;
+    iface->set_more_messages_to_send = NULL;
+    iface->set_more_messages_to_send_finish = NULL;
     iface->init_current_storages = NULL;
     iface->init_current_storages_finish = NULL;
     iface->load_initial_sms_parts = load_initial_sms_parts;
@@ -72,6 +72,27 @@ G_DEFINE_TYPE_EXTENDED (MMBroadbandModemQmi, mm_broadband_modem_qmi, MM_TYPE_BRO
                         G_IMPLEMENT_INTERFACE (MM_TYPE_IFACE_MODEM_FIRMWARE, iface_modem_firmware_init)
                         G_IMPLEMENT_INTERFACE (MM_TYPE_SHARED_QMI, shared_qmi_init))
 
+/* Independent DMS requests sent while loading modem properties */
+typedef enum {
+    DMS_REQUEST_MANUFACTURER,
+    DMS_REQUEST_MODEL,
+    DMS_REQUEST_REVISION,
+    DMS_REQUEST_HARDWARE_REVISION,
+    DMS_REQUEST_IDS,
+    DMS_REQUEST_MSISDN,
+    DMS_REQUEST_OPERATING_MODE,
+    DMS_REQUEST_LAST
+} DmsRequest;
+
+typedef struct {
+    /* Tasks waiting for the response of the request in flight */
+    gboolean  in_flight;
+    GList    *waiters;
+    /* Successful response received without anyone waiting for it */
+    gpointer  output;
+    gint64    output_time;
+} DmsRequestState;
+
 struct _MMBroadbandModemQmiPrivate {
     /* Cached device IDs, retrieved by the modem interface when loading device
      * IDs, and used afterwards in the 3GPP and CDMA interfaces. */
@@ -82,6 +103,9 @@ struct _MMBroadbandModemQmiPrivate {
     /* Cached supported frequency bands; in order to handle ANY */
     GArray *supported_bands;
 
+    /* Shared and prefetched DMS requests */
+    DmsRequestState dms_requests[DMS_REQUEST_LAST];
+
     /* 3GPP and CDMA share unsolicited events setup/enable/disable/cleanup */
     gboolean unsolicited_events_enabled;
     gboolean unsolicited_events_setup;
@@ -190,6 +214,222 @@ modem_create_bearer (MMIfaceModem *self,
     g_object_unref (task);
 }
 
+/*****************************************************************************/
+/* Shared DMS requests
+ *
+ * Most of the modem properties are loaded with independent DMS requests,
+ * one after the other. When the first of them is loaded, all the others are
+ * sent in parallel, and each loader later takes the response already
+ * received instead of sending the request again. Loaders running while the
+ * same request is in flight are all served by that single transaction.
+ *
+ * Only successful responses are kept, and just for a few seconds, so that
+ * later loads (e.g. the power state when enabling) still query the device.
+ */
+
+#define DMS_REQUEST_TIMEOUT_SECS          5
+#define DMS_REQUEST_OUTPUT_VALIDITY_SECS 10
+
+typedef void     (* DmsRequestFunc)       (QmiClientDms         *client,
+                                           gpointer              unused,
+                                           guint                 timeout,
+                                           GCancellable         *cancellable,
+                                           GAsyncReadyCallback   callback,
+                                           gpointer              user_data);
+typedef gpointer (* DmsRequestFinishFunc) (QmiClientDms         *client,
+                                           GAsyncResult         *res,
+                                           GError              **error);
+typedef gboolean (* DmsOutputResultFunc)  (gpointer              output,
+                                           GError              **error);
+typedef gpointer (* DmsOutputRefFunc)     (gpointer              output);
+
+typedef struct {
+    const gchar          *name;
+    DmsRequestFunc        run;
+    DmsRequestFinishFunc  finish;
+    DmsOutputResultFunc   get_result;
+    DmsOutputRefFunc      ref;
+    GDestroyNotify        unref;
+} DmsRequestInfo;
+
+#define DMS_REQUEST_INFO(NAME, method)                                      \
+    {                                                                       \
+        NAME,                                                               \
+        (DmsRequestFunc)       qmi_client_dms_##method,                     \
+        (DmsRequestFinishFunc) qmi_client_dms_##method##_finish,            \
+        (DmsOutputResultFunc)  qmi_message_dms_##method##_output_get_result, \
+        (DmsOutputRefFunc)     qmi_message_dms_##method##_output_ref,       \
+        (GDestroyNotify)       qmi_message_dms_##method##_output_unref,     \
+    }
+
+static const DmsRequestInfo dms_request_info[DMS_REQUEST_LAST] = {
+    [DMS_REQUEST_MANUFACTURER]      = DMS_REQUEST_INFO ("Get Manufacturer",      get_manufacturer),
+    [DMS_REQUEST_MODEL]             = DMS_REQUEST_INFO ("Get Model",             get_model),
+    [DMS_REQUEST_REVISION]          = DMS_REQUEST_INFO ("Get Revision",          get_revision),
+    [DMS_REQUEST_HARDWARE_REVISION] = DMS_REQUEST_INFO ("Get Hardware Revision", get_hardware_revision),
+    [DMS_REQUEST_IDS]               = DMS_REQUEST_INFO ("Get IDs",               get_ids),
+    [DMS_REQUEST_MSISDN]            = DMS_REQUEST_INFO ("Get MSISDN",            get_msisdn),
+    [DMS_REQUEST_OPERATING_MODE]    = DMS_REQUEST_INFO ("Get Operating Mode",    get_operating_mode),
+};
+
+typedef struct {
+    MMBroadbandModemQmi *self;
+    DmsRequest           request;
+    GTimer              *timer;
+} DmsRequestContext;
+
+static void
+dms_request_state_clear_output (DmsRequestState *state,
+                                DmsRequest       request)
+{
+    if (state->output) {
+        dms_request_info[request].unref (state->output);
+        state->output = NULL;
+    }
+}
+
+static void
+dms_request_ready (QmiClientDms      *client,
+                   GAsyncResult      *res,
+                   DmsRequestContext *ctx)
+{
+    const DmsRequestInfo *info;
+    DmsRequestState      *state;
+    gpointer              output;
+    GError               *error = NULL;
+    GList                *waiters;
+    GList                *l;
+
+    info  = &dms_request_info[ctx->request];
+    state = &ctx->self->priv->dms_requests[ctx->request];
+
+    output = info->finish (client, res, &error);
+    mm_dbg ("DMS %s response received in %.3lf seconds%s",
+            info->name, g_timer_elapsed (ctx->timer, NULL), output ? "" : " (failed)");
+
+    waiters = state->waiters;
+    state->waiters = NULL;
+    state->in_flight = FALSE;
+
+    if (!waiters) {
+        /* Prefetched; keep the response only if it is usable */
+        if (output && info->get_result (output, NULL)) {
+            dms_request_state_clear_output (state, ctx->request);
+            state->output = info->ref (output);
+            state->output_time = g_get_monotonic_time ();
+        }
+    } else {
+        for (l = waiters; l; l = g_list_next (l)) {
+            GTask *task = l->data;
+
+            if (output)
+                g_task_return_pointer (task, info->ref (output), info->unref);
+            else
+                g_task_return_error (task, g_error_copy (error));
+            g_object_unref (task);
+        }
+        g_list_free (waiters);
+    }
+
+    if (output)
+        info->unref (output);
+    if (error)
+        g_error_free (error);
+    g_timer_destroy (ctx->timer);
+    g_object_unref (ctx->self);
+    g_slice_free (DmsRequestContext, ctx);
+}
+
+static void
+dms_request_start (MMBroadbandModemQmi *self,
+                   QmiClient           *client,
+                   DmsRequest           request)
+{
+    DmsRequestContext *ctx;
+
+    ctx = g_slice_new (DmsRequestContext);
+    ctx->self = g_object_ref (self);
+    ctx->request = request;
+    ctx->timer = g_timer_new ();
+
+    self->priv->dms_requests[request].in_flight = TRUE;
+    dms_request_info[request].run (QMI_CLIENT_DMS (client),
+                                  NULL,
+                                  DMS_REQUEST_TIMEOUT_SECS,
+                                  NULL,
+                                  (GAsyncReadyCallback)dms_request_ready,
+                                  ctx);
+}
+
+static gboolean
+dms_request_peek_output (MMBroadbandModemQmi *self,
+                         DmsRequest           request)
+{
+    DmsRequestState *state;
+
+    state = &self->priv->dms_requests[request];
+    if (state->output &&
+        (g_get_monotonic_time () - state->output_time) > (DMS_REQUEST_OUTPUT_VALIDITY_SECS * G_USEC_PER_SEC)) {
+        mm_dbg ("Discarding outdated DMS %s response", dms_request_info[request].name);
+        dms_request_state_clear_output (state, request);
+    }
+    return !!state->output;
+}
+
+static void
+dms_request_prefetch (MMBroadbandModemQmi *self,
+                      QmiClient           *client)
+{
+    DmsRequest request;
+    guint      n_started = 0;
+
+    for (request = 0; request < DMS_REQUEST_LAST; request++) {
+        if (self->priv->dms_requests[request].in_flight ||
+            dms_request_peek_output (self, request))
+            continue;
+        dms_request_start (self, client, request);
+        n_started++;
+    }
+
+    if (n_started)
+        mm_dbg ("Prefetching %u DMS responses...", n_started);
+}
+
+/* Returns a new reference to the request output */
+static gpointer
+dms_request_finish (MMBroadbandModemQmi  *self,
+                    GAsyncResult         *res,
+                    GError              **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+dms_request (MMBroadbandModemQmi *self,
+             QmiClient           *client,
+             DmsRequest           request,
+             GAsyncReadyCallback  callback,
+             gpointer             user_data)
+{
+    DmsRequestState *state;
+    GTask           *task;
+
+    state = &self->priv->dms_requests[request];
+    task = g_task_new (self, NULL, callback, user_data);
+
+    /* Prefetched responses are given to a single loader */
+    if (dms_request_peek_output (self, request)) {
+        g_task_return_pointer (task, state->output, dms_request_info[request].unref);
+        state->output = NULL;
+        g_object_unref (task);
+        return;
+    }
+
+    state->waiters = g_list_append (state->waiters, task);
+    if (!state->in_flight)
+        dms_request_start (self, client, request);
+}
+
 /*****************************************************************************/
 /* Manufacturer loading (Modem interface) */
 
@@ -202,14 +442,14 @@ modem_load_manufacturer_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_manufacturer_ready (QmiClientDms *client,
+dms_get_manufacturer_ready (MMBroadbandModemQmi *self,
                             GAsyncResult *res,
                             GTask *task)
 {
     QmiMessageDmsGetManufacturerOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_manufacturer_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -241,13 +481,15 @@ modem_load_manufacturer (MMIfaceModem *self,
                                       callback, user_data))
         return;
 
+    /* First of the DMS based loaders; send all the others right away */
+    dms_request_prefetch (MM_BROADBAND_MODEM_QMI (self), client);
+
     mm_dbg ("loading manufacturer...");
-    qmi_client_dms_get_manufacturer (QMI_CLIENT_DMS (client),
-                                     NULL,
-                                     5,
-                                     NULL,
-                                     (GAsyncReadyCallback)dms_get_manufacturer_ready,
-                                     g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_MANUFACTURER,
+                 (GAsyncReadyCallback)dms_get_manufacturer_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -262,14 +504,14 @@ modem_load_model_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_model_ready (QmiClientDms *client,
+dms_get_model_ready (MMBroadbandModemQmi *self,
                      GAsyncResult *res,
                      GTask *task)
 {
     QmiMessageDmsGetModelOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_model_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -302,12 +544,11 @@ modem_load_model (MMIfaceModem *self,
         return;
 
     mm_dbg ("loading model...");
-    qmi_client_dms_get_model (QMI_CLIENT_DMS (client),
-                              NULL,
-                              5,
-                              NULL,
-                              (GAsyncReadyCallback)dms_get_model_ready,
-                              g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_MODEL,
+                 (GAsyncReadyCallback)dms_get_model_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -322,14 +563,14 @@ modem_load_revision_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_revision_ready (QmiClientDms *client,
+dms_get_revision_ready (MMBroadbandModemQmi *self,
                         GAsyncResult *res,
                         GTask *task)
 {
     QmiMessageDmsGetRevisionOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_revision_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -362,12 +603,11 @@ modem_load_revision (MMIfaceModem *self,
         return;
 
     mm_dbg ("loading revision...");
-    qmi_client_dms_get_revision (QMI_CLIENT_DMS (client),
-                                 NULL,
-                                 5,
-                                 NULL,
-                                 (GAsyncReadyCallback)dms_get_revision_ready,
-                                 g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_REVISION,
+                 (GAsyncReadyCallback)dms_get_revision_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -382,14 +622,14 @@ modem_load_hardware_revision_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_hardware_revision_ready (QmiClientDms *client,
+dms_get_hardware_revision_ready (MMBroadbandModemQmi *self,
                                  GAsyncResult *res,
                                  GTask *task)
 {
     QmiMessageDmsGetHardwareRevisionOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_hardware_revision_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -422,12 +662,11 @@ modem_load_hardware_revision (MMIfaceModem *self,
         return;
 
     mm_dbg ("loading hardware revision...");
-    qmi_client_dms_get_hardware_revision (QMI_CLIENT_DMS (client),
-                                          NULL,
-                                          5,
-                                          NULL,
-                                          (GAsyncReadyCallback)dms_get_hardware_revision_ready,
-                                          g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_HARDWARE_REVISION,
+                 (GAsyncReadyCallback)dms_get_hardware_revision_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -442,17 +681,16 @@ modem_load_equipment_identifier_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_ids_ready (QmiClientDms *client,
+dms_get_ids_ready (MMBroadbandModemQmi *self,
                    GAsyncResult *res,
                    GTask *task)
 {
-    MMBroadbandModemQmi *self;
     QmiMessageDmsGetIdsOutput *output = NULL;
     GError *error = NULL;
     const gchar *str;
     guint len;
 
-    output = qmi_client_dms_get_ids_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -468,8 +706,6 @@ dms_get_ids_ready (QmiClientDms *client,
         return;
     }
 
-    self = g_task_get_source_object (task);
-
     /* In order:
      * If we have a IMEI, use it...
      * Otherwise, if we have a ESN, use it...
@@ -533,12 +769,11 @@ modem_load_equipment_identifier (MMIfaceModem *self,
         return;
 
     mm_dbg ("loading equipment identifier...");
-    qmi_client_dms_get_ids (QMI_CLIENT_DMS (client),
-                            NULL,
-                            5,
-                            NULL,
-                            (GAsyncReadyCallback)dms_get_ids_ready,
-                            g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_IDS,
+                 (GAsyncReadyCallback)dms_get_ids_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -583,14 +818,14 @@ modem_load_own_numbers_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_msisdn_ready (QmiClientDms *client,
+dms_get_msisdn_ready (MMBroadbandModemQmi *self,
                       GAsyncResult *res,
                       GTask *task)
 {
     QmiMessageDmsGetMsisdnOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_msisdn_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -626,12 +861,11 @@ modem_load_own_numbers (MMIfaceModem *self,
         return;
 
     mm_dbg ("loading own numbers...");
-    qmi_client_dms_get_msisdn (QMI_CLIENT_DMS (client),
-                               NULL,
-                               5,
-                               NULL,
-                               (GAsyncReadyCallback)dms_get_msisdn_ready,
-                               g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_MSISDN,
+                 (GAsyncReadyCallback)dms_get_msisdn_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -1933,14 +2167,14 @@ load_power_state_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_operating_mode_ready (QmiClientDms *client,
+dms_get_operating_mode_ready (MMBroadbandModemQmi *self,
                               GAsyncResult *res,
                               GTask *task)
 {
     QmiMessageDmsGetOperatingModeOutput *output = NULL;
     GError *error = NULL;
 
-    output = qmi_client_dms_get_operating_mode_finish (client, res, &error);
+    output = dms_request_finish (self, res, &error);
     if (!output) {
         g_prefix_error (&error, "QMI operation failed: ");
         g_task_return_error (task, error);
@@ -1994,12 +2228,11 @@ load_power_state (MMIfaceModem *self,
         return;
 
     mm_dbg ("Getting device operating mode...");
-    qmi_client_dms_get_operating_mode (QMI_CLIENT_DMS (client),
-                                       NULL,
-                                       5,
-                                       NULL,
-                                       (GAsyncReadyCallback)dms_get_operating_mode_ready,
-                                       g_task_new (self, NULL, callback, user_data));
+    dms_request (MM_BROADBAND_MODEM_QMI (self),
+                 client,
+                 DMS_REQUEST_OPERATING_MODE,
+                 (GAsyncReadyCallback)dms_get_operating_mode_ready,
+                 g_task_new (self, NULL, callback, user_data));
 }
 
 /*****************************************************************************/
@@ -8516,6 +8749,7 @@ static void
 finalize (GObject *object)
 {
     MMPortQmi *qmi;
+    DmsRequest i;
     MMBroadbandModemQmi *self = MM_BROADBAND_MODEM_QMI (object);
 
     qmi = mm_base_modem_peek_port_qmi (MM_BASE_MODEM (self));
@@ -8527,6 +8761,9 @@ finalize (GObject *object)
             mm_port_qmi_close (qmi);
     }
 
+    for (i = 0; i < DMS_REQUEST_LAST; i++)
+        dms_request_state_clear_output (&self->priv->dms_requests[i], i);
+
     g_free (self->priv->imei);
     g_free (self->priv->meid);
     g_free (self->priv->esn);
@@ -8725,6 +8962,8 @@ iface_modem_messaging_init (MMIfaceModemMessaging *iface)
     iface->setup_sms_format_finish = modem_messaging_setup_sms_format_finish;
     iface->set_default_storage = messaging_set_default_storage;
     iface->set_default_storage_finish = messaging_set_default_storage_finish;
+    iface->set_more_messages_to_send = NULL;
+    iface->set_more_messages_to_send_finish = NULL;
     iface->load_initial_sms_parts = load_initial_sms_parts;
     iface->load_initial_sms_parts_finish = load_initial_sms_parts_finish;
     iface->setup_unsolicited_events = messaging_setup_unsolicited_events;
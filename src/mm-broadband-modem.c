@@ -119,6 +119,7 @@ enum {
     PROP_MODEM_SIM_HOT_SWAP_SUPPORTED,
     PROP_MODEM_SIM_HOT_SWAP_CONFIGURED,
     PROP_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED,
+    PROP_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE,
     PROP_FLOW_CONTROL,
     PROP_LAST
 };
@@ -139,6 +140,7 @@ struct _MMBroadbandModemPrivate {
     gboolean sim_hot_swap_supported;
     gboolean sim_hot_swap_configured;
     gboolean periodic_signal_check_disabled;
+    gboolean connection_status_indications_unreliable;
 
     /*<--- Modem interface --->*/
     /* Properties */
@@ -160,7 +162,15 @@ struct _MMBroadbandModemPrivate {
     MM3gppCmerInd modem_cmer_ind;
     gboolean modem_cgerep_support_checked;
     gboolean modem_cgerep_supported;
+    gboolean modem_cgerep_enabled;
+    /* Whether context deactivations reported with +CGEV include the cid */
+    gboolean modem_cgev_deact_cid_reported;
+    gboolean modem_cgev_deact_cid_missing;
     MMFlowControl flow_control;
+    /* Cached +CGDCONT? and +CGDCONT=? replies */
+    gboolean pdp_context_list_valid;
+    GList *pdp_context_list;
+    GList *pdp_context_format_list;
 
     /*<--- Modem 3GPP interface --->*/
     /* Properties */
@@ -2655,6 +2665,117 @@ modem_load_access_technologies (MMIfaceModem *self,
     g_object_unref (task);
 }
 
+/*****************************************************************************/
+/* PDP context cache
+ *
+ * Bearers select the PDP context to use from the +CGDCONT? and +CGDCONT=?
+ * replies; those are kept here so that a reconnection doesn't need to
+ * query them again. The list of contexts is updated with the contexts
+ * defined by the bearers themselves, and dropped whenever it may no longer
+ * be accurate: SIM change, context definitions from outside the bearers,
+ * or network events we don't track in detail. The list of supported
+ * formats only depends on the device, so it is kept for the whole lifetime
+ * of the modem.
+ */
+
+gboolean
+mm_broadband_modem_peek_pdp_context_list (MMBroadbandModem  *self,
+                                          GList            **pdp_list)
+{
+    if (!self->priv->pdp_context_list_valid)
+        return FALSE;
+
+    *pdp_list = self->priv->pdp_context_list;
+    return TRUE;
+}
+
+void
+mm_broadband_modem_take_pdp_context_list (MMBroadbandModem *self,
+                                          GList            *pdp_list)
+{
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
+    self->priv->pdp_context_list = pdp_list;
+    self->priv->pdp_context_list_valid = TRUE;
+}
+
+static gint
+pdp_context_cmp_cid (const MM3gppPdpContext *a,
+                     const MM3gppPdpContext *b)
+{
+    return ((gint) a->cid - (gint) b->cid);
+}
+
+void
+mm_broadband_modem_update_pdp_context (MMBroadbandModem *self,
+                                       guint             cid,
+                                       MMBearerIpFamily  pdp_type,
+                                       const gchar      *apn)
+{
+    MM3gppPdpContext *pdp = NULL;
+    GList            *l;
+
+    if (!self->priv->pdp_context_list_valid)
+        return;
+
+    for (l = self->priv->pdp_context_list; l; l = g_list_next (l)) {
+        if (((MM3gppPdpContext *) l->data)->cid == cid) {
+            pdp = l->data;
+            break;
+        }
+    }
+
+    if (!pdp) {
+        pdp = g_slice_new0 (MM3gppPdpContext);
+        pdp->cid = cid;
+        self->priv->pdp_context_list = g_list_insert_sorted (self->priv->pdp_context_list,
+                                                             pdp,
+                                                             (GCompareFunc) pdp_context_cmp_cid);
+    }
+
+    pdp->pdp_type = pdp_type;
+    g_free (pdp->apn);
+    pdp->apn = g_strdup (apn);
+}
+
+void
+mm_broadband_modem_invalidate_pdp_context_list (MMBroadbandModem *self)
+{
+    if (!self->priv->pdp_context_list_valid)
+        return;
+
+    mm_dbg ("Cached PDP context list invalidated");
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
+    self->priv->pdp_context_list = NULL;
+    self->priv->pdp_context_list_valid = FALSE;
+}
+
+static gboolean
+pdp_context_list_has_cid (MMBroadbandModem *self,
+                          guint             cid)
+{
+    GList *l;
+
+    for (l = self->priv->pdp_context_list; l; l = g_list_next (l)) {
+        if (((MM3gppPdpContext *) l->data)->cid == cid)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+GList *
+mm_broadband_modem_peek_pdp_context_format_list (MMBroadbandModem *self)
+{
+    return self->priv->pdp_context_format_list;
+}
+
+void
+mm_broadband_modem_take_pdp_context_format_list (MMBroadbandModem *self,
+                                                 GList            *format_list)
+{
+    mm_3gpp_pdp_context_format_list_free (self->priv->pdp_context_format_list);
+    self->priv->pdp_context_format_list = format_list;
+}
+
 /*****************************************************************************/
 /* Setup/Cleanup unsolicited events (3GPP interface) */
 
@@ -2707,6 +2828,44 @@ bearer_list_report_disconnections (MMBroadbandModem *self,
     g_object_unref (list);
 }
 
+static void
+bearer_poll_connection_status (MMBaseBearer *bearer)
+{
+    /* Only AT bearers rely on +CGEV */
+    if (MM_IS_BROADBAND_BEARER (bearer))
+        mm_base_bearer_set_connection_status_indications (bearer, FALSE);
+}
+
+/* Connection monitoring only relies on +CGEV once a context deactivation has
+ * been reported with its cid, as some modems never send them, or send them
+ * without the cid; in the latter case the bearers can't rely on them at all */
+static void
+cgev_deactivation_reported (MMBroadbandModem *self,
+                            guint             cid)
+{
+    MMBearerList *list = NULL;
+
+    if (cid) {
+        self->priv->modem_cgev_deact_cid_reported = TRUE;
+        return;
+    }
+
+    if (self->priv->modem_cgev_deact_cid_missing)
+        return;
+
+    mm_dbg ("+CGEV context deactivations reported without cid: polling connection status");
+    self->priv->modem_cgev_deact_cid_missing = TRUE;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_BEARER_LIST, &list,
+                  NULL);
+    if (!list)
+        return;
+
+    mm_bearer_list_foreach (list, (MMBearerListForeachFunc)bearer_poll_connection_status, NULL);
+    g_object_unref (list);
+}
+
 static void
 cgev_process_detach (MMBroadbandModem *self,
                      MM3gppCgev        type)
@@ -2739,6 +2898,10 @@ cgev_process_primary (MMBroadbandModem *self,
         return;
     }
 
+    /* Contexts may be defined on the fly, e.g. by the network on attach */
+    if (self->priv->pdp_context_list_valid && !pdp_context_list_has_cid (self, cid))
+        mm_broadband_modem_invalidate_pdp_context_list (self);
+
     switch (type) {
     case MM_3GPP_CGEV_NW_ACT_PRIMARY:
         mm_info ("network request to activate context (cid %u)", cid);
@@ -2748,10 +2911,12 @@ cgev_process_primary (MMBroadbandModem *self,
         break;
     case MM_3GPP_CGEV_NW_DEACT_PRIMARY:
         mm_info ("network request to deactivate context (cid %u)", cid);
+        cgev_deactivation_reported (self, cid);
         bearer_list_report_disconnections (self, cid);
         break;
     case MM_3GPP_CGEV_ME_DEACT_PRIMARY:
         mm_info ("mobile equipment request to deactivate context (cid %u)", cid);
+        cgev_deactivation_reported (self, cid);
         bearer_list_report_disconnections (self, cid);
         break;
     default:
@@ -2775,6 +2940,9 @@ cgev_process_secondary (MMBroadbandModem *self,
         return;
     }
 
+    if (self->priv->pdp_context_list_valid && !pdp_context_list_has_cid (self, cid))
+        mm_broadband_modem_invalidate_pdp_context_list (self);
+
     switch (type) {
     case MM_3GPP_CGEV_NW_ACT_SECONDARY:
         mm_info ("network request to activate secondary context (cid %u, primary cid %u)", cid, p_cid);
@@ -2784,10 +2952,12 @@ cgev_process_secondary (MMBroadbandModem *self,
         break;
     case MM_3GPP_CGEV_NW_DEACT_SECONDARY:
         mm_info ("network request to deactivate secondary context (cid %u, primary cid %u)", cid, p_cid);
+        cgev_deactivation_reported (self, cid);
         bearer_list_report_disconnections (self, cid);
         break;
     case MM_3GPP_CGEV_ME_DEACT_SECONDARY:
         mm_info ("mobile equipment request to deactivate secondary context (cid %u, primary cid %u)", cid, p_cid);
+        cgev_deactivation_reported (self, cid);
         bearer_list_report_disconnections (self, cid);
         break;
     default:
@@ -2817,6 +2987,8 @@ cgev_process_pdp (MMBroadbandModem *self,
         mm_info ("network request to activate context (type %s, address %s) has been automatically rejected", pdp_type, pdp_addr);
         break;
     case MM_3GPP_CGEV_NW_REACT:
+        /* The network may have updated the context definition */
+        mm_broadband_modem_invalidate_pdp_context_list (self);
         /* NOTE: we don't currently notify about automatic reconnections like this one */
         if (cid)
             mm_info ("network request to reactivate context (type %s, address %s, cid %u)", pdp_type, pdp_addr, cid);
@@ -2824,6 +2996,7 @@ cgev_process_pdp (MMBroadbandModem *self,
             mm_info ("network request to reactivate context (type %s, address %s, cid unknown)", pdp_type, pdp_addr);
         break;
     case MM_3GPP_CGEV_NW_DEACT_PDP:
+        cgev_deactivation_reported (self, cid);
         if (cid) {
             mm_info ("network request to deactivate context (type %s, address %s, cid %u)", pdp_type, pdp_addr, cid);
             bearer_list_report_disconnections (self, cid);
@@ -2831,6 +3004,7 @@ cgev_process_pdp (MMBroadbandModem *self,
             mm_info ("network request to deactivate context (type %s, address %s, cid unknown)", pdp_type, pdp_addr);
         break;
     case MM_3GPP_CGEV_ME_DEACT_PDP:
+        cgev_deactivation_reported (self, cid);
         if (cid) {
             mm_info ("mobile equipment request to deactivate context (type %s, address %s, cid %u)", pdp_type, pdp_addr, cid);
             bearer_list_report_disconnections (self, cid);
@@ -2883,10 +3057,13 @@ cgev_received (MMPortSerialAt   *port,
     case MM_3GPP_CGEV_NW_REACT:
         cgev_process_pdp (self, type, str);
         break;
-    case MM_3GPP_CGEV_NW_CLASS:
-    case MM_3GPP_CGEV_ME_CLASS:
     case MM_3GPP_CGEV_NW_MODIFY:
     case MM_3GPP_CGEV_ME_MODIFY:
+        /* The context parameters may have changed */
+        mm_broadband_modem_invalidate_pdp_context_list (self);
+        break;
+    case MM_3GPP_CGEV_NW_CLASS:
+    case MM_3GPP_CGEV_ME_CLASS:
         /* ignore */
         break;
     default:
@@ -3250,6 +3427,7 @@ typedef struct {
     gchar          *cgerep_command;
     gboolean        cgerep_primary_done;
     gboolean        cgerep_secondary_done;
+    gboolean        cgerep_running;
 } UnsolicitedEventsContext;
 
 static void
@@ -3289,7 +3467,8 @@ unsolicited_events_setup_ready (MMBroadbandModem *self,
                 ctx->enable ? "enable" : "disable",
                 error->message);
         g_error_free (error);
-    }
+    } else if (ctx->enable && ctx->cgerep_running)
+        self->priv->modem_cgerep_enabled = TRUE;
 
     /* Continue on next port/command */
     run_unsolicited_events_setup (task);
@@ -3337,6 +3516,7 @@ run_unsolicited_events_setup (GTask *task)
 
     /* Enable unsolicited events in given port */
     if (port && command) {
+        ctx->cgerep_running = (command == ctx->cgerep_command);
         mm_base_modem_at_command_full (MM_BASE_MODEM (self),
                                        port,
                                        command,
@@ -3396,6 +3576,9 @@ modem_3gpp_disable_unsolicited_events (MMIfaceModem3gpp *_self,
     ctx->secondary = mm_base_modem_get_port_secondary (MM_BASE_MODEM (self));
     g_task_set_task_data (task, ctx, (GDestroyNotify)unsolicited_events_context_free);
 
+    /* No longer rely on +CGEV reports, even if disabling them fails */
+    self->priv->modem_cgerep_enabled = FALSE;
+
     if (self->priv->modem_cind_support_checked && self->priv->modem_cind_supported)
         ctx->cmer_command = mm_3gpp_build_cmer_set_request (self->priv->modem_cmer_disable_mode, MM_3GPP_CMER_IND_NONE);
 
@@ -4006,6 +4189,13 @@ modem_command (MMIfaceModem *self,
                GAsyncReadyCallback callback,
                gpointer user_data)
 {
+    gchar *cmd_up;
+
+    /* Contexts defined by the user are not tracked */
+    cmd_up = g_ascii_strup (cmd, -1);
+    if (strstr (cmd_up, "+CGDCONT="))
+        mm_broadband_modem_invalidate_pdp_context_list (MM_BROADBAND_MODEM (self));
+    g_free (cmd_up);
 
     mm_base_modem_at_command (MM_BASE_MODEM (self), cmd, timeout,
                               FALSE,
@@ -6390,6 +6580,33 @@ modem_messaging_set_default_storage (MMIfaceModemMessaging *_self,
     g_free (cmd);
 }
 
+/*****************************************************************************/
+/* Keep the SMS relay link open (Messaging interface) */
+
+static gboolean
+modem_messaging_set_more_messages_to_send_finish (MMIfaceModemMessaging *self,
+                                                  GAsyncResult *res,
+                                                  GError **error)
+{
+    return !!mm_base_modem_at_command_finish (MM_BASE_MODEM (self), res, error);
+}
+
+static void
+modem_messaging_set_more_messages_to_send (MMIfaceModemMessaging *self,
+                                           gboolean enable,
+                                           GAsyncReadyCallback callback,
+                                           gpointer user_data)
+{
+    /* Mode 2 keeps the link open until explicitly disabled, not only for
+     * the next message */
+    mm_base_modem_at_command (MM_BASE_MODEM (self),
+                              enable ? "+CMMS=2" : "+CMMS=0",
+                              3,
+                              FALSE,
+                              callback,
+                              user_data);
+}
+
 /*****************************************************************************/
 /* Setup SMS format (Messaging interface) */
 
@@ -6512,8 +6729,15 @@ modem_messaging_setup_cleanup_unsolicited_events_finish (MMIfaceModemMessaging *
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+/* The storage may be locked by some other operation, e.g. while the initial
+ * SMS parts are loaded in the background */
+#define SMS_PART_LOCK_RETRY_TIMEOUT_SECS 1
+#define SMS_PART_LOCK_MAX_RETRIES        10
+
 typedef struct {
     guint idx;
+    MMSmsStorage storage;
+    guint n_lock_retries;
 } SmsPartContext;
 
 static void
@@ -6571,6 +6795,15 @@ sms_part_ready (MMBroadbandModem *self,
     g_object_unref (task);
 }
 
+static void indication_lock_storages (GTask *task);
+
+static gboolean
+indication_lock_storages_retry_cb (GTask *task)
+{
+    indication_lock_storages (task);
+    return G_SOURCE_REMOVE;
+}
+
 static void
 indication_lock_storages_ready (MMBroadbandModem *self,
                                 GAsyncResult *res,
@@ -6580,9 +6813,23 @@ indication_lock_storages_ready (MMBroadbandModem *self,
     gchar *command;
     GError *error = NULL;
 
+    ctx = g_task_get_task_data (task);
+
     if (!mm_broadband_modem_lock_sms_storages_finish (self, res, &error)) {
-        /* TODO: we should either make this lock() never fail, by automatically
-         * retrying after some time, or otherwise retry here. */
+        if (g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_RETRY) &&
+            ctx->n_lock_retries < SMS_PART_LOCK_MAX_RETRIES) {
+            mm_dbg ("Couldn't lock storage to read SMS part (%d), will retry: '%s'",
+                    ctx->idx, error->message);
+            g_error_free (error);
+            ctx->n_lock_retries++;
+            g_timeout_add_seconds (SMS_PART_LOCK_RETRY_TIMEOUT_SECS,
+                                   (GSourceFunc)indication_lock_storages_retry_cb,
+                                   task);
+            return;
+        }
+
+        mm_warn ("Couldn't lock storage to read SMS part (%d): '%s'",
+                 ctx->idx, error->message);
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
@@ -6591,7 +6838,6 @@ indication_lock_storages_ready (MMBroadbandModem *self,
     /* Storage now set and locked */
 
     /* Retrieve the message */
-    ctx = g_task_get_task_data (task);
     command = g_strdup_printf ("+CMGR=%d", ctx->idx);
     mm_base_modem_at_command (MM_BASE_MODEM (self),
                               command,
@@ -6602,6 +6848,23 @@ indication_lock_storages_ready (MMBroadbandModem *self,
     g_free (command);
 }
 
+static void
+indication_lock_storages (GTask *task)
+{
+    MMBroadbandModem *self;
+    SmsPartContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    /* First, request to set the proper storage to read from */
+    mm_broadband_modem_lock_sms_storages (self,
+                                          ctx->storage,
+                                          MM_SMS_STORAGE_UNKNOWN,
+                                          (GAsyncReadyCallback)indication_lock_storages_ready,
+                                          task);
+}
+
 static void
 cmti_received (MMPortSerialAt *port,
                GMatchInfo *info,
@@ -6634,18 +6897,14 @@ cmti_received (MMPortSerialAt *port,
         return;
     }
 
-    ctx = g_new (SmsPartContext, 1);
+    ctx = g_new0 (SmsPartContext, 1);
     ctx->idx = idx;
+    ctx->storage = storage;
 
     task = g_task_new (self, NULL, NULL, NULL);
     g_task_set_task_data (task, ctx, g_free);
 
-    /* First, request to set the proper storage to read from */
-    mm_broadband_modem_lock_sms_storages (self,
-                                          storage,
-                                          MM_SMS_STORAGE_UNKNOWN,
-                                          (GAsyncReadyCallback)indication_lock_storages_ready,
-                                          task);
+    indication_lock_storages (task);
 }
 
 static void
@@ -6932,14 +7191,74 @@ sms_pdu_type_from_str (const gchar *str)
     return MM_SMS_PDU_TYPE_UNKNOWN;
 }
 
+static void
+sms_text_part_list_take_entry (MM3gppTextInfo *info,
+                               GTask          *task)
+{
+    MMBroadbandModem *self;
+    ListPartsContext *ctx;
+    MMSmsPart *part;
+    gchar *number, *text, *ucs2_text;
+    gsize ucs2_len = 0;
+    GByteArray *raw;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    /* Get part state */
+    if (!info->status) {
+        mm_dbg ("Failed to get part status");
+        goto out;
+    }
+
+    /* Get and parse number */
+    if (!info->number) {
+        mm_dbg ("Failed to get message sender number");
+        goto out;
+    }
+
+    number = mm_broadband_modem_take_and_convert_to_utf8 (self, info->number);
+    info->number = NULL;
+
+    /* Get and parse text */
+    text = mm_broadband_modem_take_and_convert_to_utf8 (self, info->text);
+    info->text = NULL;
+
+    /* The raw SMS data can only be GSM, UCS2, or unknown (8-bit), so we
+     * need to convert to UCS2 here.
+     */
+    ucs2_text = g_convert (text, -1, "UCS-2BE//TRANSLIT", "UTF-8", NULL, &ucs2_len, NULL);
+    g_assert (ucs2_text);
+    raw = g_byte_array_sized_new (ucs2_len);
+    g_byte_array_append (raw, (const guint8 *) ucs2_text, ucs2_len);
+    g_free (ucs2_text);
+
+    /* all take() methods pass ownership of the value as well */
+    part = mm_sms_part_new (info->index,
+                            sms_pdu_type_from_str (info->status));
+    mm_sms_part_take_number (part, number);
+    /* Timestamp is always expected in ASCII */
+    mm_sms_part_take_timestamp (part, info->timestamp);
+    info->timestamp = NULL;
+    mm_sms_part_take_text (part, text);
+    mm_sms_part_take_data (part, raw);
+    mm_sms_part_set_class (part, -1);
+
+    mm_dbg ("Correctly parsed SMS list entry (%d)", info->index);
+    mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (self),
+                                        part,
+                                        sms_state_from_str (info->status),
+                                        ctx->list_storage);
+
+out:
+    mm_3gpp_text_info_free (info);
+}
+
 static void
 sms_text_part_list_ready (MMBroadbandModem *self,
                           GAsyncResult *res,
                           GTask *task)
 {
-    ListPartsContext *ctx;
-    GRegex *r;
-    GMatchInfo *match_info = NULL;
     const gchar *response;
     GError *error = NULL;
 
@@ -6950,97 +7269,18 @@ sms_text_part_list_ready (MMBroadbandModem *self,
         return;
     }
 
-    /* +CMGL: <index>,<stat>,<oa/da>,[alpha],<scts><CR><LF><data><CR><LF> */
-    r = g_regex_new ("\\+CMGL:\\s*(\\d+)\\s*,\\s*([^,]*),\\s*([^,]*),\\s*([^,]*),\\s*([^\\r\\n]*)\\r\\n([^\\r\\n]*)",
-                     0, 0, NULL);
-    g_assert (r);
-
-    if (!g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, NULL)) {
+    /* Each entry is processed as soon as it's parsed */
+    if (!mm_3gpp_parse_text_cmgl_response_foreach (response,
+                                                   (MM3gppTextInfoFunc)sms_text_part_list_take_entry,
+                                                   task)) {
         g_task_return_new_error (task,
                                  MM_CORE_ERROR,
                                  MM_CORE_ERROR_INVALID_ARGS,
                                  "Couldn't parse SMS list response");
         g_object_unref (task);
-        g_match_info_free (match_info);
-        g_regex_unref (r);
         return;
     }
 
-    ctx = g_task_get_task_data (task);
-
-    while (g_match_info_matches (match_info)) {
-        MMSmsPart *part;
-        guint matches, idx;
-        gchar *number, *timestamp, *text, *ucs2_text, *stat;
-        gsize ucs2_len = 0;
-        GByteArray *raw;
-
-        matches = g_match_info_get_match_count (match_info);
-        if (matches != 7) {
-            mm_dbg ("Failed to match entire CMGL response (count %d)", matches);
-            goto next;
-        }
-
-        if (!mm_get_uint_from_match_info (match_info, 1, &idx)) {
-            mm_dbg ("Failed to convert message index");
-            goto next;
-        }
-
-        /* Get part state */
-        stat = mm_get_string_unquoted_from_match_info (match_info, 2);
-        if (!stat) {
-            mm_dbg ("Failed to get part status");
-            goto next;
-        }
-
-        /* Get and parse number */
-        number = mm_get_string_unquoted_from_match_info (match_info, 3);
-        if (!number) {
-            mm_dbg ("Failed to get message sender number");
-            g_free (stat);
-            goto next;
-        }
-
-        number = mm_broadband_modem_take_and_convert_to_utf8 (MM_BROADBAND_MODEM (self),
-                                                              number);
-
-        /* Get and parse timestamp (always expected in ASCII) */
-        timestamp = mm_get_string_unquoted_from_match_info (match_info, 5);
-
-        /* Get and parse text */
-        text = mm_broadband_modem_take_and_convert_to_utf8 (MM_BROADBAND_MODEM (self),
-                                                            g_match_info_fetch (match_info, 6));
-
-        /* The raw SMS data can only be GSM, UCS2, or unknown (8-bit), so we
-         * need to convert to UCS2 here.
-         */
-        ucs2_text = g_convert (text, -1, "UCS-2BE//TRANSLIT", "UTF-8", NULL, &ucs2_len, NULL);
-        g_assert (ucs2_text);
-        raw = g_byte_array_sized_new (ucs2_len);
-        g_byte_array_append (raw, (const guint8 *) ucs2_text, ucs2_len);
-        g_free (ucs2_text);
-
-        /* all take() methods pass ownership of the value as well */
-        part = mm_sms_part_new (idx,
-                                sms_pdu_type_from_str (stat));
-        mm_sms_part_take_number (part, number);
-        mm_sms_part_take_timestamp (part, timestamp);
-        mm_sms_part_take_text (part, text);
-        mm_sms_part_take_data (part, raw);
-        mm_sms_part_set_class (part, -1);
-
-        mm_dbg ("Correctly parsed SMS list entry (%d)", idx);
-        mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (self),
-                                            part,
-                                            sms_state_from_str (stat),
-                                            ctx->list_storage);
-        g_free (stat);
-next:
-        g_match_info_next (match_info, NULL);
-    }
-    g_match_info_free (match_info);
-    g_regex_unref (r);
-
     /* We consider all done */
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
@@ -7063,16 +7303,39 @@ sms_state_from_index (guint index)
     }
 }
 
+static void
+sms_pdu_part_list_take_entry (MM3gppPduInfo *info,
+                              GTask         *task)
+{
+    ListPartsContext *ctx;
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+
+    part = mm_sms_part_3gpp_new_from_pdu (info->index, info->pdu, &error);
+    if (part) {
+        mm_dbg ("Correctly parsed PDU (%d)", info->index);
+        mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (g_task_get_source_object (task)),
+                                            part,
+                                            sms_state_from_index (info->status),
+                                            ctx->list_storage);
+    } else {
+        /* Don't treat the error as critical */
+        mm_dbg ("Error parsing PDU (%d): %s", info->index, error->message);
+        g_error_free (error);
+    }
+
+    mm_3gpp_pdu_info_free (info);
+}
+
 static void
 sms_pdu_part_list_ready (MMBroadbandModem *self,
                          GAsyncResult *res,
                          GTask *task)
 {
-    ListPartsContext *ctx;
     const gchar *response;
     GError *error = NULL;
-    GList *info_list;
-    GList *l;
 
     /* Always always always unlock mem1 storage. Warned you've been. */
     mm_broadband_modem_unlock_sms_storages (self, TRUE, FALSE);
@@ -7084,35 +7347,17 @@ sms_pdu_part_list_ready (MMBroadbandModem *self,
         return;
     }
 
-    info_list = mm_3gpp_parse_pdu_cmgl_response (response, &error);
-    if (error) {
+    /* Each PDU is decoded and given to the messaging interface as soon as
+     * it's found in the response, no intermediate list is built */
+    if (!mm_3gpp_parse_pdu_cmgl_response_foreach (response,
+                                                  (MM3gppPduInfoFunc)sms_pdu_part_list_take_entry,
+                                                  task,
+                                                  &error)) {
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
-    ctx = g_task_get_task_data (task);
-
-    for (l = info_list; l; l = g_list_next (l)) {
-        MM3gppPduInfo *info = l->data;
-        MMSmsPart *part;
-
-        part = mm_sms_part_3gpp_new_from_pdu (info->index, info->pdu, &error);
-        if (part) {
-            mm_dbg ("Correctly parsed PDU (%d)", info->index);
-            mm_iface_modem_messaging_take_part (MM_IFACE_MODEM_MESSAGING (self),
-                                                part,
-                                                sms_state_from_index (info->status),
-                                                ctx->list_storage);
-        } else {
-            /* Don't treat the error as critical */
-            mm_dbg ("Error parsing PDU (%d): %s", info->index, error->message);
-            g_clear_error (&error);
-        }
-    }
-
-    mm_3gpp_pdu_info_list_free (info_list);
-
     /* We consider all done */
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
@@ -10988,6 +11233,14 @@ mm_broadband_modem_get_current_charset (MMBroadbandModem *self)
     return self->priv->modem_current_charset;
 }
 
+gboolean
+mm_broadband_modem_get_cgev_deactivations_reliable (MMBroadbandModem *self)
+{
+    return (self->priv->modem_cgerep_enabled &&
+            self->priv->modem_cgev_deact_cid_reported &&
+            !self->priv->modem_cgev_deact_cid_missing);
+}
+
 gchar *
 mm_broadband_modem_create_device_identifier (MMBroadbandModem *self,
                                              const gchar *ati,
@@ -11028,6 +11281,8 @@ after_hotswap_event_disable_ready (MMBaseModem *self,
 void
 mm_broadband_modem_update_sim_hot_swap_detected (MMBroadbandModem *self)
 {
+    mm_broadband_modem_invalidate_pdp_context_list (self);
+
     if (self->priv->sim_hot_swap_ports_ctx) {
         mm_dbg ("Releasing SIM hot swap ports context");
         ports_context_unref (self->priv->sim_hot_swap_ports_ctx);
@@ -11116,6 +11371,9 @@ set_property (GObject *object,
         self->priv->modem_firmware_dbus_skeleton = g_value_dup_object (value);
         break;
     case PROP_MODEM_SIM:
+        /* Contexts may be provisioned from the SIM */
+        if (self->priv->modem_sim != g_value_get_object (value))
+            mm_broadband_modem_invalidate_pdp_context_list (self);
         g_clear_object (&self->priv->modem_sim);
         self->priv->modem_sim = g_value_dup_object (value);
         break;
@@ -11184,6 +11442,9 @@ set_property (GObject *object,
     case PROP_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED:
         self->priv->periodic_signal_check_disabled = g_value_get_boolean (value);
         break;
+    case PROP_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE:
+        self->priv->connection_status_indications_unreliable = g_value_get_boolean (value);
+        break;
     case PROP_FLOW_CONTROL:
         self->priv->flow_control = g_value_get_flags (value);
         break;
@@ -11301,6 +11562,9 @@ get_property (GObject *object,
     case PROP_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED:
         g_value_set_boolean (value, self->priv->periodic_signal_check_disabled);
         break;
+    case PROP_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE:
+        g_value_set_boolean (value, self->priv->connection_status_indications_unreliable);
+        break;
     case PROP_FLOW_CONTROL:
         g_value_set_flags (value, self->priv->flow_control);
         break;
@@ -11334,6 +11598,7 @@ mm_broadband_modem_init (MMBroadbandModem *self)
     self->priv->current_sms_mem2_storage = MM_SMS_STORAGE_UNKNOWN;
     self->priv->sim_hot_swap_supported = FALSE;
     self->priv->periodic_signal_check_disabled = FALSE;
+    self->priv->connection_status_indications_unreliable = FALSE;
     self->priv->modem_cmer_enable_mode = MM_3GPP_CMER_MODE_NONE;
     self->priv->modem_cmer_disable_mode = MM_3GPP_CMER_MODE_NONE;
     self->priv->modem_cmer_ind = MM_3GPP_CMER_IND_NONE;
@@ -11354,6 +11619,9 @@ finalize (GObject *object)
     if (self->priv->modem_3gpp_registration_regex)
         mm_3gpp_creg_regex_destroy (self->priv->modem_3gpp_registration_regex);
 
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
+    mm_3gpp_pdp_context_format_list_free (self->priv->pdp_context_format_list);
+
     G_OBJECT_CLASS (mm_broadband_modem_parent_class)->finalize (object);
 }
 
@@ -11607,6 +11875,8 @@ iface_modem_messaging_init (MMIfaceModemMessaging *iface)
     iface->load_supported_storages_finish = modem_messaging_load_supported_storages_finish;
     iface->set_default_storage = modem_messaging_set_default_storage;
     iface->set_default_storage_finish = modem_messaging_set_default_storage_finish;
+    iface->set_more_messages_to_send = modem_messaging_set_more_messages_to_send;
+    iface->set_more_messages_to_send_finish = modem_messaging_set_more_messages_to_send_finish;
     iface->setup_sms_format = modem_messaging_setup_sms_format;
     iface->setup_sms_format_finish = modem_messaging_setup_sms_format_finish;
     iface->load_initial_sms_parts = modem_messaging_load_initial_sms_parts;
@@ -11829,6 +12099,10 @@ mm_broadband_modem_class_init (MMBroadbandModemClass *klass)
                                       PROP_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED,
                                       MM_IFACE_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED);
 
+    g_object_class_override_property (object_class,
+                                      PROP_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE,
+                                      MM_IFACE_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE);
+
     properties[PROP_FLOW_CONTROL] =
         g_param_spec_flags (MM_BROADBAND_MODEM_FLOW_CONTROL,
                             "Flow control",
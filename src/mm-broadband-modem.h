@@ -112,6 +112,10 @@ gchar *mm_broadband_modem_take_and_convert_to_current_charset (MMBroadbandModem
 
 MMModemCharset mm_broadband_modem_get_current_charset (MMBroadbandModem *self);
 
+/* Whether the modem reports context deactivations with +CGEV, including the
+ * cid; only known once such a deactivation has been seen */
+gboolean mm_broadband_modem_get_cgev_deactivations_reliable (MMBroadbandModem *self);
+
 /* Create a unique device identifier string using the ATI and ATI1 replies and some
  * additional internal info */
 gchar *mm_broadband_modem_create_device_identifier (MMBroadbandModem *self,
@@ -130,6 +134,21 @@ gboolean mm_broadband_modem_lock_sms_storages_finish (MMBroadbandModem *self,
 void     mm_broadband_modem_unlock_sms_storages      (MMBroadbandModem *self,
                                                       gboolean mem1,
                                                       gboolean mem2);
+/* Cached PDP context information, shared by all bearers of the modem. The
+ * lists are owned by the modem; the PDP context list may be valid and empty. */
+gboolean  mm_broadband_modem_peek_pdp_context_list        (MMBroadbandModem  *self,
+                                                           GList            **pdp_list);
+void      mm_broadband_modem_take_pdp_context_list        (MMBroadbandModem  *self,
+                                                           GList             *pdp_list);
+void      mm_broadband_modem_update_pdp_context           (MMBroadbandModem  *self,
+                                                           guint              cid,
+                                                           MMBearerIpFamily   pdp_type,
+                                                           const gchar       *apn);
+void      mm_broadband_modem_invalidate_pdp_context_list  (MMBroadbandModem  *self);
+GList    *mm_broadband_modem_peek_pdp_context_format_list (MMBroadbandModem  *self);
+void      mm_broadband_modem_take_pdp_context_format_list (MMBroadbandModem  *self,
+                                                           GList             *format_list);
+
 /* Helper to update SIM hot swap */
 void mm_broadband_modem_update_sim_hot_swap_detected (MMBroadbandModem *self);
 
@@ -111,28 +111,301 @@ charset_iconv_from (MMModemCharset charset)
     return NULL;
 }
 
+/*****************************************************************************/
+/* Cached iconv converters
+ *
+ * Opening an iconv descriptor is far more expensive than the conversions we
+ * usually do (operator names, USSD, SMS text), so descriptors are opened once
+ * per (to, from) pair and kept for the lifetime of the process. The number of
+ * pairs in use is bound by the charset table above. */
+
+#define CONVERTER_CACHE_SIZE 24
+
+typedef struct {
+    const gchar *to;
+    const gchar *from;
+    GIConv       converter;
+} CachedConverter;
+
+static CachedConverter converter_cache[CONVERTER_CACHE_SIZE];
+G_LOCK_DEFINE_STATIC (converter_cache);
+
+static gchar *
+charset_iconv_convert (const gchar  *str,
+                       gssize        len,
+                       const gchar  *to,
+                       const gchar  *from,
+                       gsize        *bytes_read,
+                       gsize        *bytes_written,
+                       GError      **error)
+{
+    GIConv  converter = (GIConv) -1;
+    gchar  *converted;
+    guint   i;
+
+    if (!to || !from) {
+        g_set_error (error, G_CONVERT_ERROR, G_CONVERT_ERROR_NO_CONVERSION,
+                     "Conversion from character set '%s' to '%s' is not supported",
+                     from ? from : "(none)", to ? to : "(none)");
+        return NULL;
+    }
+
+    G_LOCK (converter_cache);
+
+    for (i = 0; i < CONVERTER_CACHE_SIZE && converter_cache[i].to; i++) {
+        if (g_str_equal (converter_cache[i].to, to) && g_str_equal (converter_cache[i].from, from)) {
+            converter = converter_cache[i].converter;
+            break;
+        }
+    }
+
+    if (converter == (GIConv) -1) {
+        converter = g_iconv_open (to, from);
+        if (converter == (GIConv) -1) {
+            G_UNLOCK (converter_cache);
+            g_set_error (error, G_CONVERT_ERROR, G_CONVERT_ERROR_NO_CONVERSION,
+                         "Conversion from character set '%s' to '%s' is not supported",
+                         from, to);
+            return NULL;
+        }
+        /* If the cache is full just use a one-shot converter */
+        if (i < CONVERTER_CACHE_SIZE) {
+            converter_cache[i].to = g_intern_string (to);
+            converter_cache[i].from = g_intern_string (from);
+            converter_cache[i].converter = converter;
+        }
+    } else {
+        /* Reset state left over from the previous use */
+        g_iconv (converter, NULL, NULL, NULL, NULL);
+    }
+
+    converted = g_convert_with_iconv (str, len, converter, bytes_read, bytes_written, error);
+
+    if (i >= CONVERTER_CACHE_SIZE)
+        g_iconv_close (converter);
+
+    G_UNLOCK (converter_cache);
+
+    return converted;
+}
+
+/*****************************************************************************/
+/* Conversion fast paths
+ *
+ * The charsets modems use most can be converted without iconv. These only
+ * handle input that is fully representable in the target charset; anything
+ * else returns NULL so that the caller falls back to iconv, which takes care
+ * of error reporting and transliteration exactly as before. */
+
+static gchar *
+fast_to_utf8 (const gchar    *data,
+              gsize           len,
+              MMModemCharset  charset)
+{
+    const guint8 *in = (const guint8 *) data;
+    gchar        *out;
+    gchar        *p;
+    gsize         i;
+
+    switch (charset) {
+    case MM_MODEM_CHARSET_UTF8:
+        if (!g_utf8_validate (data, len, NULL))
+            return NULL;
+        return g_strndup (data, len);
+
+    case MM_MODEM_CHARSET_IRA:
+        for (i = 0; i < len; i++) {
+            if (in[i] & 0x80)
+                return NULL;
+        }
+        return g_strndup (data, len);
+
+    case MM_MODEM_CHARSET_8859_1:
+        /* Latin-1 maps 1:1 to the first 256 code points */
+        p = out = g_malloc (len * 2 + 1);
+        for (i = 0; i < len; i++) {
+            if (in[i] < 0x80)
+                *p++ = in[i];
+            else {
+                *p++ = 0xC0 | (in[i] >> 6);
+                *p++ = 0x80 | (in[i] & 0x3F);
+            }
+        }
+        *p = '\0';
+        return out;
+
+    case MM_MODEM_CHARSET_UCS2:
+        if (len % 2)
+            return NULL;
+        p = out = g_malloc ((len / 2) * 3 + 1);
+        for (i = 0; i < len; i += 2) {
+            gunichar c;
+
+            c = (in[i] << 8) | in[i + 1];
+            /* Surrogates are not valid UCS-2 */
+            if (c >= 0xD800 && c <= 0xDFFF) {
+                g_free (out);
+                return NULL;
+            }
+            p += g_unichar_to_utf8 (c, p);
+        }
+        *p = '\0';
+        return out;
+
+    case MM_MODEM_CHARSET_GSM:
+        /* Unpacked GSM 03.38 default alphabet, one septet per byte */
+        if (len >= 4096)
+            return NULL;
+        return (gchar *) mm_charset_gsm_unpacked_to_utf8 (in, len);
+
+    case MM_MODEM_CHARSET_PCCP437:
+    case MM_MODEM_CHARSET_PCDN:
+    case MM_MODEM_CHARSET_HEX:
+    case MM_MODEM_CHARSET_UNKNOWN:
+    default:
+        return NULL;
+    }
+}
+
+static gchar *
+fast_from_utf8 (const gchar    *utf8,
+                MMModemCharset  charset,
+                gsize          *out_len)
+{
+    const gchar *c;
+    gsize        len;
+    guint8      *out;
+    gsize        n = 0;
+
+    len = strlen (utf8);
+
+    switch (charset) {
+    case MM_MODEM_CHARSET_UTF8:
+        if (!g_utf8_validate (utf8, len, NULL))
+            return NULL;
+        *out_len = len;
+        return g_strndup (utf8, len);
+
+    case MM_MODEM_CHARSET_IRA:
+        for (n = 0; n < len; n++) {
+            if (utf8[n] & 0x80)
+                return NULL;
+        }
+        *out_len = len;
+        return g_strndup (utf8, len);
+
+    case MM_MODEM_CHARSET_8859_1:
+        out = g_malloc (len + 1);
+        for (c = utf8; *c; c = g_utf8_next_char (c)) {
+            gunichar uc;
+
+            uc = g_utf8_get_char (c);
+            if (uc > 0xFF) {
+                g_free (out);
+                return NULL;
+            }
+            out[n++] = uc;
+        }
+        out[n] = '\0';
+        *out_len = n;
+        return (gchar *) out;
+
+    case MM_MODEM_CHARSET_UCS2:
+        /* At most one UCS-2 unit per UTF-8 byte */
+        out = g_malloc (len * 2 + 2);
+        for (c = utf8; *c; c = g_utf8_next_char (c)) {
+            gunichar uc;
+
+            uc = g_utf8_get_char (c);
+            if (uc > 0xFFFF) {
+                g_free (out);
+                return NULL;
+            }
+            out[n++] = uc >> 8;
+            out[n++] = uc & 0xFF;
+        }
+        out[n] = out[n + 1] = '\0';
+        *out_len = n;
+        return (gchar *) out;
+
+    case MM_MODEM_CHARSET_GSM: {
+        guint32 gsm_len = 0;
+
+        if (!mm_charset_can_convert_to (utf8, MM_MODEM_CHARSET_GSM))
+            return NULL;
+        out = mm_charset_utf8_to_unpacked_gsm (utf8, &gsm_len);
+        if (out)
+            *out_len = gsm_len;
+        return (gchar *) out;
+    }
+
+    case MM_MODEM_CHARSET_PCCP437:
+    case MM_MODEM_CHARSET_PCDN:
+    case MM_MODEM_CHARSET_HEX:
+    case MM_MODEM_CHARSET_UNKNOWN:
+    default:
+        return NULL;
+    }
+}
+
+/* Convert from the given charset to UTF-8; returns NULL on error */
+static gchar *
+charset_convert_to_utf8 (const gchar    *data,
+                         gsize           len,
+                         MMModemCharset  charset)
+{
+    gchar *converted;
+
+    converted = fast_to_utf8 (data, len, charset);
+    if (converted)
+        return converted;
+
+    return charset_iconv_convert (data, len,
+                                  "UTF-8//TRANSLIT", charset_iconv_from (charset),
+                                  NULL, NULL, NULL);
+}
+
+/* Convert from UTF-8 to the given charset; returns NULL on error */
+static gchar *
+charset_convert_from_utf8 (const gchar     *utf8,
+                           MMModemCharset   charset,
+                           gboolean         translit,
+                           gsize           *out_len,
+                           GError         **error)
+{
+    gchar *converted;
+
+    converted = fast_from_utf8 (utf8, charset, out_len);
+    if (converted)
+        return converted;
+
+    return charset_iconv_convert (utf8, -1,
+                                  translit ? charset_iconv_to (charset) : charset_iconv_from (charset),
+                                  "UTF-8",
+                                  NULL, out_len, error);
+}
+
+/*****************************************************************************/
+
 gboolean
 mm_modem_charset_byte_array_append (GByteArray *array,
                                     const char *utf8,
                                     gboolean quoted,
                                     MMModemCharset charset)
 {
-    const char *iconv_to;
     char *converted;
     GError *error = NULL;
     gsize written = 0;
 
     g_return_val_if_fail (array != NULL, FALSE);
     g_return_val_if_fail (utf8 != NULL, FALSE);
+    g_return_val_if_fail (charset != MM_MODEM_CHARSET_UNKNOWN, FALSE);
 
-    iconv_to = charset_iconv_to (charset);
-    g_return_val_if_fail (iconv_to != NULL, FALSE);
-
-    converted = g_convert (utf8, -1, iconv_to, "UTF-8", NULL, &written, &error);
+    converted = charset_convert_from_utf8 (utf8, charset, TRUE, &written, &error);
     if (!converted) {
         if (error) {
             mm_warn ("failed to convert '%s' to %s character set: (%d) %s",
-                     utf8, iconv_to, error->code, error->message);
+                     utf8, mm_modem_charset_to_string (charset), error->code, error->message);
             g_error_free (error);
         }
         return FALSE;
@@ -152,41 +425,21 @@ gchar *
 mm_modem_charset_byte_array_to_utf8 (GByteArray     *array,
                                      MMModemCharset  charset)
 {
-    char *converted;
-    const char *iconv_from;
-    GError *error = NULL;
-
     g_return_val_if_fail (array != NULL, NULL);
     g_return_val_if_fail (charset != MM_MODEM_CHARSET_UNKNOWN, NULL);
 
-    iconv_from = charset_iconv_from (charset);
-    g_return_val_if_fail (iconv_from != NULL, FALSE);
-
-    converted = g_convert ((const gchar *)array->data, array->len,
-                           "UTF-8//TRANSLIT", iconv_from,
-                           NULL, NULL, &error);
-    if (!converted || error) {
-        g_clear_error (&error);
-        converted = NULL;
-    }
-
-    return converted;
+    return charset_convert_to_utf8 ((const gchar *)array->data, array->len, charset);
 }
 
 char *
 mm_modem_charset_hex_to_utf8 (const char *src, MMModemCharset charset)
 {
     char *unconverted, *converted;
-    const char *iconv_from;
     gsize unconverted_len = 0;
-    GError *error = NULL;
 
     g_return_val_if_fail (src != NULL, NULL);
     g_return_val_if_fail (charset != MM_MODEM_CHARSET_UNKNOWN, NULL);
 
-    iconv_from = charset_iconv_from (charset);
-    g_return_val_if_fail (iconv_from != NULL, FALSE);
-
     unconverted = mm_utils_hexstr2bin (src, &unconverted_len);
     if (!unconverted)
         return NULL;
@@ -194,14 +447,7 @@ mm_modem_charset_hex_to_utf8 (const char *src, MMModemCharset charset)
     if (charset == MM_MODEM_CHARSET_UTF8 || charset == MM_MODEM_CHARSET_IRA)
         return unconverted;
 
-    converted = g_convert (unconverted, unconverted_len,
-                           "UTF-8//TRANSLIT", iconv_from,
-                           NULL, NULL, &error);
-    if (!converted || error) {
-        g_clear_error (&error);
-        converted = NULL;
-    }
-
+    converted = charset_convert_to_utf8 (unconverted, unconverted_len, charset);
     g_free (unconverted);
 
     return converted;
@@ -212,27 +458,17 @@ mm_modem_charset_utf8_to_hex (const char *src, MMModemCharset charset)
 {
     gsize converted_len = 0;
     char *converted;
-    const char *iconv_to;
-    GError *error = NULL;
     gchar *hex;
 
     g_return_val_if_fail (src != NULL, NULL);
     g_return_val_if_fail (charset != MM_MODEM_CHARSET_UNKNOWN, NULL);
 
-    iconv_to = charset_iconv_from (charset);
-    g_return_val_if_fail (iconv_to != NULL, FALSE);
-
     if (charset == MM_MODEM_CHARSET_UTF8 || charset == MM_MODEM_CHARSET_IRA)
         return g_strdup (src);
 
-    converted = g_convert (src, strlen (src),
-                           iconv_to, "UTF-8//TRANSLIT",
-                           NULL, &converted_len, &error);
-    if (!converted || error) {
-        g_clear_error (&error);
-        g_free (converted);
+    converted = charset_convert_from_utf8 (src, charset, FALSE, &converted_len, NULL);
+    if (!converted)
         return NULL;
-    }
 
     /* Get hex representation of the string */
     hex = mm_utils_bin2hexstr ((guint8 *)converted, converted_len);
@@ -643,23 +879,83 @@ mm_charset_can_convert_to (const char *utf8,
     return TRUE;
 }
 
+/* 8 septets fill exactly 7 octets, so once the bit offset is octet-aligned
+ * septets are (un)packed in blocks of 8 through a single 64-bit word. The
+ * word is always built byte by byte, so this works in any endianness. */
+
+static inline void
+gsm_unpack_block (const guint8 *in,
+                  guint8       *out)
+{
+    guint64 word;
+
+    word = ((guint64) in[0]       |
+            (guint64) in[1] << 8  |
+            (guint64) in[2] << 16 |
+            (guint64) in[3] << 24 |
+            (guint64) in[4] << 32 |
+            (guint64) in[5] << 40 |
+            (guint64) in[6] << 48);
+
+    out[0] = word & 0x7F;
+    out[1] = (word >> 7) & 0x7F;
+    out[2] = (word >> 14) & 0x7F;
+    out[3] = (word >> 21) & 0x7F;
+    out[4] = (word >> 28) & 0x7F;
+    out[5] = (word >> 35) & 0x7F;
+    out[6] = (word >> 42) & 0x7F;
+    out[7] = (word >> 49) & 0x7F;
+}
+
+static inline void
+gsm_pack_block (const guint8 *in,
+                guint8       *out)
+{
+    guint64 word;
+
+    word = ((guint64) (in[0] & 0x7F)       |
+            (guint64) (in[1] & 0x7F) << 7  |
+            (guint64) (in[2] & 0x7F) << 14 |
+            (guint64) (in[3] & 0x7F) << 21 |
+            (guint64) (in[4] & 0x7F) << 28 |
+            (guint64) (in[5] & 0x7F) << 35 |
+            (guint64) (in[6] & 0x7F) << 42 |
+            (guint64) (in[7] & 0x7F) << 49);
+
+    out[0] = word & 0xFF;
+    out[1] = (word >> 8) & 0xFF;
+    out[2] = (word >> 16) & 0xFF;
+    out[3] = (word >> 24) & 0xFF;
+    out[4] = (word >> 32) & 0xFF;
+    out[5] = (word >> 40) & 0xFF;
+    out[6] = (word >> 48) & 0xFF;
+}
+
 guint8 *
 mm_charset_gsm_unpack (const guint8 *gsm,
                        guint32 num_septets,
                        guint8 start_offset,  /* in _bits_ */
                        guint32 *out_unpacked_len)
 {
-    GByteArray *unpacked;
-    int i;
+    guint8 *unpacked;
+    guint32 i = 0;
 
-    unpacked = g_byte_array_sized_new (num_septets + 1);
+    unpacked = g_malloc (num_septets + 1);
 
-    for (i = 0; i < num_septets; i++) {
+    while (i < num_septets) {
         guint8 bits_here, bits_in_next, octet, offset, c;
         guint32 start_bit;
 
         start_bit = start_offset + (i * 7); /* Overall bit offset of char in buffer */
         offset = start_bit % 8;  /* Offset to start of char in this byte */
+
+        /* Octet-aligned and at least 8 septets left? Do a whole block */
+        if (!offset && (num_septets - i) >= 8) {
+            gsm_unpack_block (&gsm[start_bit / 8], &unpacked[i]);
+            i += 8;
+            continue;
+        }
+
         bits_here = offset ? (8 - offset) : 7;
         bits_in_next = 7 - bits_here;
 
@@ -672,11 +968,12 @@ mm_charset_gsm_unpack (const guint8 *gsm,
             octet = gsm[(start_bit / 8) + 1];
             c |= (octet & (0xFF >> (8 - bits_in_next))) << bits_here;
         }
-        g_byte_array_append (unpacked, &c, 1);
+        unpacked[i++] = c;
     }
 
-    *out_unpacked_len = unpacked->len;
-    return g_byte_array_free (unpacked, FALSE);
+    unpacked[num_septets] = 0;
+    *out_unpacked_len = num_septets;
+    return unpacked;
 }
 
 guint8 *
@@ -687,7 +984,7 @@ mm_charset_gsm_pack (const guint8 *src,
 {
     guint8 *packed;
     guint octet = 0, lshift, plen;
-    int i = 0;
+    guint32 i = 0;
 
     g_return_val_if_fail (start_offset < 8, NULL);
 
@@ -698,7 +995,16 @@ mm_charset_gsm_pack (const guint8 *src,
 
     packed = g_malloc0 (plen);
 
-    for (i = 0, lshift = start_offset; i < src_len; i++) {
+    lshift = start_offset;
+    while (i < src_len) {
+        /* Octet-aligned and at least 8 septets left? Do a whole block */
+        if (!lshift && (src_len - i) >= 8) {
+            gsm_pack_block (&src[i], &packed[octet]);
+            octet += 7;
+            i += 8;
+            continue;
+        }
+
         packed[octet] |= (src[i] & 0x7F) << lshift;
         if (lshift > 1) {
             /* Grab the lost bits and add to next octet */
@@ -708,6 +1014,7 @@ mm_charset_gsm_pack (const guint8 *src,
         if (lshift)
             octet++;
         lshift = lshift ? lshift - 1 : 7;
+        i++;
     }
 
     if (out_packed_len)
@@ -741,22 +1048,10 @@ mm_charset_take_and_convert_to_utf8 (gchar *str, MMModemCharset charset)
     case MM_MODEM_CHARSET_GSM:
     case MM_MODEM_CHARSET_8859_1:
     case MM_MODEM_CHARSET_PCCP437:
-    case MM_MODEM_CHARSET_PCDN: {
-        const gchar *iconv_from;
-        GError *error = NULL;
-
-        iconv_from = charset_iconv_from (charset);
-        utf8 = g_convert (str, strlen (str),
-                          "UTF-8//TRANSLIT", iconv_from,
-                          NULL, NULL, &error);
-        if (!utf8 || error) {
-            g_clear_error (&error);
-            utf8 = NULL;
-        }
-
+    case MM_MODEM_CHARSET_PCDN:
+        utf8 = charset_convert_to_utf8 (str, strlen (str), charset);
         g_free (str);
         break;
-    }
 
     case MM_MODEM_CHARSET_UCS2: {
         gsize len;
@@ -789,9 +1084,9 @@ mm_charset_take_and_convert_to_utf8 (gchar *str, MMModemCharset charset)
          * the partial conversion length to re-convert the part of the string
          * that is UTF-8, if any.
          */
-        utf8 = g_convert (str, strlen (str),
-                          "UTF-8//TRANSLIT", "UTF-8//TRANSLIT",
-                          &bread, &bwritten, NULL);
+        utf8 = charset_iconv_convert (str, strlen (str),
+                                      "UTF-8//TRANSLIT", "UTF-8//TRANSLIT",
+                                      &bread, &bwritten, NULL);
 
         /* Valid conversion, or we didn't get enough valid UTF-8 */
         if (utf8 || (bwritten <= 2)) {
@@ -803,9 +1098,9 @@ mm_charset_take_and_convert_to_utf8 (gchar *str, MMModemCharset charset)
          * location and get what we can.
          */
         str[bread] = '\0';
-        utf8 = g_convert (str, strlen (str),
-                          "UTF-8//TRANSLIT", "UTF-8//TRANSLIT",
-                          NULL, NULL, NULL);
+        utf8 = charset_iconv_convert (str, strlen (str),
+                                      "UTF-8//TRANSLIT", "UTF-8//TRANSLIT",
+                                      NULL, NULL, NULL);
         g_free (str);
         break;
     }
@@ -865,36 +1160,18 @@ mm_utf8_take_and_convert_to_charset (gchar *str,
     case MM_MODEM_CHARSET_8859_1:
     case MM_MODEM_CHARSET_PCCP437:
     case MM_MODEM_CHARSET_PCDN: {
-        const gchar *iconv_to;
-        GError *error = NULL;
-
-        iconv_to = charset_iconv_from (charset);
-        encoded = g_convert (str, strlen (str),
-                             iconv_to, "UTF-8",
-                             NULL, NULL, &error);
-        if (!encoded || error) {
-            g_clear_error (&error);
-            encoded = NULL;
-        }
+        gsize encoded_len = 0;
 
+        encoded = charset_convert_from_utf8 (str, charset, FALSE, &encoded_len, NULL);
         g_free (str);
         break;
     }
 
     case MM_MODEM_CHARSET_UCS2: {
-        const gchar *iconv_to;
         gsize encoded_len = 0;
-        GError *error = NULL;
         gchar *hex;
 
-        iconv_to = charset_iconv_from (charset);
-        encoded = g_convert (str, strlen (str),
-                             iconv_to, "UTF-8",
-                             NULL, &encoded_len, &error);
-        if (!encoded || error) {
-            g_clear_error (&error);
-            encoded = NULL;
-        }
+        encoded = charset_convert_from_utf8 (str, charset, FALSE, &encoded_len, NULL);
 
         /* Get hex representation of the string */
         hex = mm_utils_bin2hexstr ((guint8 *)encoded, encoded_len);
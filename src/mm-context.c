@@ -41,6 +41,10 @@ static gboolean      debug;
 static MMFilterRule  filter_policy = MM_FILTER_POLICY_DEFAULT;
 static gboolean      no_auto_scan = NO_AUTO_SCAN_DEFAULT;
 static const gchar  *initial_kernel_events;
+static gint          bearer_stats_rate;
+static const gchar  *sms_sink;
+static const gchar  *qmi_state_dir;
+static gboolean      configure_data_interfaces;
 
 static gboolean
 filter_policy_option_arg (const gchar  *option_name,
@@ -90,6 +94,26 @@ static const GOptionEntry entries[] = {
         "Path to initial kernel events file",
         "[PATH]"
     },
+    {
+        "bearer-stats-rate", 0, 0, G_OPTION_ARG_INT, &bearer_stats_rate,
+        "Refresh rate of bearer statistics read from kernel network interfaces, in seconds",
+        "[SECS]"
+    },
+    {
+        "sms-sink", 0, 0, G_OPTION_ARG_FILENAME, &sms_sink,
+        "Path to a FIFO or unix socket where received SMS messages are delivered",
+        "[PATH]"
+    },
+    {
+        "qmi-state-dir", 0, 0, G_OPTION_ARG_FILENAME, &qmi_state_dir,
+        "Directory where QMI client IDs are kept across restarts",
+        "[PATH]"
+    },
+    {
+        "configure-data-interfaces", 0, 0, G_OPTION_ARG_NONE, &configure_data_interfaces,
+        "Configure link, addresses and routes of raw-IP network interfaces of connected QMI and MBIM bearers",
+        NULL
+    },
     {
         "debug", 0, 0, G_OPTION_ARG_NONE, &debug,
         "Run with extended debugging capabilities",
@@ -132,6 +156,30 @@ mm_context_get_filter_policy (void)
     return filter_policy;
 }
 
+guint
+mm_context_get_bearer_stats_rate (void)
+{
+    return (guint) bearer_stats_rate;
+}
+
+const gchar *
+mm_context_get_sms_sink (void)
+{
+    return sms_sink;
+}
+
+const gchar *
+mm_context_get_qmi_state_dir (void)
+{
+    return qmi_state_dir;
+}
+
+gboolean
+mm_context_get_configure_data_interfaces (void)
+{
+    return configure_data_interfaces;
+}
+
 /*****************************************************************************/
 /* Log context */
 
@@ -340,6 +388,12 @@ mm_context_init (gint argc,
             log_show_ts = TRUE;
     }
 
+    /* Bearer stats rate, if given, must be a positive number of seconds */
+    if (bearer_stats_rate < 0) {
+        g_warning ("error: --bearer-stats-rate must be a positive number of seconds");
+        exit (1);
+    }
+
     /* Initial kernel events processing may only be used if autoscan is disabled */
 #if defined WITH_UDEV
     if (!no_auto_scan && initial_kernel_events) {
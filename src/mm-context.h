@@ -28,9 +28,13 @@
 void mm_context_init (gint    argc,
                       gchar **argv);
 
-gboolean     mm_context_get_debug                 (void);
-const gchar *mm_context_get_initial_kernel_events (void);
-gboolean     mm_context_get_no_auto_scan          (void);
+gboolean     mm_context_get_debug                     (void);
+const gchar *mm_context_get_initial_kernel_events     (void);
+gboolean     mm_context_get_no_auto_scan              (void);
+guint        mm_context_get_bearer_stats_rate         (void);
+const gchar *mm_context_get_sms_sink                  (void);
+const gchar *mm_context_get_qmi_state_dir             (void);
+gboolean     mm_context_get_configure_data_interfaces (void);
 
 /* Filter support */
 MMFilterRule mm_context_get_filter_policy (void);
@@ -14,6 +14,12 @@
  * Copyright (C) 2012 Lanedo GmbH <aleksander@lanedo.com>
  */
 
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <gio/gunixfdlist.h>
+
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
@@ -25,6 +31,9 @@
 
 #define MM_LOCATION_GPS_REFRESH_TIME_SECS 30
 
+/* Largest assistance data file accepted in InjectAssistanceDataFd() */
+#define MAX_ASSISTANCE_DATA_FILE_SIZE (4 * 1024 * 1024)
+
 #define LOCATION_CONTEXT_TAG "location-context-tag"
 
 static GQuark location_context_quark;
@@ -234,6 +243,37 @@ notify_gps_location_update (MMIfaceModemLocation *self,
                                        NULL));
 }
 
+static void
+notify_gps_fix (MMIfaceModemLocation *self,
+                MmGdbusModemLocation *skeleton,
+                MMLocationGpsNmea *location_gps_nmea,
+                MMLocationGpsRaw *location_gps_raw)
+{
+    GVariant *dictionary;
+
+    /* Same rules as for the property: nothing is signaled if the user
+     * didn't want location to be signaled */
+    if (!mm_gdbus_modem_location_get_signals_location (skeleton))
+        return;
+
+    dictionary = build_location_dictionary (NULL,
+                                            NULL,
+                                            location_gps_nmea,
+                                            location_gps_raw,
+                                            NULL);
+    mm_gdbus_modem_location_emit_gps_fix (skeleton, dictionary);
+}
+
+static gboolean
+nmea_trace_is_fix (const gchar *nmea_trace)
+{
+    /* GGA sentences close a fix, whatever the talker ID ($GPGGA, $GNGGA...) */
+    return (nmea_trace[0] == '$' &&
+            nmea_trace[1] != '\0' &&
+            nmea_trace[2] != '\0' &&
+            g_str_has_prefix (&nmea_trace[3], "GGA,"));
+}
+
 void
 mm_iface_modem_location_gps_update (MMIfaceModemLocation *self,
                                     const gchar *nmea_trace)
@@ -242,6 +282,8 @@ mm_iface_modem_location_gps_update (MMIfaceModemLocation *self,
     LocationContext *ctx;
     gboolean update_nmea = FALSE;
     gboolean update_raw = FALSE;
+    gboolean fix_nmea = FALSE;
+    gboolean fix_raw = FALSE;
 
     ctx = get_location_context (self);
     g_object_get (self,
@@ -252,24 +294,36 @@ mm_iface_modem_location_gps_update (MMIfaceModemLocation *self,
 
     if (mm_gdbus_modem_location_get_enabled (skeleton) & MM_MODEM_LOCATION_SOURCE_GPS_NMEA) {
         g_assert (ctx->location_gps_nmea != NULL);
-        if (mm_location_gps_nmea_add_trace (ctx->location_gps_nmea, nmea_trace) &&
-            (ctx->location_gps_nmea_last_time == 0 ||
-             time (NULL) - ctx->location_gps_nmea_last_time >= mm_gdbus_modem_location_get_gps_refresh_rate (skeleton))) {
-            ctx->location_gps_nmea_last_time = time (NULL);
-            update_nmea = TRUE;
+        if (mm_location_gps_nmea_add_trace (ctx->location_gps_nmea, nmea_trace)) {
+            fix_nmea = nmea_trace_is_fix (nmea_trace);
+            if (ctx->location_gps_nmea_last_time == 0 ||
+                time (NULL) - ctx->location_gps_nmea_last_time >= mm_gdbus_modem_location_get_gps_refresh_rate (skeleton)) {
+                ctx->location_gps_nmea_last_time = time (NULL);
+                update_nmea = TRUE;
+            }
         }
     }
 
     if (mm_gdbus_modem_location_get_enabled (skeleton) & MM_MODEM_LOCATION_SOURCE_GPS_RAW) {
         g_assert (ctx->location_gps_raw != NULL);
-        if (mm_location_gps_raw_add_trace (ctx->location_gps_raw, nmea_trace) &&
-            (ctx->location_gps_raw_last_time == 0 ||
-             time (NULL) - ctx->location_gps_raw_last_time >= mm_gdbus_modem_location_get_gps_refresh_rate (skeleton))) {
-            ctx->location_gps_raw_last_time = time (NULL);
-            update_raw = TRUE;
+        if (mm_location_gps_raw_add_trace (ctx->location_gps_raw, nmea_trace)) {
+            fix_raw = TRUE;
+            if (ctx->location_gps_raw_last_time == 0 ||
+                time (NULL) - ctx->location_gps_raw_last_time >= mm_gdbus_modem_location_get_gps_refresh_rate (skeleton)) {
+                ctx->location_gps_raw_last_time = time (NULL);
+                update_raw = TRUE;
+            }
         }
     }
 
+    /* In high rate mode every fix is signaled, regardless of the refresh rate
+     * applied to the Location property */
+    if ((fix_nmea || fix_raw) && mm_gdbus_modem_location_get_gps_high_rate (skeleton))
+        notify_gps_fix (self,
+                        skeleton,
+                        (mm_gdbus_modem_location_get_enabled (skeleton) & MM_MODEM_LOCATION_SOURCE_GPS_NMEA) ? ctx->location_gps_nmea : NULL,
+                        fix_raw ? ctx->location_gps_raw : NULL);
+
     if (update_nmea || update_raw)
         notify_gps_location_update (self,
                                     skeleton,
@@ -1035,21 +1089,50 @@ handle_set_supl_server (MmGdbusModemLocation *skeleton,
 
 /*****************************************************************************/
 
+void
+mm_iface_modem_location_assistance_data_progress (MMIfaceModemLocation *self,
+                                                  gsize                 injected,
+                                                  gsize                 total)
+{
+    MmGdbusModemLocation *skeleton;
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_LOCATION_DBUS_SKELETON, &skeleton,
+                  NULL);
+    if (!skeleton)
+        return;
+
+    mm_gdbus_modem_location_emit_assistance_data_progress (skeleton, (guint) injected, (guint) total);
+    g_object_unref (skeleton);
+}
+
+/* The same context is used for both InjectAssistanceData() and
+ * InjectAssistanceDataFd(); either datav or fd_list is given. In both cases
+ * the context owns the data buffer until the plugin has finished injecting
+ * it, so that plugins don't need to make their own copy. */
 typedef struct {
     MmGdbusModemLocation  *skeleton;
     GDBusMethodInvocation *invocation;
     MMIfaceModemLocation  *self;
     GVariant              *datav;
+    GUnixFDList           *fd_list;
+    gint                   fd_index;
+    GByteArray            *fd_data;
 } HandleInjectAssistanceDataContext;
 
 static void
 handle_inject_assistance_data_context_free (HandleInjectAssistanceDataContext *ctx)
 {
-    g_object_unref  (ctx->skeleton);
-    g_object_unref  (ctx->invocation);
-    g_object_unref  (ctx->self);
-    g_variant_unref (ctx->datav);
-    g_slice_free    (HandleInjectAssistanceDataContext, ctx);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    if (ctx->datav)
+        g_variant_unref (ctx->datav);
+    if (ctx->fd_list)
+        g_object_unref (ctx->fd_list);
+    if (ctx->fd_data)
+        g_byte_array_unref (ctx->fd_data);
+    g_slice_free (HandleInjectAssistanceDataContext, ctx);
 }
 
 static void
@@ -1061,12 +1144,89 @@ inject_assistance_data_ready (MMIfaceModemLocation              *self,
 
     if (!MM_IFACE_MODEM_LOCATION_GET_INTERFACE (self)->inject_assistance_data_finish (self, res, &error))
         g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else if (ctx->fd_list)
+        mm_gdbus_modem_location_complete_inject_assistance_data_fd (ctx->skeleton, ctx->invocation, NULL);
     else
         mm_gdbus_modem_location_complete_inject_assistance_data (ctx->skeleton, ctx->invocation);
 
     handle_inject_assistance_data_context_free (ctx);
 }
 
+/* The file is copied instead of mapped, as the client could truncate it
+ * while the mapping is in use, making the daemon crash with SIGBUS */
+static gboolean
+read_assistance_data_fd (HandleInjectAssistanceDataContext  *ctx,
+                         GError                            **error)
+{
+    gint        fd;
+    struct stat st;
+    gsize       size;
+
+    fd = g_unix_fd_list_get (ctx->fd_list, ctx->fd_index, error);
+    if (fd < 0)
+        return FALSE;
+
+    /* Only regular files, reading from a pipe or socket could block */
+    if (fstat (fd, &st) < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't get assistance data file info: %s", g_strerror (errno));
+        close (fd);
+        return FALSE;
+    }
+    if (!S_ISREG (st.st_mode)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Assistance data must be given in a regular file");
+        close (fd);
+        return FALSE;
+    }
+    if (st.st_size <= 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Assistance data file is empty");
+        close (fd);
+        return FALSE;
+    }
+    if (st.st_size > MAX_ASSISTANCE_DATA_FILE_SIZE) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_TOO_MANY,
+                     "Assistance data file too big: %" G_GINT64_FORMAT " bytes (max %u)",
+                     (gint64) st.st_size, MAX_ASSISTANCE_DATA_FILE_SIZE);
+        close (fd);
+        return FALSE;
+    }
+
+    /* The file may change size while reading it; never read past the size
+     * validated above, and take whatever is there if it is truncated */
+    size = (gsize) st.st_size;
+    ctx->fd_data = g_byte_array_sized_new (size);
+    g_byte_array_set_size (ctx->fd_data, size);
+    size = 0;
+    while (size < ctx->fd_data->len) {
+        gssize n_read;
+
+        n_read = read (fd, &ctx->fd_data->data[size], ctx->fd_data->len - size);
+        if (n_read < 0 && errno == EINTR)
+            continue;
+        if (n_read < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Couldn't read assistance data file: %s", g_strerror (errno));
+            close (fd);
+            return FALSE;
+        }
+        if (n_read == 0)
+            break;
+        size += n_read;
+    }
+    close (fd);
+
+    if (size == 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Assistance data file is empty");
+        return FALSE;
+    }
+    g_byte_array_set_size (ctx->fd_data, size);
+
+    return TRUE;
+}
+
 static void
 handle_inject_assistance_data_auth_ready (MMBaseModem                       *self,
                                           GAsyncResult                      *res,
@@ -1103,7 +1263,17 @@ handle_inject_assistance_data_auth_ready (MMBaseModem                       *sel
         return;
     }
 
-    data = (const guint8 *) g_variant_get_fixed_array (ctx->datav, &data_size, sizeof (guint8));
+    if (ctx->fd_list) {
+        if (!read_assistance_data_fd (ctx, &error)) {
+            g_prefix_error (&error, "Cannot inject assistance data: ");
+            g_dbus_method_invocation_take_error (ctx->invocation, error);
+            handle_inject_assistance_data_context_free (ctx);
+            return;
+        }
+        data = ctx->fd_data->data;
+        data_size = ctx->fd_data->len;
+    } else
+        data = (const guint8 *) g_variant_get_fixed_array (ctx->datav, &data_size, sizeof (guint8));
 
     /* Request to inject assistance data */
     MM_IFACE_MODEM_LOCATION_GET_INTERFACE (self)->inject_assistance_data (ctx->self,
@@ -1121,7 +1291,7 @@ handle_inject_assistance_data (MmGdbusModemLocation  *skeleton,
 {
     HandleInjectAssistanceDataContext *ctx;
 
-    ctx = g_slice_new (HandleInjectAssistanceDataContext);
+    ctx = g_slice_new0 (HandleInjectAssistanceDataContext);
     ctx->skeleton   = g_object_ref (skeleton);
     ctx->invocation = g_object_ref (invocation);
     ctx->self       = g_object_ref (self);
@@ -1135,6 +1305,38 @@ handle_inject_assistance_data (MmGdbusModemLocation  *skeleton,
     return TRUE;
 }
 
+static gboolean
+handle_inject_assistance_data_fd (MmGdbusModemLocation  *skeleton,
+                                  GDBusMethodInvocation *invocation,
+                                  GUnixFDList           *fd_list,
+                                  gint                   fd_index,
+                                  MMIfaceModemLocation  *self)
+{
+    HandleInjectAssistanceDataContext *ctx;
+
+    if (!fd_list) {
+        g_dbus_method_invocation_return_error (invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_INVALID_ARGS,
+                                               "Cannot inject assistance data: no file descriptor given");
+        return TRUE;
+    }
+
+    ctx = g_slice_new0 (HandleInjectAssistanceDataContext);
+    ctx->skeleton   = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self       = g_object_ref (self);
+    ctx->fd_list    = g_object_ref (fd_list);
+    ctx->fd_index   = fd_index;
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_inject_assistance_data_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 typedef struct {
@@ -1222,6 +1424,90 @@ handle_set_gps_refresh_rate (MmGdbusModemLocation *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    MmGdbusModemLocation *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModemLocation *self;
+    gboolean enable;
+} HandleSetGpsHighRateContext;
+
+static void
+handle_set_gps_high_rate_context_free (HandleSetGpsHighRateContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleSetGpsHighRateContext, ctx);
+}
+
+static void
+handle_set_gps_high_rate_auth_ready (MMBaseModem *self,
+                                     GAsyncResult *res,
+                                     HandleSetGpsHighRateContext *ctx)
+{
+    GError *error = NULL;
+    MMModemState modem_state;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_set_gps_high_rate_context_free (ctx);
+        return;
+    }
+
+    modem_state = MM_MODEM_STATE_UNKNOWN;
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &modem_state,
+                  NULL);
+    if (modem_state < MM_MODEM_STATE_ENABLED) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot set GPS high rate mode: "
+                                               "device not yet enabled");
+        handle_set_gps_high_rate_context_free (ctx);
+        return;
+    }
+
+    /* If GPS is NOT supported, set error */
+    if (!(mm_gdbus_modem_location_get_capabilities (ctx->skeleton) & ((MM_MODEM_LOCATION_SOURCE_GPS_RAW |
+                                                                       MM_MODEM_LOCATION_SOURCE_GPS_NMEA)))) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_UNSUPPORTED,
+                                               "Cannot set GPS high rate mode: GPS not supported");
+        handle_set_gps_high_rate_context_free (ctx);
+        return;
+    }
+
+    mm_gdbus_modem_location_set_gps_high_rate (ctx->skeleton, ctx->enable);
+    mm_gdbus_modem_location_complete_set_gps_high_rate (ctx->skeleton, ctx->invocation);
+    handle_set_gps_high_rate_context_free (ctx);
+}
+
+static gboolean
+handle_set_gps_high_rate (MmGdbusModemLocation *skeleton,
+                          GDBusMethodInvocation *invocation,
+                          gboolean enable,
+                          MMIfaceModemLocation *self)
+{
+    HandleSetGpsHighRateContext *ctx;
+
+    ctx = g_slice_new (HandleSetGpsHighRateContext);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+    ctx->enable = enable;
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_set_gps_high_rate_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     MmGdbusModemLocation *skeleton;
     GDBusMethodInvocation *invocation;
@@ -1786,10 +2072,18 @@ interface_initialization_step (GTask *task)
                           "handle-inject-assistance-data",
                           G_CALLBACK (handle_inject_assistance_data),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-inject-assistance-data-fd",
+                          G_CALLBACK (handle_inject_assistance_data_fd),
+                          self);
         g_signal_connect (ctx->skeleton,
                           "handle-set-gps-refresh-rate",
                           G_CALLBACK (handle_set_gps_refresh_rate),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-set-gps-high-rate",
+                          G_CALLBACK (handle_set_gps_high_rate),
+                          self);
         g_signal_connect (ctx->skeleton,
                           "handle-get-location",
                           G_CALLBACK (handle_get_location),
@@ -1837,6 +2131,7 @@ mm_iface_modem_location_initialize (MMIfaceModemLocation *self,
         mm_gdbus_modem_location_set_supported_assistance_data (skeleton, MM_MODEM_LOCATION_ASSISTANCE_DATA_TYPE_NONE);
         mm_gdbus_modem_location_set_enabled (skeleton, MM_MODEM_LOCATION_SOURCE_NONE);
         mm_gdbus_modem_location_set_signals_location (skeleton, FALSE);
+        mm_gdbus_modem_location_set_gps_high_rate (skeleton, FALSE);
         mm_gdbus_modem_location_set_location (skeleton,
                                               build_location_dictionary (NULL, NULL, NULL, NULL, NULL));
 
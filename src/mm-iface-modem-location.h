@@ -93,7 +93,8 @@ struct _MMIfaceModemLocation {
                                         GAsyncResult *res,
                                         GError **error);
 
-    /* Inject assistance data (async) */
+    /* Inject assistance data (async). The data is owned by the caller and is
+     * guaranteed to stay valid until the operation is completed. */
     void     (* inject_assistance_data)       (MMIfaceModemLocation  *self,
                                                const guint8          *data,
                                                gsize                  data_size,
@@ -149,6 +150,11 @@ void mm_iface_modem_location_3gpp_update_lac_tac_ci  (MMIfaceModemLocation *self
 void mm_iface_modem_location_gps_update (MMIfaceModemLocation *self,
                                          const gchar *nmea_trace);
 
+/* Report assistance data injection progress */
+void mm_iface_modem_location_assistance_data_progress (MMIfaceModemLocation *self,
+                                                       gsize                 injected,
+                                                       gsize                 total);
+
 /* Update CDMA BS location */
 void mm_iface_modem_location_cdma_bs_update (MMIfaceModemLocation *self,
                                              gdouble longitude,
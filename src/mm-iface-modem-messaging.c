@@ -25,10 +25,14 @@
 #define SUPPORT_CHECKED_TAG "messaging-support-checked-tag"
 #define SUPPORTED_TAG       "messaging-supported-tag"
 #define STORAGE_CONTEXT_TAG "messaging-storage-context-tag"
+#define SMS_LINK_CONTEXT_TAG "messaging-sms-link-context-tag"
+#define MESSAGE_LIST_UPDATE_TAG "messaging-message-list-update-tag"
 
 static GQuark support_checked_quark;
 static GQuark supported_quark;
 static GQuark storage_context_quark;
+static GQuark sms_link_context_quark;
+static GQuark message_list_update_quark;
 
 /*****************************************************************************/
 
@@ -142,6 +146,89 @@ get_storage_context (MMIfaceModemMessaging *self)
 
 /*****************************************************************************/
 
+typedef struct {
+    /* Number of users requesting the link to be kept open */
+    guint holders;
+    /* Set once the modem rejected the request */
+    gboolean unsupported;
+} SmsLinkContext;
+
+static SmsLinkContext *
+get_sms_link_context (MMIfaceModemMessaging *self)
+{
+    SmsLinkContext *ctx;
+
+    if (G_UNLIKELY (!sms_link_context_quark))
+        sms_link_context_quark = (g_quark_from_static_string (
+                                      SMS_LINK_CONTEXT_TAG));
+
+    ctx = g_object_get_qdata (G_OBJECT (self), sms_link_context_quark);
+    if (!ctx) {
+        /* Create context and keep it as object data */
+        ctx = g_new0 (SmsLinkContext, 1);
+
+        g_object_set_qdata_full (
+            G_OBJECT (self),
+            sms_link_context_quark,
+            ctx,
+            (GDestroyNotify)g_free);
+    }
+
+    return ctx;
+}
+
+static void
+set_more_messages_to_send_ready (MMIfaceModemMessaging *self,
+                                 GAsyncResult *res)
+{
+    GError *error = NULL;
+
+    if (!MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_more_messages_to_send_finish (self, res, &error)) {
+        mm_dbg ("Couldn't update SMS link retention: '%s'; won't try again", error->message);
+        get_sms_link_context (self)->unsupported = TRUE;
+        g_error_free (error);
+    }
+}
+
+static void
+set_more_messages_to_send (MMIfaceModemMessaging *self,
+                           gboolean enable)
+{
+    if (get_sms_link_context (self)->unsupported ||
+        !MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_more_messages_to_send ||
+        !MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_more_messages_to_send_finish)
+        return;
+
+    /* The result isn't waited for: commands are run in order, so the request
+     * always gets to the modem before the messages sent after it */
+    MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_more_messages_to_send (
+        self,
+        enable,
+        (GAsyncReadyCallback)set_more_messages_to_send_ready,
+        NULL);
+}
+
+void
+mm_iface_modem_messaging_hold_sms_link (MMIfaceModemMessaging *self)
+{
+    if (get_sms_link_context (self)->holders++ == 0)
+        set_more_messages_to_send (self, TRUE);
+}
+
+void
+mm_iface_modem_messaging_release_sms_link (MMIfaceModemMessaging *self)
+{
+    SmsLinkContext *ctx;
+
+    ctx = get_sms_link_context (self);
+    g_return_if_fail (ctx->holders > 0);
+
+    if (--ctx->holders == 0)
+        set_more_messages_to_send (self, FALSE);
+}
+
+/*****************************************************************************/
+
 typedef struct {
     MmGdbusModemMessaging *skeleton;
     GDBusMethodInvocation *invocation;
@@ -245,6 +332,209 @@ handle_delete (MmGdbusModemMessaging *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    MmGdbusModemMessaging *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModemMessaging *self;
+    gchar **paths;
+} HandleDeleteMessagesContext;
+
+static void
+handle_delete_messages_context_free (HandleDeleteMessagesContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_strfreev (ctx->paths);
+    g_free (ctx);
+}
+
+static void
+handle_delete_messages_ready (MMSmsList *list,
+                              GAsyncResult *res,
+                              HandleDeleteMessagesContext *ctx)
+{
+    GError *error = NULL;
+    guint n_deleted = 0;
+
+    if (!mm_sms_list_delete_sms_multiple_finish (list, res, &n_deleted, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else
+        mm_gdbus_modem_messaging_complete_delete_messages (ctx->skeleton, ctx->invocation, n_deleted);
+
+    handle_delete_messages_context_free (ctx);
+}
+
+static void
+handle_delete_messages_auth_ready (MMBaseModem *self,
+                                   GAsyncResult *res,
+                                   HandleDeleteMessagesContext *ctx)
+{
+    MMModemState modem_state = MM_MODEM_STATE_UNKNOWN;
+    MMSmsList *list = NULL;
+    GError *error = NULL;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_delete_messages_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &modem_state,
+                  NULL);
+
+    if (modem_state < MM_MODEM_STATE_ENABLED) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot delete SMS: device not yet enabled");
+        handle_delete_messages_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (!list) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot delete SMS: missing SMS list");
+        handle_delete_messages_context_free (ctx);
+        return;
+    }
+
+    mm_sms_list_delete_sms_multiple (list,
+                                     (const gchar *const *)ctx->paths,
+                                     (GAsyncReadyCallback)handle_delete_messages_ready,
+                                     ctx);
+    g_object_unref (list);
+}
+
+static gboolean
+handle_delete_messages (MmGdbusModemMessaging *skeleton,
+                        GDBusMethodInvocation *invocation,
+                        const gchar *const *paths,
+                        MMIfaceModemMessaging *self)
+{
+    HandleDeleteMessagesContext *ctx;
+
+    ctx = g_new (HandleDeleteMessagesContext, 1);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+    ctx->paths = g_strdupv ((gchar **)paths);
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_MESSAGING,
+                             (GAsyncReadyCallback)handle_delete_messages_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    MmGdbusModemMessaging *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModemMessaging *self;
+} HandleDeleteAllContext;
+
+static void
+handle_delete_all_context_free (HandleDeleteAllContext *ctx)
+{
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_free (ctx);
+}
+
+static void
+handle_delete_all_ready (MMSmsList *list,
+                         GAsyncResult *res,
+                         HandleDeleteAllContext *ctx)
+{
+    GError *error = NULL;
+    guint n_deleted = 0;
+
+    if (!mm_sms_list_delete_all_finish (list, res, &n_deleted, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else
+        mm_gdbus_modem_messaging_complete_delete_all (ctx->skeleton, ctx->invocation, n_deleted);
+
+    handle_delete_all_context_free (ctx);
+}
+
+static void
+handle_delete_all_auth_ready (MMBaseModem *self,
+                              GAsyncResult *res,
+                              HandleDeleteAllContext *ctx)
+{
+    MMModemState modem_state = MM_MODEM_STATE_UNKNOWN;
+    MMSmsList *list = NULL;
+    GError *error = NULL;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_delete_all_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &modem_state,
+                  NULL);
+
+    if (modem_state < MM_MODEM_STATE_ENABLED) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot delete SMS: device not yet enabled");
+        handle_delete_all_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (!list) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot delete SMS: missing SMS list");
+        handle_delete_all_context_free (ctx);
+        return;
+    }
+
+    mm_sms_list_delete_all (list,
+                            (GAsyncReadyCallback)handle_delete_all_ready,
+                            ctx);
+    g_object_unref (list);
+}
+
+static gboolean
+handle_delete_all (MmGdbusModemMessaging *skeleton,
+                   GDBusMethodInvocation *invocation,
+                   MMIfaceModemMessaging *self)
+{
+    HandleDeleteAllContext *ctx;
+
+    ctx = g_new (HandleDeleteAllContext, 1);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_MESSAGING,
+                             (GAsyncReadyCallback)handle_delete_all_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 typedef struct {
     MmGdbusModemMessaging *skeleton;
     GDBusMethodInvocation *invocation;
@@ -363,12 +653,173 @@ handle_create (MmGdbusModemMessaging *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    MmGdbusModemMessaging *skeleton;
+    GDBusMethodInvocation *invocation;
+    MMIfaceModemMessaging *self;
+    gchar **paths;
+    GList *sms;
+    GList *current;
+    gboolean need_link_release;
+} HandleSendMessagesContext;
+
+static void
+handle_send_messages_context_free (HandleSendMessagesContext *ctx)
+{
+    if (ctx->need_link_release)
+        mm_iface_modem_messaging_release_sms_link (ctx->self);
+    g_list_free_full (ctx->sms, g_object_unref);
+    g_strfreev (ctx->paths);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->self);
+    g_free (ctx);
+}
+
+static void send_next_message (HandleSendMessagesContext *ctx);
+
+static void
+send_message_ready (MMBaseSms *sms,
+                    GAsyncResult *res,
+                    HandleSendMessagesContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_base_sms_send_finish (sms, res, &error)) {
+        g_prefix_error (&error, "Couldn't send SMS '%s': ", mm_base_sms_get_path (sms));
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    ctx->current = g_list_next (ctx->current);
+    send_next_message (ctx);
+}
+
+static void
+send_next_message (HandleSendMessagesContext *ctx)
+{
+    if (!ctx->current) {
+        mm_gdbus_modem_messaging_complete_send_messages (ctx->skeleton, ctx->invocation);
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    mm_base_sms_send (MM_BASE_SMS (ctx->current->data),
+                      (GAsyncReadyCallback)send_message_ready,
+                      ctx);
+}
+
+static void
+handle_send_messages_auth_ready (MMBaseModem *self,
+                                 GAsyncResult *res,
+                                 HandleSendMessagesContext *ctx)
+{
+    MMModemState modem_state = MM_MODEM_STATE_UNKNOWN;
+    MMSmsList *list = NULL;
+    GError *error = NULL;
+    guint i;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &modem_state,
+                  NULL);
+
+    if (modem_state < MM_MODEM_STATE_ENABLED) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot send SMS: device not yet enabled");
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &list,
+                  NULL);
+    if (!list) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_WRONG_STATE,
+                                               "Cannot send SMS: missing SMS list");
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    /* Validate all paths before sending anything */
+    for (i = 0; ctx->paths && ctx->paths[i]; i++) {
+        MMBaseSms *sms;
+
+        sms = mm_sms_list_get_sms (list, ctx->paths[i]);
+        if (!sms) {
+            g_dbus_method_invocation_return_error (ctx->invocation,
+                                                   MM_CORE_ERROR,
+                                                   MM_CORE_ERROR_NOT_FOUND,
+                                                   "No SMS found with path '%s'",
+                                                   ctx->paths[i]);
+            g_object_unref (list);
+            handle_send_messages_context_free (ctx);
+            return;
+        }
+        ctx->sms = g_list_prepend (ctx->sms, sms);
+    }
+    ctx->sms = g_list_reverse (ctx->sms);
+    g_object_unref (list);
+
+    if (!ctx->sms) {
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_INVALID_ARGS,
+                                               "No SMS given to send");
+        handle_send_messages_context_free (ctx);
+        return;
+    }
+
+    /* Keep the link open for the whole batch */
+    if (ctx->sms->next) {
+        mm_iface_modem_messaging_hold_sms_link (ctx->self);
+        ctx->need_link_release = TRUE;
+    }
+
+    ctx->current = ctx->sms;
+    send_next_message (ctx);
+}
+
 static gboolean
-handle_list (MmGdbusModemMessaging *skeleton,
-             GDBusMethodInvocation *invocation,
-             MMIfaceModemMessaging *self)
+handle_send_messages (MmGdbusModemMessaging *skeleton,
+                      GDBusMethodInvocation *invocation,
+                      const gchar *const *paths,
+                      MMIfaceModemMessaging *self)
+{
+    HandleSendMessagesContext *ctx;
+
+    ctx = g_new0 (HandleSendMessagesContext, 1);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->self = g_object_ref (self);
+    ctx->paths = g_strdupv ((gchar **)paths);
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_MESSAGING,
+                             (GAsyncReadyCallback)handle_send_messages_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+/* Returns a new reference to the SMS list, or NULL if the invocation was
+ * already completed with an error */
+static MMSmsList *
+get_sms_list_for_listing (MMIfaceModemMessaging *self,
+                          GDBusMethodInvocation *invocation)
 {
-    GStrv paths;
     MMSmsList *list = NULL;
     MMModemState modem_state;
 
@@ -383,7 +834,7 @@ handle_list (MmGdbusModemMessaging *skeleton,
                                                MM_CORE_ERROR_WRONG_STATE,
                                                "Cannot list SMS messages: "
                                                "device not yet enabled");
-        return TRUE;
+        return NULL;
     }
 
     g_object_get (self,
@@ -394,9 +845,24 @@ handle_list (MmGdbusModemMessaging *skeleton,
                                                MM_CORE_ERROR,
                                                MM_CORE_ERROR_WRONG_STATE,
                                                "Cannot list SMS: missing SMS list");
-        return TRUE;
+        return NULL;
     }
 
+    return list;
+}
+
+static gboolean
+handle_list (MmGdbusModemMessaging *skeleton,
+             GDBusMethodInvocation *invocation,
+             MMIfaceModemMessaging *self)
+{
+    GStrv paths;
+    MMSmsList *list;
+
+    list = get_sms_list_for_listing (self, invocation);
+    if (!list)
+        return TRUE;
+
     paths = mm_sms_list_get_paths (list);
     mm_gdbus_modem_messaging_complete_list (skeleton,
                                             invocation,
@@ -406,6 +872,60 @@ handle_list (MmGdbusModemMessaging *skeleton,
     return TRUE;
 }
 
+static gboolean
+handle_list_range (MmGdbusModemMessaging *skeleton,
+                   GDBusMethodInvocation *invocation,
+                   guint offset,
+                   guint count,
+                   MMIfaceModemMessaging *self)
+{
+    GStrv paths;
+    MMSmsList *list;
+
+    list = get_sms_list_for_listing (self, invocation);
+    if (!list)
+        return TRUE;
+
+    paths = mm_sms_list_get_paths_range (list, offset, count);
+    mm_gdbus_modem_messaging_complete_list_range (skeleton,
+                                                  invocation,
+                                                  (const gchar *const *)paths);
+    g_strfreev (paths);
+    g_object_unref (list);
+    return TRUE;
+}
+
+static gboolean
+handle_list_since (MmGdbusModemMessaging *skeleton,
+                   GDBusMethodInvocation *invocation,
+                   guint64 timestamp,
+                   MMIfaceModemMessaging *self)
+{
+    GStrv paths;
+    MMSmsList *list;
+
+    if (timestamp > G_MAXINT64) {
+        g_dbus_method_invocation_return_error (invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_INVALID_ARGS,
+                                               "Invalid timestamp: %" G_GUINT64_FORMAT,
+                                               timestamp);
+        return TRUE;
+    }
+
+    list = get_sms_list_for_listing (self, invocation);
+    if (!list)
+        return TRUE;
+
+    paths = mm_sms_list_get_paths_since (list, (gint64)timestamp);
+    mm_gdbus_modem_messaging_complete_list_since (skeleton,
+                                                  invocation,
+                                                  (const gchar *const *)paths);
+    g_strfreev (paths);
+    g_object_unref (list);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -489,15 +1009,55 @@ mm_iface_modem_messaging_is_storage_supported_for_receiving (MMIfaceModemMessagi
 
 /*****************************************************************************/
 
-static void
-update_message_list (MmGdbusModemMessaging *skeleton,
-                     MMSmsList *list)
+/* Loading a full SMS storage adds messages one by one; instead of building
+ * the whole list of paths for every single message, the 'Messages' property
+ * is refreshed once from an idle. The list pending to be published is kept
+ * in the skeleton. */
+
+static gboolean
+update_message_list_idle (MmGdbusModemMessaging *skeleton)
 {
+    MMSmsList *list;
     gchar **paths;
 
+    list = g_object_steal_qdata (G_OBJECT (skeleton), message_list_update_quark);
+    if (!list)
+        return G_SOURCE_REMOVE;
+
     paths = mm_sms_list_get_paths (list);
     mm_gdbus_modem_messaging_set_messages (skeleton, (const gchar *const *)paths);
     g_strfreev (paths);
+    g_object_unref (list);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+update_message_list (MmGdbusModemMessaging *skeleton,
+                     MMSmsList *list)
+{
+    if (G_UNLIKELY (!message_list_update_quark))
+        message_list_update_quark = g_quark_from_static_string (MESSAGE_LIST_UPDATE_TAG);
+
+    /* Already scheduled? */
+    if (g_object_get_qdata (G_OBJECT (skeleton), message_list_update_quark))
+        return;
+
+    g_object_set_qdata_full (G_OBJECT (skeleton),
+                             message_list_update_quark,
+                             g_object_ref (list),
+                             g_object_unref);
+    g_idle_add_full (G_PRIORITY_DEFAULT_IDLE,
+                     (GSourceFunc)update_message_list_idle,
+                     g_object_ref (skeleton),
+                     g_object_unref);
+}
+
+static void
+cancel_message_list_update (MmGdbusModemMessaging *skeleton)
+{
+    /* The idle will find nothing to publish */
+    if (message_list_update_quark)
+        g_object_set_qdata (G_OBJECT (skeleton), message_list_update_quark, NULL);
 }
 
 static void
@@ -640,6 +1200,7 @@ interface_disabling_step (GTask *task)
 
     case DISABLING_STEP_LAST:
         /* Clear SMS list */
+        cancel_message_list_update (ctx->skeleton);
         g_object_set (self,
                       MM_IFACE_MODEM_MESSAGING_SMS_LIST, NULL,
                       NULL);
@@ -683,71 +1244,41 @@ mm_iface_modem_messaging_disable (MMIfaceModemMessaging *self,
 }
 
 /*****************************************************************************/
+/* Background loading of the initial SMS parts */
 
-typedef struct _EnablingContext EnablingContext;
-static void interface_enabling_step (GTask *task);
-
-typedef enum {
-    ENABLING_STEP_FIRST,
-    ENABLING_STEP_SETUP_SMS_FORMAT,
-    ENABLING_STEP_STORAGE_DEFAULTS,
-    ENABLING_STEP_LOAD_INITIAL_SMS_PARTS,
-    ENABLING_STEP_SETUP_UNSOLICITED_EVENTS,
-    ENABLING_STEP_ENABLE_UNSOLICITED_EVENTS,
-    ENABLING_STEP_LAST
-} EnablingStep;
+/* Storages may be locked for a while, e.g. while reading a message received
+ * right after enabling unsolicited events */
+#define INITIAL_SMS_PARTS_LOAD_RETRY_TIMEOUT_SECS 1
+#define INITIAL_SMS_PARTS_LOAD_MAX_RETRIES        10
 
-struct _EnablingContext {
-    EnablingStep step;
-    MmGdbusModemMessaging *skeleton;
+typedef struct {
+    MMSmsList *list;
     guint mem1_storage_index;
-};
+    guint n_retries;
+} InitialSmsPartsLoadContext;
 
 static void
-enabling_context_free (EnablingContext *ctx)
+initial_sms_parts_load_context_free (InitialSmsPartsLoadContext *ctx)
 {
-    if (ctx->skeleton)
-        g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->list);
     g_free (ctx);
 }
 
-gboolean
-mm_iface_modem_messaging_enable_finish (MMIfaceModemMessaging *self,
-                                        GAsyncResult *res,
-                                        GError **error)
-{
-    return g_task_propagate_boolean (G_TASK (res), error);
-}
+static void initial_sms_parts_load_next (GTask *task);
 
-static void
-setup_sms_format_ready (MMIfaceModemMessaging *self,
-                        GAsyncResult *res,
-                        GTask *task)
+static gboolean
+initial_sms_parts_load_retry_cb (GTask *task)
 {
-    EnablingContext *ctx;
-    GError *error = NULL;
-
-    MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->setup_sms_format_finish (self, res, &error);
-    if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
-
-    /* Go on to next step */
-    ctx = g_task_get_task_data (task);
-    ctx->step++;
-    interface_enabling_step (task);
+    initial_sms_parts_load_next (task);
+    return G_SOURCE_REMOVE;
 }
 
-static void load_initial_sms_parts_from_storages (GTask *task);
-
 static void
 load_initial_sms_parts_ready (MMIfaceModemMessaging *self,
                               GAsyncResult *res,
                               GTask *task)
 {
-    EnablingContext *ctx;
+    InitialSmsPartsLoadContext *ctx;
     GError *error = NULL;
 
     ctx = g_task_get_task_data (task);
@@ -756,6 +1287,16 @@ load_initial_sms_parts_ready (MMIfaceModemMessaging *self,
     if (error) {
         StorageContext *storage_ctx;
 
+        if (g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_RETRY) &&
+            ctx->n_retries < INITIAL_SMS_PARTS_LOAD_MAX_RETRIES) {
+            ctx->n_retries++;
+            g_error_free (error);
+            g_timeout_add_seconds (INITIAL_SMS_PARTS_LOAD_RETRY_TIMEOUT_SECS,
+                                   (GSourceFunc)initial_sms_parts_load_retry_cb,
+                                   task);
+            return;
+        }
+
         storage_ctx = get_storage_context (self);
         mm_dbg ("Couldn't load SMS parts from storage '%s': '%s'",
                 mm_sms_storage_get_string (g_array_index (storage_ctx->supported_mem1,
@@ -767,33 +1308,16 @@ load_initial_sms_parts_ready (MMIfaceModemMessaging *self,
 
     /* Go on with the storage iteration */
     ctx->mem1_storage_index++;
-    load_initial_sms_parts_from_storages (task);
-}
-
-static void
-set_default_storage_ready (MMIfaceModemMessaging *self,
-                           GAsyncResult *res,
-                           GTask *task)
-{
-    EnablingContext *ctx;
-    GError *error = NULL;
-
-    if (!MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_default_storage_finish (self, res, &error)) {
-        mm_warn ("Could not set default storage: '%s'", error->message);
-        g_error_free (error);
-    }
-
-    /* Go on with next step */
-    ctx = g_task_get_task_data (task);
-    ctx->step++;
-    interface_enabling_step (task);
+    ctx->n_retries = 0;
+    initial_sms_parts_load_next (task);
 }
 
 static void
-load_initial_sms_parts_from_storages (GTask *task)
+initial_sms_parts_load_next (GTask *task)
 {
     MMIfaceModemMessaging *self;
-    EnablingContext *ctx;
+    InitialSmsPartsLoadContext *ctx;
+    MMSmsList *current = NULL;
     gboolean all_loaded = FALSE;
     StorageContext *storage_ctx;
 
@@ -801,6 +1325,19 @@ load_initial_sms_parts_from_storages (GTask *task)
     ctx = g_task_get_task_data (task);
     storage_ctx = get_storage_context (self);
 
+    /* Stop if the modem got disabled in the meantime */
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &current,
+                  NULL);
+    if (current)
+        g_object_unref (current);
+    if (current != ctx->list) {
+        mm_dbg ("SMS list changed, aborting initial SMS parts loading");
+        g_task_return_boolean (task, FALSE);
+        g_object_unref (task);
+        return;
+    }
+
     if (!storage_ctx->supported_mem1 || ctx->mem1_storage_index >= storage_ctx->supported_mem1->len)
         all_loaded = TRUE;
     /* We'll skip the 'MT' storage, as that is a combination of 'SM' and 'ME'; but only if
@@ -815,9 +1352,10 @@ load_initial_sms_parts_from_storages (GTask *task)
     }
 
     if (all_loaded) {
-        /* Go on with next step */
-        ctx->step++;
-        interface_enabling_step (task);
+        mm_dbg ("Initial SMS parts loaded: %u messages available",
+                mm_sms_list_get_count (ctx->list));
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
         return;
     }
 
@@ -830,6 +1368,104 @@ load_initial_sms_parts_from_storages (GTask *task)
         task);
 }
 
+/* Messages already stored in the device are loaded in the background, so
+ * that enabling the modem doesn't depend on how full the storages are. Each
+ * message is exported as soon as all its parts are loaded, and reported with
+ * the 'Added' signal as any other one. */
+static void
+initial_sms_parts_load_start (MMIfaceModemMessaging *self)
+{
+    InitialSmsPartsLoadContext *ctx;
+    GTask *task;
+
+    ctx = g_new0 (InitialSmsPartsLoadContext, 1);
+    g_object_get (self,
+                  MM_IFACE_MODEM_MESSAGING_SMS_LIST, &ctx->list,
+                  NULL);
+    g_assert (ctx->list);
+
+    task = g_task_new (self, NULL, NULL, NULL);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)initial_sms_parts_load_context_free);
+
+    initial_sms_parts_load_next (task);
+}
+
+/*****************************************************************************/
+
+typedef struct _EnablingContext EnablingContext;
+static void interface_enabling_step (GTask *task);
+
+typedef enum {
+    ENABLING_STEP_FIRST,
+    ENABLING_STEP_SETUP_SMS_FORMAT,
+    ENABLING_STEP_STORAGE_DEFAULTS,
+    ENABLING_STEP_SETUP_UNSOLICITED_EVENTS,
+    ENABLING_STEP_ENABLE_UNSOLICITED_EVENTS,
+    ENABLING_STEP_LOAD_INITIAL_SMS_PARTS,
+    ENABLING_STEP_LAST
+} EnablingStep;
+
+struct _EnablingContext {
+    EnablingStep step;
+    MmGdbusModemMessaging *skeleton;
+};
+
+static void
+enabling_context_free (EnablingContext *ctx)
+{
+    if (ctx->skeleton)
+        g_object_unref (ctx->skeleton);
+    g_free (ctx);
+}
+
+gboolean
+mm_iface_modem_messaging_enable_finish (MMIfaceModemMessaging *self,
+                                        GAsyncResult *res,
+                                        GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+setup_sms_format_ready (MMIfaceModemMessaging *self,
+                        GAsyncResult *res,
+                        GTask *task)
+{
+    EnablingContext *ctx;
+    GError *error = NULL;
+
+    MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->setup_sms_format_finish (self, res, &error);
+    if (error) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Go on to next step */
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    interface_enabling_step (task);
+}
+
+static void
+set_default_storage_ready (MMIfaceModemMessaging *self,
+                           GAsyncResult *res,
+                           GTask *task)
+{
+    EnablingContext *ctx;
+    GError *error = NULL;
+
+    if (!MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->set_default_storage_finish (self, res, &error)) {
+        mm_warn ("Could not set default storage: '%s'", error->message);
+        g_error_free (error);
+    }
+
+    /* Go on with next step */
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    interface_enabling_step (task);
+}
+
 static void
 setup_unsolicited_events_ready (MMIfaceModemMessaging *self,
                                 GAsyncResult *res,
@@ -1000,16 +1636,6 @@ interface_enabling_step (GTask *task)
         ctx->step++;
     }
 
-    case ENABLING_STEP_LOAD_INITIAL_SMS_PARTS:
-        /* Allow loading the initial list of SMS parts */
-        if (MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts &&
-            MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts_finish) {
-            load_initial_sms_parts_from_storages (task);
-            return;
-        }
-        /* Fall down to next step */
-        ctx->step++;
-
     case ENABLING_STEP_SETUP_UNSOLICITED_EVENTS:
         /* Allow setting up unsolicited events */
         if (MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->setup_unsolicited_events &&
@@ -1036,6 +1662,16 @@ interface_enabling_step (GTask *task)
         /* Fall down to next step */
         ctx->step++;
 
+    case ENABLING_STEP_LOAD_INITIAL_SMS_PARTS:
+        /* Allow loading the initial list of SMS parts. This is done once
+         * unsolicited events are enabled, so that no message received while
+         * loading is lost. */
+        if (MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts &&
+            MM_IFACE_MODEM_MESSAGING_GET_INTERFACE (self)->load_initial_sms_parts_finish)
+            initial_sms_parts_load_start (self);
+        /* Fall down to next step */
+        ctx->step++;
+
     case ENABLING_STEP_LAST:
         /* We are done without errors! */
         g_task_return_boolean (task, TRUE);
@@ -1353,10 +1989,30 @@ interface_initialization_step (GTask *task)
                           "handle-delete",
                           G_CALLBACK (handle_delete),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-delete-messages",
+                          G_CALLBACK (handle_delete_messages),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-delete-all",
+                          G_CALLBACK (handle_delete_all),
+                          self);
         g_signal_connect (ctx->skeleton,
                           "handle-list",
                           G_CALLBACK (handle_list),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-list-range",
+                          G_CALLBACK (handle_list_range),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-list-since",
+                          G_CALLBACK (handle_list_since),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-send-messages",
+                          G_CALLBACK (handle_send_messages),
+                          self);
 
         /* Finally, export the new interface */
         mm_gdbus_object_skeleton_set_modem_messaging (MM_GDBUS_OBJECT_SKELETON (self),
@@ -79,6 +79,15 @@ struct _MMIfaceModemMessaging {
                                             GAsyncResult *res,
                                             GError **error);
 
+    /* Enable or disable keeping the SMS relay link open between messages (async) */
+    void (* set_more_messages_to_send) (MMIfaceModemMessaging *self,
+                                        gboolean enable,
+                                        GAsyncReadyCallback callback,
+                                        gpointer user_data);
+    gboolean (*set_more_messages_to_send_finish) (MMIfaceModemMessaging *self,
+                                                  GAsyncResult *res,
+                                                  GError **error);
+
     /* Setup SMS format (async) */
     void (* setup_sms_format) (MMIfaceModemMessaging *self,
                                GAsyncReadyCallback callback,
@@ -185,6 +194,11 @@ gboolean mm_iface_modem_messaging_is_storage_supported_for_receiving (MMIfaceMod
 /* SMS creation */
 MMBaseSms *mm_iface_modem_messaging_create_sms (MMIfaceModemMessaging *self);
 
+/* Keep the SMS relay link open while sending several messages in a row.
+ * Calls may be nested; the link is released with the last release call. */
+void mm_iface_modem_messaging_hold_sms_link    (MMIfaceModemMessaging *self);
+void mm_iface_modem_messaging_release_sms_link (MMIfaceModemMessaging *self);
+
 /* Look for a new valid multipart reference */
 guint8 mm_iface_modem_messaging_get_local_multipart_reference (MMIfaceModemMessaging *self,
                                                                const gchar *number,
@@ -13,6 +13,8 @@
  * Copyright (C) 2013 Aleksander Morgado <aleksander@gnu.org>
  */
 
+#include <stdlib.h>
+
 #include <ModemManager.h>
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
@@ -24,10 +26,15 @@
 #define SUPPORT_CHECKED_TAG "signal-support-checked-tag"
 #define SUPPORTED_TAG       "signal-supported-tag"
 #define REFRESH_CONTEXT_TAG "signal-refresh-context-tag"
+#define HISTORY_CONTEXT_TAG "signal-history-context-tag"
+
+/* Each sample takes 320 bytes, so limit the history to ~1MB per modem */
+#define HISTORY_SIZE_MAX 3600
 
 static GQuark support_checked_quark;
 static GQuark supported_quark;
 static GQuark refresh_context_quark;
+static GQuark history_context_quark;
 
 /*****************************************************************************/
 
@@ -71,6 +78,245 @@ clear_values (MMIfaceModemSignal *self)
     g_object_unref (skeleton);
 }
 
+/*****************************************************************************/
+/* Signal history */
+
+typedef enum {
+    SIGNAL_TECH_CDMA,
+    SIGNAL_TECH_EVDO,
+    SIGNAL_TECH_GSM,
+    SIGNAL_TECH_UMTS,
+    SIGNAL_TECH_LTE,
+    SIGNAL_TECH_LAST
+} SignalTech;
+
+static const gchar *signal_tech_str[SIGNAL_TECH_LAST] = {
+    [SIGNAL_TECH_CDMA] = "cdma",
+    [SIGNAL_TECH_EVDO] = "evdo",
+    [SIGNAL_TECH_GSM]  = "gsm",
+    [SIGNAL_TECH_UMTS] = "umts",
+    [SIGNAL_TECH_LTE]  = "lte",
+};
+
+typedef enum {
+    SIGNAL_VALUE_RSSI,
+    SIGNAL_VALUE_ECIO,
+    SIGNAL_VALUE_SINR,
+    SIGNAL_VALUE_IO,
+    SIGNAL_VALUE_RSCP,
+    SIGNAL_VALUE_RSRQ,
+    SIGNAL_VALUE_RSRP,
+    SIGNAL_VALUE_SNR,
+    SIGNAL_VALUE_LAST
+} SignalValue;
+
+/* Keys match the ones used in the per-technology dictionaries */
+static const struct {
+    const gchar *key;
+    gdouble    (*get) (MMSignal *self);
+} signal_values[SIGNAL_VALUE_LAST] = {
+    [SIGNAL_VALUE_RSSI] = { "rssi", mm_signal_get_rssi },
+    [SIGNAL_VALUE_ECIO] = { "ecio", mm_signal_get_ecio },
+    [SIGNAL_VALUE_SINR] = { "sinr", mm_signal_get_sinr },
+    [SIGNAL_VALUE_IO]   = { "io",   mm_signal_get_io   },
+    [SIGNAL_VALUE_RSCP] = { "rscp", mm_signal_get_rscp },
+    [SIGNAL_VALUE_RSRQ] = { "rsrq", mm_signal_get_rsrq },
+    [SIGNAL_VALUE_RSRP] = { "rsrp", mm_signal_get_rsrp },
+    [SIGNAL_VALUE_SNR]  = { "snr",  mm_signal_get_snr  },
+};
+
+/* A sample is the full matrix of values, MM_SIGNAL_UNKNOWN if not given */
+#define SAMPLE_N_VALUES (SIGNAL_TECH_LAST * SIGNAL_VALUE_LAST)
+
+typedef struct {
+    guint    size;
+    guint    n_samples;
+    guint    next;
+    gdouble *samples;
+} HistoryContext;
+
+static void
+history_context_free (HistoryContext *ctx)
+{
+    g_free (ctx->samples);
+    g_slice_free (HistoryContext, ctx);
+}
+
+static HistoryContext *
+get_history_context (MMIfaceModemSignal *self)
+{
+    if (G_UNLIKELY (!history_context_quark))
+        history_context_quark = g_quark_from_static_string (HISTORY_CONTEXT_TAG);
+    return (HistoryContext *) g_object_get_qdata (G_OBJECT (self), history_context_quark);
+}
+
+static void
+setup_history_context (MMIfaceModemSignal *self,
+                       guint               size)
+{
+    HistoryContext *ctx;
+
+    if (G_UNLIKELY (!history_context_quark))
+        history_context_quark = g_quark_from_static_string (HISTORY_CONTEXT_TAG);
+
+    if (!size) {
+        mm_dbg ("Extended signal information history disabled");
+        g_object_set_qdata (G_OBJECT (self), history_context_quark, NULL);
+        return;
+    }
+
+    ctx = get_history_context (self);
+    if (ctx && ctx->size == size)
+        return;
+
+    mm_dbg ("Extended signal information history enabled (size: %u samples)", size);
+    ctx = g_slice_new0 (HistoryContext);
+    ctx->size = size;
+    ctx->samples = g_new (gdouble, (gsize) size * SAMPLE_N_VALUES);
+    g_object_set_qdata_full (G_OBJECT (self),
+                             history_context_quark,
+                             ctx,
+                             (GDestroyNotify)history_context_free);
+}
+
+static void
+history_add_sample (MMIfaceModemSignal *self,
+                    MMSignal           *signals[SIGNAL_TECH_LAST])
+{
+    HistoryContext *ctx;
+    gdouble        *sample;
+    guint           tech;
+    guint           value;
+
+    ctx = get_history_context (self);
+    if (!ctx)
+        return;
+
+    /* Overwrite the oldest sample once the ring is full */
+    sample = &ctx->samples[ctx->next * SAMPLE_N_VALUES];
+    for (tech = 0; tech < SIGNAL_TECH_LAST; tech++) {
+        for (value = 0; value < SIGNAL_VALUE_LAST; value++)
+            sample[tech * SIGNAL_VALUE_LAST + value] = (signals[tech] ?
+                                                        signal_values[value].get (signals[tech]) :
+                                                        MM_SIGNAL_UNKNOWN);
+    }
+
+    ctx->next = (ctx->next + 1) % ctx->size;
+    if (ctx->n_samples < ctx->size)
+        ctx->n_samples++;
+}
+
+static gint
+cmp_double (gconstpointer a,
+            gconstpointer b)
+{
+    gdouble da = *((const gdouble *)a);
+    gdouble db = *((const gdouble *)b);
+
+    return (da > db) - (da < db);
+}
+
+/* Nearest-rank percentile over a sorted array */
+static gdouble
+percentile (const gdouble *sorted,
+            guint          n,
+            guint          p)
+{
+    guint rank;
+
+    rank = (p * n + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static GVariant *
+history_build_value_stats (HistoryContext *ctx,
+                           guint           offset)
+{
+    GVariantBuilder  builder;
+    GVariantBuilder  values_builder;
+    gdouble         *sorted;
+    gdouble          sum = 0;
+    guint            n = 0;
+    guint            first;
+    guint            i;
+
+    sorted = g_new (gdouble, ctx->n_samples);
+    g_variant_builder_init (&values_builder, G_VARIANT_TYPE ("ad"));
+
+    /* Walk from oldest to newest */
+    first = (ctx->next + ctx->size - ctx->n_samples) % ctx->size;
+    for (i = 0; i < ctx->n_samples; i++) {
+        gdouble value;
+
+        value = ctx->samples[((first + i) % ctx->size) * SAMPLE_N_VALUES + offset];
+        if (value == MM_SIGNAL_UNKNOWN)
+            continue;
+        g_variant_builder_add (&values_builder, "d", value);
+        sorted[n++] = value;
+        sum += value;
+    }
+
+    if (!n) {
+        g_variant_builder_clear (&values_builder);
+        g_free (sorted);
+        return NULL;
+    }
+
+    qsort (sorted, n, sizeof (gdouble), cmp_double);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "samples", g_variant_new_uint32 (n));
+    g_variant_builder_add (&builder, "{sv}", "min",     g_variant_new_double (sorted[0]));
+    g_variant_builder_add (&builder, "{sv}", "max",     g_variant_new_double (sorted[n - 1]));
+    g_variant_builder_add (&builder, "{sv}", "mean",    g_variant_new_double (sum / n));
+    g_variant_builder_add (&builder, "{sv}", "p50",     g_variant_new_double (percentile (sorted, n, 50)));
+    g_variant_builder_add (&builder, "{sv}", "p90",     g_variant_new_double (percentile (sorted, n, 90)));
+    g_variant_builder_add (&builder, "{sv}", "p95",     g_variant_new_double (percentile (sorted, n, 95)));
+    g_variant_builder_add (&builder, "{sv}", "values",  g_variant_builder_end (&values_builder));
+    g_free (sorted);
+
+    return g_variant_builder_end (&builder);
+}
+
+static GVariant *
+history_build_dictionary (MMIfaceModemSignal *self)
+{
+    HistoryContext  *ctx;
+    GVariantBuilder  builder;
+    guint            tech;
+    guint            value;
+
+    ctx = get_history_context (self);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "samples", g_variant_new_uint32 (ctx ? ctx->n_samples : 0));
+    if (!ctx || !ctx->n_samples)
+        return g_variant_builder_end (&builder);
+
+    for (tech = 0; tech < SIGNAL_TECH_LAST; tech++) {
+        GVariantBuilder tech_builder;
+        gboolean        tech_found = FALSE;
+
+        g_variant_builder_init (&tech_builder, G_VARIANT_TYPE ("a{sv}"));
+        for (value = 0; value < SIGNAL_VALUE_LAST; value++) {
+            GVariant *stats;
+
+            stats = history_build_value_stats (ctx, tech * SIGNAL_VALUE_LAST + value);
+            if (stats) {
+                g_variant_builder_add (&tech_builder, "{sv}", signal_values[value].key, stats);
+                tech_found = TRUE;
+            }
+        }
+
+        if (tech_found)
+            g_variant_builder_add (&builder, "{sv}", signal_tech_str[tech], g_variant_builder_end (&tech_builder));
+        else
+            g_variant_builder_clear (&tech_builder);
+    }
+
+    return g_variant_builder_end (&builder);
+}
+
 static void
 load_values_ready (MMIfaceModemSignal *self,
                    GAsyncResult *res)
@@ -105,9 +351,26 @@ load_values_ready (MMIfaceModemSignal *self,
     if (!skeleton) {
         mm_warn ("Cannot update extended signal information: "
                  "Couldn't get interface skeleton");
+        g_clear_object (&cdma);
+        g_clear_object (&evdo);
+        g_clear_object (&gsm);
+        g_clear_object (&umts);
+        g_clear_object (&lte);
         return;
     }
 
+    /* Keep the sample in the history, if enabled */
+    {
+        MMSignal *signals[SIGNAL_TECH_LAST];
+
+        signals[SIGNAL_TECH_CDMA] = cdma;
+        signals[SIGNAL_TECH_EVDO] = evdo;
+        signals[SIGNAL_TECH_GSM]  = gsm;
+        signals[SIGNAL_TECH_UMTS] = umts;
+        signals[SIGNAL_TECH_LTE]  = lte;
+        history_add_sample (self, signals);
+    }
+
     if (cdma) {
         dictionary = mm_signal_get_dictionary (cdma);
         mm_gdbus_modem_signal_set_cdma (skeleton, dictionary);
@@ -306,6 +569,122 @@ handle_setup (MmGdbusModemSignal *skeleton,
 
 /*****************************************************************************/
 
+typedef struct {
+    GDBusMethodInvocation *invocation;
+    MmGdbusModemSignal *skeleton;
+    MMIfaceModemSignal *self;
+    guint size;
+} HandleSetupHistoryContext;
+
+static void
+handle_setup_history_context_free (HandleSetupHistoryContext *ctx)
+{
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleSetupHistoryContext, ctx);
+}
+
+static void
+handle_setup_history_auth_ready (MMBaseModem *self,
+                                 GAsyncResult *res,
+                                 HandleSetupHistoryContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else if (ctx->size > HISTORY_SIZE_MAX)
+        g_dbus_method_invocation_return_error (ctx->invocation,
+                                               MM_CORE_ERROR,
+                                               MM_CORE_ERROR_INVALID_ARGS,
+                                               "Cannot setup history: size %u exceeds the maximum (%u)",
+                                               ctx->size, HISTORY_SIZE_MAX);
+    else {
+        setup_history_context (ctx->self, ctx->size);
+        mm_gdbus_modem_signal_set_history_size (ctx->skeleton, ctx->size);
+        mm_gdbus_modem_signal_complete_setup_history (ctx->skeleton, ctx->invocation);
+    }
+    handle_setup_history_context_free (ctx);
+}
+
+static gboolean
+handle_setup_history (MmGdbusModemSignal *skeleton,
+                      GDBusMethodInvocation *invocation,
+                      guint size,
+                      MMIfaceModemSignal *self)
+{
+    HandleSetupHistoryContext *ctx;
+
+    ctx = g_slice_new (HandleSetupHistoryContext);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->self = g_object_ref (self);
+    ctx->size = size;
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_setup_history_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GDBusMethodInvocation *invocation;
+    MmGdbusModemSignal *skeleton;
+    MMIfaceModemSignal *self;
+} HandleGetHistoryContext;
+
+static void
+handle_get_history_context_free (HandleGetHistoryContext *ctx)
+{
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleGetHistoryContext, ctx);
+}
+
+static void
+handle_get_history_auth_ready (MMBaseModem *self,
+                               GAsyncResult *res,
+                               HandleGetHistoryContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else
+        mm_gdbus_modem_signal_complete_get_history (ctx->skeleton,
+                                                    ctx->invocation,
+                                                    history_build_dictionary (ctx->self));
+    handle_get_history_context_free (ctx);
+}
+
+static gboolean
+handle_get_history (MmGdbusModemSignal *skeleton,
+                    GDBusMethodInvocation *invocation,
+                    MMIfaceModemSignal *self)
+{
+    HandleGetHistoryContext *ctx;
+
+    ctx = g_slice_new (HandleGetHistoryContext);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->self = g_object_ref (self);
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_get_history_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 gboolean
 mm_iface_modem_signal_disable_finish (MMIfaceModemSignal *self,
                                       GAsyncResult *res,
@@ -492,6 +871,14 @@ interface_initialization_step (GTask *task)
                           "handle-setup",
                           G_CALLBACK (handle_setup),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-setup-history",
+                          G_CALLBACK (handle_setup_history),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-get-history",
+                          G_CALLBACK (handle_get_history),
+                          self);
         /* Finally, export the new interface */
         mm_gdbus_object_skeleton_set_modem_signal (MM_GDBUS_OBJECT_SKELETON (self),
                                                    MM_GDBUS_MODEM_SIGNAL (ctx->skeleton));
@@ -544,6 +931,9 @@ mm_iface_modem_signal_shutdown (MMIfaceModemSignal *self)
     /* Teardown refresh context */
     teardown_refresh_context (self);
 
+    /* Drop history */
+    setup_history_context (self, 0);
+
     /* Unexport DBus interface and remove the skeleton */
     mm_gdbus_object_skeleton_set_modem_signal (MM_GDBUS_OBJECT_SKELETON (self), NULL);
     g_object_set (self,
@@ -28,6 +28,107 @@
 #include "mm-iface-modem-simple.h"
 #include "mm-log.h"
 
+/*****************************************************************************/
+/* Connection time histograms */
+
+#define CONNECTION_HISTOGRAMS_TAG "connection-histograms-tag"
+static GQuark connection_histograms_quark;
+
+/* Upper limits of the histogram buckets, in milliseconds; an additional
+ * bucket gets anything above the last limit */
+static const guint32 histogram_limits[] = { 1000, 2000, 5000, 10000, 20000, 30000, 60000, 120000 };
+#define HISTOGRAM_BUCKETS (G_N_ELEMENTS (histogram_limits) + 1)
+
+typedef struct {
+    guint connections;
+    guint retries;
+    guint32 time_to_registered[HISTOGRAM_BUCKETS];
+    guint32 time_to_connected[HISTOGRAM_BUCKETS];
+    guint32 time_to_ip[HISTOGRAM_BUCKETS];
+} ConnectionHistograms;
+
+static ConnectionHistograms *
+get_connection_histograms (MMIfaceModemSimple *self)
+{
+    ConnectionHistograms *histograms;
+
+    if (G_UNLIKELY (!connection_histograms_quark))
+        connection_histograms_quark = g_quark_from_static_string (CONNECTION_HISTOGRAMS_TAG);
+
+    histograms = g_object_get_qdata (G_OBJECT (self), connection_histograms_quark);
+    if (!histograms) {
+        histograms = g_new0 (ConnectionHistograms, 1);
+        g_object_set_qdata_full (G_OBJECT (self), connection_histograms_quark, histograms, g_free);
+    }
+    return histograms;
+}
+
+static void
+histogram_add (guint32 *histogram,
+               guint    value)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (histogram_limits); i++) {
+        if (value <= histogram_limits[i])
+            break;
+    }
+    histogram[i]++;
+}
+
+void
+mm_iface_modem_simple_report_connection_times (MMIfaceModemSimple *self,
+                                               guint               time_to_registered,
+                                               guint               time_to_connected,
+                                               guint               time_to_ip,
+                                               guint               retries)
+{
+    ConnectionHistograms *histograms;
+
+    histograms = get_connection_histograms (self);
+    histograms->connections++;
+    histograms->retries += retries;
+    if (time_to_registered != G_MAXUINT)
+        histogram_add (histograms->time_to_registered, time_to_registered);
+    if (time_to_connected != G_MAXUINT)
+        histogram_add (histograms->time_to_connected, time_to_connected);
+    if (time_to_ip != G_MAXUINT)
+        histogram_add (histograms->time_to_ip, time_to_ip);
+}
+
+static GVariant *
+histogram_build_variant (const guint32 *histogram)
+{
+    return g_variant_new_fixed_array (G_VARIANT_TYPE_UINT32, histogram, HISTOGRAM_BUCKETS, sizeof (guint32));
+}
+
+static GVariant *
+connection_histograms_build_dictionary (MMIfaceModemSimple *self)
+{
+    GVariantBuilder       builder;
+    ConnectionHistograms *histograms;
+
+    histograms = get_connection_histograms (self);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "connections",
+                           g_variant_new_uint32 (histograms->connections));
+    g_variant_builder_add (&builder, "{sv}", "retries",
+                           g_variant_new_uint32 (histograms->retries));
+    g_variant_builder_add (&builder, "{sv}", "bucket-limits",
+                           g_variant_new_fixed_array (G_VARIANT_TYPE_UINT32,
+                                                      histogram_limits,
+                                                      G_N_ELEMENTS (histogram_limits),
+                                                      sizeof (guint32)));
+    g_variant_builder_add (&builder, "{sv}", "time-to-registered",
+                           histogram_build_variant (histograms->time_to_registered));
+    g_variant_builder_add (&builder, "{sv}", "time-to-connected",
+                           histogram_build_variant (histograms->time_to_connected));
+    g_variant_builder_add (&builder, "{sv}", "time-to-ip",
+                           histogram_build_variant (histograms->time_to_ip));
+    return g_variant_builder_end (&builder);
+}
+
 /*****************************************************************************/
 /* Register in either a CDMA or a 3GPP network (or both) */
 
@@ -36,6 +137,7 @@ typedef struct {
     guint remaining_tries_cdma;
     guint remaining_tries_3gpp;
     guint max_try_time;
+    guint retries;
 } RegisterInNetworkContext;
 
 static void
@@ -48,8 +150,14 @@ register_in_network_context_free (RegisterInNetworkContext *ctx)
 static gboolean
 register_in_3gpp_or_cdma_network_finish (MMIfaceModemSimple *self,
                                          GAsyncResult *res,
+                                         guint *retries,
                                          GError **error)
 {
+    RegisterInNetworkContext *ctx;
+
+    ctx = g_task_get_task_data (G_TASK (res));
+    if (retries)
+        *retries = ctx->retries;
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
@@ -67,6 +175,7 @@ register_in_cdma_network_ready (MMIfaceModemCdma *self,
 
     if (!mm_iface_modem_cdma_register_in_network_finish (self, res, NULL)) {
         /* Retry check */
+        ctx->retries++;
         check_next_registration (task);
         return;
     }
@@ -88,6 +197,7 @@ register_in_3gpp_network_ready (MMIfaceModem3gpp *self,
 
     if (!mm_iface_modem_3gpp_register_in_network_finish (self, res, NULL)) {
         /* Retry check */
+        ctx->retries++;
         check_next_registration (task);
         return;
     }
@@ -198,6 +308,11 @@ typedef struct {
 
     /* Results to set */
     MMBaseBearer *bearer;
+
+    /* Connection trace, in monotonic time */
+    gint64 request_time;
+    gint64 registered_time;
+    guint registration_retries;
 } ConnectionContext;
 
 static void
@@ -262,13 +377,14 @@ register_in_3gpp_or_cdma_network_ready (MMIfaceModemSimple *self,
 {
     GError *error = NULL;
 
-    if (!register_in_3gpp_or_cdma_network_finish (self, res, &error)) {
+    if (!register_in_3gpp_or_cdma_network_finish (self, res, &ctx->registration_retries, &error)) {
         g_dbus_method_invocation_take_error (ctx->invocation, error);
         connection_context_free (ctx);
         return;
     }
 
     /* Registered now! */
+    ctx->registered_time = g_get_monotonic_time ();
     ctx->step++;
     connection_step (ctx);
 }
@@ -591,6 +707,11 @@ connection_step (ConnectionContext *ctx)
         /* Wait... if we're already using an existing bearer, we need to check if it is
          * already connected; and if so, just don't do anything else */
         if (mm_base_bearer_get_status (ctx->bearer) != MM_BEARER_STATUS_CONNECTED) {
+            if (ctx->registered_time)
+                mm_base_bearer_trace_registration (ctx->bearer,
+                                                   ctx->request_time,
+                                                   ctx->registered_time,
+                                                   ctx->registration_retries);
             mm_base_bearer_connect (ctx->bearer,
                                     (GAsyncReadyCallback)connect_bearer_ready,
                                     ctx);
@@ -735,6 +856,7 @@ handle_connect (MmGdbusModemSimple *skeleton,
     ctx->invocation = g_object_ref (invocation);
     ctx->self = g_object_ref (self);
     ctx->dictionary = g_variant_ref (dictionary);
+    ctx->request_time = g_get_monotonic_time ();
 
     mm_base_modem_authorize (MM_BASE_MODEM (self),
                              invocation,
@@ -916,6 +1038,19 @@ handle_get_status (MmGdbusModemSimple *skeleton,
 
 /*****************************************************************************/
 
+static gboolean
+handle_get_connection_histograms (MmGdbusModemSimple *skeleton,
+                                  GDBusMethodInvocation *invocation,
+                                  MMIfaceModemSimple *self)
+{
+    mm_gdbus_modem_simple_complete_get_connection_histograms (skeleton,
+                                                              invocation,
+                                                              connection_histograms_build_dictionary (self));
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 void
 mm_iface_modem_simple_initialize (MMIfaceModemSimple *self)
 {
@@ -945,6 +1080,10 @@ mm_iface_modem_simple_initialize (MMIfaceModemSimple *self)
                           "handle-get-status",
                           G_CALLBACK (handle_get_status),
                           self);
+        g_signal_connect (skeleton,
+                          "handle-get-connection-histograms",
+                          G_CALLBACK (handle_get_connection_histograms),
+                          self);
 
         /* Finally, export the new interface */
         mm_gdbus_object_skeleton_set_modem_simple (MM_GDBUS_OBJECT_SKELETON (self),
@@ -41,4 +41,12 @@ void mm_iface_modem_simple_initialize (MMIfaceModemSimple *self);
 /* Shutdown Modem Simple interface */
 void mm_iface_modem_simple_shutdown (MMIfaceModemSimple *self);
 
+/* Add the times of a successful connection to the per-modem histograms,
+ * in milliseconds; G_MAXUINT if unknown */
+void mm_iface_modem_simple_report_connection_times (MMIfaceModemSimple *self,
+                                                    guint               time_to_registered,
+                                                    guint               time_to_connected,
+                                                    guint               time_to_ip,
+                                                    guint               retries);
+
 #endif /* MM_IFACE_MODEM_SIMPLE_H */
@@ -5415,6 +5415,14 @@ iface_modem_init (gpointer g_iface)
                                FALSE,
                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
 
+    g_object_interface_install_property
+        (g_iface,
+         g_param_spec_boolean (MM_IFACE_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE,
+                               "Connection status indications unreliable",
+                               "Whether bearer disconnections may not be reported with indications, so connection status must be polled.",
+                               FALSE,
+                               G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
     initialized = TRUE;
 }
 
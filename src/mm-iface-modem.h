@@ -39,6 +39,7 @@
 #define MM_IFACE_MODEM_SIM_HOT_SWAP_SUPPORTED  "iface-modem-sim-hot-swap-supported"
 #define MM_IFACE_MODEM_SIM_HOT_SWAP_CONFIGURED "iface-modem-sim-hot-swap-configured"
 #define MM_IFACE_MODEM_PERIODIC_SIGNAL_CHECK_DISABLED "iface-modem-periodic-signal-check-disabled"
+#define MM_IFACE_MODEM_CONNECTION_STATUS_INDICATIONS_UNRELIABLE "iface-modem-connection-status-indications-unreliable"
 
 typedef struct _MMIfaceModem MMIfaceModem;
 
@@ -32,6 +32,7 @@
 #include "mm-modem-helpers.h"
 #include "mm-helper-enums-types.h"
 #include "mm-log.h"
+#include "mm-regex.h"
 
 /*****************************************************************************/
 
@@ -419,6 +420,66 @@ mm_new_iso8601_time (guint year,
     return g_string_free (str, FALSE);
 }
 
+/* Parses the SMS timestamps reported by the SMS parts: "YYMMDDHHMMSS+ZZ" as
+ * decoded from PDUs, with the offset in hours, or "yy/MM/dd,hh:mm:ss+zz" as
+ * reported in text mode, with the offset in quarters of an hour. */
+
+static gboolean
+read_two_digits (const gchar **str,
+                 guint        *out)
+{
+    if (!g_ascii_isdigit ((*str)[0]) || !g_ascii_isdigit ((*str)[1]))
+        return FALSE;
+
+    *out = (g_ascii_digit_value ((*str)[0]) * 10) + g_ascii_digit_value ((*str)[1]);
+    *str += 2;
+    return TRUE;
+}
+
+gboolean
+mm_sms_timestamp_to_unix (const gchar *str,
+                          gint64      *out_unix_time)
+{
+    static const gchar text_separators[] = "//,::";
+    guint      fields[6];
+    guint      offset;
+    gint       offset_minutes;
+    gboolean   text_mode;
+    gboolean   negative;
+    guint      i;
+    GDateTime *dt;
+
+    if (!str)
+        return FALSE;
+
+    text_mode = (strchr (str, '/') != NULL);
+    for (i = 0; i < G_N_ELEMENTS (fields); i++) {
+        if (i > 0 && text_mode && *str++ != text_separators[i - 1])
+            return FALSE;
+        if (!read_two_digits (&str, &fields[i]))
+            return FALSE;
+    }
+
+    if (*str != '+' && *str != '-')
+        return FALSE;
+    negative = (*str++ == '-');
+    if (!read_two_digits (&str, &offset) || *str != '\0')
+        return FALSE;
+
+    offset_minutes = offset * (text_mode ? 15 : 60);
+    if (negative)
+        offset_minutes = -offset_minutes;
+
+    /* Years are given without century */
+    dt = g_date_time_new_utc (2000 + fields[0], fields[1], fields[2], fields[3], fields[4], fields[5]);
+    if (!dt)
+        return FALSE;
+
+    *out_unix_time = g_date_time_to_unix (dt) - (offset_minutes * 60);
+    g_date_time_unref (dt);
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 GArray *
@@ -626,17 +687,14 @@ MMFlowControl
 mm_parse_ifc_test_response (const gchar  *response,
                             GError      **error)
 {
-    GRegex        *r;
-    GError        *inner_error = NULL;
-    GMatchInfo    *match_info  = NULL;
-    MMFlowControl  te_mask     = MM_FLOW_CONTROL_UNKNOWN;
-    MMFlowControl  ta_mask     = MM_FLOW_CONTROL_UNKNOWN;
-    MMFlowControl  mask        = MM_FLOW_CONTROL_UNKNOWN;
-
-    r = g_regex_new ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    static MMRegex  r = MM_REGEX_INIT ("(?:\\+IFC:)?\\s*\\((.*)\\),\\((.*)\\)(?:\\r\\n)?", 0, 0);
+    GError         *inner_error = NULL;
+    GMatchInfo     *match_info  = NULL;
+    MMFlowControl   te_mask     = MM_FLOW_CONTROL_UNKNOWN;
+    MMFlowControl   ta_mask     = MM_FLOW_CONTROL_UNKNOWN;
+    MMFlowControl   mask        = MM_FLOW_CONTROL_UNKNOWN;
+
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -659,7 +717,6 @@ mm_parse_ifc_test_response (const gchar  *response,
 out:
 
     g_clear_pointer (&match_info, g_match_info_free);
-    g_regex_unref (r);
 
     if (inner_error)
         g_propagate_error (error, inner_error);
@@ -946,23 +1003,20 @@ GArray *
 mm_3gpp_parse_ws46_test_response (const gchar  *response,
                                   GError      **error)
 {
-    GArray     *modes = NULL;
-    GArray     *tech_values = NULL;
-    GRegex     *r;
-    GError     *inner_error = NULL;
-    GMatchInfo *match_info = NULL;
-    gchar      *full_list = NULL;
-    guint       val;
-    guint       i;
-    guint       j;
-    gboolean    supported_4g = FALSE;
-    gboolean    supported_3g = FALSE;
-    gboolean    supported_2g = FALSE;
-
-    r = g_regex_new ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    static MMRegex  r = MM_REGEX_INIT ("(?:\\+WS46:)?\\s*\\((.*)\\)(?:\\r\\n)?", 0, 0);
+    GArray         *modes = NULL;
+    GArray         *tech_values = NULL;
+    GError         *inner_error = NULL;
+    GMatchInfo     *match_info = NULL;
+    gchar          *full_list = NULL;
+    guint           val;
+    guint           i;
+    guint           j;
+    gboolean        supported_4g = FALSE;
+    gboolean        supported_3g = FALSE;
+    gboolean        supported_2g = FALSE;
+
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -1038,7 +1092,6 @@ out:
     g_free (full_list);
 
     g_clear_pointer (&match_info, g_match_info_free);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -1126,11 +1179,11 @@ GList *
 mm_3gpp_parse_cops_test_response (const gchar *reply,
                                   GError **error)
 {
-    GRegex *r;
+    static MMRegex umts_regex = MM_REGEX_INIT ("\\((\\d),\"([^\"\\)]*)\",([^,\\)]*),([^,\\)]*)[\\)]?,(\\d)\\)", G_REGEX_UNGREEDY, 0);
+    static MMRegex pre_umts_regex = MM_REGEX_INIT ("\\((\\d),([^,\\)]*),([^,\\)]*),([^\\)]*)\\)", G_REGEX_UNGREEDY, 0);
     GList *info_list = NULL;
     GMatchInfo *match_info;
     gboolean umts_format = TRUE;
-    GError *inner_error = NULL;
 
     g_return_val_if_fail (reply != NULL, NULL);
     if (error)
@@ -1159,19 +1212,8 @@ mm_3gpp_parse_cops_test_response (const gchar *reply,
      *       +COPS: (2,"","T-Mobile","31026",0),(1,"AT&T","AT&T","310410"),0)
      */
 
-    r = g_regex_new ("\\((\\d),\"([^\"\\)]*)\",([^,\\)]*),([^,\\)]*)[\\)]?,(\\d)\\)", G_REGEX_UNGREEDY, 0, &inner_error);
-    if (inner_error) {
-        mm_err ("Invalid regular expression: %s", inner_error->message);
-        g_error_free (inner_error);
-        g_set_error_literal (error,
-                             MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                             "Could not parse scan results");
-        return NULL;
-    }
-
     /* If we didn't get any hits, try the pre-UMTS format match */
-    if (!g_regex_match (r, reply, 0, &match_info)) {
-        g_regex_unref (r);
+    if (!mm_regex_match (&umts_regex, reply, 0, &match_info)) {
         g_match_info_free (match_info);
         match_info = NULL;
 
@@ -1188,17 +1230,7 @@ mm_3gpp_parse_cops_test_response (const gchar *reply,
          *       +COPS: (2,"T - Mobile",,"31026"),(1,"Einstein PCS",,"31064"),(1,"Cingular",,"31041"),,(0,1,3),(0,2)
          */
 
-        r = g_regex_new ("\\((\\d),([^,\\)]*),([^,\\)]*),([^\\)]*)\\)", G_REGEX_UNGREEDY, 0, &inner_error);
-        if (inner_error) {
-            mm_err ("Invalid regular expression: %s", inner_error->message);
-            g_error_free (inner_error);
-            g_set_error_literal (error,
-                                 MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                                 "Could not parse scan results");
-            return NULL;
-        }
-
-        g_regex_match (r, reply, 0, &match_info);
+        mm_regex_match (&pre_umts_regex, reply, 0, &match_info);
         umts_format = FALSE;
     }
 
@@ -1266,7 +1298,6 @@ mm_3gpp_parse_cops_test_response (const gchar *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return info_list;
 }
@@ -1281,7 +1312,7 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
                                   MMModemAccessTechnology  *out_act,
                                   GError                  **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     guint mode = 0;
@@ -1297,10 +1328,7 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
      * or:
      *   +COPS: <mode>,<format>,<oper>,<AcT>
      */
-    r = g_regex_new ("\\+COPS:\\s*(\\d+),(\\d+),([^,]*)(?:,(\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -1335,7 +1363,6 @@ mm_3gpp_parse_cops_read_response (const gchar              *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_free (operator);
@@ -1420,7 +1447,7 @@ GList *
 mm_3gpp_parse_cgdcont_test_response (const gchar *response,
                                      GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     GList *list = NULL;
@@ -1430,12 +1457,7 @@ mm_3gpp_parse_cgdcont_test_response (const gchar *response,
         return NULL;
     }
 
-    r = g_regex_new ("\\+CGDCONT:\\s*\\(\\s*(\\d+)\\s*-?\\s*(\\d+)?[^\\)]*\\)\\s*,\\s*\\(?\"(\\S+)\"",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, &inner_error);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
         gchar *pdp_type_str;
         guint min_cid;
@@ -1472,7 +1494,6 @@ mm_3gpp_parse_cgdcont_test_response (const gchar *response,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         mm_warn ("Unexpected error matching +CGDCONT response: '%s'", inner_error->message);
@@ -1509,7 +1530,7 @@ mm_3gpp_parse_cgdcont_read_response (const gchar *reply,
                                      GError **error)
 {
     GError *inner_error = NULL;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CGDCONT:\\s*(\\d+)\\s*,([^, \\)]*)\\s*,([^, \\)]*)\\s*,([^, \\)]*)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GList *list;
 
@@ -1518,46 +1539,40 @@ mm_3gpp_parse_cgdcont_read_response (const gchar *reply,
         return NULL;
 
     list = NULL;
-    r = g_regex_new ("\\+CGDCONT:\\s*(\\d+)\\s*,([^, \\)]*)\\s*,([^, \\)]*)\\s*,([^, \\)]*)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, &inner_error);
-    if (r) {
-        g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
-
-        while (!inner_error &&
-               g_match_info_matches (match_info)) {
-            gchar *str;
-            MMBearerIpFamily ip_family;
+    mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
 
-            str = mm_get_string_unquoted_from_match_info (match_info, 2);
-            ip_family = mm_3gpp_get_ip_family_from_pdp_type (str);
-            if (ip_family == MM_BEARER_IP_FAMILY_NONE)
-                mm_dbg ("Ignoring PDP context type: '%s'", str);
-            else {
-                MM3gppPdpContext *pdp;
-
-                pdp = g_slice_new0 (MM3gppPdpContext);
-                if (!mm_get_uint_from_match_info (match_info, 1, &pdp->cid)) {
-                    inner_error = g_error_new (MM_CORE_ERROR,
-                                               MM_CORE_ERROR_FAILED,
-                                               "Couldn't parse CID from reply: '%s'",
-                                               reply);
-                    break;
-                }
-                pdp->pdp_type = ip_family;
-                pdp->apn = mm_get_string_unquoted_from_match_info (match_info, 3);
+    while (!inner_error &&
+           g_match_info_matches (match_info)) {
+        gchar *str;
+        MMBearerIpFamily ip_family;
 
-                list = g_list_prepend (list, pdp);
+        str = mm_get_string_unquoted_from_match_info (match_info, 2);
+        ip_family = mm_3gpp_get_ip_family_from_pdp_type (str);
+        if (ip_family == MM_BEARER_IP_FAMILY_NONE)
+            mm_dbg ("Ignoring PDP context type: '%s'", str);
+        else {
+            MM3gppPdpContext *pdp;
+
+            pdp = g_slice_new0 (MM3gppPdpContext);
+            if (!mm_get_uint_from_match_info (match_info, 1, &pdp->cid)) {
+                inner_error = g_error_new (MM_CORE_ERROR,
+                                           MM_CORE_ERROR_FAILED,
+                                           "Couldn't parse CID from reply: '%s'",
+                                           reply);
+                break;
             }
+            pdp->pdp_type = ip_family;
+            pdp->apn = mm_get_string_unquoted_from_match_info (match_info, 3);
 
-            g_free (str);
-            g_match_info_next (match_info, &inner_error);
+            list = g_list_prepend (list, pdp);
         }
 
-        g_match_info_free (match_info);
-        g_regex_unref (r);
+        g_free (str);
+        g_match_info_next (match_info, &inner_error);
     }
 
+    g_match_info_free (match_info);
+
     if (inner_error) {
         mm_3gpp_pdp_context_list_free (list);
         g_propagate_error (error, inner_error);
@@ -1596,7 +1611,7 @@ mm_3gpp_parse_cgact_read_response (const gchar *reply,
                                    GError **error)
 {
     GError *inner_error = NULL;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CGACT:\\s*(\\d+),(\\d+)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info;
     GList *list;
 
@@ -1605,11 +1620,7 @@ mm_3gpp_parse_cgact_read_response (const gchar *reply,
         return NULL;
 
     list = NULL;
-    r = g_regex_new ("\\+CGACT:\\s*(\\d+),(\\d+)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, &inner_error);
-    g_assert (r);
-
-    g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, &inner_error);
     while (!inner_error && g_match_info_matches (match_info)) {
         MM3gppPdpContextActive *pdp_active;
         guint cid = 0;
@@ -1639,7 +1650,6 @@ mm_3gpp_parse_cgact_read_response (const gchar *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         mm_3gpp_pdp_context_active_list_free (list);
@@ -1861,7 +1871,7 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
                                   gboolean *sms_text_supported,
                                   GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0);
     GMatchInfo *match_info;
     gchar *s;
     guint32 min = -1, max = -1;
@@ -1872,18 +1882,13 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
     while (isspace (*reply))
         reply++;
 
-    r = g_regex_new ("\\(?\\s*(\\d+)\\s*[-,]?\\s*(\\d+)?\\s*\\)?", 0, 0, error);
-    if (!r)
-        return FALSE;
-
-    if (!g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
+    if (!mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
                      "Failed to parse CMGF query result '%s'",
                      reply);
         g_match_info_free (match_info);
-        g_regex_unref (r);
         return FALSE;
     }
 
@@ -1904,7 +1909,6 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
     *sms_text_supported = (max >= 1);
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
     return TRUE;
 }
 
@@ -1915,7 +1919,7 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
                                   guint index,
                                   GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0);
     GMatchInfo *match_info;
     gint count;
     gint status;
@@ -1924,10 +1928,7 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
 
     /* +CMGR: <stat>,<alpha>,<length>(whitespace)<pdu> */
     /* The <alpha> and <length> fields are matched, but not currently used */
-    r = g_regex_new ("\\+CMGR:\\s*(\\d+)\\s*,([^,]*),\\s*(\\d+)\\s*([^\\r\\n]*)", 0, 0, NULL);
-    g_assert (r);
-
-    if (!g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
+    if (!mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
         g_set_error (error,
                      MM_CORE_ERROR,
                      MM_CORE_ERROR_FAILED,
@@ -1974,7 +1975,6 @@ mm_3gpp_parse_cmgr_read_response (const gchar *reply,
 
 done:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return info;
 }
@@ -1989,7 +1989,7 @@ mm_3gpp_parse_crsm_response (const gchar *reply,
                              gchar **hex,
                              GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?", G_REGEX_RAW, 0);
     GMatchInfo *match_info;
 
     g_assert (sw1 != NULL);
@@ -2005,17 +2005,12 @@ mm_3gpp_parse_crsm_response (const gchar *reply,
         return FALSE;
     }
 
-    r = g_regex_new ("\\+CRSM:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,\\s*\"?([0-9a-fA-F]+)\"?",
-                     G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
-    if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL) &&
+    if (mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL) &&
         mm_get_uint_from_match_info (match_info, 1, sw1) &&
         mm_get_uint_from_match_info (match_info, 2, sw2))
         *hex = mm_get_string_unquoted_from_match_info (match_info, 3);
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (*hex == NULL) {
         g_set_error (error,
@@ -2091,7 +2086,15 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
                                   gchar       **out_dns_secondary_address,
                                   GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CGCONTRDP: "
+                                       "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
+                                       "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
+                                       "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
+                                       "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
+                                       "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
+                                       "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
+                                       "(?:,(.*))?"    /* others, ignored */
+                                       "(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       cid = 0;
@@ -2119,19 +2122,7 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
      * The format of the response changed in TS 27.007 v9.4.0, we try to detect
      * both formats ('a' if >= v9.4.0, 'b' if < v9.4.0) with a single regex here.
      */
-    r = g_regex_new ("\\+CGCONTRDP: "
-                     "(\\d+),(\\d+),([^,]*)" /* cid, bearer id, apn */
-                     "(?:,([^,]*))?" /* (a)ip+mask        or (b)ip */
-                     "(?:,([^,]*))?" /* (a)gateway        or (b)mask */
-                     "(?:,([^,]*))?" /* (a)dns1           or (b)gateway */
-                     "(?:,([^,]*))?" /* (a)dns2           or (b)dns1 */
-                     "(?:,([^,]*))?" /* (a)p-cscf primary or (b)dns2 */
-                     "(?:,(.*))?"    /* others, ignored */
-                     "(?:\\r\\n)?",
-                     0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -2182,7 +2173,6 @@ mm_3gpp_parse_cgcontrdp_response (const gchar  *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     g_free (local_address_and_subnet);
 
@@ -2232,7 +2222,7 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
                                    guint        *out_state,
                                    GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       state = G_MAXUINT;
@@ -2243,10 +2233,7 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
      * +CFUN: 1,0
      *   ..but we don't care about the second number
      */
-    r = g_regex_new ("\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -2266,7 +2253,6 @@ mm_3gpp_parse_cfun_query_response (const gchar  *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -2289,7 +2275,7 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
                              guint        *out_rsrp,
                              GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0);
     GMatchInfo *match_info;
     GError     *inner_error = NULL;
     guint       rxlev = 99;
@@ -2310,10 +2296,7 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
     /* Response may be e.g.:
      * +CESQ: 99,99,255,255,20,80
      */
-    r = g_regex_new ("\\+CESQ: (\\d+),(\\d+),(\\d+),(\\d+),(\\d+),(\\d+)(?:\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, response, strlen (response), 0, 0, &match_info, &inner_error);
     if (!inner_error && g_match_info_matches (match_info)) {
         if (!mm_get_uint_from_match_info (match_info, 1, &rxlev)) {
             inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Couldn't read RXLEV");
@@ -2344,7 +2327,6 @@ mm_3gpp_parse_cesq_response (const gchar  *response,
 
 out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -2613,7 +2595,7 @@ mm_3gpp_parse_cpms_test_response (const gchar *reply,
                                   GArray **mem2,
                                   GArray **mem3)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\s*\"([^,\\)]+)\"\\s*", 0, 0);
     gchar **split;
     guint i;
     GArray *tmp1 = NULL;
@@ -2637,9 +2619,6 @@ mm_3gpp_parse_cpms_test_response (const gchar *reply,
         return FALSE;
     }
 
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
-    g_assert (r);
-
     for (i = 0; i < N_EXPECTED_GROUPS; i++) {
         GMatchInfo *match_info = NULL;
         GArray *array;
@@ -2648,7 +2627,7 @@ mm_3gpp_parse_cpms_test_response (const gchar *reply,
         array = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
 
         /* Got a range group to match */
-        if (g_regex_match_full (r, split[i], strlen (split[i]), 0, 0, &match_info, NULL)) {
+        if (mm_regex_match_full (&r, split[i], strlen (split[i]), 0, 0, &match_info, NULL)) {
             while (g_match_info_matches (match_info)) {
                 gchar *str;
 
@@ -2677,7 +2656,6 @@ mm_3gpp_parse_cpms_test_response (const gchar *reply,
     }
 
     g_strfreev (split);
-    g_regex_unref (r);
 
     g_warn_if_fail (tmp1 != NULL);
     g_warn_if_fail (tmp2 != NULL);
@@ -2715,15 +2693,11 @@ mm_3gpp_parse_cpms_query_response (const gchar *reply,
                                    MMSmsStorage *memw,
                                    GError **error)
 {
-    GRegex *r = NULL;
+    static MMRegex r = MM_REGEX_INIT (CPMS_QUERY_REGEX, G_REGEX_RAW, 0);
     gboolean ret = FALSE;
     GMatchInfo *match_info = NULL;
 
-    r = g_regex_new (CPMS_QUERY_REGEX, G_REGEX_RAW, 0, NULL);
-
-    g_assert (r);
-
-    if (!g_regex_match (r, reply, 0, &match_info)) {
+    if (!mm_regex_match (&r, reply, 0, &match_info)) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Could not parse CPMS query response '%s'", reply);
         goto end;
@@ -2746,9 +2720,6 @@ mm_3gpp_parse_cpms_query_response (const gchar *reply,
     ret = TRUE;
 
 end:
-    if (r != NULL)
-        g_regex_unref (r);
-
     g_match_info_free (match_info);
 
     return ret;
@@ -2784,7 +2755,7 @@ mm_3gpp_parse_cscs_test_response (const gchar *reply,
                                   MMModemCharset *out_charsets)
 {
     MMModemCharset charsets = MM_MODEM_CHARSET_UNKNOWN;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\s*([^,\\)]+)\\s*", 0, 0);
     GMatchInfo *match_info;
     gchar *p, *str;
     gboolean success = FALSE;
@@ -2808,11 +2779,7 @@ mm_3gpp_parse_cscs_test_response (const gchar *reply,
     }
 
     /* Now parse each charset */
-    r = g_regex_new ("\\s*([^,\\)]+)\\s*", 0, 0, NULL);
-    if (!r)
-        return FALSE;
-
-    if (g_regex_match_full (r, p, strlen (p), 0, 0, &match_info, NULL)) {
+    if (mm_regex_match_full (&r, p, strlen (p), 0, 0, &match_info, NULL)) {
         while (g_match_info_matches (match_info)) {
             str = g_match_info_fetch (match_info, 1);
             charsets |= mm_modem_charset_from_string (str);
@@ -2823,7 +2790,6 @@ mm_3gpp_parse_cscs_test_response (const gchar *reply,
         }
     }
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (success)
         *out_charsets = charsets;
@@ -2837,7 +2803,7 @@ gboolean
 mm_3gpp_parse_clck_test_response (const gchar *reply,
                                   MMModem3gppFacility *out_facilities)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\s*\"([^,\\)]+)\"\\s*", 0, 0);
     GMatchInfo *match_info;
 
     g_return_val_if_fail (reply != NULL, FALSE);
@@ -2850,11 +2816,8 @@ mm_3gpp_parse_clck_test_response (const gchar *reply,
     reply = mm_strip_tag (reply, "+CLCK:");
 
     /* Now parse each facility */
-    r = g_regex_new ("\\s*\"([^,\\)]+)\"\\s*", 0, 0, NULL);
-    g_assert (r != NULL);
-
     *out_facilities = MM_MODEM_3GPP_FACILITY_NONE;
-    if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
+    if (mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
         while (g_match_info_matches (match_info)) {
             gchar *str;
 
@@ -2868,7 +2831,6 @@ mm_3gpp_parse_clck_test_response (const gchar *reply,
         }
     }
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return (*out_facilities != MM_MODEM_3GPP_FACILITY_NONE);
 }
@@ -2879,7 +2841,7 @@ gboolean
 mm_3gpp_parse_clck_write_response (const gchar *reply,
                                    gboolean *enabled)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\s*([01])\\s*", 0, 0);
     GMatchInfo *match_info;
     gboolean success = FALSE;
 
@@ -2888,10 +2850,7 @@ mm_3gpp_parse_clck_write_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, "+CLCK:");
 
-    r = g_regex_new ("\\s*([01])\\s*", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (g_regex_match (r, reply, 0, &match_info)) {
+    if (mm_regex_match (&r, reply, 0, &match_info)) {
         gchar *str;
 
         str = g_match_info_fetch (match_info, 1);
@@ -2910,7 +2869,6 @@ mm_3gpp_parse_clck_write_response (const gchar *reply,
         }
     }
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return success;
 }
@@ -2921,18 +2879,14 @@ GStrv
 mm_3gpp_parse_cnum_exec_response (const gchar *reply)
 {
     GArray *array = NULL;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d", G_REGEX_UNGREEDY, 0);
     GMatchInfo *match_info;
 
     /* Empty strings also return NULL list */
     if (!reply || !reply[0])
         return NULL;
 
-    r = g_regex_new ("\\+CNUM:\\s*((\"([^\"]|(\\\"))*\")|([^,]*)),\"(?<num>\\S+)\",\\d",
-                     G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match (r, reply, 0, &match_info);
+    mm_regex_match (&r, reply, 0, &match_info);
     while (g_match_info_matches (match_info)) {
         gchar *number;
 
@@ -2949,7 +2903,6 @@ mm_3gpp_parse_cnum_exec_response (const gchar *reply)
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return (array ? (GStrv) g_array_free (array, FALSE) : NULL);
 }
@@ -3149,7 +3102,7 @@ mm_3gpp_parse_cind_test_response (const gchar *reply,
                                   GError **error)
 {
     GHashTable *hash;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\(([^,]*),\\((\\d+)[-,](\\d+).*\\)", G_REGEX_UNGREEDY, 0);
     GMatchInfo *match_info;
     guint idx = 1;
 
@@ -3161,17 +3114,9 @@ mm_3gpp_parse_cind_test_response (const gchar *reply,
     while (isspace (*reply))
         reply++;
 
-    r = g_regex_new ("\\(([^,]*),\\((\\d+)[-,](\\d+).*\\)", G_REGEX_UNGREEDY, 0, NULL);
-    if (!r) {
-        g_set_error_literal (error,
-                             MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                             "Could not parse scan results.");
-        return NULL;
-    }
-
     hash = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) cind_response_free);
 
-    if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
+    if (mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
         while (g_match_info_matches (match_info)) {
             MM3gppCindResponse *resp;
             gchar *desc, *tmp;
@@ -3197,7 +3142,6 @@ mm_3gpp_parse_cind_test_response (const gchar *reply,
         }
     }
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return hash;
 }
@@ -3209,7 +3153,7 @@ mm_3gpp_parse_cind_read_response (const gchar *reply,
                                   GError **error)
 {
     GByteArray *array = NULL;
-    GRegex *r = NULL;
+    static MMRegex r = MM_REGEX_INIT ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0);
     GMatchInfo *match_info;
     GError *inner_error = NULL;
     guint8 t;
@@ -3225,10 +3169,7 @@ mm_3gpp_parse_cind_read_response (const gchar *reply,
 
     reply = mm_strip_tag (reply, CIND_TAG);
 
-    r = g_regex_new ("(\\d+)[^0-9]+", G_REGEX_UNGREEDY, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
+    if (!mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, NULL)) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Could not parse the +CIND response '%s': didn't match",
                      reply);
@@ -3270,7 +3211,6 @@ mm_3gpp_parse_cind_read_response (const gchar *reply,
 
 done:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return array;
 }
@@ -3373,7 +3313,11 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
                                    guint        *out_cid,
                                    GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("(?:"
+                                       "REJECT|"
+                                       "NW REACT|"
+                                       "NW DEACT|ME DEACT"
+                                       ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0);
     GMatchInfo *match_info = NULL;
     GError     *inner_error = NULL;
     gchar      *pdp_type = NULL;
@@ -3385,14 +3329,8 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_PDP ||
               type == MM_3GPP_CGEV_ME_DEACT_PDP);
 
-    r = g_regex_new ("(?:"
-                     "REJECT|"
-                     "NW REACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([^,]*),\\s*([^,]*)(?:,\\s*([0-9]+))?", 0, 0, NULL);
-
     str = mm_strip_tag (str, "+CGEV:");
-    g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, str, strlen (str), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -3422,7 +3360,6 @@ mm_3gpp_parse_cgev_indication_pdp (const gchar  *str,
 out:
     if (match_info)
         g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_free (pdp_type);
@@ -3459,7 +3396,10 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
                                        guint        *out_cid,
                                        GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("(?:"
+                                       "NW PDN ACT|ME PDN ACT|"
+                                       "NW PDN DEACT|ME PDN DEACT|"
+                                       ")\\s*([0-9]+)", 0, 0);
     GMatchInfo *match_info = NULL;
     GError     *inner_error = NULL;
     guint       cid = 0;
@@ -3469,13 +3409,8 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
               (type == MM_3GPP_CGEV_NW_DEACT_PRIMARY) ||
               (type == MM_3GPP_CGEV_ME_DEACT_PRIMARY));
 
-    r = g_regex_new ("(?:"
-                     "NW PDN ACT|ME PDN ACT|"
-                     "NW PDN DEACT|ME PDN DEACT|"
-                     ")\\s*([0-9]+)", 0, 0, NULL);
-
     str = mm_strip_tag (str, "+CGEV:");
-    g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, str, strlen (str), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -3492,7 +3427,6 @@ mm_3gpp_parse_cgev_indication_primary (const gchar  *str,
 out:
     if (match_info)
         g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -3518,7 +3452,10 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
                                          guint        *out_event_type,
                                          GError      **error)
 {
-    GRegex     *r;
+    static MMRegex r = MM_REGEX_INIT ("(?:"
+                                       "NW ACT|ME ACT|"
+                                       "NW DEACT|ME DEACT"
+                                       ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0);
     GMatchInfo *match_info = NULL;
     GError     *inner_error = NULL;
     guint       p_cid = 0;
@@ -3530,13 +3467,8 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
               type == MM_3GPP_CGEV_NW_DEACT_SECONDARY ||
               type == MM_3GPP_CGEV_ME_DEACT_SECONDARY);
 
-    r = g_regex_new ("(?:"
-                     "NW ACT|ME ACT|"
-                     "NW DEACT|ME DEACT"
-                     ")\\s*([0-9]+),\\s*([0-9]+),\\s*([0-9]+)", 0, 0, NULL);
-
     str = mm_strip_tag (str, "+CGEV:");
-    g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
+    mm_regex_match_full (&r, str, strlen (str), 0, 0, &match_info, &inner_error);
     if (inner_error)
         goto out;
 
@@ -3563,7 +3495,6 @@ mm_3gpp_parse_cgev_indication_secondary (const gchar  *str,
 out:
     if (match_info)
         g_match_info_free (match_info);
-    g_regex_unref (r);
 
     if (inner_error) {
         g_propagate_error (error, inner_error);
@@ -3594,55 +3525,237 @@ mm_3gpp_pdu_info_list_free (GList *info_list)
     g_list_free_full (info_list, (GDestroyNotify)mm_3gpp_pdu_info_free);
 }
 
-GList *
-mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
-                                 GError **error)
+/* Duplicates the given substring, removing the enclosing quotes and
+ * whitespaces if any. Returns NULL if nothing is left. */
+static gchar *
+cmgl_strndup_unquoted (const gchar *str,
+                       gsize        len)
 {
-    GError *inner_error = NULL;
-    GList *list = NULL;
-    GMatchInfo *match_info;
-    GRegex *r;
+    if ((len >= 2) && (str[0] == '"') && (str[len - 1] == '"')) {
+        str++;
+        len -= 2;
+    }
+
+    while (len > 0 && g_ascii_isspace (str[0])) {
+        str++;
+        len--;
+    }
+    while (len > 0 && g_ascii_isspace (str[len - 1]))
+        len--;
+
+    return (len > 0 ? g_strndup (str, len) : NULL);
+}
+
+/* Parses '\s*(\d+)\s*,' and returns the position right after the comma */
+static const gchar *
+cmgl_parse_int_field (const gchar *p,
+                      gint        *out)
+{
+    gint64 value = 0;
+
+    while (g_ascii_isspace (*p))
+        p++;
+
+    if (!g_ascii_isdigit (*p))
+        return NULL;
+
+    while (g_ascii_isdigit (*p)) {
+        value = (value * 10) + (*p - '0');
+        if (value > G_MAXINT)
+            return NULL;
+        p++;
+    }
+
+    while (g_ascii_isspace (*p))
+        p++;
+
+    if (*p != ',')
+        return NULL;
+
+    *out = (gint) value;
+    return p + 1;
+}
+
+/* Looks for the line following the +CMGL header that starts at 'p'. Returns
+ * the start of the line and sets its length, or NULL if incomplete. */
+static const gchar *
+cmgl_find_data_line (const gchar *p,
+                     gsize       *len)
+{
+    const gchar *line;
+
+    line = strstr (p, "\r\n");
+    if (!line)
+        return NULL;
+
+    line += 2;
+    *len = strcspn (line, "\r\n");
+    return line;
+}
+
+gboolean
+mm_3gpp_parse_pdu_cmgl_response_foreach (const gchar        *str,
+                                         MM3gppPduInfoFunc   callback,
+                                         gpointer            user_data,
+                                         GError            **error)
+{
+    const gchar *p;
+
+    g_return_val_if_fail (str != NULL, FALSE);
+    g_return_val_if_fail (callback != NULL, FALSE);
 
     /*
      * +CMGL: <index>, <status>, [<alpha>], <length>
      *   or
      * +CMGL: <index>, <status>, <length>
      *
-     * We just read <index>, <stat> and the PDU itself.
+     * We just read <index>, <stat> and the PDU itself, which comes in the
+     * next line. The response is scanned just once, and every entry is
+     * reported as soon as it is found.
      */
-    r = g_regex_new ("\\+CMGL:\\s*(\\d+)\\s*,\\s*(\\d+)\\s*,(.*)\\r\\n([^\\r\\n]*)(\\r\\n)?",
-                     G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, str, strlen (str), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
+    p = str;
+    while ((p = strstr (p, "+CMGL:")) != NULL) {
         MM3gppPduInfo *info;
+        const gchar   *header;
+        const gchar   *pdu;
+        gsize          pdu_len;
+        gint           index;
+        gint           status;
+
+        p += strlen ("+CMGL:");
+
+        /* Headers not matching the expected format are skipped */
+        if (!(header = cmgl_parse_int_field (p, &index)) ||
+            !(header = cmgl_parse_int_field (header, &status)))
+            continue;
+
+        pdu = cmgl_find_data_line (header, &pdu_len);
+        if (!pdu)
+            break;
+        p = pdu + pdu_len;
 
         info = g_new0 (MM3gppPduInfo, 1);
-        if (mm_get_int_from_match_info (match_info, 1, &info->index) &&
-            mm_get_int_from_match_info (match_info, 2, &info->status) &&
-            (info->pdu = mm_get_string_unquoted_from_match_info (match_info, 4)) != NULL) {
-            /* Append to our list of results and keep on */
-            list = g_list_append (list, info);
-            g_match_info_next (match_info, &inner_error);
-        } else {
-            inner_error = g_error_new (MM_CORE_ERROR,
-                                       MM_CORE_ERROR_FAILED,
-                                       "Error parsing +CMGL response: '%s'",
-                                       str);
+        info->index = index;
+        info->status = status;
+        info->pdu = cmgl_strndup_unquoted (pdu, pdu_len);
+        if (!info->pdu) {
+            g_free (info);
+            g_set_error (error,
+                         MM_CORE_ERROR,
+                         MM_CORE_ERROR_FAILED,
+                         "Error parsing +CMGL response: '%s'",
+                         str);
+            return FALSE;
         }
+
+        callback (info, user_data);
     }
 
-    g_match_info_free (match_info);
-    g_regex_unref (r);
+    return TRUE;
+}
 
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+static void
+cmgl_pdu_info_prepend (MM3gppPduInfo  *info,
+                       GList         **list)
+{
+    *list = g_list_prepend (*list, info);
+}
+
+GList *
+mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
+                                 GError **error)
+{
+    GList *list = NULL;
+
+    if (!mm_3gpp_parse_pdu_cmgl_response_foreach (str,
+                                                  (MM3gppPduInfoFunc)cmgl_pdu_info_prepend,
+                                                  &list,
+                                                  error)) {
         mm_3gpp_pdu_info_list_free (list);
         return NULL;
     }
 
-    return list;
+    return g_list_reverse (list);
+}
+
+void
+mm_3gpp_text_info_free (MM3gppTextInfo *info)
+{
+    g_free (info->status);
+    g_free (info->number);
+    g_free (info->timestamp);
+    g_free (info->text);
+    g_free (info);
+}
+
+guint
+mm_3gpp_parse_text_cmgl_response_foreach (const gchar        *str,
+                                          MM3gppTextInfoFunc  callback,
+                                          gpointer            user_data)
+{
+    const gchar *p;
+    guint        n_entries = 0;
+
+    g_return_val_if_fail (str != NULL, 0);
+    g_return_val_if_fail (callback != NULL, 0);
+
+    /* +CMGL: <index>,<stat>,<oa/da>,[alpha],<scts><CR><LF><data><CR><LF> */
+    p = str;
+    while ((p = strstr (p, "+CMGL:")) != NULL) {
+        MM3gppTextInfo *info;
+        const gchar    *header;
+        const gchar    *fields[3];
+        gsize           fields_len[3];
+        const gchar    *scts;
+        gsize           scts_len;
+        const gchar    *text;
+        gsize           text_len;
+        gint            index;
+        guint           i;
+
+        p += strlen ("+CMGL:");
+
+        /* Headers not matching the expected format are skipped */
+        if (!(header = cmgl_parse_int_field (p, &index)))
+            continue;
+
+        /* <stat>, <oa/da> and [alpha] are all given in the header line */
+        for (i = 0; i < G_N_ELEMENTS (fields); i++) {
+            while (*header == ' ' || *header == '\t')
+                header++;
+            fields[i] = header;
+            fields_len[i] = strcspn (header, ",\r\n");
+            header += fields_len[i];
+            if (*header != ',')
+                break;
+            header++;
+        }
+        if (i < G_N_ELEMENTS (fields))
+            continue;
+
+        /* <scts> is the rest of the line, as it may include a comma itself */
+        while (*header == ' ' || *header == '\t')
+            header++;
+        scts = header;
+        scts_len = strcspn (header, "\r\n");
+
+        text = cmgl_find_data_line (scts + scts_len, &text_len);
+        if (!text)
+            break;
+        p = text + text_len;
+
+        info = g_new0 (MM3gppTextInfo, 1);
+        info->index = index;
+        info->status = cmgl_strndup_unquoted (fields[0], fields_len[0]);
+        info->number = cmgl_strndup_unquoted (fields[1], fields_len[1]);
+        info->timestamp = cmgl_strndup_unquoted (scts, scts_len);
+        info->text = g_strndup (text, text_len);
+
+        n_entries++;
+        callback (info, user_data);
+    }
+
+    return n_entries;
 }
 
 /*************************************************************************/
@@ -4280,7 +4393,7 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
                                  GError **error)
 {
     gboolean result = FALSE;
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)", G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
 
@@ -4289,12 +4402,7 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
      *   <--- +CRM: (0-2)
      */
 
-    r = g_regex_new ("\\+CRM:\\s*\\((\\d+)-(\\d+)\\)",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW,
-                     0, error);
-    g_assert (r != NULL);
-
-    if (g_regex_match_full (r, reply, strlen (reply), 0, 0, &match_info, &match_error)) {
+    if (mm_regex_match_full (&r, reply, strlen (reply), 0, 0, &match_info, &match_error)) {
         gchar *aux;
         guint min_val = 0;
         guint max_val = 0;
@@ -4336,7 +4444,6 @@ mm_cdma_parse_crm_test_response (const gchar *reply,
     }
 
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return result;
 }
@@ -4564,7 +4671,7 @@ mm_parse_cclk_response (const char *response,
                         MMNetworkTimezone **tzp,
                         GError **error)
 {
-    GRegex *r;
+    static MMRegex r = MM_REGEX_INIT ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0);
     GMatchInfo *match_info = NULL;
     GError *match_error = NULL;
     guint year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
@@ -4577,10 +4684,7 @@ mm_parse_cclk_response (const char *response,
      *  +CCLK: "15/03/05,14:14:26-32"
      *  +CCLK: 17/07/26,11:42:15+01
      */
-    r = g_regex_new ("\\+CCLK:\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)([-+]\\d+)?\"?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    if (!g_regex_match_full (r, response, -1, 0, 0, &match_info, &match_error)) {
+    if (!mm_regex_match_full (&r, response, -1, 0, 0, &match_info, &match_error)) {
         if (match_error) {
             g_propagate_error (error, match_error);
             g_prefix_error (error, "Could not parse +CCLK results: ");
@@ -4648,7 +4752,6 @@ mm_parse_cclk_response (const char *response,
 
  out:
     g_match_info_free (match_info);
-    g_regex_unref (r);
 
     return ret;
 }
@@ -4663,14 +4766,13 @@ mm_parse_csim_response (const gchar *response,
                               GError **error)
 {
     GMatchInfo *match_info = NULL;
-    GRegex *r = NULL;
+    static MMRegex r = MM_REGEX_INIT ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0);
     gchar *str_code = NULL;
     gint retries = -1;
     guint hex_code;
     GError *inner_error = NULL;
 
-    r = g_regex_new ("\\+CSIM:\\s*[0-9]+,\\s*\".*([0-9a-fA-F]{4})\"", G_REGEX_RAW, 0, NULL);
-    g_regex_match (r, response, 0, &match_info);
+    mm_regex_match (&r, response, 0, &match_info);
 
     if (!g_match_info_matches (match_info)) {
         inner_error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
@@ -4725,7 +4827,6 @@ mm_parse_csim_response (const gchar *response,
     retries = (gint)(hex_code - MM_MIN_SIM_RETRY_HEX);
 
 out:
-    g_regex_unref (r);
     g_match_info_free (match_info);
     g_free (str_code);
 
@@ -81,6 +81,8 @@ gchar *mm_new_iso8601_time (guint year,
                             guint second,
                             gboolean have_offset,
                             gint offset_minutes);
+gboolean mm_sms_timestamp_to_unix (const gchar *str,
+                                   gint64      *out_unix_time);
 
 GArray *mm_filter_supported_modes (const GArray *all,
                                    const GArray *supported_combinations);
@@ -325,6 +327,33 @@ void   mm_3gpp_pdu_info_list_free      (GList *info_list);
 GList *mm_3gpp_parse_pdu_cmgl_response (const gchar *str,
                                         GError **error);
 
+/* Reports each entry as soon as it is parsed, passing ownership of the info
+ * to the callback. If an error is returned, the entries found before the
+ * failure have already been reported. */
+typedef void (* MM3gppPduInfoFunc) (MM3gppPduInfo *info,
+                                    gpointer       user_data);
+gboolean mm_3gpp_parse_pdu_cmgl_response_foreach (const gchar        *str,
+                                                  MM3gppPduInfoFunc   callback,
+                                                  gpointer            user_data,
+                                                  GError            **error);
+
+/* AT+CMGL="ALL" (list sms parts in text mode) response parser; returns the
+ * number of entries reported, ownership of each info is passed to the
+ * callback. */
+typedef struct {
+    gint   index;
+    gchar *status;
+    gchar *number;
+    gchar *timestamp;
+    gchar *text;
+} MM3gppTextInfo;
+typedef void (* MM3gppTextInfoFunc) (MM3gppTextInfo *info,
+                                     gpointer        user_data);
+void  mm_3gpp_text_info_free                   (MM3gppTextInfo     *info);
+guint mm_3gpp_parse_text_cmgl_response_foreach (const gchar        *str,
+                                                MM3gppTextInfoFunc  callback,
+                                                gpointer            user_data);
+
 /* AT+CMGR (Read message) response parser */
 MM3gppPduInfo *mm_3gpp_parse_cmgr_read_response (const gchar *reply,
                                                  guint index,
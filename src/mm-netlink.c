@@ -0,0 +1,367 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <config.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "mm-netlink.h"
+#include "mm-log.h"
+
+/* Requests are small: a family specific header and a few attributes. The
+ * kernel acks errors with the request appended, so leave room for it */
+#define REQUEST_SIZE  256
+#define RESPONSE_SIZE 1024
+
+/* The kernel replies right away; this is just a safety net */
+#define RESPONSE_TIMEOUT_SECS 1
+
+/* Bounded, in case the kernel keeps reporting success */
+#define MAX_ADDRESSES_FLUSHED 16
+
+typedef struct {
+    gint    fd;
+    guint32 seq;
+} Netlink;
+
+/*****************************************************************************/
+
+static gboolean
+netlink_open (Netlink  *nl,
+              GError  **error)
+{
+    struct timeval tv = { .tv_sec = RESPONSE_TIMEOUT_SECS };
+
+    nl->seq = 0;
+    nl->fd = socket (AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (nl->fd < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Cannot create netlink socket: %s", g_strerror (errno));
+        return FALSE;
+    }
+
+    setsockopt (nl->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+    return TRUE;
+}
+
+static void
+netlink_close (Netlink *nl)
+{
+    close (nl->fd);
+    nl->fd = -1;
+}
+
+static struct nlmsghdr *
+request_init (guint8  *buffer,
+              guint16  type,
+              guint16  flags,
+              gsize    header_size)
+{
+    struct nlmsghdr *hdr;
+
+    memset (buffer, 0, REQUEST_SIZE);
+    hdr = (struct nlmsghdr *) buffer;
+    hdr->nlmsg_len = NLMSG_LENGTH (header_size);
+    hdr->nlmsg_type = type;
+    hdr->nlmsg_flags = NLM_F_REQUEST | NLM_F_ACK | flags;
+    return hdr;
+}
+
+static void
+request_add_attribute (struct nlmsghdr *hdr,
+                       guint16          type,
+                       gconstpointer    data,
+                       gsize            size)
+{
+    struct rtattr *rta;
+
+    g_assert (NLMSG_ALIGN (hdr->nlmsg_len) + RTA_SPACE (size) <= REQUEST_SIZE);
+
+    rta = (struct rtattr *) (((guint8 *) hdr) + NLMSG_ALIGN (hdr->nlmsg_len));
+    rta->rta_type = type;
+    rta->rta_len = RTA_LENGTH (size);
+    memcpy (RTA_DATA (rta), data, size);
+    hdr->nlmsg_len = NLMSG_ALIGN (hdr->nlmsg_len) + RTA_SPACE (size);
+}
+
+/* Returns 0 on success, or the negative errno reported by the kernel */
+static gint
+netlink_transaction (Netlink         *nl,
+                     struct nlmsghdr *hdr)
+{
+    guint8 response[RESPONSE_SIZE];
+
+    hdr->nlmsg_seq = ++nl->seq;
+    if (send (nl->fd, hdr, hdr->nlmsg_len, 0) < 0)
+        return -errno;
+
+    while (TRUE) {
+        struct nlmsghdr *msg;
+        gssize           len;
+
+        len = recv (nl->fd, response, sizeof (response), 0);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            return -errno;
+        }
+
+        for (msg = (struct nlmsghdr *) response; NLMSG_OK (msg, (gsize) len); msg = NLMSG_NEXT (msg, len)) {
+            if (msg->nlmsg_seq != nl->seq)
+                continue;
+            if (msg->nlmsg_type == NLMSG_ERROR) {
+                if (msg->nlmsg_len < NLMSG_LENGTH (sizeof (struct nlmsgerr)))
+                    return -EBADMSG;
+                return ((struct nlmsgerr *) NLMSG_DATA (msg))->error;
+            }
+        }
+    }
+}
+
+/*****************************************************************************/
+
+static gint
+link_set (Netlink  *nl,
+          guint     ifindex,
+          gboolean  up,
+          guint     mtu)
+{
+    guint8            buffer[REQUEST_SIZE];
+    struct nlmsghdr  *hdr;
+    struct ifinfomsg *ifi;
+
+    hdr = request_init (buffer, RTM_NEWLINK, 0, sizeof (struct ifinfomsg));
+    ifi = NLMSG_DATA (hdr);
+    ifi->ifi_family = AF_UNSPEC;
+    ifi->ifi_index = ifindex;
+    ifi->ifi_flags = up ? IFF_UP : 0;
+    ifi->ifi_change = IFF_UP;
+    if (mtu) {
+        guint32 mtu32 = mtu;
+
+        request_add_attribute (hdr, IFLA_MTU, &mtu32, sizeof (mtu32));
+    }
+
+    return netlink_transaction (nl, hdr);
+}
+
+static gint
+address_add (Netlink      *nl,
+             guint         ifindex,
+             gint          family,
+             gconstpointer address,
+             gsize         address_size,
+             guint         prefix)
+{
+    guint8            buffer[REQUEST_SIZE];
+    struct nlmsghdr  *hdr;
+    struct ifaddrmsg *ifa;
+
+    hdr = request_init (buffer, RTM_NEWADDR, NLM_F_CREATE | NLM_F_REPLACE, sizeof (struct ifaddrmsg));
+    ifa = NLMSG_DATA (hdr);
+    ifa->ifa_family = family;
+    ifa->ifa_prefixlen = prefix;
+    ifa->ifa_scope = RT_SCOPE_UNIVERSE;
+    ifa->ifa_index = ifindex;
+    /* The network already made sure the address is unique */
+    if (family == AF_INET6)
+        ifa->ifa_flags = IFA_F_NODAD;
+    request_add_attribute (hdr, IFA_LOCAL, address, address_size);
+    request_add_attribute (hdr, IFA_ADDRESS, address, address_size);
+
+    return netlink_transaction (nl, hdr);
+}
+
+static gint
+address_delete_any_ipv4 (Netlink *nl,
+                         guint    ifindex)
+{
+    guint8            buffer[REQUEST_SIZE];
+    struct nlmsghdr  *hdr;
+    struct ifaddrmsg *ifa;
+
+    /* Without address attributes, the first address of the interface is
+     * removed */
+    hdr = request_init (buffer, RTM_DELADDR, 0, sizeof (struct ifaddrmsg));
+    ifa = NLMSG_DATA (hdr);
+    ifa->ifa_family = AF_INET;
+    ifa->ifa_index = ifindex;
+
+    return netlink_transaction (nl, hdr);
+}
+
+static gint
+default_route_add (Netlink *nl,
+                   guint    ifindex,
+                   gint     family)
+{
+    guint8            buffer[REQUEST_SIZE];
+    struct nlmsghdr  *hdr;
+    struct rtmsg     *rtm;
+    guint32           oif = ifindex;
+
+    /* There is no link layer, so no need to route through the gateway */
+    hdr = request_init (buffer, RTM_NEWROUTE, NLM_F_CREATE | NLM_F_EXCL, sizeof (struct rtmsg));
+    rtm = NLMSG_DATA (hdr);
+    rtm->rtm_family = family;
+    rtm->rtm_table = RT_TABLE_MAIN;
+    rtm->rtm_protocol = RTPROT_STATIC;
+    rtm->rtm_scope = RT_SCOPE_LINK;
+    rtm->rtm_type = RTN_UNICAST;
+    request_add_attribute (hdr, RTA_OIF, &oif, sizeof (oif));
+
+    return netlink_transaction (nl, hdr);
+}
+
+/*****************************************************************************/
+
+static gboolean
+configure_ip (Netlink           *nl,
+              const gchar       *iface,
+              guint              ifindex,
+              MMBearerIpConfig  *config,
+              gint               family,
+              GError           **error)
+{
+    guint8       address[sizeof (struct in6_addr)];
+    gsize        address_size;
+    const gchar *str;
+    guint        prefix;
+    gint         err;
+
+    if (!config || mm_bearer_ip_config_get_method (config) != MM_BEARER_IP_METHOD_STATIC)
+        return TRUE;
+
+    address_size = (family == AF_INET ? sizeof (struct in_addr) : sizeof (struct in6_addr));
+    str = mm_bearer_ip_config_get_address (config);
+    if (!str || inet_pton (family, str, address) != 1) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "Invalid IP address to configure in '%s': %s", iface, str ? str : "none");
+        return FALSE;
+    }
+
+    /* Without prefix, the address alone is on-link */
+    prefix = mm_bearer_ip_config_get_prefix (config);
+    if (!prefix || prefix > address_size * 8)
+        prefix = address_size * 8;
+
+    err = address_add (nl, ifindex, family, address, address_size, prefix);
+    if (err < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't add address %s/%u to '%s': %s", str, prefix, iface, g_strerror (-err));
+        return FALSE;
+    }
+
+    /* Another interface may be the default route already */
+    err = default_route_add (nl, ifindex, family);
+    if (err == -EEXIST)
+        mm_dbg ("Default %s route already exists, not added for '%s'",
+                family == AF_INET ? "IPv4" : "IPv6", iface);
+    else if (err < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't add default %s route through '%s': %s",
+                     family == AF_INET ? "IPv4" : "IPv6", iface, g_strerror (-err));
+        return FALSE;
+    }
+
+    mm_dbg ("Configured %s/%u in '%s'", str, prefix, iface);
+    return TRUE;
+}
+
+gboolean
+mm_netlink_configure_interface (const gchar       *iface,
+                                MMBearerIpConfig  *ipv4_config,
+                                MMBearerIpConfig  *ipv6_config,
+                                GError           **error)
+{
+    Netlink  nl;
+    guint    ifindex;
+    guint    mtu = 0;
+    gint     err;
+    gboolean success = FALSE;
+
+    ifindex = if_nametoindex (iface);
+    if (!ifindex) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
+                     "Unknown network interface '%s'", iface);
+        return FALSE;
+    }
+
+    if (!netlink_open (&nl, error))
+        return FALSE;
+
+    /* IPv4 and IPv6 may report different MTUs; take the IPv4 one */
+    if (ipv4_config)
+        mtu = mm_bearer_ip_config_get_mtu (ipv4_config);
+    if (!mtu && ipv6_config)
+        mtu = mm_bearer_ip_config_get_mtu (ipv6_config);
+
+    /* Routes can only be added once the link is up */
+    err = link_set (&nl, ifindex, TRUE, mtu);
+    if (err < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't bring up '%s': %s", iface, g_strerror (-err));
+        goto out;
+    }
+
+    if (configure_ip (&nl, iface, ifindex, ipv4_config, AF_INET, error) &&
+        configure_ip (&nl, iface, ifindex, ipv6_config, AF_INET6, error))
+        success = TRUE;
+
+out:
+    netlink_close (&nl);
+    return success;
+}
+
+gboolean
+mm_netlink_reset_interface (const gchar  *iface,
+                            GError      **error)
+{
+    Netlink nl;
+    guint   ifindex;
+    guint   i;
+    gint    err;
+
+    ifindex = if_nametoindex (iface);
+    if (!ifindex) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
+                     "Unknown network interface '%s'", iface);
+        return FALSE;
+    }
+
+    if (!netlink_open (&nl, error))
+        return FALSE;
+
+    /* IPv4 addresses are kept when the link goes down */
+    for (i = 0; i < MAX_ADDRESSES_FLUSHED && address_delete_any_ipv4 (&nl, ifindex) == 0; i++);
+
+    err = link_set (&nl, ifindex, FALSE, 0);
+    netlink_close (&nl);
+
+    if (err < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Couldn't bring down '%s': %s", iface, g_strerror (-err));
+        return FALSE;
+    }
+
+    mm_dbg ("Reset network interface '%s'", iface);
+    return TRUE;
+}
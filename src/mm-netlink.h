@@ -0,0 +1,42 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef MM_NETLINK_H
+#define MM_NETLINK_H
+
+#include <glib.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+/* Configuration of the network interfaces of connected bearers over
+ * rtnetlink, enabled with --configure-data-interfaces. Only meant for
+ * interfaces without link layer (raw-IP), where static IP settings can
+ * be applied as given by the modem, with routes through the device. */
+
+/* Brings the link up with the given MTU, adds the addresses and the default
+ * routes of the IP configurations using the STATIC method. */
+gboolean mm_netlink_configure_interface (const gchar       *iface,
+                                         MMBearerIpConfig  *ipv4_config,
+                                         MMBearerIpConfig  *ipv6_config,
+                                         GError           **error);
+
+/* Removes the IPv4 addresses and brings the link down, which also removes
+ * the routes and IPv6 addresses. */
+gboolean mm_netlink_reset_interface     (const gchar       *iface,
+                                         GError           **error);
+
+#endif /* MM_NETLINK_H */
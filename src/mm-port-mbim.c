@@ -30,9 +30,15 @@
 
 G_DEFINE_TYPE (MMPortMbim, mm_port_mbim, MM_TYPE_PORT)
 
+/* How long a successful query response may be given to later callers */
+#define CACHED_QUERY_VALIDITY_SECS 10
+
 struct _MMPortMbimPrivate {
     gboolean    in_progress;
     MbimDevice *mbim_device;
+    /* Shared query responses, and notifications to invalidate them */
+    GHashTable *cached_queries;
+    gulong      notification_id;
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     QmiDevice  *qmi_device;
     GList      *qmi_clients;
@@ -254,6 +260,7 @@ mbim_device_open_ready (MbimDevice   *mbim_device,
 
     mm_dbg ("[%s] MBIM device is now open",
             mm_port_get_device (MM_PORT (self)));
+    cached_query_track_notifications (self, TRUE);
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     {
@@ -420,6 +427,7 @@ mm_port_mbim_close (MMPortMbim *self,
     }
 
     self->priv->in_progress = TRUE;
+    cached_query_track_notifications (self, FALSE);
 
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     if (self->priv->qmi_device) {
@@ -441,6 +449,330 @@ mm_port_mbim_close (MMPortMbim *self,
     g_clear_object (&self->priv->mbim_device);
 }
 
+/*****************************************************************************/
+/* Shared queries */
+
+typedef struct {
+    /* Last successful response, if any */
+    MbimMessage *response;
+    gint64       response_time;
+    /* Bumped whenever the response is invalidated, so that responses of
+     * queries sent before that are not stored */
+    guint        generation;
+    /* Tasks waiting for the query in flight */
+    gboolean     in_flight;
+    GList       *waiters;
+} CachedQuery;
+
+typedef struct {
+    MMPortMbim *self;
+    gpointer    key;
+    guint       generation;
+} CachedQueryContext;
+
+#define CACHED_QUERY_KEY(service, cid) GUINT_TO_POINTER (((guint)(service) << 16) | ((cid) & 0xFFFF))
+
+static void
+cached_query_free (CachedQuery *query)
+{
+    g_assert (!query->waiters);
+    if (query->response)
+        mbim_message_unref (query->response);
+    g_slice_free (CachedQuery, query);
+}
+
+static void
+cached_query_clear_response (CachedQuery *query)
+{
+    if (query->response) {
+        mbim_message_unref (query->response);
+        query->response = NULL;
+    }
+    query->generation++;
+}
+
+static CachedQuery *
+cached_query_lookup (MMPortMbim *self,
+                     gpointer    key,
+                     gboolean    create)
+{
+    CachedQuery *query;
+
+    if (!self->priv->cached_queries) {
+        if (!create)
+            return NULL;
+        self->priv->cached_queries = g_hash_table_new_full (g_direct_hash,
+                                                            g_direct_equal,
+                                                            NULL,
+                                                            (GDestroyNotify)cached_query_free);
+    }
+
+    query = g_hash_table_lookup (self->priv->cached_queries, key);
+    if (!query && create) {
+        query = g_slice_new0 (CachedQuery);
+        g_hash_table_insert (self->priv->cached_queries, key, query);
+    }
+
+    /* Outdated responses are never given */
+    if (query && query->response &&
+        (g_get_monotonic_time () - query->response_time) > (CACHED_QUERY_VALIDITY_SECS * G_USEC_PER_SEC))
+        cached_query_clear_response (query);
+
+    return query;
+}
+
+void
+mm_port_mbim_invalidate_query (MMPortMbim  *self,
+                               MbimService  service,
+                               guint        cid)
+{
+    CachedQuery *query;
+
+    query = cached_query_lookup (self, CACHED_QUERY_KEY (service, cid), FALSE);
+    if (query)
+        cached_query_clear_response (query);
+}
+
+static void
+cached_queries_invalidate_all (MMPortMbim *self)
+{
+    GHashTableIter  iter;
+    CachedQuery    *query;
+
+    if (!self->priv->cached_queries)
+        return;
+
+    g_hash_table_iter_init (&iter, self->priv->cached_queries);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *)&query))
+        cached_query_clear_response (query);
+}
+
+static void
+cached_query_notification_cb (MbimDevice  *device,
+                              MbimMessage *notification,
+                              MMPortMbim  *self)
+{
+    MbimService service;
+    guint       cid;
+
+    service = mbim_message_indicate_status_get_service (notification);
+    cid = mbim_message_indicate_status_get_cid (notification);
+
+    mm_port_mbim_invalidate_query (self, service, cid);
+
+    /* A different SIM state may also change the PIN and home provider info */
+    if (service == MBIM_SERVICE_BASIC_CONNECT && cid == MBIM_CID_BASIC_CONNECT_SUBSCRIBER_READY_STATUS) {
+        mm_port_mbim_invalidate_query (self, MBIM_SERVICE_BASIC_CONNECT, MBIM_CID_BASIC_CONNECT_PIN);
+        mm_port_mbim_invalidate_query (self, MBIM_SERVICE_BASIC_CONNECT, MBIM_CID_BASIC_CONNECT_HOME_PROVIDER);
+    }
+}
+
+static void
+cached_query_track_notifications (MMPortMbim *self,
+                                  gboolean    track)
+{
+    if (track) {
+        g_assert (self->priv->mbim_device);
+        g_assert (!self->priv->notification_id);
+        self->priv->notification_id = g_signal_connect (self->priv->mbim_device,
+                                                        MBIM_DEVICE_SIGNAL_INDICATE_STATUS,
+                                                        G_CALLBACK (cached_query_notification_cb),
+                                                        self);
+        return;
+    }
+
+    if (self->priv->notification_id) {
+        if (self->priv->mbim_device)
+            g_signal_handler_disconnect (self->priv->mbim_device, self->priv->notification_id);
+        self->priv->notification_id = 0;
+    }
+    cached_queries_invalidate_all (self);
+}
+
+MbimMessage *
+mm_port_mbim_cached_query_finish (MMPortMbim    *self,
+                                  GAsyncResult  *res,
+                                  GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+cached_query_ready (MbimDevice         *device,
+                    GAsyncResult       *res,
+                    CachedQueryContext *ctx)
+{
+    CachedQuery *query;
+    MbimMessage *response;
+    GError      *error = NULL;
+    GList       *waiters;
+    GList       *l;
+
+    response = mbim_device_command_finish (device, res, &error);
+
+    query = cached_query_lookup (ctx->self, ctx->key, TRUE);
+    waiters = query->waiters;
+    query->waiters = NULL;
+    query->in_flight = FALSE;
+
+    /* Only keep successful responses, and only if nothing changed since the
+     * query was sent */
+    if (response &&
+        ctx->generation == query->generation &&
+        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, NULL)) {
+        if (query->response)
+            mbim_message_unref (query->response);
+        query->response = mbim_message_ref (response);
+        query->response_time = g_get_monotonic_time ();
+    }
+
+    for (l = waiters; l; l = g_list_next (l)) {
+        GTask *task = l->data;
+
+        if (response)
+            g_task_return_pointer (task, mbim_message_ref (response), (GDestroyNotify)mbim_message_unref);
+        else
+            g_task_return_error (task, g_error_copy (error));
+        g_object_unref (task);
+    }
+    g_list_free (waiters);
+
+    if (response)
+        mbim_message_unref (response);
+    if (error)
+        g_error_free (error);
+    g_object_unref (ctx->self);
+    g_slice_free (CachedQueryContext, ctx);
+}
+
+static gpointer
+cached_query_key (MbimMessage *message)
+{
+    guint32 len = 0;
+
+    if (mbim_message_get_message_type (message) != MBIM_MESSAGE_TYPE_COMMAND ||
+        mbim_message_command_get_command_type (message) != MBIM_MESSAGE_COMMAND_TYPE_QUERY)
+        return NULL;
+
+    mbim_message_command_get_raw_information_buffer (message, &len);
+    if (len > 0)
+        return NULL;
+
+    return CACHED_QUERY_KEY (mbim_message_command_get_service (message),
+                             mbim_message_command_get_cid (message));
+}
+
+static void
+cached_query_run (MMPortMbim  *self,
+                  MbimMessage *message,
+                  guint        timeout,
+                  GTask       *task)
+{
+    CachedQuery        *query;
+    CachedQueryContext *ctx;
+    gpointer            key;
+
+    key = cached_query_key (message);
+    g_assert (key);
+
+    query = cached_query_lookup (self, key, TRUE);
+
+    if (query->response) {
+        if (task) {
+            mm_dbg ("[%s] reusing '%s' response",
+                    mm_port_get_device (MM_PORT (self)),
+                    mbim_cid_get_printable (mbim_message_command_get_service (message),
+                                            mbim_message_command_get_cid (message)));
+            g_task_return_pointer (task, mbim_message_ref (query->response), (GDestroyNotify)mbim_message_unref);
+            g_object_unref (task);
+        }
+        return;
+    }
+
+    if (task)
+        query->waiters = g_list_append (query->waiters, task);
+
+    if (query->in_flight)
+        return;
+
+    ctx = g_slice_new (CachedQueryContext);
+    ctx->self = g_object_ref (self);
+    ctx->key = key;
+    ctx->generation = query->generation;
+
+    query->in_flight = TRUE;
+    mbim_device_command (self->priv->mbim_device,
+                         message,
+                         timeout,
+                         NULL,
+                         (GAsyncReadyCallback)cached_query_ready,
+                         ctx);
+}
+
+static void
+command_ready (MbimDevice   *device,
+               GAsyncResult *res,
+               GTask        *task)
+{
+    MbimMessage *response;
+    GError      *error = NULL;
+
+    response = mbim_device_command_finish (device, res, &error);
+    if (!response)
+        g_task_return_error (task, error);
+    else
+        g_task_return_pointer (task, response, (GDestroyNotify)mbim_message_unref);
+    g_object_unref (task);
+}
+
+void
+mm_port_mbim_cached_query (MMPortMbim          *self,
+                           MbimMessage         *message,
+                           guint                timeout,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_PORT_MBIM (self));
+
+    task = g_task_new (self, NULL, callback, user_data);
+
+    if (!self->priv->mbim_device) {
+        g_task_return_new_error (task,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_WRONG_STATE,
+                                 "Port not open");
+        g_object_unref (task);
+        return;
+    }
+
+    if (!cached_query_key (message)) {
+        mbim_device_command (self->priv->mbim_device,
+                             message,
+                             timeout,
+                             NULL,
+                             (GAsyncReadyCallback)command_ready,
+                             task);
+        return;
+    }
+
+    cached_query_run (self, message, timeout, task);
+}
+
+void
+mm_port_mbim_prefetch_query (MMPortMbim  *self,
+                             MbimMessage *message,
+                             guint        timeout)
+{
+    g_return_if_fail (MM_IS_PORT_MBIM (self));
+
+    if (!self->priv->mbim_device || !cached_query_key (message))
+        return;
+
+    cached_query_run (self, message, timeout, NULL);
+}
+
 /*****************************************************************************/
 
 MbimDevice *
@@ -481,11 +813,24 @@ dispose (GObject *object)
 #endif
 
     /* Clear device object */
+    cached_query_track_notifications (self, FALSE);
     g_clear_object (&self->priv->mbim_device);
 
     G_OBJECT_CLASS (mm_port_mbim_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+    MMPortMbim *self = MM_PORT_MBIM (object);
+
+    /* Queries in flight hold a reference, so there are no waiters left */
+    if (self->priv->cached_queries)
+        g_hash_table_unref (self->priv->cached_queries);
+
+    G_OBJECT_CLASS (mm_port_mbim_parent_class)->finalize (object);
+}
+
 static void
 mm_port_mbim_class_init (MMPortMbimClass *klass)
 {
@@ -495,4 +840,5 @@ mm_port_mbim_class_init (MMPortMbimClass *klass)
 
     /* Virtual methods */
     object_class->dispose = dispose;
+    object_class->finalize = finalize;
 }
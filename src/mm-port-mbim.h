@@ -90,4 +90,26 @@ gboolean   mm_port_mbim_allocate_qmi_client_finish (MMPortMbim           *self,
 
 MbimDevice *mm_port_mbim_peek_device (MMPortMbim *self);
 
+/* Queries without input payload (e.g. Device Caps, Subscriber Ready Status)
+ * may be shared: successful responses are kept for a few seconds, or until a
+ * notification for the same command is received, and concurrent queries for
+ * the same command are served by a single transaction. Any other message is
+ * just sent to the device. */
+void         mm_port_mbim_cached_query        (MMPortMbim           *self,
+                                               MbimMessage          *message,
+                                               guint                 timeout,
+                                               GAsyncReadyCallback   callback,
+                                               gpointer              user_data);
+MbimMessage *mm_port_mbim_cached_query_finish (MMPortMbim           *self,
+                                               GAsyncResult         *res,
+                                               GError              **error);
+/* Sends the query only to have its response ready for later callers */
+void         mm_port_mbim_prefetch_query      (MMPortMbim           *self,
+                                               MbimMessage          *message,
+                                               guint                 timeout);
+/* To be used after a command changing the state reported by the query */
+void         mm_port_mbim_invalidate_query    (MMPortMbim           *self,
+                                               MbimService           service,
+                                               guint                 cid);
+
 #endif /* MM_PORT_MBIM_H */
@@ -15,6 +15,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <errno.h>
+#include <sys/stat.h>
 
 #include <libqmi-glib.h>
 
@@ -37,8 +39,167 @@ struct _MMPortQmiPrivate {
     QmiDevice *qmi_device;
     GList *services;
     gboolean llp_is_raw_ip;
+    /* Persistent state, if enabled */
+    GKeyFile *state;
+    gchar *state_path;
 };
 
+/*****************************************************************************/
+/* Persistent state
+ *
+ * If a state directory is set (--qmi-state-dir), the client IDs allocated in
+ * the port are stored in a key file per port, so that they can be reused
+ * after a daemon restart or a reprobe instead of allocating new ones. Client
+ * IDs are not released when the port is closed in that case. A stored client
+ * ID is only reused after the device answers a request sent with it.
+ *
+ * The device node is re-created whenever the modem is unplugged or resets,
+ * and any client ID allocated before that is gone; so the state is only
+ * valid as long as the device node is the same one.
+ */
+
+static gchar *state_dir;
+
+void
+mm_port_qmi_set_state_dir (const gchar *dir)
+{
+    g_free (state_dir);
+    state_dir = g_strdup (dir);
+}
+
+#define STATE_GROUP_DEVICE  "device"
+#define STATE_KEY_NODE      "node"
+#define STATE_GROUP_CLIENTS "clients"
+
+static gchar *
+state_get_node_id (MMPortQmi *self)
+{
+    struct stat  st;
+    gchar       *fullpath;
+    gchar       *node_id = NULL;
+
+    fullpath = g_strdup_printf ("/dev/%s", mm_port_get_device (MM_PORT (self)));
+    if (stat (fullpath, &st) == 0)
+        node_id = g_strdup_printf ("%lu:%lld.%09ld",
+                                   (gulong) st.st_rdev,
+                                   (long long) st.st_ctim.tv_sec,
+                                   (glong) st.st_ctim.tv_nsec);
+    else
+        mm_dbg ("Couldn't stat QMI device node '%s': %s", fullpath, g_strerror (errno));
+    g_free (fullpath);
+    return node_id;
+}
+
+static void
+state_save (MMPortQmi *self)
+{
+    GError *error = NULL;
+    gchar  *data;
+    gsize   len;
+
+    if (!self->priv->state)
+        return;
+
+    data = g_key_file_to_data (self->priv->state, &len, NULL);
+    if (!g_file_set_contents (self->priv->state_path, data, len, &error)) {
+        mm_warn ("Couldn't store QMI port state: %s", error->message);
+        g_error_free (error);
+    }
+    g_free (data);
+}
+
+static void
+state_load (MMPortQmi *self)
+{
+    gchar  *node_id;
+    gchar  *stored_node_id = NULL;
+    GError *error = NULL;
+
+    if (!state_dir)
+        return;
+
+    node_id = state_get_node_id (self);
+    if (!node_id)
+        return;
+
+    if (!self->priv->state_path) {
+        gchar *filename;
+
+        filename = g_strdup_printf ("qmi-%s.state", mm_port_get_device (MM_PORT (self)));
+        self->priv->state_path = g_build_filename (state_dir, filename, NULL);
+        g_free (filename);
+    }
+
+    if (self->priv->state)
+        g_key_file_unref (self->priv->state);
+    self->priv->state = g_key_file_new ();
+
+    if (!g_key_file_load_from_file (self->priv->state, self->priv->state_path, G_KEY_FILE_NONE, &error)) {
+        if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            mm_dbg ("Couldn't load QMI port state: %s", error->message);
+        g_error_free (error);
+    } else
+        stored_node_id = g_key_file_get_string (self->priv->state, STATE_GROUP_DEVICE, STATE_KEY_NODE, NULL);
+
+    if (g_strcmp0 (stored_node_id, node_id) != 0) {
+        if (stored_node_id)
+            mm_dbg ("QMI device node re-created, discarding stored state");
+        g_key_file_unref (self->priv->state);
+        self->priv->state = g_key_file_new ();
+        g_key_file_set_string (self->priv->state, STATE_GROUP_DEVICE, STATE_KEY_NODE, node_id);
+        state_save (self);
+    }
+
+    g_free (stored_node_id);
+    g_free (node_id);
+}
+
+static gchar *
+state_build_client_key (QmiService    service,
+                        MMPortQmiFlag flag)
+{
+    return g_strdup_printf ("%s-%u", qmi_service_get_string (service), (guint) flag);
+}
+
+static guint8
+state_get_cid (MMPortQmi     *self,
+               QmiService     service,
+               MMPortQmiFlag  flag)
+{
+    gchar *key;
+    gint   cid;
+
+    if (!self->priv->state)
+        return QMI_CID_NONE;
+
+    key = state_build_client_key (service, flag);
+    cid = g_key_file_get_integer (self->priv->state, STATE_GROUP_CLIENTS, key, NULL);
+    g_free (key);
+
+    return (cid > 0 && cid <= G_MAXUINT8) ? (guint8) cid : QMI_CID_NONE;
+}
+
+static void
+state_set_cid (MMPortQmi     *self,
+               QmiService     service,
+               MMPortQmiFlag  flag,
+               guint8         cid)
+{
+    gchar *key;
+
+    if (!self->priv->state)
+        return;
+
+    key = state_build_client_key (service, flag);
+    if (cid == QMI_CID_NONE)
+        g_key_file_remove_key (self->priv->state, STATE_GROUP_CLIENTS, key, NULL);
+    else
+        g_key_file_set_integer (self->priv->state, STATE_GROUP_CLIENTS, key, cid);
+    g_free (key);
+
+    state_save (self);
+}
+
 /*****************************************************************************/
 
 QmiClient *
@@ -84,6 +245,7 @@ mm_port_qmi_peek_device (MMPortQmi *self)
 
 typedef struct {
     ServiceInfo *info;
+    guint8 cid;
 } AllocateClientContext;
 
 static void
@@ -104,31 +266,167 @@ mm_port_qmi_allocate_client_finish (MMPortQmi *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void allocate_client_ready (QmiDevice    *qmi_device,
+                                   GAsyncResult *res,
+                                   GTask        *task);
+
 static void
-allocate_client_ready (QmiDevice *qmi_device,
+allocate_client_new (GTask *task)
+{
+    MMPortQmi *self;
+    AllocateClientContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    /* The stored client ID is no longer valid */
+    if (ctx->cid != QMI_CID_NONE) {
+        state_set_cid (self, ctx->info->service, ctx->info->flag, QMI_CID_NONE);
+        ctx->cid = QMI_CID_NONE;
+    }
+
+    qmi_device_allocate_client (self->priv->qmi_device,
+                                ctx->info->service,
+                                QMI_CID_NONE,
+                                10,
+                                g_task_get_cancellable (task),
+                                (GAsyncReadyCallback)allocate_client_ready,
+                                task);
+}
+
+static void
+allocate_client_complete (GTask *task)
+{
+    MMPortQmi *self;
+    AllocateClientContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (ctx->cid == QMI_CID_NONE)
+        state_set_cid (self, ctx->info->service, ctx->info->flag,
+                       qmi_client_get_cid (ctx->info->client));
+    /* Move the service info to our internal list */
+    self->priv->services = g_list_prepend (self->priv->services, ctx->info);
+    ctx->info = NULL;
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+validate_client_ready (QmiDevice *qmi_device,
                        GAsyncResult *res,
                        GTask *task)
 {
-    MMPortQmi *self;
     AllocateClientContext *ctx;
+    QmiMessage *response;
     GError *error = NULL;
 
+    ctx = g_task_get_task_data (task);
+
+    /* Any response other than an invalid client ID error means that the
+     * client ID is still allocated in the device, even if the request
+     * itself is not supported by the service */
+    response = qmi_device_command_full_finish (qmi_device, res, &error);
+    if (response) {
+        if (!qmi_message_response_get_result (response, &error) &&
+            !g_error_matches (error, QMI_PROTOCOL_ERROR, QMI_PROTOCOL_ERROR_INVALID_CLIENT_ID))
+            g_clear_error (&error);
+        qmi_message_unref (response);
+    }
+
+    if (!error) {
+        allocate_client_complete (task);
+        return;
+    }
+
+    /* Only unregister the client from the device; if the client ID is not
+     * valid there is nothing to release, and if the operation was cancelled
+     * it is kept for the next time */
+    qmi_device_release_client (qmi_device,
+                               ctx->info->client,
+                               QMI_DEVICE_RELEASE_CLIENT_FLAGS_NONE,
+                               3, NULL, NULL, NULL);
+    g_clear_object (&ctx->info->client);
+
+    if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    mm_dbg ("Stored client ID %u for service '%s' is not valid: %s",
+            ctx->cid, qmi_service_get_string (ctx->info->service), error->message);
+    g_error_free (error);
+    allocate_client_new (task);
+}
+
+/* Message 0x001E is "Get Supported Messages" in all services, and is answered
+ * right away; it is just used to check that the client ID is known */
+#define QMI_MESSAGE_GET_SUPPORTED_MESSAGES 0x001E
+
+static void
+validate_client (GTask *task)
+{
+    MMPortQmi *self;
+    AllocateClientContext *ctx;
+    QmiMessage *request;
+
     self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    request = qmi_message_new (ctx->info->service,
+                               ctx->cid,
+                               qmi_client_get_next_transaction_id (ctx->info->client),
+                               QMI_MESSAGE_GET_SUPPORTED_MESSAGES);
+    qmi_device_command_full (self->priv->qmi_device,
+                             request,
+                             NULL,
+                             5,
+                             g_task_get_cancellable (task),
+                             (GAsyncReadyCallback)validate_client_ready,
+                             task);
+    qmi_message_unref (request);
+}
+
+static void
+allocate_client_ready (QmiDevice *qmi_device,
+                       GAsyncResult *res,
+                       GTask *task)
+{
+    AllocateClientContext *ctx;
+    GError *error = NULL;
+
     ctx = g_task_get_task_data (task);
     ctx->info->client = qmi_device_allocate_client_finish (qmi_device, res, &error);
+
+    /* If reusing a stored client ID failed, allocate a new one */
+    if (!ctx->info->client && ctx->cid != QMI_CID_NONE) {
+        mm_dbg ("Couldn't reuse client ID %u for service '%s': %s",
+                ctx->cid, qmi_service_get_string (ctx->info->service), error->message);
+        g_error_free (error);
+        allocate_client_new (task);
+        return;
+    }
+
     if (!ctx->info->client) {
         g_prefix_error (&error,
                         "Couldn't create client for service '%s': ",
                         qmi_service_get_string (ctx->info->service));
         g_task_return_error (task, error);
-    } else {
-        /* Move the service info to our internal list */
-        self->priv->services = g_list_prepend (self->priv->services, ctx->info);
-        ctx->info = NULL;
-        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
     }
 
-    g_object_unref (task);
+    /* Creating a client with a given client ID doesn't involve the device at
+     * all, so make sure the device still knows about it (e.g. it could have
+     * been released by some other program) */
+    if (ctx->cid != QMI_CID_NONE) {
+        validate_client (task);
+        return;
+    }
+
+    allocate_client_complete (task);
 }
 
 void
@@ -163,11 +461,15 @@ mm_port_qmi_allocate_client (MMPortQmi *self,
     ctx->info = g_new0 (ServiceInfo, 1);
     ctx->info->service = service;
     ctx->info->flag = flag;
+    ctx->cid = state_get_cid (self, service, flag);
     g_task_set_task_data (task, ctx, (GDestroyNotify)allocate_client_context_free);
 
+    if (ctx->cid != QMI_CID_NONE)
+        mm_dbg ("Reusing client ID %u for service '%s'...", ctx->cid, qmi_service_get_string (service));
+
     qmi_device_allocate_client (self->priv->qmi_device,
                                 service,
-                                QMI_CID_NONE,
+                                ctx->cid,
                                 10,
                                 cancellable,
                                 (GAsyncReadyCallback)allocate_client_ready,
@@ -388,6 +690,8 @@ port_open_step (GTask *task)
          * that all callbacks go through the LAST step for completing. */
         self->priv->opening = TRUE;
 
+        state_load (self);
+
         mm_dbg ("Creating QMI device...");
         qmi_device_new (file,
                         g_task_get_cancellable (task),
@@ -583,14 +887,19 @@ mm_port_qmi_close (MMPortQmi *self)
     if (!self->priv->qmi_device)
         return;
 
-    /* Release all allocated clients */
+    /* Release all allocated clients; client IDs are kept allocated in the
+     * device if they are going to be reused */
     for (l = self->priv->services; l; l = g_list_next (l)) {
         ServiceInfo *info = l->data;
 
-        mm_dbg ("Releasing client for service '%s'...", qmi_service_get_string (info->service));
+        mm_dbg ("Releasing client for service '%s'%s...",
+                qmi_service_get_string (info->service),
+                self->priv->state ? " (keeping client ID)" : "");
         qmi_device_release_client (self->priv->qmi_device,
                                    info->client,
-                                   QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID,
+                                   (self->priv->state ?
+                                    QMI_DEVICE_RELEASE_CLIENT_FLAGS_NONE :
+                                    QMI_DEVICE_RELEASE_CLIENT_FLAGS_RELEASE_CID),
                                    3, NULL, NULL, NULL);
         g_clear_object (&info->client);
     }
@@ -647,6 +956,18 @@ dispose (GObject *object)
     G_OBJECT_CLASS (mm_port_qmi_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+    MMPortQmi *self = MM_PORT_QMI (object);
+
+    if (self->priv->state)
+        g_key_file_unref (self->priv->state);
+    g_free (self->priv->state_path);
+
+    G_OBJECT_CLASS (mm_port_qmi_parent_class)->finalize (object);
+}
+
 static void
 mm_port_qmi_class_init (MMPortQmiClass *klass)
 {
@@ -656,4 +977,5 @@ mm_port_qmi_class_init (MMPortQmiClass *klass)
 
     /* Virtual methods */
     object_class->dispose = dispose;
+    object_class->finalize = finalize;
 }
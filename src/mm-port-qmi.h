@@ -86,4 +86,8 @@ QmiDevice *mm_port_qmi_peek_device (MMPortQmi *self);
 
 gboolean mm_port_qmi_llp_is_raw_ip (MMPortQmi *self);
 
+/* Directory where client IDs are kept across restarts, or
+ * NULL to always allocate new client IDs and release them on close */
+void mm_port_qmi_set_state_dir (const gchar *dir);
+
 #endif /* MM_PORT_QMI_H */
@@ -0,0 +1,201 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <string.h>
+
+#include "mm-regex.h"
+#include "mm-log.h"
+
+typedef struct {
+    gchar              *pattern;
+    GRegexCompileFlags  compile_options;
+    GRegexMatchFlags    match_options;
+    GRegex             *regex;
+    /* Statistics, updated atomically */
+    gint                n_compilations;
+    gint                n_handles;
+    gint                n_matches;
+    gint                n_hits;
+} RegexEntry;
+
+/* Entries are never removed, so handles may keep plain pointers to them */
+G_LOCK_DEFINE_STATIC (registry);
+static GHashTable *registry;
+
+/*****************************************************************************/
+
+static guint
+entry_hash (const RegexEntry *entry)
+{
+    return (g_str_hash (entry->pattern) ^
+            ((guint)entry->compile_options * 31) ^
+            ((guint)entry->match_options * 2654435761u));
+}
+
+static gboolean
+entry_equal (const RegexEntry *a,
+             const RegexEntry *b)
+{
+    return (a->compile_options == b->compile_options &&
+            a->match_options == b->match_options &&
+            g_str_equal (a->pattern, b->pattern));
+}
+
+static RegexEntry *
+registry_lookup (const MMRegex *handle)
+{
+    RegexEntry  key;
+    RegexEntry *entry;
+
+    /* Always optimize, which enables JIT compilation */
+    key.pattern = (gchar *)handle->pattern;
+    key.compile_options = handle->compile_options | G_REGEX_OPTIMIZE;
+    key.match_options = handle->match_options;
+
+    G_LOCK (registry);
+    {
+        if (G_UNLIKELY (!registry))
+            registry = g_hash_table_new ((GHashFunc)entry_hash, (GEqualFunc)entry_equal);
+
+        entry = g_hash_table_lookup (registry, &key);
+        if (!entry) {
+            GError *error = NULL;
+
+            entry = g_slice_new0 (RegexEntry);
+            entry->pattern = g_strdup (key.pattern);
+            entry->compile_options = key.compile_options;
+            entry->match_options = key.match_options;
+            entry->regex = g_regex_new (entry->pattern, entry->compile_options, entry->match_options, &error);
+            if (!entry->regex)
+                g_error ("Invalid regular expression '%s': %s", entry->pattern, error->message);
+            entry->n_compilations++;
+            g_hash_table_add (registry, entry);
+        }
+        entry->n_handles++;
+    }
+    G_UNLOCK (registry);
+
+    return entry;
+}
+
+static inline RegexEntry *
+handle_get_entry (MMRegex *handle)
+{
+    if (g_once_init_enter (&handle->entry))
+        g_once_init_leave (&handle->entry, (gsize)registry_lookup (handle));
+    return (RegexEntry *)handle->entry;
+}
+
+/*****************************************************************************/
+
+GRegex *
+mm_regex_get (MMRegex *handle)
+{
+    g_assert (handle);
+
+    return handle_get_entry (handle)->regex;
+}
+
+gboolean
+mm_regex_match_full (MMRegex           *handle,
+                     const gchar       *string,
+                     gssize             string_len,
+                     gint               start_position,
+                     GRegexMatchFlags   match_options,
+                     GMatchInfo       **match_info,
+                     GError           **error)
+{
+    RegexEntry *entry;
+    gboolean    matched;
+
+    g_assert (handle);
+
+    entry = handle_get_entry (handle);
+    matched = g_regex_match_full (entry->regex, string, string_len, start_position,
+                                  match_options, match_info, error);
+    g_atomic_int_inc (&entry->n_matches);
+    if (matched)
+        g_atomic_int_inc (&entry->n_hits);
+    return matched;
+}
+
+gboolean
+mm_regex_match (MMRegex           *handle,
+                const gchar       *string,
+                GRegexMatchFlags   match_options,
+                GMatchInfo       **match_info)
+{
+    return mm_regex_match_full (handle, string, -1, 0, match_options, match_info, NULL);
+}
+
+/*****************************************************************************/
+
+static gint
+stats_cmp (const MMRegexStats *a,
+           const MMRegexStats *b)
+{
+    if (a->n_matches != b->n_matches)
+        return (a->n_matches > b->n_matches) ? -1 : 1;
+    return strcmp (a->pattern, b->pattern);
+}
+
+GArray *
+mm_regex_registry_get_stats (void)
+{
+    GArray *stats;
+
+    stats = g_array_new (FALSE, FALSE, sizeof (MMRegexStats));
+
+    G_LOCK (registry);
+    if (registry) {
+        GHashTableIter  iter;
+        RegexEntry     *entry;
+
+        g_hash_table_iter_init (&iter, registry);
+        while (g_hash_table_iter_next (&iter, (gpointer *)&entry, NULL)) {
+            MMRegexStats item;
+
+            item.pattern        = entry->pattern;
+            item.n_compilations = (guint) g_atomic_int_get (&entry->n_compilations);
+            item.n_handles      = (guint) g_atomic_int_get (&entry->n_handles);
+            item.n_matches      = (guint) g_atomic_int_get (&entry->n_matches);
+            item.n_hits         = (guint) g_atomic_int_get (&entry->n_hits);
+            g_array_append_val (stats, item);
+        }
+    }
+    G_UNLOCK (registry);
+
+    g_array_sort (stats, (GCompareFunc)stats_cmp);
+    return stats;
+}
+
+void
+mm_regex_registry_dump_stats (void)
+{
+    GArray *stats;
+    guint   i;
+
+    stats = mm_regex_registry_get_stats ();
+    mm_dbg ("Regex registry: %u patterns compiled", stats->len);
+    for (i = 0; i < stats->len; i++) {
+        MMRegexStats *item;
+
+        item = &g_array_index (stats, MMRegexStats, i);
+        mm_dbg ("  [%u matches, %u hits, %u compilations, %u handles] '%s'",
+                item->n_matches, item->n_hits, item->n_compilations, item->n_handles,
+                item->pattern);
+    }
+    g_array_unref (stats);
+}
@@ -0,0 +1,75 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef MM_REGEX_H
+#define MM_REGEX_H
+
+#include <glib.h>
+
+/* Process-wide registry of compiled regular expressions.
+ *
+ * Parsers declare a static handle with the pattern and flags they need, and
+ * the pattern is compiled (with JIT) the first time any handle using it is
+ * looked up. Handles with the same pattern and flags share the same compiled
+ * GRegex. Patterns are expected to be static and valid; a compilation error
+ * is a programming error and aborts.
+ *
+ *   static MMRegex cfun_regex = MM_REGEX_INIT ("\\+CFUN: (\\d+)", 0, 0);
+ *
+ *   if (mm_regex_match (&cfun_regex, response, 0, &match_info))
+ *       ...
+ */
+
+typedef struct {
+    const gchar        *pattern;
+    GRegexCompileFlags  compile_options;
+    GRegexMatchFlags    match_options;
+    /*< private >*/
+    gsize               entry;
+} MMRegex;
+
+#define MM_REGEX_INIT(pattern, compile_options, match_options) \
+    { pattern, compile_options, match_options, 0 }
+
+/* Returns the compiled regex, owned by the registry */
+GRegex *mm_regex_get (MMRegex *handle);
+
+gboolean mm_regex_match      (MMRegex           *handle,
+                              const gchar       *string,
+                              GRegexMatchFlags   match_options,
+                              GMatchInfo       **match_info);
+gboolean mm_regex_match_full (MMRegex           *handle,
+                              const gchar       *string,
+                              gssize             string_len,
+                              gint               start_position,
+                              GRegexMatchFlags   match_options,
+                              GMatchInfo       **match_info,
+                              GError           **error);
+
+/* Per-pattern statistics */
+typedef struct {
+    const gchar *pattern;
+    guint        n_compilations;
+    guint        n_handles;
+    guint        n_matches;
+    guint        n_hits;
+} MMRegexStats;
+
+/* Returns an array of MMRegexStats, sorted by number of matches, most used
+ * first. The pattern strings are owned by the registry. */
+GArray *mm_regex_registry_get_stats  (void);
+void    mm_regex_registry_dump_stats (void);
+
+#endif /* MM_REGEX_H */
@@ -3935,7 +3935,7 @@ mm_shared_qmi_location_load_supported_assistance_data (MMIfaceModemLocation  *se
 
 typedef struct {
     QmiClientLoc *client;
-    guint8       *data;
+    const guint8 *data;
     goffset       data_size;
     gulong        total_parts;
     guint32       part_size;
@@ -3955,7 +3955,6 @@ inject_assistance_data_context_free (InjectAssistanceDataContext *ctx)
             g_signal_handler_disconnect (ctx->client, ctx->indication_id);
         g_object_unref (ctx->client);
     }
-    g_free (ctx->data);
     g_slice_free (InjectAssistanceDataContext, ctx);
 }
 
@@ -4014,6 +4013,7 @@ out:
     g_signal_handler_disconnect (ctx->client, ctx->indication_id);
     ctx->indication_id = 0;
 
+    mm_iface_modem_location_assistance_data_progress (g_task_get_source_object (task), ctx->i, ctx->data_size);
     inject_xtra_data_next (task);
 }
 
@@ -4154,6 +4154,7 @@ out:
     g_signal_handler_disconnect (ctx->client, ctx->indication_id);
     ctx->indication_id = 0;
 
+    mm_iface_modem_location_assistance_data_progress (g_task_get_source_object (task), ctx->i, ctx->data_size);
     inject_assistance_data_next (task);
 }
 
@@ -4278,7 +4279,8 @@ mm_shared_qmi_location_inject_assistance_data (MMIfaceModemLocation *self,
     task = g_task_new (self, NULL, callback, user_data);
     ctx = g_slice_new0 (InjectAssistanceDataContext);
     ctx->client = g_object_ref (client);
-    ctx->data = g_memdup (data, data_size);
+    /* No need to copy the data, the caller keeps it valid until we're done */
+    ctx->data = data;
     ctx->data_size = data_size;
     ctx->part_size = ((priv->loc_assistance_data_max_part_size > 0) ? priv->loc_assistance_data_max_part_size : MAX_BYTES_PER_REQUEST);
     g_task_set_task_data (task, ctx, (GDestroyNotify) inject_assistance_data_context_free);
@@ -66,6 +66,60 @@ peek_device (gpointer self,
     return TRUE;
 }
 
+static gboolean
+peek_port (gpointer self,
+           MMPortMbim **o_port,
+           GAsyncReadyCallback callback,
+           gpointer user_data)
+{
+    MMBaseModem *modem = NULL;
+    MMPortMbim *port;
+
+    g_object_get (G_OBJECT (self),
+                  MM_BASE_SIM_MODEM, &modem,
+                  NULL);
+    g_assert (MM_IS_BASE_MODEM (modem));
+
+    port = mm_base_modem_peek_port_mbim (modem);
+    g_object_unref (modem);
+
+    if (!port) {
+        g_task_report_new_error (self,
+                                 callback,
+                                 user_data,
+                                 peek_port,
+                                 MM_CORE_ERROR,
+                                 MM_CORE_ERROR_FAILED,
+                                 "Couldn't peek MBIM port");
+        return FALSE;
+    }
+
+    *o_port = port;
+    return TRUE;
+}
+
+/* After any PIN operation the SIM state reported by the modem changes, so
+ * the shared responses to the SIM related queries are no longer valid */
+static void
+invalidate_sim_queries (MMSimMbim *self)
+{
+    MMBaseModem *modem = NULL;
+    MMPortMbim *port;
+
+    g_object_get (G_OBJECT (self),
+                  MM_BASE_SIM_MODEM, &modem,
+                  NULL);
+    g_assert (MM_IS_BASE_MODEM (modem));
+
+    port = mm_base_modem_peek_port_mbim (modem);
+    if (port) {
+        mm_port_mbim_invalidate_query (port, MBIM_SERVICE_BASIC_CONNECT, MBIM_CID_BASIC_CONNECT_PIN);
+        mm_port_mbim_invalidate_query (port, MBIM_SERVICE_BASIC_CONNECT, MBIM_CID_BASIC_CONNECT_SUBSCRIBER_READY_STATUS);
+        mm_port_mbim_invalidate_query (port, MBIM_SERVICE_BASIC_CONNECT, MBIM_CID_BASIC_CONNECT_HOME_PROVIDER);
+    }
+    g_object_unref (modem);
+}
+
 static void
 update_modem_unlock_retries (MMSimMbim *self,
                              MbimPinType pin_type,
@@ -101,7 +155,7 @@ load_sim_identifier_finish (MMBaseSim *self,
 }
 
 static void
-simid_subscriber_ready_state_ready (MbimDevice *device,
+simid_subscriber_ready_state_ready (MMPortMbim *port,
                                     GAsyncResult *res,
                                     GTask *task)
 {
@@ -109,7 +163,7 @@ simid_subscriber_ready_state_ready (MbimDevice *device,
     GError *error = NULL;
     gchar *sim_iccid;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_subscriber_ready_status_response_parse (
@@ -135,22 +189,21 @@ load_sim_identifier (MMBaseSim *self,
                      GAsyncReadyCallback callback,
                      gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)simid_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)simid_subscriber_ready_state_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -166,7 +219,7 @@ load_imsi_finish (MMBaseSim *self,
 }
 
 static void
-imsi_subscriber_ready_state_ready (MbimDevice *device,
+imsi_subscriber_ready_state_ready (MMPortMbim *port,
                                    GAsyncResult *res,
                                    GTask *task)
 {
@@ -174,7 +227,7 @@ imsi_subscriber_ready_state_ready (MbimDevice *device,
     GError *error = NULL;
     gchar *subscriber_id;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_subscriber_ready_status_response_parse (
@@ -200,22 +253,21 @@ load_imsi (MMBaseSim *self,
            GAsyncReadyCallback callback,
            gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_subscriber_ready_status_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)imsi_subscriber_ready_state_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)imsi_subscriber_ready_state_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -231,7 +283,7 @@ load_operator_identifier_finish (MMBaseSim *self,
 }
 
 static void
-load_operator_identifier_ready (MbimDevice *device,
+load_operator_identifier_ready (MMPortMbim *port,
                                 GAsyncResult *res,
                                 GTask *task)
 {
@@ -239,7 +291,7 @@ load_operator_identifier_ready (MbimDevice *device,
     GError *error = NULL;
     MbimProvider *provider;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_home_provider_response_parse (
@@ -261,22 +313,21 @@ load_operator_identifier (MMBaseSim *self,
                           GAsyncReadyCallback callback,
                           gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_home_provider_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)load_operator_identifier_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)load_operator_identifier_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -292,7 +343,7 @@ load_operator_name_finish (MMBaseSim *self,
 }
 
 static void
-load_operator_name_ready (MbimDevice *device,
+load_operator_name_ready (MMPortMbim *port,
                           GAsyncResult *res,
                           GTask *task)
 {
@@ -300,7 +351,7 @@ load_operator_name_ready (MbimDevice *device,
     GError *error = NULL;
     MbimProvider *provider;
 
-    response = mbim_device_command_finish (device, res, &error);
+    response = mm_port_mbim_cached_query_finish (port, res, &error);
     if (response &&
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
         mbim_message_home_provider_response_parse (
@@ -322,22 +373,21 @@ load_operator_name (MMBaseSim *self,
                     GAsyncReadyCallback callback,
                     gpointer user_data)
 {
-    MbimDevice *device;
+    MMPortMbim *port;
     MbimMessage *message;
     GTask *task;
 
-    if (!peek_device (self, &device, callback, user_data))
+    if (!peek_port (self, &port, callback, user_data))
         return;
 
     task = g_task_new (self, NULL, callback, user_data);
 
     message = mbim_message_home_provider_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)load_operator_name_ready,
-                         task);
+    mm_port_mbim_cached_query (port,
+                               message,
+                               10,
+                               (GAsyncReadyCallback)load_operator_name_ready,
+                               task);
     mbim_message_unref (message);
 }
 
@@ -367,6 +417,8 @@ pin_set_enter_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
+    invalidate_sim_queries (MM_SIM_MBIM (g_task_get_source_object (task)));
+
     response = mbim_device_command_finish (device, res, &error);
     if (response) {
         success = mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
@@ -464,6 +516,8 @@ puk_set_enter_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
+    invalidate_sim_queries (MM_SIM_MBIM (g_task_get_source_object (task)));
+
     response = mbim_device_command_finish (device, res, &error);
     if (response) {
         success = mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
@@ -560,6 +614,8 @@ pin_set_enable_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
+    invalidate_sim_queries (MM_SIM_MBIM (g_task_get_source_object (task)));
+
     response = mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
@@ -651,6 +707,8 @@ pin_set_change_ready (MbimDevice *device,
 
     self = g_task_get_source_object (task);
 
+    invalidate_sim_queries (MM_SIM_MBIM (g_task_get_source_object (task)));
+
     response = mbim_device_command_finish (device, res, &error);
     if (response) {
         mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error);
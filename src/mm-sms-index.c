@@ -0,0 +1,256 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <string.h>
+
+#include "mm-sms-index.h"
+
+#define N_STORAGES (MM_SMS_STORAGE_TA + 1)
+
+typedef struct {
+    gchar *number;
+    guint  reference;
+} MultipartKey;
+
+struct _MMSmsIndex {
+    /* One table per storage, keyed by part index */
+    GHashTable *parts[N_STORAGES];
+    /* One table per storage, item -> GArray of the part indices it owns */
+    GHashTable *items[N_STORAGES];
+    /* MultipartKey -> item */
+    GHashTable *multiparts;
+};
+
+/*****************************************************************************/
+
+static guint
+multipart_key_hash (const MultipartKey *key)
+{
+    return g_str_hash (key->number) ^ (key->reference * 2654435761u);
+}
+
+static gboolean
+multipart_key_equal (const MultipartKey *a,
+                     const MultipartKey *b)
+{
+    return (a->reference == b->reference && g_str_equal (a->number, b->number));
+}
+
+static void
+multipart_key_free (MultipartKey *key)
+{
+    g_free (key->number);
+    g_slice_free (MultipartKey, key);
+}
+
+/*****************************************************************************/
+
+static gboolean
+storage_valid (MMSmsStorage storage)
+{
+    return (storage > MM_SMS_STORAGE_UNKNOWN && storage < N_STORAGES);
+}
+
+static void
+item_indices_add (MMSmsIndex   *self,
+                  MMSmsStorage  storage,
+                  guint         index,
+                  gpointer      item)
+{
+    GArray *indices;
+
+    indices = g_hash_table_lookup (self->items[storage], item);
+    if (!indices) {
+        indices = g_array_new (FALSE, FALSE, sizeof (guint));
+        g_hash_table_insert (self->items[storage], item, indices);
+    }
+    g_array_append_val (indices, index);
+}
+
+static void
+item_indices_remove (MMSmsIndex   *self,
+                     MMSmsStorage  storage,
+                     guint         index,
+                     gpointer      item)
+{
+    GArray *indices;
+    guint   i;
+
+    indices = g_hash_table_lookup (self->items[storage], item);
+    if (!indices)
+        return;
+
+    for (i = 0; i < indices->len; i++) {
+        if (g_array_index (indices, guint, i) == index) {
+            g_array_remove_index_fast (indices, i);
+            break;
+        }
+    }
+    if (!indices->len)
+        g_hash_table_remove (self->items[storage], item);
+}
+
+void
+mm_sms_index_add_part (MMSmsIndex   *self,
+                       MMSmsStorage  storage,
+                       guint         index,
+                       gpointer      item)
+{
+    gpointer previous;
+
+    g_return_if_fail (storage_valid (storage));
+
+    if (!self->parts[storage]) {
+        self->parts[storage] = g_hash_table_new (g_direct_hash, g_direct_equal);
+        self->items[storage] = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_array_unref);
+    }
+
+    previous = g_hash_table_lookup (self->parts[storage], GUINT_TO_POINTER (index));
+    if (previous == item)
+        return;
+    if (previous)
+        item_indices_remove (self, storage, index, previous);
+
+    g_hash_table_insert (self->parts[storage], GUINT_TO_POINTER (index), item);
+    item_indices_add (self, storage, index, item);
+}
+
+gpointer
+mm_sms_index_lookup_part (MMSmsIndex   *self,
+                          MMSmsStorage  storage,
+                          guint         index)
+{
+    if (!storage_valid (storage) || !self->parts[storage])
+        return NULL;
+
+    return g_hash_table_lookup (self->parts[storage], GUINT_TO_POINTER (index));
+}
+
+void
+mm_sms_index_remove_part (MMSmsIndex   *self,
+                          MMSmsStorage  storage,
+                          guint         index,
+                          gpointer      item)
+{
+    /* Only remove the entry if it still points to the given item */
+    if (mm_sms_index_lookup_part (self, storage, index) == item) {
+        g_hash_table_remove (self->parts[storage], GUINT_TO_POINTER (index));
+        item_indices_remove (self, storage, index, item);
+    }
+}
+
+/* Removes all the parts of the given item, without relying on the indices
+ * the item currently reports, which are reset once the parts are deleted */
+void
+mm_sms_index_remove_item (MMSmsIndex   *self,
+                          MMSmsStorage  storage,
+                          gpointer      item)
+{
+    GArray *indices;
+    guint   i;
+
+    if (!storage_valid (storage) || !self->parts[storage])
+        return;
+
+    indices = g_hash_table_lookup (self->items[storage], item);
+    if (!indices)
+        return;
+
+    for (i = 0; i < indices->len; i++)
+        g_hash_table_remove (self->parts[storage], GUINT_TO_POINTER (g_array_index (indices, guint, i)));
+    g_hash_table_remove (self->items[storage], item);
+}
+
+guint
+mm_sms_index_count_parts (MMSmsIndex   *self,
+                          MMSmsStorage  storage)
+{
+    if (!storage_valid (storage) || !self->parts[storage])
+        return 0;
+
+    return g_hash_table_size (self->parts[storage]);
+}
+
+/*****************************************************************************/
+
+void
+mm_sms_index_add_multipart (MMSmsIndex  *self,
+                            const gchar *number,
+                            guint        reference,
+                            gpointer     item)
+{
+    MultipartKey *key;
+
+    key = g_slice_new (MultipartKey);
+    key->number = g_strdup (number ? number : "");
+    key->reference = reference;
+    g_hash_table_replace (self->multiparts, key, item);
+}
+
+gpointer
+mm_sms_index_lookup_multipart (MMSmsIndex  *self,
+                               const gchar *number,
+                               guint        reference)
+{
+    MultipartKey key;
+
+    key.number = (gchar *)(number ? number : "");
+    key.reference = reference;
+    return g_hash_table_lookup (self->multiparts, &key);
+}
+
+void
+mm_sms_index_remove_multipart (MMSmsIndex  *self,
+                               const gchar *number,
+                               guint        reference,
+                               gpointer     item)
+{
+    MultipartKey key;
+
+    key.number = (gchar *)(number ? number : "");
+    key.reference = reference;
+    if (g_hash_table_lookup (self->multiparts, &key) == item)
+        g_hash_table_remove (self->multiparts, &key);
+}
+
+/*****************************************************************************/
+
+MMSmsIndex *
+mm_sms_index_new (void)
+{
+    MMSmsIndex *self;
+
+    self = g_slice_new0 (MMSmsIndex);
+    self->multiparts = g_hash_table_new_full ((GHashFunc)multipart_key_hash,
+                                              (GEqualFunc)multipart_key_equal,
+                                              (GDestroyNotify)multipart_key_free,
+                                              NULL);
+    return self;
+}
+
+void
+mm_sms_index_free (MMSmsIndex *self)
+{
+    guint i;
+
+    for (i = 0; i < N_STORAGES; i++) {
+        if (self->parts[i])
+            g_hash_table_unref (self->parts[i]);
+        if (self->items[i])
+            g_hash_table_unref (self->items[i]);
+    }
+    g_hash_table_unref (self->multiparts);
+    g_slice_free (MMSmsIndex, self);
+}
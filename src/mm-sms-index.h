@@ -0,0 +1,61 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef MM_SMS_INDEX_H
+#define MM_SMS_INDEX_H
+
+#include <glib.h>
+#include <ModemManager.h>
+
+/* Lookup tables used to find which message owns a given stored part, or
+ * which multipart message a new part belongs to, without walking the whole
+ * list of messages. Items are not owned by the index. */
+typedef struct _MMSmsIndex MMSmsIndex;
+
+MMSmsIndex *mm_sms_index_new  (void);
+void        mm_sms_index_free (MMSmsIndex *self);
+
+/* Parts, indexed by (storage, index) */
+void     mm_sms_index_add_part    (MMSmsIndex   *self,
+                                   MMSmsStorage  storage,
+                                   guint         index,
+                                   gpointer      item);
+gpointer mm_sms_index_lookup_part (MMSmsIndex   *self,
+                                   MMSmsStorage  storage,
+                                   guint         index);
+void     mm_sms_index_remove_part (MMSmsIndex   *self,
+                                   MMSmsStorage  storage,
+                                   guint         index,
+                                   gpointer      item);
+void     mm_sms_index_remove_item (MMSmsIndex   *self,
+                                   MMSmsStorage  storage,
+                                   gpointer      item);
+guint    mm_sms_index_count_parts (MMSmsIndex   *self,
+                                   MMSmsStorage  storage);
+
+/* Multipart messages, indexed by (number, concat reference) */
+void     mm_sms_index_add_multipart    (MMSmsIndex  *self,
+                                        const gchar *number,
+                                        guint        reference,
+                                        gpointer     item);
+gpointer mm_sms_index_lookup_multipart (MMSmsIndex  *self,
+                                        const gchar *number,
+                                        guint        reference);
+void     mm_sms_index_remove_multipart (MMSmsIndex  *self,
+                                        const gchar *number,
+                                        guint        reference,
+                                        gpointer     item);
+
+#endif /* MM_SMS_INDEX_H */
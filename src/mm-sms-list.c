@@ -27,8 +27,20 @@
 #include "mm-iface-modem-messaging.h"
 #include "mm-sms-list.h"
 #include "mm-base-sms.h"
+#include "mm-sms-index.h"
+#include "mm-sms-sink.h"
+#include "mm-modem-helpers.h"
 #include "mm-log.h"
 
+/* Messages delivered to the SMS sink are removed from the storage in
+ * batches, to avoid locking the storages once per message */
+#define SINK_DELETE_BATCH_SIZE    16
+#define SINK_DELETE_TIMEOUT_SECS  2
+
+/* Parts of the same message usually arrive within seconds; multipart messages
+ * still incomplete after this time are exposed in D-Bus as usual */
+#define SINK_PENDING_TIMEOUT_SECS 120
+
 G_DEFINE_TYPE (MMSmsList, mm_sms_list, G_TYPE_OBJECT);
 
 enum {
@@ -50,8 +62,31 @@ struct _MMSmsListPrivate {
     MMBaseModem *modem;
     /* List of sms objects */
     GList *list;
+    /* Link of each sms object in the list */
+    GHashTable *links;
+    /* Lookup tables for the SMS parts loaded or received */
+    MMSmsIndex *index;
+    /* SMS objects created by the user; their parts only get an index
+     * once stored, so they are not in the lookup tables */
+    GList *user_list;
+    /* Direct delivery of received messages, if any */
+    MMSmsSink *sink;
+    /* Received multipart messages not complete yet, not exported */
+    GList *sink_pending_list; /* SinkPending */
+    /* Messages being written to the sink */
+    GList *sink_delivering_list;
+    /* Messages delivered to the sink, waiting to be removed from storage */
+    GQueue *sink_delete_queue;
+    guint sink_delete_timeout_id;
+    gboolean sink_deleting;
 };
 
+typedef struct {
+    MMSmsList *self;
+    MMBaseSms *sms;
+    guint timeout_id;
+} SinkPending;
+
 /*****************************************************************************/
 
 gboolean
@@ -111,6 +146,98 @@ mm_sms_list_get_paths (MMSmsList *self)
     return path_list;
 }
 
+/* Paged listings walk the list from the oldest message, so that pages already
+ * retrieved don't shift when new messages arrive. */
+
+GStrv
+mm_sms_list_get_paths_range (MMSmsList *self,
+                             guint offset,
+                             guint count)
+{
+    GPtrArray *paths;
+    GList *l;
+    guint i;
+
+    paths = g_ptr_array_new ();
+    for (i = 0, l = g_list_last (self->priv->list); l; l = g_list_previous (l)) {
+        const gchar *path;
+
+        path = mm_base_sms_get_path (MM_BASE_SMS (l->data));
+        if (!path)
+            continue;
+        if (i++ < offset)
+            continue;
+        g_ptr_array_add (paths, g_strdup (path));
+        if (count && paths->len == count)
+            break;
+    }
+    g_ptr_array_add (paths, NULL);
+
+    return (GStrv) g_ptr_array_free (paths, FALSE);
+}
+
+GStrv
+mm_sms_list_get_paths_since (MMSmsList *self,
+                             gint64 unix_time)
+{
+    GPtrArray *paths;
+    GList *l;
+
+    paths = g_ptr_array_new ();
+    for (l = g_list_last (self->priv->list); l; l = g_list_previous (l)) {
+        const gchar *path;
+        gint64 timestamp;
+
+        path = mm_base_sms_get_path (MM_BASE_SMS (l->data));
+        if (!path)
+            continue;
+
+        /* Messages without timestamp (e.g. those created locally) are skipped */
+        if (!mm_sms_timestamp_to_unix (mm_gdbus_sms_get_timestamp (MM_GDBUS_SMS (l->data)), &timestamp) ||
+            timestamp < unix_time)
+            continue;
+
+        g_ptr_array_add (paths, g_strdup (path));
+    }
+    g_ptr_array_add (paths, NULL);
+
+    return (GStrv) g_ptr_array_free (paths, FALSE);
+}
+
+/*****************************************************************************/
+
+static void
+list_prepend (MMSmsList *self,
+              MMBaseSms *sms)
+{
+    self->priv->list = g_list_prepend (self->priv->list, sms);
+    g_hash_table_insert (self->priv->links, sms, self->priv->list);
+}
+
+static void
+list_delete_link (MMSmsList *self,
+                  GList *link)
+{
+    g_hash_table_remove (self->priv->links, link->data);
+    self->priv->list = g_list_delete_link (self->priv->list, link);
+}
+
+/*****************************************************************************/
+
+MMBaseSms *
+mm_sms_list_get_sms (MMSmsList *self,
+                     const gchar *sms_path)
+{
+    GList *l;
+
+    for (l = self->priv->list; l; l = g_list_next (l)) {
+        if (g_strcmp0 (mm_base_sms_get_path (MM_BASE_SMS (l->data)), sms_path) == 0)
+            return g_object_ref (l->data);
+    }
+
+    return NULL;
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -128,6 +255,69 @@ cmp_sms_by_path (MMBaseSms *sms,
     return g_strcmp0 (mm_base_sms_get_path (sms), path);
 }
 
+/* Parts are unindexed before deleting them, so that new messages stored in
+ * the slots freed while the operation is ongoing are not ignored. The index
+ * entries are looked up by owner, as deleted parts get their index reset. */
+static void
+unindex_parts (MMSmsList *self,
+               MMBaseSms *sms)
+{
+    mm_sms_index_remove_item (self->priv->index, mm_base_sms_get_storage (sms), sms);
+}
+
+/* Parts not deleted are indexed again; user created messages never are */
+static void
+reindex_parts (MMSmsList *self,
+               MMBaseSms *sms)
+{
+    MMSmsStorage  storage;
+    GList        *l;
+
+    unindex_parts (self, sms);
+
+    storage = mm_base_sms_get_storage (sms);
+    if (storage == MM_SMS_STORAGE_UNKNOWN || g_list_find (self->priv->user_list, sms))
+        return;
+
+    for (l = mm_base_sms_get_parts (sms); l; l = g_list_next (l)) {
+        guint index;
+
+        index = mm_sms_part_get_index ((MMSmsPart *)l->data);
+        if (index != SMS_PART_INVALID_INDEX)
+            mm_sms_index_add_part (self->priv->index, storage, index, sms);
+    }
+}
+
+static gboolean
+sms_is_stored (MMBaseSms *sms)
+{
+    GList *l;
+
+    if (mm_base_sms_get_storage (sms) == MM_SMS_STORAGE_UNKNOWN)
+        return FALSE;
+
+    for (l = mm_base_sms_get_parts (sms); l; l = g_list_next (l)) {
+        if (mm_sms_part_get_index ((MMSmsPart *)l->data) != SMS_PART_INVALID_INDEX)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+unindex_sms (MMSmsList *self,
+             MMBaseSms *sms)
+{
+    unindex_parts (self, sms);
+
+    if (mm_base_sms_is_multipart (sms) && mm_base_sms_get_parts (sms))
+        mm_sms_index_remove_multipart (self->priv->index,
+                                       mm_sms_part_get_number ((MMSmsPart *)mm_base_sms_get_parts (sms)->data),
+                                       mm_base_sms_get_multipart_reference (sms),
+                                       sms);
+
+    self->priv->user_list = g_list_remove (self->priv->user_list, sms);
+}
+
 static void
 delete_ready (MMBaseSms *sms,
               GAsyncResult *res,
@@ -138,22 +328,23 @@ delete_ready (MMBaseSms *sms,
     GError *error = NULL;
     GList *l;
 
+    self = g_task_get_source_object (task);
+
     if (!mm_base_sms_delete_finish (sms, res, &error)) {
+        reindex_parts (self, sms);
         /* We report the error */
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
-    self = g_task_get_source_object (task);
     path = g_task_get_task_data (task);
     /* The SMS was properly deleted, we now remove it from our list */
-    l = g_list_find_custom (self->priv->list,
-                            path,
-                            (GCompareFunc)cmp_sms_by_path);
+    l = g_hash_table_lookup (self->priv->links, sms);
     if (l) {
-        g_object_unref (MM_BASE_SMS (l->data));
-        self->priv->list = g_list_delete_link (self->priv->list, l);
+        unindex_sms (self, sms);
+        list_delete_link (self, l);
+        g_object_unref (sms);
     }
 
     /* We don't need to unref the SMS any more, but we can use the
@@ -197,18 +388,369 @@ mm_sms_list_delete_sms (MMSmsList *self,
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, g_strdup (sms_path), g_free);
 
+    unindex_parts (self, MM_BASE_SMS (l->data));
     mm_base_sms_delete (MM_BASE_SMS (l->data),
                         (GAsyncReadyCallback)delete_ready,
                         task);
 }
 
+/*****************************************************************************/
+/* Delete several messages at once: parts are grouped by storage, so that each
+ * storage is locked once. Whole storages are only cleared in one go when the
+ * user explicitly asks to delete all messages, as the storages may hold
+ * messages we don't know about (e.g. not parsed, or not read yet). */
+
+typedef struct {
+    GList *sms;
+    /* Messages not exposed, also removed when clearing whole storages */
+    GList *hidden;
+    gboolean whole_storages;
+    GArray *storages;
+    MMSmsStorage current_storage;
+    guint n_requested;
+    guint n_deleted;
+    guint n_parts;
+    GError *error;
+    GTimer *timer;
+} DeleteSmsMultipleContext;
+
+static void
+delete_sms_multiple_context_free (DeleteSmsMultipleContext *ctx)
+{
+    g_list_free_full (ctx->sms, g_object_unref);
+    g_list_free_full (ctx->hidden, g_object_unref);
+    g_array_unref (ctx->storages);
+    g_clear_error (&ctx->error);
+    g_timer_destroy (ctx->timer);
+    g_free (ctx);
+}
+
+static gboolean
+delete_sms_multiple_common_finish (GAsyncResult *res,
+                                   guint *n_deleted,
+                                   GError **error)
+{
+    DeleteSmsMultipleContext *ctx;
+
+    if (!g_task_propagate_boolean (G_TASK (res), error))
+        return FALSE;
+
+    ctx = g_task_get_task_data (G_TASK (res));
+    if (n_deleted)
+        *n_deleted = ctx->n_deleted;
+    return TRUE;
+}
+
+gboolean
+mm_sms_list_delete_sms_multiple_finish (MMSmsList *self,
+                                        GAsyncResult *res,
+                                        guint *n_deleted,
+                                        GError **error)
+{
+    return delete_sms_multiple_common_finish (res, n_deleted, error);
+}
+
+gboolean
+mm_sms_list_delete_all_finish (MMSmsList *self,
+                               GAsyncResult *res,
+                               guint *n_deleted,
+                               GError **error)
+{
+    return delete_sms_multiple_common_finish (res, n_deleted, error);
+}
+
+static gboolean
+remove_sms (MMSmsList *self,
+            MMBaseSms *sms)
+{
+    gchar *path;
+    GList *l;
+
+    /* May have been removed in the meantime by some other operation */
+    l = g_hash_table_lookup (self->priv->links, sms);
+    if (!l)
+        return FALSE;
+
+    unindex_sms (self, sms);
+    list_delete_link (self, l);
+
+    path = g_strdup (mm_base_sms_get_path (sms));
+    mm_gdbus_sms_set_state (MM_GDBUS_SMS (sms), MM_SMS_STATE_UNKNOWN);
+    mm_base_sms_unexport (sms);
+    g_signal_emit (self,
+                   signals[SIGNAL_DELETED], 0,
+                   path);
+    g_free (path);
+
+    /* The reference owned by the list */
+    g_object_unref (sms);
+    return TRUE;
+}
+
+static void delete_sms_multiple_next_storage (GTask *task);
+
+static void
+delete_parts_ready (MMBaseSms *sms,
+                    GAsyncResult *res,
+                    GTask *task)
+{
+    MMSmsList *self;
+    DeleteSmsMultipleContext *ctx;
+    GError *error = NULL;
+    GList *l;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (!mm_base_sms_delete_parts_finish (sms, res, &error)) {
+        mm_dbg ("Couldn't delete SMS parts from storage '%s': %s",
+                mm_sms_storage_get_string (ctx->current_storage),
+                error->message);
+        g_clear_error (&ctx->error);
+        ctx->error = error;
+    }
+
+    /* Messages with all their parts deleted are gone */
+    for (l = ctx->sms; l; l = g_list_next (l)) {
+        if (mm_base_sms_get_storage (l->data) != ctx->current_storage)
+            continue;
+        if (sms_is_stored (l->data))
+            reindex_parts (self, l->data);
+        else if (remove_sms (self, l->data))
+            ctx->n_deleted++;
+    }
+
+    /* Messages not exposed keep going, without the parts deleted */
+    for (l = ctx->hidden; l; l = g_list_next (l)) {
+        if (mm_base_sms_get_storage (l->data) == ctx->current_storage)
+            reindex_parts (self, l->data);
+    }
+
+    delete_sms_multiple_next_storage (task);
+}
+
+static void
+add_stored_parts (GPtrArray *parts,
+                  MMBaseSms *sms)
+{
+    GList *l;
+
+    for (l = mm_base_sms_get_parts (sms); l; l = g_list_next (l)) {
+        if (mm_sms_part_get_index ((MMSmsPart *)l->data) != SMS_PART_INVALID_INDEX)
+            g_ptr_array_add (parts, l->data);
+    }
+}
+
+static void
+delete_sms_multiple_next_storage (GTask *task)
+{
+    MMSmsList *self;
+    DeleteSmsMultipleContext *ctx;
+    MMBaseSms *first = NULL;
+    GPtrArray *parts;
+    guint n_given;
+    GList *l;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (!ctx->storages->len) {
+        mm_info ("Deleted %u of %u SMS (%u stored parts) in %.3lf seconds",
+                 ctx->n_deleted, ctx->n_requested, ctx->n_parts,
+                 g_timer_elapsed (ctx->timer, NULL));
+        if (!ctx->n_deleted && ctx->error) {
+            g_task_return_error (task, ctx->error);
+            ctx->error = NULL;
+        } else
+            g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
+
+    ctx->current_storage = g_array_index (ctx->storages, MMSmsStorage, 0);
+    g_array_remove_index (ctx->storages, 0);
+
+    parts = g_ptr_array_new ();
+    for (l = ctx->sms; l; l = g_list_next (l)) {
+        if (mm_base_sms_get_storage (l->data) != ctx->current_storage)
+            continue;
+        if (!first)
+            first = l->data;
+        add_stored_parts (parts, l->data);
+        unindex_parts (self, l->data);
+    }
+    g_assert (first);
+    n_given = parts->len;
+
+    /* When clearing the whole storage, the parts of the messages not exposed
+     * go away as well, so they must not be deleted again later on */
+    for (l = ctx->hidden; l; l = g_list_next (l)) {
+        if (mm_base_sms_get_storage (l->data) != ctx->current_storage)
+            continue;
+        add_stored_parts (parts, l->data);
+        unindex_parts (self, l->data);
+    }
+
+    mm_dbg ("Deleting %u SMS parts from storage '%s'%s",
+            n_given,
+            mm_sms_storage_get_string (ctx->current_storage),
+            ctx->whole_storages ? " (whole storage)" : "");
+    ctx->n_parts += n_given;
+    mm_base_sms_delete_parts (first,
+                              ctx->current_storage,
+                              parts,
+                              ctx->whole_storages,
+                              (GAsyncReadyCallback)delete_parts_ready,
+                              task);
+    g_ptr_array_unref (parts);
+}
+
+static void
+delete_sms_multiple_run (GTask *task)
+{
+    MMSmsList *self;
+    DeleteSmsMultipleContext *ctx;
+    GList *l;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    for (l = ctx->sms; l; l = g_list_next (l)) {
+        MMSmsStorage storage;
+        guint j;
+
+        /* Messages not stored can be removed right away */
+        if (!sms_is_stored (l->data)) {
+            if (remove_sms (self, l->data))
+                ctx->n_deleted++;
+            continue;
+        }
+
+        storage = mm_base_sms_get_storage (l->data);
+        for (j = 0; j < ctx->storages->len; j++) {
+            if (g_array_index (ctx->storages, MMSmsStorage, j) == storage)
+                break;
+        }
+        if (j == ctx->storages->len)
+            g_array_append_val (ctx->storages, storage);
+    }
+
+    delete_sms_multiple_next_storage (task);
+}
+
+static GTask *
+delete_sms_multiple_task_new (MMSmsList *self,
+                              gboolean whole_storages,
+                              GAsyncReadyCallback callback,
+                              gpointer user_data)
+{
+    DeleteSmsMultipleContext *ctx;
+    GTask *task;
+
+    ctx = g_new0 (DeleteSmsMultipleContext, 1);
+    ctx->whole_storages = whole_storages;
+    ctx->storages = g_array_new (FALSE, FALSE, sizeof (MMSmsStorage));
+    ctx->timer = g_timer_new ();
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)delete_sms_multiple_context_free);
+    return task;
+}
+
+void
+mm_sms_list_delete_sms_multiple (MMSmsList *self,
+                                 const gchar *const *sms_paths,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
+{
+    DeleteSmsMultipleContext *ctx;
+    GTask *task;
+    GHashTable *by_path;
+    GHashTable *requested;
+    GList *l;
+    guint i;
+
+    task = delete_sms_multiple_task_new (self, FALSE, callback, user_data);
+    ctx = g_task_get_task_data (task);
+
+    by_path = g_hash_table_new (g_str_hash, g_str_equal);
+    for (l = self->priv->list; l; l = g_list_next (l)) {
+        const gchar *path;
+
+        path = mm_base_sms_get_path (l->data);
+        if (path)
+            g_hash_table_insert (by_path, (gpointer)path, l->data);
+    }
+
+    /* Validate all paths before deleting anything */
+    requested = g_hash_table_new (g_direct_hash, g_direct_equal);
+    for (i = 0; sms_paths && sms_paths[i]; i++) {
+        MMBaseSms *sms;
+
+        sms = g_hash_table_lookup (by_path, sms_paths[i]);
+        if (!sms) {
+            g_task_return_new_error (task,
+                                     MM_CORE_ERROR,
+                                     MM_CORE_ERROR_NOT_FOUND,
+                                     "No SMS found with path '%s'",
+                                     sms_paths[i]);
+            g_object_unref (task);
+            g_hash_table_unref (requested);
+            g_hash_table_unref (by_path);
+            return;
+        }
+        /* Skip duplicates */
+        if (g_hash_table_contains (requested, sms))
+            continue;
+        g_hash_table_add (requested, sms);
+        ctx->sms = g_list_prepend (ctx->sms, g_object_ref (sms));
+        ctx->n_requested++;
+    }
+    ctx->sms = g_list_reverse (ctx->sms);
+    g_hash_table_unref (requested);
+    g_hash_table_unref (by_path);
+
+    delete_sms_multiple_run (task);
+}
+
+void
+mm_sms_list_delete_all (MMSmsList *self,
+                        GAsyncReadyCallback callback,
+                        gpointer user_data)
+{
+    DeleteSmsMultipleContext *ctx;
+    GTask *task;
+    GList *l;
+
+    task = delete_sms_multiple_task_new (self, TRUE, callback, user_data);
+    ctx = g_task_get_task_data (task);
+
+    for (l = self->priv->list; l; l = g_list_next (l)) {
+        ctx->sms = g_list_prepend (ctx->sms, g_object_ref (l->data));
+        ctx->n_requested++;
+    }
+
+    /* Messages being delivered to the sink or already delivered and waiting
+     * to be removed, and multipart messages waiting for more parts before
+     * being delivered */
+    for (l = self->priv->sink_delivering_list; l; l = g_list_next (l))
+        ctx->hidden = g_list_prepend (ctx->hidden, g_object_ref (l->data));
+    for (l = self->priv->sink_delete_queue->head; l; l = g_list_next (l))
+        ctx->hidden = g_list_prepend (ctx->hidden, g_object_ref (l->data));
+    for (l = self->priv->sink_pending_list; l; l = g_list_next (l))
+        ctx->hidden = g_list_prepend (ctx->hidden, g_object_ref (((SinkPending *)l->data)->sms));
+
+    delete_sms_multiple_run (task);
+}
+
 /*****************************************************************************/
 
 void
 mm_sms_list_add_sms (MMSmsList *self,
                      MMBaseSms *sms)
 {
-    self->priv->list = g_list_prepend (self->priv->list, g_object_ref (sms));
+    list_prepend (self, g_object_ref (sms));
+    self->priv->user_list = g_list_prepend (self->priv->user_list, sms);
     g_signal_emit (self, signals[SIGNAL_ADDED], 0,
                    mm_base_sms_get_path (sms),
                    FALSE);
@@ -216,29 +758,313 @@ mm_sms_list_add_sms (MMSmsList *self,
 
 /*****************************************************************************/
 
-static guint
-cmp_sms_by_concat_reference (MMBaseSms *sms,
-                             gpointer user_data)
+static void
+index_part (MMSmsList *self,
+            MMBaseSms *sms,
+            MMSmsPart *part)
 {
-    if (!mm_base_sms_is_multipart (sms))
-        return -1;
+    MMSmsStorage storage;
+    guint        index;
 
-    return (GPOINTER_TO_UINT (user_data) - mm_base_sms_get_multipart_reference (sms));
+    storage = mm_base_sms_get_storage (sms);
+    index = mm_sms_part_get_index (part);
+    if (storage != MM_SMS_STORAGE_UNKNOWN && index != SMS_PART_INVALID_INDEX)
+        mm_sms_index_add_part (self->priv->index, storage, index, sms);
+}
+
+static void
+expose_sms (MMSmsList *self,
+            MMBaseSms *sms,
+            gboolean received)
+{
+    mm_base_sms_export (sms);
+    list_prepend (self, sms);
+    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
+                   mm_base_sms_get_path (sms),
+                   received);
+}
+
+/*****************************************************************************/
+/* Direct delivery to the SMS sink */
+
+static void     sink_delete_next    (MMSmsList *self);
+static gboolean sink_delete_timeout (MMSmsList *self);
+
+static void
+sink_delete_done (MMSmsList *self,
+                  MMBaseSms *sms)
+{
+    unindex_sms (self, sms);
+    g_object_unref (sms);
 }
 
 typedef struct {
-    guint part_index;
+    MMSmsList *self;
+    GList *batch;
+} SinkDeleteContext;
+
+static void
+sink_delete_ready (MMBaseSms *sms,
+                   GAsyncResult *res,
+                   SinkDeleteContext *ctx)
+{
+    MMSmsList *self;
+    GList *batch;
+    GList *l;
+    GError *error = NULL;
+
+    self = ctx->self;
+    batch = ctx->batch;
+    g_free (ctx);
+
+    if (!mm_base_sms_delete_parts_finish (sms, res, &error)) {
+        if (g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_RETRY) && self->priv->modem) {
+            /* Storages busy, try again later */
+            for (l = g_list_last (batch); l; l = g_list_previous (l)) {
+                reindex_parts (self, l->data);
+                g_queue_push_head (self->priv->sink_delete_queue, l->data);
+            }
+            g_list_free (batch);
+            self->priv->sink_deleting = FALSE;
+            if (!self->priv->sink_delete_timeout_id)
+                self->priv->sink_delete_timeout_id = g_timeout_add_seconds (SINK_DELETE_TIMEOUT_SECS,
+                                                                            (GSourceFunc)sink_delete_timeout,
+                                                                            self);
+            g_error_free (error);
+            g_object_unref (self);
+            return;
+        }
+        mm_warn ("Couldn't remove SMS delivered to the sink from storage: %s", error->message);
+        g_error_free (error);
+    }
+
+    for (l = batch; l; l = g_list_next (l))
+        sink_delete_done (self, l->data);
+    g_list_free (batch);
+
+    sink_delete_next (self);
+    g_object_unref (self);
+}
+
+static void
+sink_delete_next (MMSmsList *self)
+{
+    MMBaseSms *sms;
     MMSmsStorage storage;
-} PartIndexAndStorage;
+    GPtrArray *parts;
+    GList *batch = NULL;
+    SinkDeleteContext *ctx;
 
-static guint
-cmp_sms_by_part_index_and_storage (MMBaseSms *sms,
-                                   PartIndexAndStorage *ctx)
+    sms = g_queue_peek_head (self->priv->sink_delete_queue);
+    if (!sms) {
+        self->priv->sink_deleting = FALSE;
+        return;
+    }
+
+    /* All the queued messages in the same storage go in a single request */
+    storage = mm_base_sms_get_storage (sms);
+    parts = g_ptr_array_new ();
+    while ((sms = g_queue_peek_head (self->priv->sink_delete_queue)) != NULL &&
+           mm_base_sms_get_storage (sms) == storage) {
+        GList *p;
+
+        g_queue_pop_head (self->priv->sink_delete_queue);
+        for (p = mm_base_sms_get_parts (sms); p; p = g_list_next (p)) {
+            if (mm_sms_part_get_index ((MMSmsPart *)p->data) != SMS_PART_INVALID_INDEX)
+                g_ptr_array_add (parts, p->data);
+        }
+        unindex_parts (self, sms);
+        batch = g_list_prepend (batch, sms);
+    }
+    batch = g_list_reverse (batch);
+
+    self->priv->sink_deleting = TRUE;
+    ctx = g_new0 (SinkDeleteContext, 1);
+    ctx->self = g_object_ref (self);
+    ctx->batch = batch;
+    mm_base_sms_delete_parts (MM_BASE_SMS (batch->data),
+                              storage,
+                              parts,
+                              FALSE,
+                              (GAsyncReadyCallback)sink_delete_ready,
+                              ctx);
+    g_ptr_array_unref (parts);
+}
+
+static gboolean
+sink_delete_timeout (MMSmsList *self)
 {
-    return !(mm_base_sms_get_storage (sms) == ctx->storage &&
-             mm_base_sms_has_part_index (sms, ctx->part_index));
+    self->priv->sink_delete_timeout_id = 0;
+    if (!self->priv->sink_deleting)
+        sink_delete_next (self);
+    return G_SOURCE_REMOVE;
 }
 
+static void
+sink_schedule_delete (MMSmsList *self)
+{
+    if (self->priv->sink_deleting)
+        return;
+
+    if (g_queue_get_length (self->priv->sink_delete_queue) >= SINK_DELETE_BATCH_SIZE) {
+        if (self->priv->sink_delete_timeout_id) {
+            g_source_remove (self->priv->sink_delete_timeout_id);
+            self->priv->sink_delete_timeout_id = 0;
+        }
+        sink_delete_next (self);
+        return;
+    }
+
+    if (!self->priv->sink_delete_timeout_id)
+        self->priv->sink_delete_timeout_id = g_timeout_add_seconds (SINK_DELETE_TIMEOUT_SECS,
+                                                                    (GSourceFunc)sink_delete_timeout,
+                                                                    self);
+}
+
+static void
+sink_deliver_ready (MMBaseSms *sms,
+                    GAsyncResult *res,
+                    MMSmsList *self)
+{
+    GError *error = NULL;
+    GList *l;
+
+    mm_sms_sink_deliver_finish (self->priv->sink, res, &error);
+
+    /* The list may have been disposed in the meantime */
+    l = g_list_find (self->priv->sink_delivering_list, sms);
+    if (!l) {
+        g_clear_error (&error);
+        g_object_unref (self);
+        return;
+    }
+    self->priv->sink_delivering_list = g_list_delete_link (self->priv->sink_delivering_list, l);
+
+    if (error) {
+        mm_dbg ("Couldn't deliver SMS to the sink, exposing it instead: %s", error->message);
+        g_error_free (error);
+        expose_sms (self, sms, TRUE);
+    } else if (!sms_is_stored (sms))
+        sink_delete_done (self, sms);
+    else {
+        /* Keep it indexed until removed, so that the parts are not taken again */
+        g_queue_push_tail (self->priv->sink_delete_queue, sms);
+        sink_schedule_delete (self);
+    }
+
+    g_object_unref (self);
+}
+
+/* Takes ownership of the SMS if there is a sink; if the delivery fails, the
+ * message is exposed as usual */
+static gboolean
+sink_deliver (MMSmsList *self,
+              MMBaseSms *sms)
+{
+    if (!self->priv->sink)
+        return FALSE;
+
+    self->priv->sink_delivering_list = g_list_prepend (self->priv->sink_delivering_list, sms);
+    mm_sms_sink_deliver (self->priv->sink,
+                         sms,
+                         g_dbus_object_get_object_path (G_DBUS_OBJECT (self->priv->modem)),
+                         (GAsyncReadyCallback)sink_deliver_ready,
+                         g_object_ref (self));
+    return TRUE;
+}
+
+static void
+sink_pending_free (SinkPending *pending)
+{
+    if (pending->timeout_id)
+        g_source_remove (pending->timeout_id);
+    if (pending->sms)
+        g_object_unref (pending->sms);
+    g_free (pending);
+}
+
+static GList *
+sink_pending_find (MMSmsList *self,
+                   MMBaseSms *sms)
+{
+    GList *l;
+
+    for (l = self->priv->sink_pending_list; l; l = g_list_next (l)) {
+        if (((SinkPending *)l->data)->sms == sms)
+            return l;
+    }
+    return NULL;
+}
+
+/* Removes the message from the pending list, returns a full reference */
+static MMBaseSms *
+sink_pending_steal (MMSmsList *self,
+                    GList *link)
+{
+    SinkPending *pending;
+    MMBaseSms *sms;
+
+    pending = link->data;
+    self->priv->sink_pending_list = g_list_delete_link (self->priv->sink_pending_list, link);
+    sms = pending->sms;
+    pending->sms = NULL;
+    sink_pending_free (pending);
+    return sms;
+}
+
+static gboolean
+sink_pending_timeout (SinkPending *pending)
+{
+    MMSmsList *self;
+    GList *l;
+
+    self = pending->self;
+    pending->timeout_id = 0;
+
+    l = g_list_find (self->priv->sink_pending_list, pending);
+    g_assert (l);
+    mm_dbg ("Multipart SMS not complete after %u seconds, exposing it",
+            SINK_PENDING_TIMEOUT_SECS);
+    /* Parts received later on are taken by the exposed message */
+    expose_sms (self, sink_pending_steal (self, l), TRUE);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+sink_pending_add (MMSmsList *self,
+                  MMBaseSms *sms)
+{
+    SinkPending *pending;
+
+    pending = g_new0 (SinkPending, 1);
+    pending->self = self;
+    pending->sms = sms;
+    pending->timeout_id = g_timeout_add_seconds (SINK_PENDING_TIMEOUT_SECS,
+                                                 (GSourceFunc)sink_pending_timeout,
+                                                 pending);
+    self->priv->sink_pending_list = g_list_prepend (self->priv->sink_pending_list, pending);
+}
+
+static void
+sink_pending_check (MMSmsList *self,
+                    GList *link)
+{
+    MMBaseSms *sms;
+
+    if (!mm_base_sms_multipart_is_complete (((SinkPending *)link->data)->sms))
+        return;
+
+    sms = sink_pending_steal (self, link);
+
+    /* If assembling failed, expose it so that it can be deleted */
+    if (mm_base_sms_multipart_is_assembled (sms) && sink_deliver (self, sms))
+        return;
+
+    expose_sms (self, sms, TRUE);
+}
+
+/*****************************************************************************/
+
 static gboolean
 take_singlepart (MMSmsList *self,
                  MMSmsPart *part,
@@ -256,10 +1082,11 @@ take_singlepart (MMSmsList *self,
     if (!sms)
         return FALSE;
 
-    self->priv->list = g_list_prepend (self->priv->list, sms);
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   state == MM_SMS_STATE_RECEIVED);
+    index_part (self, sms, part);
+    if (state == MM_SMS_STATE_RECEIVED && sink_deliver (self, sms))
+        return TRUE;
+
+    expose_sms (self, sms, state == MM_SMS_STATE_RECEIVED);
     return TRUE;
 }
 
@@ -270,17 +1097,23 @@ take_multipart (MMSmsList *self,
                 MMSmsStorage storage,
                 GError **error)
 {
-    GList *l;
     MMBaseSms *sms;
     guint concat_reference;
+    GList *l;
 
     concat_reference = mm_sms_part_get_concat_reference (part);
-    l = g_list_find_custom (self->priv->list,
-                            GUINT_TO_POINTER (concat_reference),
-                            (GCompareFunc)cmp_sms_by_concat_reference);
-    if (l)
+    sms = mm_sms_index_lookup_multipart (self->priv->index,
+                                         mm_sms_part_get_number (part),
+                                         concat_reference);
+    if (sms) {
         /* Try to take the part */
-        return mm_base_sms_multipart_take_part (MM_BASE_SMS (l->data), part, error);
+        if (!mm_base_sms_multipart_take_part (sms, part, error))
+            return FALSE;
+        index_part (self, sms, part);
+        if ((l = sink_pending_find (self, sms)) != NULL)
+            sink_pending_check (self, l);
+        return TRUE;
+    }
 
     /* Create new Multipart */
     sms = mm_base_sms_multipart_new (self->priv->modem,
@@ -293,12 +1126,25 @@ take_multipart (MMSmsList *self,
     if (!sms)
         return FALSE;
 
-    self->priv->list = g_list_prepend (self->priv->list, sms);
-    g_signal_emit (self, signals[SIGNAL_ADDED], 0,
-                   mm_base_sms_get_path (sms),
-                   (state == MM_SMS_STATE_RECEIVED ||
-                    state == MM_SMS_STATE_RECEIVING));
+    index_part (self, sms, part);
+    mm_sms_index_add_multipart (self->priv->index,
+                                mm_sms_part_get_number (part),
+                                concat_reference,
+                                sms);
+
+    /* With direct delivery, received messages are kept aside until all
+     * parts are available */
+    if (self->priv->sink &&
+        (state == MM_SMS_STATE_RECEIVED ||
+         state == MM_SMS_STATE_RECEIVING)) {
+        sink_pending_add (self, sms);
+        sink_pending_check (self, self->priv->sink_pending_list);
+        return TRUE;
+    }
 
+    expose_sms (self, sms,
+                (state == MM_SMS_STATE_RECEIVED ||
+                 state == MM_SMS_STATE_RECEIVING));
     return TRUE;
 }
 
@@ -307,18 +1153,25 @@ mm_sms_list_has_part (MMSmsList *self,
                       MMSmsStorage storage,
                       guint index)
 {
-    PartIndexAndStorage ctx;
+    GList *l;
 
     if (storage == MM_SMS_STORAGE_UNKNOWN ||
         index == SMS_PART_INVALID_INDEX)
         return FALSE;
 
-    ctx.part_index = index;
-    ctx.storage = storage;
+    if (mm_sms_index_lookup_part (self->priv->index, storage, index))
+        return TRUE;
+
+    /* Messages created by the user are few, just walk them */
+    for (l = self->priv->user_list; l; l = g_list_next (l)) {
+        MMBaseSms *sms = MM_BASE_SMS (l->data);
+
+        if (mm_base_sms_get_storage (sms) == storage &&
+            mm_base_sms_has_part_index (sms, index))
+            return TRUE;
+    }
 
-    return !!g_list_find_custom (self->priv->list,
-                                 &ctx,
-                                 (GCompareFunc)cmp_sms_by_part_index_and_storage);
+    return FALSE;
 }
 
 gboolean
@@ -421,6 +1274,10 @@ mm_sms_list_init (MMSmsList *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_SMS_LIST,
                                               MMSmsListPrivate);
+    self->priv->links = g_hash_table_new (g_direct_hash, g_direct_equal);
+    self->priv->index = mm_sms_index_new ();
+    self->priv->sink = mm_sms_sink_get_default ();
+    self->priv->sink_delete_queue = g_queue_new ();
 }
 
 static void
@@ -428,13 +1285,40 @@ dispose (GObject *object)
 {
     MMSmsList *self = MM_SMS_LIST (object);
 
+    if (self->priv->sink_delete_timeout_id) {
+        g_source_remove (self->priv->sink_delete_timeout_id);
+        self->priv->sink_delete_timeout_id = 0;
+    }
+    /* Messages not removed yet will be delivered again next time the storage
+     * is loaded */
+    g_queue_free_full (self->priv->sink_delete_queue, g_object_unref);
+    self->priv->sink_delete_queue = g_queue_new ();
+    g_list_free_full (self->priv->sink_pending_list, (GDestroyNotify)sink_pending_free);
+    self->priv->sink_pending_list = NULL;
+    g_list_free_full (self->priv->sink_delivering_list, g_object_unref);
+    self->priv->sink_delivering_list = NULL;
+
     g_clear_object (&self->priv->modem);
+    g_clear_pointer (&self->priv->user_list, g_list_free);
+    g_hash_table_remove_all (self->priv->links);
     g_list_free_full (self->priv->list, g_object_unref);
     self->priv->list = NULL;
 
     G_OBJECT_CLASS (mm_sms_list_parent_class)->dispose (object);
 }
 
+static void
+finalize (GObject *object)
+{
+    MMSmsList *self = MM_SMS_LIST (object);
+
+    g_hash_table_unref (self->priv->links);
+    mm_sms_index_free (self->priv->index);
+    g_queue_free (self->priv->sink_delete_queue);
+
+    G_OBJECT_CLASS (mm_sms_list_parent_class)->finalize (object);
+}
+
 static void
 mm_sms_list_class_init (MMSmsListClass *klass)
 {
@@ -446,6 +1330,7 @@ mm_sms_list_class_init (MMSmsListClass *klass)
     object_class->get_property = get_property;
     object_class->set_property = set_property;
     object_class->dispose = dispose;
+    object_class->finalize = finalize;
 
     /* Properties */
     properties[PROP_MODEM] =
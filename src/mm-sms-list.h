@@ -60,6 +60,13 @@ MMSmsList *mm_sms_list_new (MMBaseModem *modem);
 
 GStrv mm_sms_list_get_paths (MMSmsList *self);
 guint mm_sms_list_get_count (MMSmsList *self);
+GStrv mm_sms_list_get_paths_range (MMSmsList *self,
+                                   guint offset,
+                                   guint count);
+GStrv mm_sms_list_get_paths_since (MMSmsList *self,
+                                   gint64 unix_time);
+MMBaseSms *mm_sms_list_get_sms (MMSmsList *self,
+                                const gchar *sms_path);
 
 gboolean mm_sms_list_has_part (MMSmsList *self,
                                MMSmsStorage storage,
@@ -82,6 +89,23 @@ gboolean mm_sms_list_delete_sms_finish (MMSmsList *self,
                                         GAsyncResult *res,
                                         GError **error);
 
+void     mm_sms_list_delete_sms_multiple        (MMSmsList *self,
+                                                 const gchar *const *sms_paths,
+                                                 GAsyncReadyCallback callback,
+                                                 gpointer user_data);
+gboolean mm_sms_list_delete_sms_multiple_finish (MMSmsList *self,
+                                                 GAsyncResult *res,
+                                                 guint *n_deleted,
+                                                 GError **error);
+
+void     mm_sms_list_delete_all        (MMSmsList *self,
+                                        GAsyncReadyCallback callback,
+                                        gpointer user_data);
+gboolean mm_sms_list_delete_all_finish (MMSmsList *self,
+                                        GAsyncResult *res,
+                                        guint *n_deleted,
+                                        GError **error);
+
 gboolean mm_sms_list_has_local_multipart_reference (MMSmsList *self,
                                                     const gchar *number,
                                                     guint8 reference);
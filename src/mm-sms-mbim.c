@@ -333,6 +333,185 @@ sms_delete (MMBaseSms *self,
 
 /*****************************************************************************/
 
+typedef struct {
+    MbimDevice *device;
+    GPtrArray *parts;
+    guint i;
+    guint n_failed;
+} SmsDeleteMultiplePartsContext;
+
+static void
+sms_delete_multiple_parts_context_free (SmsDeleteMultiplePartsContext *ctx)
+{
+    g_ptr_array_unref (ctx->parts);
+    g_object_unref (ctx->device);
+    g_slice_free (SmsDeleteMultiplePartsContext, ctx);
+}
+
+static gboolean
+sms_delete_parts_finish (MMBaseSms *self,
+                         GAsyncResult *res,
+                         GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static gboolean
+sms_delete_set_finish (MbimDevice *device,
+                       GAsyncResult *res,
+                       GError **error)
+{
+    MbimMessage *response;
+    gboolean deleted = FALSE;
+
+    response = mbim_device_command_finish (device, res, error);
+    if (response &&
+        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, error))
+        deleted = mbim_message_sms_delete_response_parse (response, error);
+
+    if (response)
+        mbim_message_unref (response);
+    return deleted;
+}
+
+static void
+sms_delete_set (SmsDeleteMultiplePartsContext *ctx,
+                MbimSmsFlag flag,
+                guint32 index,
+                GAsyncReadyCallback callback,
+                GTask *task)
+{
+    MbimMessage *message;
+
+    message = mbim_message_sms_delete_set_new (flag, index, NULL);
+    mbim_device_command (ctx->device,
+                         message,
+                         flag == MBIM_SMS_FLAG_ALL ? 30 : 10,
+                         NULL,
+                         callback,
+                         task);
+    mbim_message_unref (message);
+}
+
+static void delete_multiple_next_part (GTask *task);
+
+static void
+delete_multiple_part_ready (MbimDevice *device,
+                            GAsyncResult *res,
+                            GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+    part = g_ptr_array_index (ctx->parts, ctx->i);
+
+    /* Parts that couldn't be deleted keep their index */
+    if (!sms_delete_set_finish (device, res, &error)) {
+        ctx->n_failed++;
+        mm_dbg ("Couldn't delete SMS part with index %u: '%s'",
+                mm_sms_part_get_index (part),
+                error->message);
+        g_error_free (error);
+    } else
+        mm_sms_part_set_index (part, SMS_PART_INVALID_INDEX);
+
+    ctx->i++;
+    delete_multiple_next_part (task);
+}
+
+static void
+delete_multiple_next_part (GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Skip non-stored parts */
+    while (ctx->i < ctx->parts->len &&
+           mm_sms_part_get_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, ctx->i)) == SMS_PART_INVALID_INDEX)
+        ctx->i++;
+
+    if (ctx->i == ctx->parts->len) {
+        if (ctx->n_failed > 0)
+            g_task_return_new_error (task,
+                                     MM_CORE_ERROR,
+                                     MM_CORE_ERROR_FAILED,
+                                     "Couldn't delete %u SMS parts",
+                                     ctx->n_failed);
+        else
+            g_task_return_boolean (task, TRUE);
+
+        g_object_unref (task);
+        return;
+    }
+
+    sms_delete_set (ctx,
+                    MBIM_SMS_FLAG_INDEX,
+                    (guint32)mm_sms_part_get_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, ctx->i)),
+                    (GAsyncReadyCallback)delete_multiple_part_ready,
+                    task);
+}
+
+static void
+delete_all_ready (MbimDevice *device,
+                  GAsyncResult *res,
+                  GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    GError *error = NULL;
+    guint i;
+
+    ctx = g_task_get_task_data (task);
+
+    if (!sms_delete_set_finish (device, res, &error)) {
+        mm_dbg ("Couldn't delete all SMS parts at once: '%s'", error->message);
+        g_error_free (error);
+        delete_multiple_next_part (task);
+        return;
+    }
+
+    for (i = 0; i < ctx->parts->len; i++)
+        mm_sms_part_set_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, i), SMS_PART_INVALID_INDEX);
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+sms_delete_parts (MMBaseSms *self,
+                  MMSmsStorage storage,
+                  GPtrArray *parts,
+                  gboolean whole_storage,
+                  GAsyncReadyCallback callback,
+                  gpointer user_data)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    MbimDevice *device;
+    GTask *task;
+
+    if (!peek_device (self, &device, callback, user_data))
+        return;
+
+    ctx = g_slice_new0 (SmsDeleteMultiplePartsContext);
+    ctx->device = g_object_ref (device);
+    ctx->parts = g_ptr_array_ref (parts);
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)sms_delete_multiple_parts_context_free);
+
+    /* MBIM devices expose a single message store */
+    if (whole_storage && parts->len > 0) {
+        sms_delete_set (ctx, MBIM_SMS_FLAG_ALL, 0, (GAsyncReadyCallback)delete_all_ready, task);
+        return;
+    }
+
+    delete_multiple_next_part (task);
+}
+
+/*****************************************************************************/
+
 MMBaseSms *
 mm_sms_mbim_new (MMBaseModem *modem)
 {
@@ -357,4 +536,6 @@ mm_sms_mbim_class_init (MMSmsMbimClass *klass)
     base_sms_class->send_finish = sms_send_finish;
     base_sms_class->delete = sms_delete;
     base_sms_class->delete_finish = sms_delete_finish;
+    base_sms_class->delete_parts = sms_delete_parts;
+    base_sms_class->delete_parts_finish = sms_delete_parts_finish;
 }
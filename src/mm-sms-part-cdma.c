@@ -229,34 +229,106 @@ encoding_to_string (Encoding encoding)
 }
 
 /*****************************************************************************/
-/* Read bits; o_bits < 8; n_bits <= 8
+/* Bit reader
+ *
+ * Fields in the transport layer parameters and bearer data subparameters are
+ * packed MSB first, with no alignment:
  *
  * Byte 0            Byte 1
  * [7|6|5|4|3|2|1|0] [7|6|5|4|3|2|1|0]
  *
- * o_bits+n_bits <= 16
- *
+ * Reading past the end of the buffer returns 0 and flags the reader as
+ * overflown, so that a whole group of fields may be read before checking
+ * whether they were all available.
  */
-static guint8
-read_bits (const guint8 *bytes,
-           guint8 o_bits,
-           guint8 n_bits)
+
+typedef struct {
+    const guint8 *data;
+    gsize         len;      /* in bytes */
+    gsize         offset;   /* in bits */
+    gboolean      overflow;
+} BitReader;
+
+static const guint16 bit_masks[17] = {
+    0x0000, 0x0001, 0x0003, 0x0007, 0x000F, 0x001F, 0x003F, 0x007F, 0x00FF,
+    0x01FF, 0x03FF, 0x07FF, 0x0FFF, 0x1FFF, 0x3FFF, 0x7FFF, 0xFFFF
+};
+
+static inline void
+bit_reader_init (BitReader    *reader,
+                 const guint8 *data,
+                 gsize         len)
 {
-    guint8 bits_in_first;
-    guint8 bits_in_second;
+    reader->data = data;
+    reader->len = len;
+    reader->offset = 0;
+    reader->overflow = FALSE;
+}
 
-    g_assert (o_bits < 8);
-    g_assert (n_bits <= 8);
-    g_assert (o_bits + n_bits <= 16);
+static inline gboolean
+bit_reader_has (BitReader *reader,
+                gsize      n_bits)
+{
+    if (G_UNLIKELY (reader->overflow || n_bits > (reader->len * 8) - reader->offset)) {
+        reader->overflow = TRUE;
+        return FALSE;
+    }
+    return TRUE;
+}
 
-    /* Read only from the first byte */
-    if (o_bits + n_bits <= 8)
-        return (bytes[0] >> (8 - o_bits - n_bits)) & ((1 << n_bits) - 1);
+/* n_bits <= 16 */
+static inline guint16
+bit_reader_read (BitReader *reader,
+                 guint      n_bits)
+{
+    gsize   byte_offset;
+    guint   shift;
+    guint32 window;
+
+    g_assert (n_bits <= 16);
+
+    if (!n_bits || !bit_reader_has (reader, n_bits))
+        return 0;
+
+    /* A 24-bit window holds any 16-bit field, whatever the bit offset */
+    byte_offset = reader->offset >> 3;
+    shift = reader->offset & 7;
+    window = (guint32)reader->data[byte_offset] << 16;
+    if (byte_offset + 1 < reader->len) {
+        window |= (guint32)reader->data[byte_offset + 1] << 8;
+        if (byte_offset + 2 < reader->len)
+            window |= (guint32)reader->data[byte_offset + 2];
+    }
 
-    /* Read (8 - o_bits) from the first byte and (n_bits - (8 - o_bits)) from the second byte */
-    bits_in_first = 8 - o_bits;
-    bits_in_second = n_bits - bits_in_first;
-    return (read_bits (&bytes[0], o_bits, bits_in_first) << bits_in_second) | read_bits (&bytes[1], 0, bits_in_second);
+    reader->offset += n_bits;
+    return (guint16)((window >> (24 - shift - n_bits)) & bit_masks[n_bits]);
+}
+
+static inline gboolean
+bit_reader_read_bytes (BitReader *reader,
+                       guint8    *out,
+                       gsize      n_bytes)
+{
+    const guint8 *in;
+    guint shift;
+    gsize i;
+
+    if (!bit_reader_has (reader, n_bytes * 8))
+        return FALSE;
+
+    in = &reader->data[reader->offset >> 3];
+    shift = reader->offset & 7;
+    if (!shift)
+        memcpy (out, in, n_bytes);
+    else {
+        /* When unaligned, the last output byte takes bits from in[n_bytes],
+         * which bit_reader_has() already validated */
+        for (i = 0; i < n_bytes; i++)
+            out[i] = (guint8)((in[i] << shift) | (in[i + 1] >> (8 - shift)));
+    }
+
+    reader->offset += n_bytes * 8;
+    return TRUE;
 }
 
 /*****************************************************************************/
@@ -467,39 +539,31 @@ static void
 read_address (MMSmsPart *sms_part,
               const struct Parameter *parameter)
 {
+    BitReader reader;
     guint8 digit_mode;
     guint8 number_mode;
     guint8 number_type;
     guint8 numbering_plan;
     guint8 num_fields;
-    guint byte_offset = 0;
-    guint bit_offset = 0;
     guint i;
     gchar *number = NULL;
 
-#define OFFSETS_UPDATE(n_bits) do { \
-        bit_offset += n_bits;       \
-        if (bit_offset >= 8) {      \
-            bit_offset-=8;          \
-            byte_offset++;          \
-        }                           \
-    } while (0)
-
-#define PARAMETER_SIZE_CHECK(required_size)                             \
-    if (parameter->parameter_len < required_size) {                     \
-        mm_dbg ("        cannot read address, need at least %u bytes (got %u)", \
-                required_size,                                          \
-                parameter->parameter_len);                              \
-        return;                                                         \
+    bit_reader_init (&reader, parameter->parameter_value, parameter->parameter_len);
+
+    /* Header fields: digit mode, number mode, and if ASCII digits, number type
+     * and numbering plan; then the number of fields */
+    digit_mode = bit_reader_read (&reader, 1);
+    number_mode = bit_reader_read (&reader, 1);
+    number_type = (digit_mode == DIGIT_MODE_ASCII) ? bit_reader_read (&reader, 3) : 0xFF;
+    numbering_plan = ((digit_mode == DIGIT_MODE_ASCII && number_mode == NUMBER_MODE_DIGIT) ?
+                      bit_reader_read (&reader, 4) : 0xFF);
+    num_fields = bit_reader_read (&reader, 8);
+    if (reader.overflow) {
+        mm_dbg ("        cannot read address, header too short (%u bytes)",
+                parameter->parameter_len);
+        return;
     }
 
-    /* Readability of digit mode and number mode (first 2 bits, i.e. first byte) */
-    PARAMETER_SIZE_CHECK (1);
-
-    /* Digit mode */
-    digit_mode = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 1);
-    OFFSETS_UPDATE (1);
-    g_assert (digit_mode <= 1);
     switch (digit_mode) {
     case DIGIT_MODE_DTMF:
         mm_dbg ("        digit mode: dtmf");
@@ -511,9 +575,6 @@ read_address (MMSmsPart *sms_part,
         g_assert_not_reached ();
     }
 
-    /* Number mode */
-    number_mode = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 1);
-    OFFSETS_UPDATE (1);
     switch (number_mode) {
     case NUMBER_MODE_DIGIT:
         mm_dbg ("        number mode: digit");
@@ -525,11 +586,7 @@ read_address (MMSmsPart *sms_part,
         g_assert_not_reached ();
     }
 
-    /* Number type */
     if (digit_mode == DIGIT_MODE_ASCII) {
-        /* No need for readability check, still in first byte always */
-        number_type = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 3);
-        OFFSETS_UPDATE (3);
         switch (number_type) {
         case NUMBER_TYPE_UNKNOWN:
             mm_dbg ("        number type: unknown");
@@ -553,15 +610,9 @@ read_address (MMSmsPart *sms_part,
             mm_dbg ("        number type unknown (%u)", number_type);
             break;
         }
-    } else
-        number_type = 0xFF;
+    }
 
-    /* Numbering plan */
     if (digit_mode == DIGIT_MODE_ASCII && number_mode == NUMBER_MODE_DIGIT) {
-        /* Readability of numbering plan; may go to second byte */
-        PARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + 4) / 8));
-        numbering_plan = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 4);
-        OFFSETS_UPDATE (4);
         switch (numbering_plan) {
         case NUMBERING_PLAN_UNKNOWN:
             mm_dbg ("        numbering plan: unknown");
@@ -582,67 +633,58 @@ read_address (MMSmsPart *sms_part,
             mm_dbg ("        numbering plan unknown (%u)", numbering_plan);
             break;
         }
-    } else
-        numbering_plan = 0xFF;
+    }
 
-    /* Readability of num_fields; will go to third byte (((bit_offset + 8) / 8) == 1) */
-    PARAMETER_SIZE_CHECK (byte_offset + 2);
-    num_fields = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 8);
-    OFFSETS_UPDATE (8);
     mm_dbg ("        num fields: %u", num_fields);
 
-    /* Address string */
+    /* Address string; the whole string is validated before reading it */
 
     if (digit_mode == DIGIT_MODE_DTMF) {
         /* DTMF */
-        PARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 4)) / 8));
+        if (!bit_reader_has (&reader, num_fields * 4))
+            goto too_short;
         number = g_malloc (num_fields + 1);
-        for (i = 0; i < num_fields; i++) {
-            number[i] = dtmf_to_ascii (read_bits (&parameter->parameter_value[byte_offset], bit_offset, 4));
-            OFFSETS_UPDATE (4);
-        }
+        for (i = 0; i < num_fields; i++)
+            number[i] = dtmf_to_ascii (bit_reader_read (&reader, 4));
         number[i] = '\0';
-    } else if (number_mode == NUMBER_MODE_DIGIT) {
-        /* ASCII
+    } else if (number_mode == NUMBER_MODE_DIGIT ||
+               number_type == DATA_NETWORK_ADDRESS_TYPE_INTERNET_EMAIL_ADDRESS) {
+        /* ASCII, or Internet e-mail address (ASCII)
          * TODO: should we expose numbering plan and number type? */
-        PARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 8)) / 8));
         number = g_malloc (num_fields + 1);
-        for (i = 0; i < num_fields; i++) {
-            number[i] = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 8);
-            OFFSETS_UPDATE (8);
-        }
-        number[i] = '\0';
-    } else if (number_type == DATA_NETWORK_ADDRESS_TYPE_INTERNET_EMAIL_ADDRESS) {
-        /* Internet e-mail address (ASCII) */
-        PARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 8)) / 8));
-        number = g_malloc (num_fields + 1);
-        for (i = 0; i < num_fields; i++) {
-            number[i] = read_bits (&parameter->parameter_value[byte_offset], bit_offset, 8);
-            OFFSETS_UPDATE (8);
+        if (!bit_reader_read_bytes (&reader, (guint8 *)number, num_fields)) {
+            g_free (number);
+            goto too_short;
         }
-        number[i] = '\0';
+        number[num_fields] = '\0';
     } else if (number_type == DATA_NETWORK_ADDRESS_TYPE_INTERNET_PROTOCOL) {
-        GString *str;
+        static const gchar hex[] = "0123456789ABCDEF";
 
         /* Binary data network address (most significant first)
-         * For now, just print the hex string (e.g. FF:01...) */
-        PARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 8)) / 8));
-        str = g_string_sized_new (num_fields * 2);
+         * For now, just print the hex string (e.g. FF01...) */
+        if (!bit_reader_has (&reader, num_fields * 8))
+            goto too_short;
+        number = g_malloc ((num_fields * 2) + 1);
         for (i = 0; i < num_fields; i++) {
-            g_string_append_printf (str, "%.2X", read_bits (&parameter->parameter_value[byte_offset], bit_offset, 8));
-            OFFSETS_UPDATE (8);
+            guint8 byte;
+
+            byte = bit_reader_read (&reader, 8);
+            number[i * 2]     = hex[byte >> 4];
+            number[i * 2 + 1] = hex[byte & 0x0F];
         }
-        number = g_string_free (str, FALSE);
+        number[i * 2] = '\0';
     } else
         mm_dbg ("        data network address number type unknown (%u)", number_type);
 
     mm_dbg ("        address: %s", number);
 
-    mm_sms_part_set_number (sms_part, number);
-    g_free (number);
+    mm_sms_part_take_number (sms_part, number);
+    return;
 
-#undef OFFSETS_UPDATE
-#undef PARAMETER_SIZE_CHECK
+too_short:
+    mm_dbg ("        cannot read address, %u fields don't fit in %u bytes",
+            num_fields,
+            parameter->parameter_len);
 }
 
 static void
@@ -659,7 +701,7 @@ read_bearer_reply_option (MMSmsPart *sms_part,
         return;
     }
 
-    sequence = read_bits (&parameter->parameter_value[0], 0, 6);
+    sequence = parameter->parameter_value[0] >> 2;
     mm_dbg ("        sequence: %u", sequence);
 
     mm_sms_part_set_message_reference (sms_part, sequence);
@@ -674,7 +716,7 @@ read_cause_codes (MMSmsPart *sms_part,
     guint8 cause_code;
     MMSmsDeliveryState delivery_state;
 
-    g_assert (parameter->parameter_id == PARAMETER_ID_BEARER_REPLY_OPTION);
+    g_assert (parameter->parameter_id == PARAMETER_ID_CAUSE_CODES);
 
     if (parameter->parameter_len != 1 && parameter->parameter_len != 2) {
         mm_dbg ("        invalid cause codes length found (%u): ignoring",
@@ -682,10 +724,10 @@ read_cause_codes (MMSmsPart *sms_part,
         return;
     }
 
-    sequence = read_bits (&parameter->parameter_value[0], 0, 6);
+    sequence = parameter->parameter_value[0] >> 2;
     mm_dbg ("        sequence: %u", sequence);
 
-    error_class = read_bits (&parameter->parameter_value[0], 6, 2);
+    error_class = parameter->parameter_value[0] & 0x03;
     mm_dbg ("        error class: %u", error_class);
 
     if (error_class != ERROR_CLASS_NO_ERROR) {
@@ -710,6 +752,7 @@ static void
 read_bearer_data_message_identifier (MMSmsPart *sms_part,
                                      const struct Parameter *subparameter)
 {
+    BitReader reader;
     guint8 message_type;
     guint16 message_id;
     guint8 header_ind;
@@ -722,7 +765,12 @@ read_bearer_data_message_identifier (MMSmsPart *sms_part,
         return;
     }
 
-    message_type = read_bits (&subparameter->parameter_value[0], 0, 4);
+    /* Length already validated, all fields fit */
+    bit_reader_init (&reader, subparameter->parameter_value, subparameter->parameter_len);
+    message_type = bit_reader_read (&reader, 4);
+    message_id = bit_reader_read (&reader, 16);
+    header_ind = bit_reader_read (&reader, 1);
+
     switch (message_type) {
     case TELESERVICE_MESSAGE_TYPE_UNKNOWN:
         mm_dbg ("            message type: unknown");
@@ -756,76 +804,108 @@ read_bearer_data_message_identifier (MMSmsPart *sms_part,
         break;
     }
 
-    message_id = ((read_bits (&subparameter->parameter_value[0], 4, 8) << 8) |
-                  (read_bits (&subparameter->parameter_value[1], 4, 8)));
-    message_id = GUINT16_FROM_BE (message_id);
     mm_dbg ("            message id: %u", (guint) message_id);
-
-    header_ind = read_bits (&subparameter->parameter_value[2], 4, 1);
     mm_dbg ("            header indicator: %u", header_ind);
 }
 
+/* Latin-1 maps 1:1 to the first 256 code points, so it is converted to UTF-8
+ * while read, without an intermediate buffer */
+static gchar *
+read_latin_text (BitReader *reader,
+                 guint num_fields)
+{
+    gchar *text;
+    gchar *out;
+    guint i;
+
+    if (!bit_reader_has (reader, num_fields * 8))
+        return NULL;
+
+    out = text = g_malloc ((num_fields * 2) + 1);
+    for (i = 0; i < num_fields; i++) {
+        guint8 c;
+
+        c = bit_reader_read (reader, 8);
+        if (c < 0x80)
+            *out++ = c;
+        else {
+            *out++ = 0xC0 | (c >> 6);
+            *out++ = 0x80 | (c & 0x3F);
+        }
+    }
+    *out = '\0';
+    return text;
+}
+
+/* UCS-2 (big endian), converted to UTF-8 while read */
+static gchar *
+read_unicode_text (BitReader *reader,
+                   guint num_fields)
+{
+    gchar *text;
+    gchar *out;
+    guint i;
+
+    if (!bit_reader_has (reader, num_fields * 16))
+        return NULL;
+
+    /* BMP characters take at most 3 bytes in UTF-8 */
+    out = text = g_malloc ((num_fields * 3) + 1);
+    for (i = 0; i < num_fields; i++) {
+        gunichar c;
+
+        c = bit_reader_read (reader, 16);
+        /* Surrogates are not valid UCS-2 */
+        if (c >= 0xD800 && c <= 0xDFFF) {
+            g_free (text);
+            return NULL;
+        }
+        out += g_unichar_to_utf8 (c, out);
+    }
+    *out = '\0';
+    return text;
+}
+
 static void
 read_bearer_data_user_data (MMSmsPart *sms_part,
                             const struct Parameter *subparameter)
 {
+    BitReader reader;
     guint8 message_encoding;
     guint8 message_type = 0;
     guint8 num_fields;
-    guint byte_offset = 0;
-    guint bit_offset = 0;
-
-#define OFFSETS_UPDATE(n_bits) do { \
-        bit_offset += n_bits;       \
-        if (bit_offset >= 8) {      \
-            bit_offset-=8;          \
-            byte_offset++;          \
-        }                           \
-    } while (0)
-
-#define SUBPARAMETER_SIZE_CHECK(required_size)                             \
-    if (subparameter->parameter_len < required_size) {                  \
-        mm_dbg ("        cannot read user data, need at least %u bytes (got %u)", \
-                required_size,                                          \
-                subparameter->parameter_len);                           \
-        return;                                                         \
-    }
 
     g_assert (subparameter->parameter_id == SUBPARAMETER_ID_USER_DATA);
 
-    /* Message encoding */
-    SUBPARAMETER_SIZE_CHECK (1);
-    message_encoding = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 5);
-    OFFSETS_UPDATE (5);
-    mm_dbg ("            message encoding: %s", encoding_to_string (message_encoding));
+    bit_reader_init (&reader, subparameter->parameter_value, subparameter->parameter_len);
 
-    /* Message type, only if extended protocol message */
-    if (message_encoding == ENCODING_EXTENDED_PROTOCOL_MESSAGE) {
-        SUBPARAMETER_SIZE_CHECK (2);
-        message_type = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 8);
-        OFFSETS_UPDATE (8);
-        mm_dbg ("            message type: %u", message_type);
+    /* Message encoding, message type (only if extended protocol message) and
+     * number of fields */
+    message_encoding = bit_reader_read (&reader, 5);
+    if (message_encoding == ENCODING_EXTENDED_PROTOCOL_MESSAGE)
+        message_type = bit_reader_read (&reader, 8);
+    num_fields = bit_reader_read (&reader, 8);
+    if (reader.overflow) {
+        mm_dbg ("        cannot read user data, header too short (%u bytes)",
+                subparameter->parameter_len);
+        return;
     }
 
-    /* Number of fields */
-    SUBPARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + 8) / 8));
-    num_fields = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 8);
-    OFFSETS_UPDATE (8);
+    mm_dbg ("            message encoding: %s", encoding_to_string (message_encoding));
+    if (message_encoding == ENCODING_EXTENDED_PROTOCOL_MESSAGE)
+        mm_dbg ("            message type: %u", message_type);
     mm_dbg ("            num fields: %u", num_fields);
 
     /* Now, process actual text or data */
     switch (message_encoding) {
     case ENCODING_OCTET: {
         GByteArray *data;
-        guint i;
-
-        SUBPARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 8)) / 8));
 
         data = g_byte_array_sized_new (num_fields);
         g_byte_array_set_size (data, num_fields);
-        for (i = 0; i < num_fields; i++) {
-            data->data[i] = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 8);
-            OFFSETS_UPDATE (8);
+        if (!bit_reader_read_bytes (&reader, data->data, num_fields)) {
+            g_byte_array_unref (data);
+            break;
         }
 
         mm_dbg ("            data: (%u bytes)", num_fields);
@@ -837,13 +917,12 @@ read_bearer_data_user_data (MMSmsPart *sms_part,
         gchar *text;
         guint i;
 
-        SUBPARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 7)) / 8));
+        if (!bit_reader_has (&reader, num_fields * 7))
+            break;
 
         text = g_malloc (num_fields + 1);
-        for (i = 0; i < num_fields; i++) {
-            text[i] = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 7);
-            OFFSETS_UPDATE (7);
-        }
+        for (i = 0; i < num_fields; i++)
+            text[i] = bit_reader_read (&reader, 7);
         text[i] = '\0';
 
         mm_dbg ("            text: '%s'", text);
@@ -852,57 +931,29 @@ read_bearer_data_user_data (MMSmsPart *sms_part,
     }
 
     case ENCODING_LATIN: {
-        gchar *latin;
         gchar *text;
-        guint i;
-
-        SUBPARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_fields * 8)) / 8));
-
-        latin = g_malloc (num_fields + 1);
-        for (i = 0; i < num_fields; i++) {
-            latin[i] = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 8);
-            OFFSETS_UPDATE (8);
-        }
-        latin[i] = '\0';
 
-        text = g_convert (latin, -1, "UTF-8", "ISO−8859−1", NULL, NULL, NULL);
-        if (!text) {
-            mm_dbg ("            text/data: ignored (latin to UTF-8 conversion error)");
-        } else {
-            mm_dbg ("            text: '%s'", text);
-            mm_sms_part_take_text (sms_part, text);
-        }
+        text = read_latin_text (&reader, num_fields);
+        if (!text)
+            break;
 
-        g_free (latin);
+        mm_dbg ("            text: '%s'", text);
+        mm_sms_part_take_text (sms_part, text);
         break;
     }
 
     case ENCODING_UNICODE: {
-        gchar *utf16;
         gchar *text;
-        guint i;
-        guint num_bytes;
-
-        /* 2 bytes per field! */
-        num_bytes = num_fields * 2;
 
-        SUBPARAMETER_SIZE_CHECK (byte_offset + 1 + ((bit_offset + (num_bytes * 8)) / 8));
-
-        utf16 = g_malloc (num_bytes);
-        for (i = 0; i < num_bytes; i++) {
-            utf16[i] = read_bits (&subparameter->parameter_value[byte_offset], bit_offset, 8);
-            OFFSETS_UPDATE (8);
-        }
-
-        text = g_convert (utf16, num_bytes, "UTF-8", "UCS-2BE", NULL, NULL, NULL);
+        text = read_unicode_text (&reader, num_fields);
         if (!text) {
-            mm_dbg ("            text/data: ignored (UTF-16 to UTF-8 conversion error)");
-        } else {
-            mm_dbg ("            text: '%s'", text);
-            mm_sms_part_take_text (sms_part, text);
+            if (!reader.overflow)
+                mm_dbg ("            text/data: ignored (UTF-16 to UTF-8 conversion error)");
+            break;
         }
 
-        g_free (utf16);
+        mm_dbg ("            text: '%s'", text);
+        mm_sms_part_take_text (sms_part, text);
         break;
     }
 
@@ -910,8 +961,10 @@ read_bearer_data_user_data (MMSmsPart *sms_part,
         mm_dbg ("            text/data: ignored (unsupported encoding)");
     }
 
-#undef OFFSETS_UPDATE
-#undef SUBPARAMETER_SIZE_CHECK
+    if (reader.overflow)
+        mm_dbg ("        cannot read user data, %u fields don't fit in %u bytes",
+                num_fields,
+                subparameter->parameter_len);
 }
 
 static void
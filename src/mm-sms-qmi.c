@@ -774,6 +774,215 @@ sms_delete (MMBaseSms *self,
 
 /*****************************************************************************/
 
+typedef struct {
+    QmiClientWms *client;
+    QmiWmsStorageType storage;
+    GPtrArray *parts;
+    guint i;
+    guint n_failed;
+} SmsDeleteMultiplePartsContext;
+
+static void
+sms_delete_multiple_parts_context_free (SmsDeleteMultiplePartsContext *ctx)
+{
+    g_ptr_array_unref (ctx->parts);
+    g_object_unref (ctx->client);
+    g_slice_free (SmsDeleteMultiplePartsContext, ctx);
+}
+
+static gboolean
+sms_delete_parts_finish (MMBaseSms *self,
+                         GAsyncResult *res,
+                         GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static QmiWmsMessageMode
+part_get_message_mode (MMSmsPart *part)
+{
+    return (MM_SMS_PART_IS_3GPP (part) ?
+            QMI_WMS_MESSAGE_MODE_GSM_WCDMA :
+            QMI_WMS_MESSAGE_MODE_CDMA);
+}
+
+static gboolean
+wms_delete_finish (QmiClientWms *client,
+                   GAsyncResult *res,
+                   GError **error)
+{
+    QmiMessageWmsDeleteOutput *output;
+    gboolean deleted;
+
+    output = qmi_client_wms_delete_finish (client, res, error);
+    if (!output) {
+        g_prefix_error (error, "QMI operation failed: ");
+        return FALSE;
+    }
+
+    deleted = qmi_message_wms_delete_output_get_result (output, error);
+    qmi_message_wms_delete_output_unref (output);
+    return deleted;
+}
+
+static void
+wms_delete (SmsDeleteMultiplePartsContext *ctx,
+            MMSmsPart *part,
+            gboolean whole_storage,
+            GAsyncReadyCallback callback,
+            GTask *task)
+{
+    QmiMessageWmsDeleteInput *input;
+
+    input = qmi_message_wms_delete_input_new ();
+    qmi_message_wms_delete_input_set_memory_storage (input, ctx->storage, NULL);
+    /* Without index, all messages of the given mode in the storage are removed */
+    if (!whole_storage)
+        qmi_message_wms_delete_input_set_memory_index (input, (guint32)mm_sms_part_get_index (part), NULL);
+    qmi_message_wms_delete_input_set_message_mode (input, part_get_message_mode (part), NULL);
+    qmi_client_wms_delete (ctx->client,
+                           input,
+                           whole_storage ? 20 : 5,
+                           NULL,
+                           callback,
+                           task);
+    qmi_message_wms_delete_input_unref (input);
+}
+
+static void delete_multiple_next_part (GTask *task);
+
+static void
+delete_multiple_part_ready (QmiClientWms *client,
+                            GAsyncResult *res,
+                            GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    ctx = g_task_get_task_data (task);
+    part = g_ptr_array_index (ctx->parts, ctx->i);
+
+    /* Parts that couldn't be deleted keep their index */
+    if (!wms_delete_finish (client, res, &error)) {
+        ctx->n_failed++;
+        mm_dbg ("Couldn't delete SMS part with index %u: '%s'",
+                mm_sms_part_get_index (part),
+                error->message);
+        g_error_free (error);
+    } else
+        mm_sms_part_set_index (part, SMS_PART_INVALID_INDEX);
+
+    ctx->i++;
+    delete_multiple_next_part (task);
+}
+
+static void
+delete_multiple_next_part (GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Skip non-stored parts */
+    while (ctx->i < ctx->parts->len &&
+           mm_sms_part_get_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, ctx->i)) == SMS_PART_INVALID_INDEX)
+        ctx->i++;
+
+    if (ctx->i == ctx->parts->len) {
+        if (ctx->n_failed > 0)
+            g_task_return_new_error (task,
+                                     MM_CORE_ERROR,
+                                     MM_CORE_ERROR_FAILED,
+                                     "Couldn't delete %u SMS parts",
+                                     ctx->n_failed);
+        else
+            g_task_return_boolean (task, TRUE);
+
+        g_object_unref (task);
+        return;
+    }
+
+    wms_delete (ctx,
+                g_ptr_array_index (ctx->parts, ctx->i),
+                FALSE,
+                (GAsyncReadyCallback)delete_multiple_part_ready,
+                task);
+}
+
+static void
+delete_all_ready (QmiClientWms *client,
+                  GAsyncResult *res,
+                  GTask *task)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    GError *error = NULL;
+    guint i;
+
+    ctx = g_task_get_task_data (task);
+
+    if (!wms_delete_finish (client, res, &error)) {
+        mm_dbg ("Couldn't delete all SMS parts at once: '%s'", error->message);
+        g_error_free (error);
+        delete_multiple_next_part (task);
+        return;
+    }
+
+    for (i = 0; i < ctx->parts->len; i++)
+        mm_sms_part_set_index ((MMSmsPart *)g_ptr_array_index (ctx->parts, i), SMS_PART_INVALID_INDEX);
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+sms_delete_parts (MMBaseSms *self,
+                  MMSmsStorage storage,
+                  GPtrArray *parts,
+                  gboolean whole_storage,
+                  GAsyncReadyCallback callback,
+                  gpointer user_data)
+{
+    SmsDeleteMultiplePartsContext *ctx;
+    QmiClient *client = NULL;
+    GTask *task;
+    guint i;
+
+    /* Ensure WMS client */
+    if (!ensure_qmi_client (MM_SMS_QMI (self),
+                            QMI_SERVICE_WMS, &client,
+                            callback, user_data))
+        return;
+
+    ctx = g_slice_new0 (SmsDeleteMultiplePartsContext);
+    ctx->client = g_object_ref (client);
+    ctx->storage = mm_sms_storage_to_qmi_storage_type (storage);
+    ctx->parts = g_ptr_array_ref (parts);
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, ctx, (GDestroyNotify)sms_delete_multiple_parts_context_free);
+
+    /* A whole storage request removes messages of a single mode */
+    for (i = 1; whole_storage && i < parts->len; i++) {
+        if (part_get_message_mode (g_ptr_array_index (parts, i)) !=
+            part_get_message_mode (g_ptr_array_index (parts, 0)))
+            whole_storage = FALSE;
+    }
+
+    if (whole_storage && parts->len > 0) {
+        wms_delete (ctx,
+                    g_ptr_array_index (parts, 0),
+                    TRUE,
+                    (GAsyncReadyCallback)delete_all_ready,
+                    task);
+        return;
+    }
+
+    delete_multiple_next_part (task);
+}
+
+/*****************************************************************************/
+
 MMBaseSms *
 mm_sms_qmi_new (MMBaseModem *modem)
 {
@@ -798,4 +1007,6 @@ mm_sms_qmi_class_init (MMSmsQmiClass *klass)
     base_sms_class->send_finish = sms_send_finish;
     base_sms_class->delete = sms_delete;
     base_sms_class->delete_finish = sms_delete_finish;
+    base_sms_class->delete_parts = sms_delete_parts;
+    base_sms_class->delete_parts_finish = sms_delete_parts_finish;
 }
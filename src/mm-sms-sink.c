@@ -0,0 +1,394 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <config.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include <glib-unix.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-sms-sink.h"
+#include "mm-context.h"
+#include "mm-log.h"
+
+/* How long to wait for the reader to take more data before giving up on the
+ * queued records */
+#define WRITE_TIMEOUT_SECS 2
+
+/* Records waiting to be written; when full, new messages are processed as
+ * usual instead */
+#define MAX_QUEUED_RECORDS 32
+
+struct _MMSmsSink {
+    gchar    *path;
+    gint      fd;
+    gboolean  is_socket;
+    /* Deliveries waiting to be written, the first one may be partially
+     * written already */
+    GQueue   *queue;
+    gsize     offset;
+    guint     watch_id;
+    guint     timeout_id;
+};
+
+typedef struct {
+    guint8 *buffer;
+    gsize   len;
+} Record;
+
+static void
+record_free (Record *record)
+{
+    g_free (record->buffer);
+    g_free (record);
+}
+
+/*****************************************************************************/
+
+static gboolean
+sink_open (MMSmsSink  *self,
+           GError    **error)
+{
+    struct stat st;
+    gint        fd;
+
+    if (stat (self->path, &st) < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Cannot access SMS sink '%s': %s", self->path, g_strerror (errno));
+        return FALSE;
+    }
+
+    if (S_ISFIFO (st.st_mode)) {
+        /* Fails with ENXIO if there is no reader. SIGPIPE is ignored by
+         * the daemon when a sink is configured. */
+        fd = open (self->path, O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Cannot open SMS sink FIFO '%s': %s", self->path, g_strerror (errno));
+            return FALSE;
+        }
+    } else if (S_ISSOCK (st.st_mode)) {
+        struct sockaddr_un addr;
+
+        if (strlen (self->path) >= sizeof (addr.sun_path)) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "SMS sink socket path too long: '%s'", self->path);
+            return FALSE;
+        }
+
+        fd = socket (AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Cannot create SMS sink socket: %s", g_strerror (errno));
+            return FALSE;
+        }
+
+        memset (&addr, 0, sizeof (addr));
+        addr.sun_family = AF_UNIX;
+        strcpy (addr.sun_path, self->path);
+        /* Local sockets either connect right away or fail */
+        if (connect (fd, (struct sockaddr *)&addr, sizeof (addr)) < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                         "Cannot connect to SMS sink socket '%s': %s", self->path, g_strerror (errno));
+            close (fd);
+            return FALSE;
+        }
+    } else {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                     "SMS sink '%s' is neither a FIFO nor a unix socket", self->path);
+        return FALSE;
+    }
+
+    mm_dbg ("SMS sink '%s' opened", self->path);
+    self->fd = fd;
+    self->is_socket = S_ISSOCK (st.st_mode);
+    return TRUE;
+}
+
+static void
+sink_close (MMSmsSink *self)
+{
+    if (self->fd < 0)
+        return;
+    mm_dbg ("SMS sink '%s' closed", self->path);
+    close (self->fd);
+    self->fd = -1;
+}
+
+static gssize
+sink_write (MMSmsSink    *self,
+            const guint8 *buffer,
+            gsize         len)
+{
+    /* Avoid SIGPIPE when the reader went away */
+    if (self->is_socket)
+        return send (self->fd, buffer, len, MSG_NOSIGNAL);
+    return write (self->fd, buffer, len);
+}
+
+/*****************************************************************************/
+
+GVariant *
+mm_sms_sink_build_record (MMBaseSms   *sms,
+                          const gchar *modem_path)
+{
+    GVariantBuilder  builder;
+    MmGdbusSms      *gdbus_sms;
+    GVariant        *data;
+    const gchar     *str;
+
+    gdbus_sms = MM_GDBUS_SMS (sms);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    if (modem_path)
+        g_variant_builder_add (&builder, "{sv}", "modem", g_variant_new_object_path (modem_path));
+    if ((str = mm_gdbus_sms_get_number (gdbus_sms)) != NULL)
+        g_variant_builder_add (&builder, "{sv}", "number", g_variant_new_string (str));
+    if ((str = mm_gdbus_sms_get_text (gdbus_sms)) != NULL)
+        g_variant_builder_add (&builder, "{sv}", "text", g_variant_new_string (str));
+    if ((data = mm_gdbus_sms_get_data (gdbus_sms)) != NULL && g_variant_n_children (data) > 0)
+        g_variant_builder_add (&builder, "{sv}", "data", data);
+    if ((str = mm_gdbus_sms_get_smsc (gdbus_sms)) != NULL)
+        g_variant_builder_add (&builder, "{sv}", "smsc", g_variant_new_string (str));
+    if ((str = mm_gdbus_sms_get_timestamp (gdbus_sms)) != NULL)
+        g_variant_builder_add (&builder, "{sv}", "timestamp", g_variant_new_string (str));
+    g_variant_builder_add (&builder, "{sv}", "storage",
+                           g_variant_new_uint32 (mm_gdbus_sms_get_storage (gdbus_sms)));
+    g_variant_builder_add (&builder, "{sv}", "pdu-type",
+                           g_variant_new_uint32 (mm_gdbus_sms_get_pdu_type (gdbus_sms)));
+    g_variant_builder_add (&builder, "{sv}", "class",
+                           g_variant_new_int32 (mm_gdbus_sms_get_class (gdbus_sms)));
+    if (mm_gdbus_sms_get_teleservice_id (gdbus_sms) != MM_SMS_CDMA_TELESERVICE_ID_UNKNOWN)
+        g_variant_builder_add (&builder, "{sv}", "teleservice-id",
+                               g_variant_new_uint32 (mm_gdbus_sms_get_teleservice_id (gdbus_sms)));
+
+    return g_variant_builder_end (&builder);
+}
+
+/*****************************************************************************/
+
+static void sink_flush (MMSmsSink *self);
+
+static void
+sink_fail_queued (MMSmsSink *self,
+                  gint code,
+                  const gchar *reason)
+{
+    GTask *task;
+
+    if (self->watch_id) {
+        g_source_remove (self->watch_id);
+        self->watch_id = 0;
+    }
+    if (self->timeout_id) {
+        g_source_remove (self->timeout_id);
+        self->timeout_id = 0;
+    }
+
+    /* A partially written record can't be recovered; readers will see the
+     * connection closed */
+    if (self->offset > 0) {
+        sink_close (self);
+        self->offset = 0;
+    }
+
+    while ((task = g_queue_pop_head (self->queue)) != NULL) {
+        g_task_return_new_error (task, MM_CORE_ERROR, code,
+                                 "Couldn't write to SMS sink '%s': %s",
+                                 self->path, reason);
+        g_object_unref (task);
+    }
+}
+
+static gboolean
+sink_write_timeout (MMSmsSink *self)
+{
+    self->timeout_id = 0;
+    /* If nothing was written, the connection is still usable */
+    sink_fail_queued (self,
+                      self->offset > 0 ? MM_CORE_ERROR_FAILED : MM_CORE_ERROR_RETRY,
+                      "reader not taking data");
+    return G_SOURCE_REMOVE;
+}
+
+static void
+sink_restart_timeout (MMSmsSink *self)
+{
+    if (self->timeout_id)
+        g_source_remove (self->timeout_id);
+    self->timeout_id = g_timeout_add_seconds (WRITE_TIMEOUT_SECS,
+                                              (GSourceFunc)sink_write_timeout,
+                                              self);
+}
+
+static gboolean
+sink_writable_cb (gint fd,
+                  GIOCondition condition,
+                  MMSmsSink *self)
+{
+    self->watch_id = 0;
+    sink_flush (self);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+sink_flush (MMSmsSink *self)
+{
+    GTask *task;
+
+    while ((task = g_queue_peek_head (self->queue)) != NULL) {
+        Record *record;
+        gssize  written;
+
+        record = g_task_get_task_data (task);
+        written = sink_write (self, &record->buffer[self->offset], record->len - self->offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            /* Wait until the reader takes more data */
+            if (!self->watch_id)
+                self->watch_id = g_unix_fd_add (self->fd,
+                                                G_IO_OUT,
+                                                (GUnixFDSourceFunc)sink_writable_cb,
+                                                self);
+            if (!self->timeout_id)
+                sink_restart_timeout (self);
+            return;
+        }
+
+        if (written <= 0) {
+            sink_fail_queued (self, MM_CORE_ERROR_FAILED,
+                              g_strerror (written < 0 ? errno : EPIPE));
+            sink_close (self);
+            return;
+        }
+
+        /* The reader is taking data */
+        if (self->timeout_id)
+            sink_restart_timeout (self);
+
+        self->offset += written;
+        if (self->offset < record->len)
+            continue;
+
+        self->offset = 0;
+        g_queue_pop_head (self->queue);
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+    }
+
+    if (self->timeout_id) {
+        g_source_remove (self->timeout_id);
+        self->timeout_id = 0;
+    }
+}
+
+gboolean
+mm_sms_sink_deliver_finish (MMSmsSink     *self,
+                            GAsyncResult  *res,
+                            GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+void
+mm_sms_sink_deliver (MMSmsSink           *self,
+                     MMBaseSms           *sms,
+                     const gchar         *modem_path,
+                     GAsyncReadyCallback  callback,
+                     gpointer             user_data)
+{
+    GTask    *task;
+    GVariant *variant;
+    Record   *record;
+    gsize     size;
+    guint32   size_be;
+    GError   *error = NULL;
+
+    task = g_task_new (sms, NULL, callback, user_data);
+
+    if (self->fd < 0 && !sink_open (self, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    if (g_queue_get_length (self->queue) >= MAX_QUEUED_RECORDS) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_RETRY,
+                                 "SMS sink '%s' is full", self->path);
+        g_object_unref (task);
+        return;
+    }
+
+    variant = g_variant_ref_sink (mm_sms_sink_build_record (sms, modem_path));
+    size = g_variant_get_size (variant);
+    if (size > G_MAXUINT32) {
+        g_variant_unref (variant);
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_TOO_MANY,
+                                 "SMS record too big: %" G_GSIZE_FORMAT " bytes", size);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Length and record in a single buffer */
+    record = g_new0 (Record, 1);
+    record->len = sizeof (size_be) + size;
+    record->buffer = g_malloc (record->len);
+    size_be = GUINT32_TO_BE ((guint32) size);
+    memcpy (record->buffer, &size_be, sizeof (size_be));
+    g_variant_store (variant, &record->buffer[sizeof (size_be)]);
+    g_variant_unref (variant);
+    g_task_set_task_data (task, record, (GDestroyNotify)record_free);
+
+    g_queue_push_tail (self->queue, task);
+    /* If already waiting for the reader, the record goes after the others */
+    if (!self->watch_id)
+        sink_flush (self);
+}
+
+/*****************************************************************************/
+
+MMSmsSink *
+mm_sms_sink_get_default (void)
+{
+    static MMSmsSink *sink;
+    static gboolean   initialized;
+
+    if (G_UNLIKELY (!initialized)) {
+        const gchar *path;
+
+        initialized = TRUE;
+        path = mm_context_get_sms_sink ();
+        if (path) {
+            sink = g_new0 (MMSmsSink, 1);
+            sink->path = g_strdup (path);
+            sink->fd = -1;
+            sink->queue = g_queue_new ();
+            mm_info ("Received SMS messages will be delivered to '%s'", path);
+        }
+    }
+
+    return sink;
+}
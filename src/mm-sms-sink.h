@@ -0,0 +1,69 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef MM_SMS_SINK_H
+#define MM_SMS_SINK_H
+
+#include <glib.h>
+#include <gio/gio.h>
+
+#include "mm-base-sms.h"
+
+/* Direct delivery of received SMS messages to a local FIFO or unix stream
+ * socket, configured with --sms-sink. Messages delivered this way are never
+ * exported in D-Bus; they are removed from the modem storage right away.
+ *
+ * Delivery is at-most-once: a message is considered delivered as soon as its
+ * whole record is written to the FIFO or socket, there is no acknowledgement
+ * from the reader. Records written but not read before the reader goes away
+ * are lost. Records not fully written are never considered delivered, and
+ * their messages are exposed in D-Bus instead.
+ *
+ * Each record is a 32-bit big endian length followed by a GVariant of type
+ * a{sv} in serialized (normal) form, with the following keys:
+ *
+ *   "modem"     (o)  Path of the modem which received the message.
+ *   "number"    (s)  Sender number.
+ *   "text"      (s)  Message text, if any.
+ *   "data"      (ay) Message data, if any.
+ *   "smsc"      (s)  SMSC address, if known.
+ *   "timestamp" (s)  SMSC timestamp, as in the D-Bus SMS Timestamp property.
+ *   "storage"   (u)  MMSmsStorage where the message was stored.
+ *   "pdu-type"  (u)  MMSmsPduType.
+ *   "class"     (i)  3GPP message class, or -1 if unknown.
+ *   "teleservice-id" (u) MMSmsCdmaTeleserviceId, CDMA messages only.
+ */
+typedef struct _MMSmsSink MMSmsSink;
+
+/* Returns the sink configured for the daemon, or NULL */
+MMSmsSink *mm_sms_sink_get_default (void);
+
+GVariant *mm_sms_sink_build_record (MMBaseSms   *sms,
+                                    const gchar *modem_path);
+
+/* Queues the record of the given message, which is written as soon as the
+ * reader takes it. If the sink cannot take it (e.g. no reader, or not
+ * accepting more data), the operation fails and the message should be
+ * processed as usual. */
+void     mm_sms_sink_deliver        (MMSmsSink            *self,
+                                     MMBaseSms            *sms,
+                                     const gchar          *modem_path,
+                                     GAsyncReadyCallback   callback,
+                                     gpointer              user_data);
+gboolean mm_sms_sink_deliver_finish (MMSmsSink            *self,
+                                     GAsyncResult         *res,
+                                     GError              **error);
+
+#endif /* MM_SMS_SINK_H */
@@ -0,0 +1,399 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <config.h>
+#include <string.h>
+
+#include <ModemManager.h>
+
+#include "mm-snapshot.h"
+
+/* Format of the snapshot dictionary */
+#define SNAPSHOT_VERSION 1
+
+/* Removals kept to build deltas; clients asking for changes since an older
+ * generation get a full snapshot */
+#define MAX_TOMBSTONES 256
+
+static const gchar *default_interfaces[] = {
+    MM_DBUS_INTERFACE_MODEM,
+    MM_DBUS_INTERFACE_MODEM_MODEM3GPP,
+    MM_DBUS_INTERFACE_MODEM_SIGNAL,
+    MM_DBUS_INTERFACE_MODEM_LOCATION,
+    MM_DBUS_INTERFACE_BEARER,
+    NULL
+};
+
+typedef struct {
+    GVariant *value;
+    guint64   generation;
+} PropertyState;
+
+typedef struct {
+    /* Interface name -> (property name -> PropertyState) */
+    GHashTable *interfaces;
+    /* Last build in which the object was added */
+    guint       build;
+} ObjectState;
+
+typedef struct {
+    gchar   *path;
+    /* NULL if the whole object was removed */
+    gchar   *interface;
+    guint64  generation;
+} Tombstone;
+
+struct _MMSnapshot {
+    /* Random identifier of this daemon instance, so that generations given
+     * by clients of a previous instance are not mistaken for ours */
+    gchar      *instance;
+    /* Object path -> ObjectState */
+    GHashTable *objects;
+    /* Removals, oldest first */
+    GQueue     *tombstones;
+    /* Generation of the last snapshot with changes */
+    guint64     generation;
+    /* Deltas can only be built since this generation */
+    guint64     min_generation;
+
+    /* Ongoing build */
+    guint       build;
+    gchar     **interfaces;
+    gboolean    changed;
+};
+
+/*****************************************************************************/
+
+static void
+property_state_free (PropertyState *state)
+{
+    g_variant_unref (state->value);
+    g_slice_free (PropertyState, state);
+}
+
+static void
+object_state_free (ObjectState *state)
+{
+    g_hash_table_unref (state->interfaces);
+    g_slice_free (ObjectState, state);
+}
+
+static void
+tombstone_free (Tombstone *tombstone)
+{
+    g_free (tombstone->path);
+    g_free (tombstone->interface);
+    g_slice_free (Tombstone, tombstone);
+}
+
+static void
+add_tombstone (MMSnapshot  *self,
+               const gchar *path,
+               const gchar *interface)
+{
+    Tombstone *tombstone;
+
+    tombstone = g_slice_new (Tombstone);
+    tombstone->path = g_strdup (path);
+    tombstone->interface = g_strdup (interface);
+    tombstone->generation = self->generation + 1;
+    g_queue_push_tail (self->tombstones, tombstone);
+    self->changed = TRUE;
+
+    if (g_queue_get_length (self->tombstones) > MAX_TOMBSTONES) {
+        tombstone = g_queue_pop_head (self->tombstones);
+        self->min_generation = tombstone->generation;
+        tombstone_free (tombstone);
+    }
+}
+
+static gboolean
+interface_requested (MMSnapshot  *self,
+                     const gchar *interface)
+{
+    guint i;
+
+    for (i = 0; self->interfaces[i]; i++) {
+        if (g_str_equal (self->interfaces[i], interface))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/*****************************************************************************/
+
+void
+mm_snapshot_begin (MMSnapshot          *self,
+                   const gchar * const *interfaces)
+{
+    g_assert (!self->interfaces);
+
+    self->build++;
+    self->changed = FALSE;
+    self->interfaces = g_strdupv ((gchar **) (interfaces ? interfaces : default_interfaces));
+}
+
+static GDBusInterfaceSkeleton *
+find_skeleton (GList       *skeletons,
+               const gchar *interface)
+{
+    GList *l;
+
+    for (l = skeletons; l; l = g_list_next (l)) {
+        if (g_str_equal (g_dbus_interface_skeleton_get_info (l->data)->name, interface))
+            return l->data;
+    }
+    return NULL;
+}
+
+static void
+update_interface (MMSnapshot             *self,
+                  GHashTable             *properties,
+                  GDBusInterfaceSkeleton *skeleton)
+{
+    GVariant     *dictionary;
+    GVariantIter  iter;
+    gchar        *name;
+    GVariant     *value;
+
+    dictionary = g_variant_ref_sink (g_dbus_interface_skeleton_get_properties (skeleton));
+    g_variant_iter_init (&iter, dictionary);
+    while (g_variant_iter_next (&iter, "{sv}", &name, &value)) {
+        PropertyState *state;
+
+        state = g_hash_table_lookup (properties, name);
+        if (state && g_variant_equal (state->value, value)) {
+            g_variant_unref (value);
+            g_free (name);
+            continue;
+        }
+
+        if (!state) {
+            state = g_slice_new (PropertyState);
+            g_hash_table_insert (properties, name, state);
+        } else {
+            g_variant_unref (state->value);
+            g_free (name);
+        }
+        state->value = value;
+        state->generation = self->generation + 1;
+        self->changed = TRUE;
+    }
+    g_variant_unref (dictionary);
+}
+
+void
+mm_snapshot_add_object (MMSnapshot  *self,
+                        const gchar *path,
+                        GList       *skeletons)
+{
+    ObjectState    *object;
+    GHashTableIter  iter;
+    const gchar    *interface;
+    GHashTable     *properties;
+    guint           i;
+
+    g_assert (self->interfaces);
+
+    object = g_hash_table_lookup (self->objects, path);
+    if (!object) {
+        object = g_slice_new0 (ObjectState);
+        object->interfaces = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+        g_hash_table_insert (self->objects, g_strdup (path), object);
+    }
+    object->build = self->build;
+
+    /* Interfaces no longer in the object */
+    g_hash_table_iter_init (&iter, object->interfaces);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &interface, NULL)) {
+        if (!find_skeleton (skeletons, interface)) {
+            add_tombstone (self, path, interface);
+            g_hash_table_iter_remove (&iter);
+        }
+    }
+
+    /* Only the requested interfaces are compared; the others keep their
+     * state until they're requested again */
+    for (i = 0; self->interfaces[i]; i++) {
+        GDBusInterfaceSkeleton *skeleton;
+
+        skeleton = find_skeleton (skeletons, self->interfaces[i]);
+        if (!skeleton)
+            continue;
+
+        properties = g_hash_table_lookup (object->interfaces, self->interfaces[i]);
+        if (!properties) {
+            properties = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) property_state_free);
+            g_hash_table_insert (object->interfaces, g_strdup (self->interfaces[i]), properties);
+        }
+        update_interface (self, properties, skeleton);
+    }
+}
+
+static GVariant *
+build_objects (MMSnapshot *self,
+               guint64     since_generation)
+{
+    GVariantBuilder  objects_builder;
+    GHashTableIter   objects_iter;
+    const gchar     *path;
+    ObjectState     *object;
+
+    g_variant_builder_init (&objects_builder, G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
+
+    g_hash_table_iter_init (&objects_iter, self->objects);
+    while (g_hash_table_iter_next (&objects_iter, (gpointer *) &path, (gpointer *) &object)) {
+        GVariantBuilder  interfaces_builder;
+        GHashTableIter   interfaces_iter;
+        const gchar     *interface;
+        GHashTable      *properties;
+        gboolean         object_changed = FALSE;
+
+        g_variant_builder_init (&interfaces_builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+
+        g_hash_table_iter_init (&interfaces_iter, object->interfaces);
+        while (g_hash_table_iter_next (&interfaces_iter, (gpointer *) &interface, (gpointer *) &properties)) {
+            GVariantBuilder  properties_builder;
+            GHashTableIter   properties_iter;
+            const gchar     *name;
+            PropertyState   *state;
+            gboolean         interface_changed = FALSE;
+
+            if (!interface_requested (self, interface))
+                continue;
+
+            g_variant_builder_init (&properties_builder, G_VARIANT_TYPE ("a{sv}"));
+
+            g_hash_table_iter_init (&properties_iter, properties);
+            while (g_hash_table_iter_next (&properties_iter, (gpointer *) &name, (gpointer *) &state)) {
+                if (state->generation <= since_generation)
+                    continue;
+                g_variant_builder_add (&properties_builder, "{sv}", name, state->value);
+                interface_changed = TRUE;
+            }
+
+            /* Interfaces without changes are not reported */
+            if (!interface_changed) {
+                g_variant_builder_clear (&properties_builder);
+                continue;
+            }
+
+            g_variant_builder_add (&interfaces_builder, "{sa{sv}}", interface, &properties_builder);
+            object_changed = TRUE;
+        }
+
+        if (!object_changed) {
+            g_variant_builder_clear (&interfaces_builder);
+            continue;
+        }
+
+        g_variant_builder_add (&objects_builder, "{oa{sa{sv}}}", path, &interfaces_builder);
+    }
+
+    return g_variant_builder_end (&objects_builder);
+}
+
+GVariant *
+mm_snapshot_end (MMSnapshot  *self,
+                 const gchar *since_instance,
+                 guint64      since_generation)
+{
+    GVariantBuilder  builder;
+    GHashTableIter   iter;
+    const gchar     *path;
+    ObjectState     *object;
+    gboolean         full;
+
+    g_assert (self->interfaces);
+
+    /* Objects not added in this build are gone */
+    g_hash_table_iter_init (&iter, self->objects);
+    while (g_hash_table_iter_next (&iter, (gpointer *) &path, (gpointer *) &object)) {
+        if (object->build != self->build) {
+            add_tombstone (self, path, NULL);
+            g_hash_table_iter_remove (&iter);
+        }
+    }
+
+    if (self->changed)
+        self->generation++;
+
+    /* Full snapshot if requested, if the generation was given by a previous
+     * instance of the daemon, or if the delta can't be built any more */
+    full = (!since_generation ||
+            !since_instance ||
+            !g_str_equal (since_instance, self->instance) ||
+            since_generation < self->min_generation ||
+            since_generation > self->generation);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "version",    g_variant_new_uint32 (SNAPSHOT_VERSION));
+    g_variant_builder_add (&builder, "{sv}", "instance",   g_variant_new_string (self->instance));
+    g_variant_builder_add (&builder, "{sv}", "generation", g_variant_new_uint64 (self->generation));
+    g_variant_builder_add (&builder, "{sv}", "full",       g_variant_new_boolean (full));
+    g_variant_builder_add (&builder, "{sv}", "objects",    build_objects (self, full ? 0 : since_generation));
+
+    if (!full) {
+        GVariantBuilder  removed_objects;
+        GVariantBuilder  removed_interfaces;
+        GList           *l;
+
+        g_variant_builder_init (&removed_objects, G_VARIANT_TYPE ("ao"));
+        g_variant_builder_init (&removed_interfaces, G_VARIANT_TYPE ("a(os)"));
+        for (l = self->tombstones->head; l; l = g_list_next (l)) {
+            Tombstone *tombstone = l->data;
+
+            if (tombstone->generation <= since_generation)
+                continue;
+            if (!tombstone->interface)
+                g_variant_builder_add (&removed_objects, "o", tombstone->path);
+            else if (interface_requested (self, tombstone->interface))
+                g_variant_builder_add (&removed_interfaces, "(os)", tombstone->path, tombstone->interface);
+        }
+        g_variant_builder_add (&builder, "{sv}", "removed-objects",    g_variant_builder_end (&removed_objects));
+        g_variant_builder_add (&builder, "{sv}", "removed-interfaces", g_variant_builder_end (&removed_interfaces));
+    }
+
+    g_strfreev (self->interfaces);
+    self->interfaces = NULL;
+
+    return g_variant_builder_end (&builder);
+}
+
+/*****************************************************************************/
+
+MMSnapshot *
+mm_snapshot_new (void)
+{
+    MMSnapshot *self;
+
+    self = g_slice_new0 (MMSnapshot);
+    self->instance = g_strdup_printf ("%08x%08x%08x%08x",
+                                      g_random_int (), g_random_int (),
+                                      g_random_int (), g_random_int ());
+    self->objects = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) object_state_free);
+    self->tombstones = g_queue_new ();
+    return self;
+}
+
+void
+mm_snapshot_free (MMSnapshot *self)
+{
+    g_hash_table_unref (self->objects);
+    g_queue_free_full (self->tombstones, (GDestroyNotify) tombstone_free);
+    g_strfreev (self->interfaces);
+    g_free (self->instance);
+    g_slice_free (MMSnapshot, self);
+}
@@ -0,0 +1,48 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef MM_SNAPSHOT_H
+#define MM_SNAPSHOT_H
+
+#include <glib.h>
+#include <gio/gio.h>
+
+/* Snapshots of the properties of the exported objects, as returned by the
+ * Manager GetSnapshot() method. Changes are detected by comparing the
+ * property values with the ones seen in the previous snapshot; each
+ * property keeps the generation in which it last changed, so that clients
+ * can ask only for the properties changed since the instance and generation
+ * reported in their previous snapshot. */
+typedef struct _MMSnapshot MMSnapshot;
+
+MMSnapshot *mm_snapshot_new  (void);
+void        mm_snapshot_free (MMSnapshot *self);
+
+/* A snapshot is built by adding all the exported objects to consider, given
+ * as their path and list of GDBusInterfaceSkeletons, between begin() and
+ * end(). Objects previously seen but not added are reported as removed.
+ * Only the given interfaces are reported; if @interfaces is NULL, a default
+ * set is used. A delta is only built if @since_instance matches the one of
+ * this snapshot, otherwise a full snapshot is returned. */
+void      mm_snapshot_begin      (MMSnapshot          *self,
+                                  const gchar * const *interfaces);
+void      mm_snapshot_add_object (MMSnapshot          *self,
+                                  const gchar         *path,
+                                  GList               *skeletons);
+GVariant *mm_snapshot_end        (MMSnapshot          *self,
+                                  const gchar         *since_instance,
+                                  guint64              since_generation);
+
+#endif /* MM_SNAPSHOT_H */
@@ -0,0 +1,312 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-base-modem.h"
+#include "mm-base-modem-at.h"
+#include "mm-broadband-modem.h"
+#include "mm-iface-modem.h"
+#include "mm-iface-modem-messaging.h"
+#include "mm-base-sms.h"
+
+#include "fake-modem.h"
+
+GPtrArray *at_commands;
+GPtrArray *failing_commands;
+
+void
+fake_modem_init (void)
+{
+    at_commands = g_ptr_array_new_with_free_func (g_free);
+    failing_commands = g_ptr_array_new_with_free_func (g_free);
+}
+
+void
+fake_modem_reset (void)
+{
+    g_ptr_array_set_size (at_commands, 0);
+    g_ptr_array_set_size (failing_commands, 0);
+}
+
+gboolean
+fake_modem_command_sent (const gchar *command)
+{
+    guint i;
+
+    for (i = 0; i < at_commands->len; i++) {
+        if (g_str_equal (g_ptr_array_index (at_commands, i), command))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+enum {
+    PROP_0,
+    PROP_CONNECTION,
+};
+
+G_DEFINE_TYPE (MMBaseModem, mm_base_modem, MM_GDBUS_TYPE_OBJECT_SKELETON)
+
+static void
+base_modem_set_property (GObject *object,
+                         guint prop_id,
+                         const GValue *value,
+                         GParamSpec *pspec)
+{
+    /* Never exported */
+}
+
+static void
+base_modem_get_property (GObject *object,
+                         guint prop_id,
+                         GValue *value,
+                         GParamSpec *pspec)
+{
+    g_value_set_object (value, NULL);
+}
+
+static void
+mm_base_modem_init (MMBaseModem *self)
+{
+}
+
+static void
+mm_base_modem_class_init (MMBaseModemClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+    object_class->set_property = base_modem_set_property;
+    object_class->get_property = base_modem_get_property;
+
+    g_object_class_install_property
+        (object_class, PROP_CONNECTION,
+         g_param_spec_object (MM_BASE_MODEM_CONNECTION,
+                              "Connection",
+                              "GDBus connection to the system bus.",
+                              G_TYPE_DBUS_CONNECTION,
+                              G_PARAM_READWRITE));
+}
+
+GType
+mm_iface_modem_get_type (void)
+{
+    static GType iface_modem_type = 0;
+
+    if (!G_UNLIKELY (iface_modem_type)) {
+        static const GTypeInfo info = {
+            sizeof (MMIfaceModem), /* class_size */
+        };
+
+        iface_modem_type = g_type_register_static (G_TYPE_INTERFACE,
+                                                   "MMIfaceModem",
+                                                   &info,
+                                                   0);
+    }
+
+    return iface_modem_type;
+}
+
+GType
+mm_iface_modem_messaging_get_type (void)
+{
+    static GType iface_modem_messaging_type = 0;
+
+    if (!G_UNLIKELY (iface_modem_messaging_type)) {
+        static const GTypeInfo info = {
+            sizeof (MMIfaceModemMessaging), /* class_size */
+        };
+
+        iface_modem_messaging_type = g_type_register_static (G_TYPE_INTERFACE,
+                                                             "MMIfaceModemMessaging",
+                                                             &info,
+                                                             0);
+    }
+
+    return iface_modem_messaging_type;
+}
+
+static void
+iface_modem_init (MMIfaceModem *iface)
+{
+}
+
+static void
+iface_modem_messaging_init (MMIfaceModemMessaging *iface)
+{
+}
+
+G_DEFINE_TYPE_WITH_CODE (MMBroadbandModem, mm_broadband_modem, MM_TYPE_BASE_MODEM,
+                         G_IMPLEMENT_INTERFACE (MM_TYPE_IFACE_MODEM, iface_modem_init)
+                         G_IMPLEMENT_INTERFACE (MM_TYPE_IFACE_MODEM_MESSAGING, iface_modem_messaging_init))
+
+static void
+mm_broadband_modem_init (MMBroadbandModem *self)
+{
+}
+
+static void
+mm_broadband_modem_class_init (MMBroadbandModemClass *klass)
+{
+}
+
+MMBaseModem *
+fake_modem_new (void)
+{
+    return MM_BASE_MODEM (g_object_new (MM_TYPE_BROADBAND_MODEM,
+                                        "g-object-path", "/org/freedesktop/ModemManager1/Modem/0",
+                                        NULL));
+}
+
+void
+mm_base_modem_at_command (MMBaseModem *self,
+                          const gchar *command,
+                          guint timeout,
+                          gboolean allow_cached,
+                          GAsyncReadyCallback callback,
+                          gpointer user_data)
+{
+    GTask *task;
+    guint  i;
+
+    g_ptr_array_add (at_commands, g_strdup (command));
+
+    task = g_task_new (self, NULL, callback, user_data);
+    for (i = 0; i < failing_commands->len; i++) {
+        if (g_str_equal (g_ptr_array_index (failing_commands, i), command)) {
+            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                     "Command '%s' failed", command);
+            g_object_unref (task);
+            return;
+        }
+    }
+    g_task_return_pointer (task, (gpointer) "", NULL);
+    g_object_unref (task);
+}
+
+void
+mm_base_modem_at_command_raw (MMBaseModem *self,
+                              const gchar *command,
+                              guint timeout,
+                              gboolean allow_cached,
+                              GAsyncReadyCallback callback,
+                              gpointer user_data)
+{
+    mm_base_modem_at_command (self, command, timeout, allow_cached, callback, user_data);
+}
+
+const gchar *
+mm_base_modem_at_command_finish (MMBaseModem *self,
+                                 GAsyncResult *res,
+                                 GError **error)
+{
+    return (const gchar *) g_task_propagate_pointer (G_TASK (res), error);
+}
+
+void
+mm_base_modem_authorize (MMBaseModem *self,
+                         GDBusMethodInvocation *invocation,
+                         const gchar *authorization,
+                         GAsyncReadyCallback callback,
+                         gpointer user_data)
+{
+    g_assert_not_reached ();
+}
+
+gboolean
+mm_base_modem_authorize_finish (MMBaseModem *self,
+                                GAsyncResult *res,
+                                GError **error)
+{
+    g_assert_not_reached ();
+    return FALSE;
+}
+
+void
+mm_broadband_modem_lock_sms_storages (MMBroadbandModem *self,
+                                      MMSmsStorage mem1,
+                                      MMSmsStorage mem2,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data)
+{
+    GTask *task;
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+gboolean
+mm_broadband_modem_lock_sms_storages_finish (MMBroadbandModem *self,
+                                             GAsyncResult *res,
+                                             GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+void
+mm_broadband_modem_unlock_sms_storages (MMBroadbandModem *self,
+                                        gboolean mem1,
+                                        gboolean mem2)
+{
+}
+
+gboolean
+mm_iface_modem_is_3gpp (MMIfaceModem *self)
+{
+    return TRUE;
+}
+
+MMBaseSms *
+mm_iface_modem_messaging_create_sms (MMIfaceModemMessaging *self)
+{
+    return mm_base_sms_new (MM_BASE_MODEM (self));
+}
+
+gboolean
+mm_iface_modem_messaging_is_storage_supported_for_storing (MMIfaceModemMessaging *self,
+                                                           MMSmsStorage storage,
+                                                           GError **error)
+{
+    g_assert_not_reached ();
+    return FALSE;
+}
+
+void
+mm_iface_modem_messaging_hold_sms_link (MMIfaceModemMessaging *self)
+{
+    g_assert_not_reached ();
+}
+
+void
+mm_iface_modem_messaging_release_sms_link (MMIfaceModemMessaging *self)
+{
+    g_assert_not_reached ();
+}
+
+guint8
+mm_iface_modem_messaging_get_local_multipart_reference (MMIfaceModemMessaging *self,
+                                                        const gchar *number,
+                                                        GError **error)
+{
+    g_assert_not_reached ();
+    return 0;
+}
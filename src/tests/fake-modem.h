@@ -0,0 +1,38 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#ifndef FAKE_MODEM_H
+#define FAKE_MODEM_H
+
+#include <glib.h>
+
+#include "mm-base-modem.h"
+
+/* Fake modem for the SMS tests
+ *
+ * The SMS list and the SMS objects only need a few things from the modem: the
+ * messaging interface to create SMS objects, the SMS storage locking, and the
+ * AT command API. AT commands are recorded and succeed right away unless
+ * listed as failing. */
+
+extern GPtrArray *at_commands;
+extern GPtrArray *failing_commands;
+
+void         fake_modem_init         (void);
+void         fake_modem_reset        (void);
+gboolean     fake_modem_command_sent (const gchar *command);
+MMBaseModem *fake_modem_new          (void);
+
+#endif /* FAKE_MODEM_H */
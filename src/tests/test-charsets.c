@@ -315,6 +315,40 @@ test_gsm7_pack_7_chars_offset (void)
     g_free (packed);
 }
 
+static void
+test_gsm7_pack_unpack_offsets (void)
+{
+    guint8 unpacked[40];
+    guint  len;
+    guint  offset;
+    guint  i;
+
+    for (i = 0; i < G_N_ELEMENTS (unpacked); i++)
+        unpacked[i] = (i * 37 + 11) & 0x7F;
+
+    /* Cover both the per-septet and the 8-septet block paths, for every
+     * start offset */
+    for (offset = 0; offset < 8; offset++) {
+        for (len = 1; len <= G_N_ELEMENTS (unpacked); len++) {
+            guint8  *packed;
+            guint8  *result;
+            guint32  packed_len = 0;
+            guint32  result_len = 0;
+
+            packed = mm_charset_gsm_pack (unpacked, len, offset, &packed_len);
+            g_assert (packed);
+            g_assert_cmpuint (packed_len, ==, ((len * 7) + offset + 7) / 8);
+
+            result = mm_charset_gsm_unpack (packed, len, offset, &result_len);
+            g_assert_cmpuint (result_len, ==, len);
+            g_assert_cmpint (memcmp (result, unpacked, len), ==, 0);
+
+            g_free (result);
+            g_free (packed);
+        }
+    }
+}
+
 static void
 test_take_convert_ucs2_hex_utf8 (void)
 {
@@ -410,6 +444,170 @@ test_charset_can_covert_to (void)
     }
 }
 
+static void
+test_charset_fast_paths (void)
+{
+    static const struct {
+        MMModemCharset  charset;
+        const gchar    *iconv_name;
+        const gchar    *utf8;
+    } tests[] = {
+        { MM_MODEM_CHARSET_UCS2,   "UCS-2BE",   "T-Mobile" },
+        { MM_MODEM_CHARSET_UCS2,   "UCS-2BE",   "ホモ・サピエンス 喂人类" },
+        { MM_MODEM_CHARSET_UCS2,   "UCS-2BE",   "" },
+        { MM_MODEM_CHARSET_8859_1, "ISO8859-1", "patín ÿ ©" },
+        { MM_MODEM_CHARSET_IRA,    "ASCII",     "some basic ascii" },
+    };
+    guint i;
+
+    /* The hand-written conversions must match what iconv gives */
+    for (i = 0; i < G_N_ELEMENTS (tests); i++) {
+        gchar *expected_bin;
+        gsize  expected_len = 0;
+        gchar *expected_hex;
+        gchar *hex;
+        gchar *utf8;
+
+        expected_bin = g_convert (tests[i].utf8, -1, tests[i].iconv_name, "UTF-8", NULL, &expected_len, NULL);
+        g_assert (expected_bin);
+        expected_hex = mm_utils_bin2hexstr ((const guint8 *) expected_bin, expected_len);
+
+        if (tests[i].charset != MM_MODEM_CHARSET_IRA) {
+            hex = mm_modem_charset_utf8_to_hex (tests[i].utf8, tests[i].charset);
+            g_assert_cmpstr (hex, ==, expected_hex);
+            g_free (hex);
+        }
+
+        utf8 = mm_modem_charset_hex_to_utf8 (expected_hex, tests[i].charset);
+        g_assert_cmpstr (utf8, ==, tests[i].utf8);
+        g_free (utf8);
+
+        g_free (expected_hex);
+        g_free (expected_bin);
+    }
+
+    /* Not representable in the fast paths, falls back to iconv */
+    g_assert (mm_modem_charset_utf8_to_hex ("€", MM_MODEM_CHARSET_8859_1) == NULL);
+    g_assert (mm_modem_charset_hex_to_utf8 ("D800", MM_MODEM_CHARSET_UCS2) == NULL);
+
+    /* GSM default alphabet has no iconv converter at all */
+    {
+        GByteArray *array;
+        gchar      *utf8;
+
+        array = g_byte_array_new ();
+        g_assert (mm_modem_charset_byte_array_append (array, "a ñ Ω", FALSE, MM_MODEM_CHARSET_GSM));
+        utf8 = mm_modem_charset_byte_array_to_utf8 (array, MM_MODEM_CHARSET_GSM);
+        g_assert_cmpstr (utf8, ==, "a ñ Ω");
+        g_free (utf8);
+        g_byte_array_unref (array);
+    }
+}
+
+/*****************************************************************************/
+
+#define BENCHMARK_SEPTETS    160
+#define BENCHMARK_HEX_BYTES  140
+#define BENCHMARK_ITERATIONS 200000
+
+static void
+test_gsm7_pack_unpack_benchmark (void)
+{
+    guint8  unpacked[BENCHMARK_SEPTETS];
+    gdouble elapsed;
+    guint   i;
+
+    for (i = 0; i < BENCHMARK_SEPTETS; i++)
+        unpacked[i] = g_test_rand_int_range (0, 0x80);
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        guint8  *packed;
+        guint8  *result;
+        guint32  packed_len;
+        guint32  result_len;
+
+        packed = mm_charset_gsm_pack (unpacked, BENCHMARK_SEPTETS, i % 7, &packed_len);
+        result = mm_charset_gsm_unpack (packed, BENCHMARK_SEPTETS, i % 7, &result_len);
+        g_assert_cmpuint (result_len, ==, BENCHMARK_SEPTETS);
+        g_free (result);
+        g_free (packed);
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "%u GSM7 pack+unpack of %u septets in %.3lf seconds",
+                             BENCHMARK_ITERATIONS, BENCHMARK_SEPTETS, elapsed);
+    g_test_message ("%.1lf MB/s", (BENCHMARK_ITERATIONS * (gdouble) BENCHMARK_SEPTETS) / (elapsed * 1e6));
+}
+
+static void
+test_charset_conversion_benchmark (void)
+{
+    static const struct {
+        MMModemCharset  charset;
+        const gchar    *utf8;
+    } tests[] = {
+        { MM_MODEM_CHARSET_UCS2,    "Your balance is 12.34 EUR. Vàlid until 31/12" },
+        { MM_MODEM_CHARSET_8859_1,  "Your balance is 12.34 EUR. Vàlid until 31/12" },
+        { MM_MODEM_CHARSET_GSM,     "Your balance is 12.34 EUR. Vàlid until 31/12" },
+        /* Goes through the cached iconv converter */
+        { MM_MODEM_CHARSET_PCCP437, "Your balance is 12.34 EUR. Vàlid until 31/12" },
+    };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (tests); i++) {
+        gdouble elapsed;
+        guint   j;
+
+        g_test_timer_start ();
+        for (j = 0; j < BENCHMARK_ITERATIONS; j++) {
+            gchar *hex;
+            gchar *utf8;
+
+            hex = mm_modem_charset_utf8_to_hex (tests[i].utf8, tests[i].charset);
+            utf8 = mm_modem_charset_hex_to_utf8 (hex, tests[i].charset);
+            g_assert_cmpstr (utf8, ==, tests[i].utf8);
+            g_free (utf8);
+            g_free (hex);
+        }
+        elapsed = g_test_timer_elapsed ();
+
+        g_test_minimized_result (elapsed, "%u %s round trips in %.3lf seconds",
+                                 BENCHMARK_ITERATIONS, mm_modem_charset_to_string (tests[i].charset), elapsed);
+        g_test_message ("%s: %.0lf conversions/s",
+                        mm_modem_charset_to_string (tests[i].charset), (2 * BENCHMARK_ITERATIONS) / elapsed);
+    }
+}
+
+static void
+test_hex_benchmark (void)
+{
+    guint8  bin[BENCHMARK_HEX_BYTES];
+    gdouble elapsed;
+    guint   i;
+
+    for (i = 0; i < BENCHMARK_HEX_BYTES; i++)
+        bin[i] = g_test_rand_int_range (0, 0x100);
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        gchar *hex;
+        gchar *result;
+        gsize  result_len;
+
+        hex = mm_utils_bin2hexstr (bin, BENCHMARK_HEX_BYTES);
+        result = mm_utils_hexstr2bin (hex, &result_len);
+        g_assert_cmpuint (result_len, ==, BENCHMARK_HEX_BYTES);
+        g_free (result);
+        g_free (hex);
+    }
+    elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "%u hex encode+decode of %u bytes in %.3lf seconds",
+                             BENCHMARK_ITERATIONS, BENCHMARK_HEX_BYTES, elapsed);
+    g_test_message ("%.1lf MB/s", (BENCHMARK_ITERATIONS * (gdouble) BENCHMARK_HEX_BYTES) / (elapsed * 1e6));
+}
+
 void
 _mm_log (const char *loc,
          const char *func,
@@ -448,12 +646,20 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/charsets/gsm7/pack/24-chars",          test_gsm7_pack_24_chars);
     g_test_add_func ("/MM/charsets/gsm7/pack/last-septet-alone", test_gsm7_pack_last_septet_alone);
     g_test_add_func ("/MM/charsets/gsm7/pack/7-chars-offset",    test_gsm7_pack_7_chars_offset);
+    g_test_add_func ("/MM/charsets/gsm7/pack-unpack/offsets",    test_gsm7_pack_unpack_offsets);
 
     g_test_add_func ("/MM/charsets/take-convert/ucs2/hex",         test_take_convert_ucs2_hex_utf8);
     g_test_add_func ("/MM/charsets/take-convert/ucs2/bad-ascii",   test_take_convert_ucs2_bad_ascii);
     g_test_add_func ("/MM/charsets/take-convert/ucs2/bad-ascii-2", test_take_convert_ucs2_bad_ascii2);
 
     g_test_add_func ("/MM/charsets/can-convert-to", test_charset_can_covert_to);
+    g_test_add_func ("/MM/charsets/fast-paths",     test_charset_fast_paths);
+
+    if (g_test_perf ()) {
+        g_test_add_func ("/MM/charsets/gsm7/benchmark", test_gsm7_pack_unpack_benchmark);
+        g_test_add_func ("/MM/charsets/hex/benchmark",  test_hex_benchmark);
+        g_test_add_func ("/MM/charsets/conversion/benchmark", test_charset_conversion_benchmark);
+    }
 
     return g_test_run ();
 }
@@ -412,6 +412,130 @@ test_cmgl_response_pantech_multiple (void *f, gpointer d)
     test_cmgl_response (str, expected, G_N_ELEMENTS (expected));
 }
 
+static void
+test_cmgl_response_missing_pdu (void *f, gpointer d)
+{
+    GList *list;
+    GError *error = NULL;
+
+    list = mm_3gpp_parse_pdu_cmgl_response ("+CMGL: 17,3,35\r\n\r\nOK", &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_assert (list == NULL);
+    g_error_free (error);
+}
+
+static void
+cmgl_foreach_store_index (MM3gppPduInfo *info,
+                          GArray        *indices)
+{
+    g_array_append_val (indices, info->index);
+    mm_3gpp_pdu_info_free (info);
+}
+
+static void
+test_cmgl_response_foreach (void *f, gpointer d)
+{
+    const gchar *str =
+        "+CMGL: 17,3,35\r\n079100F40D1101000F001000B917118336058F300001954747A0E4ACF41F27298CDCE83C6EF371B0402814020\r\n"
+        "+CMGL: X,3,35\r\n079100F40D1101000F001000B917118336058F300001954747A0E4ACF41F27298CDCE83C6EF371B0402814020\r\n"
+        "+CMGL: 13,3,35\r\n079100F40D1101000F001000B917118336058F300001954747A0E4ACF41F27298CDCE83C6EF371B0402814020\r\n"
+        "+CMGL: 11,3,35\r\n";
+    GArray *indices;
+    GError *error = NULL;
+
+    /* Malformed headers are skipped, the trailing incomplete entry ignored */
+    indices = g_array_new (FALSE, FALSE, sizeof (gint));
+    g_assert (mm_3gpp_parse_pdu_cmgl_response_foreach (str,
+                                                       (MM3gppPduInfoFunc)cmgl_foreach_store_index,
+                                                       indices,
+                                                       &error));
+    g_assert_no_error (error);
+    g_assert_cmpuint (indices->len, ==, 2);
+    g_assert_cmpint (g_array_index (indices, gint, 0), ==, 17);
+    g_assert_cmpint (g_array_index (indices, gint, 1), ==, 13);
+    g_array_unref (indices);
+}
+
+static void
+cmgl_text_foreach_append (MM3gppTextInfo *info,
+                          GPtrArray      *infos)
+{
+    g_ptr_array_add (infos, info);
+}
+
+static void
+test_cmgl_text_response (void *f, gpointer d)
+{
+    const gchar *str =
+        "+CMGL: 1,\"REC UNREAD\",\"+31628870634\",,\"11/06/13,10:05:02+08\"\r\n"
+        "hello, world\r\n"
+        "+CMGL: 2,\"STO SENT\",\"+31628870634\",\"alpha\",\r\n"
+        "\r\n"
+        "+CMGL: 3,\"REC READ\",\"+31628870634\",\r\n"
+        "skipped\r\n";
+    GPtrArray *infos;
+    MM3gppTextInfo *info;
+
+    infos = g_ptr_array_new_with_free_func ((GDestroyNotify)mm_3gpp_text_info_free);
+    g_assert_cmpuint (mm_3gpp_parse_text_cmgl_response_foreach (str,
+                                                                (MM3gppTextInfoFunc)cmgl_text_foreach_append,
+                                                                infos), ==, 2);
+    g_assert_cmpuint (infos->len, ==, 2);
+
+    info = g_ptr_array_index (infos, 0);
+    g_assert_cmpint (info->index, ==, 1);
+    g_assert_cmpstr (info->status, ==, "REC UNREAD");
+    g_assert_cmpstr (info->number, ==, "+31628870634");
+    g_assert_cmpstr (info->timestamp, ==, "11/06/13,10:05:02+08");
+    g_assert_cmpstr (info->text, ==, "hello, world");
+
+    info = g_ptr_array_index (infos, 1);
+    g_assert_cmpint (info->index, ==, 2);
+    g_assert_cmpstr (info->status, ==, "STO SENT");
+    g_assert (info->timestamp == NULL);
+    g_assert_cmpstr (info->text, ==, "");
+
+    g_ptr_array_unref (infos);
+}
+
+#define CMGL_BENCHMARK_PDU                                              \
+    "07914306073011F00405812261F700003130916191314095C27"               \
+    "4D96D2FBBD3E437280CB2BEC961F3DB5D76818EF2F0381D9E83E06F39A8CC2E9FD372F" \
+    "77BEE0249CBE37A594E0E83E2F532085E2F93CB73D0B93CA7A7DFEEB01C447F93DF731" \
+    "0BD3E07CDCB727B7A9C7ECF41E432C8FC96B7C32079189E26874179D0F8DD7E93C3A0B" \
+    "21B246AA641D637396C7EBBCB22D0FD7E77B5D376B3AB3C07"
+
+static void
+test_cmgl_response_benchmark (void *f, gpointer d)
+{
+    static const guint n_entries[] = { 10, 100, 1000 };
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (n_entries); i++) {
+        GString *str;
+        GList *list;
+        GError *error = NULL;
+        gdouble elapsed;
+        guint j;
+
+        str = g_string_new (NULL);
+        for (j = 0; j < n_entries[i]; j++)
+            g_string_append_printf (str, "+CMGL: %u,1,,147\r\n" CMGL_BENCHMARK_PDU "\r\n", j);
+        g_string_append (str, "\r\nOK\r\n");
+
+        g_test_timer_start ();
+        list = mm_3gpp_parse_pdu_cmgl_response (str->str, &error);
+        elapsed = g_test_timer_elapsed ();
+
+        g_assert_no_error (error);
+        g_assert_cmpuint (g_list_length (list), ==, n_entries[i]);
+        g_test_minimized_result (elapsed, "%u +CMGL entries parsed in %.6lf seconds", n_entries[i], elapsed);
+
+        mm_3gpp_pdu_info_list_free (list);
+        g_string_free (str, TRUE);
+    }
+}
+
 /*****************************************************************************/
 /* Test CMGR responses */
 
@@ -3469,6 +3593,47 @@ test_cclk_response (void)
     }
 }
 
+/*****************************************************************************/
+/* Test SMS timestamp to UNIX time conversion */
+
+typedef struct {
+    const gchar *str;
+    gboolean ret;
+    gint64 unix_time;
+} SmsTimestampUnixTest;
+
+static const SmsTimestampUnixTest sms_timestamp_unix_tests[] = {
+    /* As decoded from PDUs, offset in hours */
+    { "110228115050-05",      TRUE,  1298911850 },
+    { "110329192004+04",      TRUE,  1301412004 },
+    { "000101000000+00",      TRUE,  946684800  },
+    /* As reported in text mode, offset in quarters of an hour */
+    { "11/03/29,19:20:04+16", TRUE,  1301412004 },
+    { "11/02/28,11:50:50-20", TRUE,  1298911850 },
+    { "110329192004",         FALSE, 0          },
+    { "110329192004+4",       FALSE, 0          },
+    { "110329192004+04 ",     FALSE, 0          },
+    { "111329192004+04",      FALSE, 0          },
+    { "11/03/29 19:20:04+16", FALSE, 0          },
+    { "2011-03-29T19:20:04Z", FALSE, 0          },
+    { "",                     FALSE, 0          },
+};
+
+static void
+test_sms_timestamp_to_unix (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (sms_timestamp_unix_tests); i++) {
+        gint64 unix_time = 0;
+        gboolean ret;
+
+        ret = mm_sms_timestamp_to_unix (sms_timestamp_unix_tests[i].str, &unix_time);
+        g_assert (ret == sms_timestamp_unix_tests[i].ret);
+        if (ret)
+            g_assert_cmpint (unix_time, ==, sms_timestamp_unix_tests[i].unix_time);
+    }
+}
 
 /*****************************************************************************/
 /* Test +CRSM responses */
@@ -4214,6 +4379,11 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_generic_multiple, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_pantech, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgl_response_pantech_multiple, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgl_response_missing_pdu, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgl_response_foreach, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmgl_text_response, NULL));
+    if (g_test_perf ())
+        g_test_suite_add (suite, TESTCASE (test_cmgl_response_benchmark, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cmgr_response_generic, NULL));
     g_test_suite_add (suite, TESTCASE (test_cmgr_response_telit, NULL));
@@ -4223,6 +4393,7 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_supported_capability_filter, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cclk_response, NULL));
+    g_test_suite_add (suite, TESTCASE (test_sms_timestamp_to_unix, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_crsm_response, NULL));
 
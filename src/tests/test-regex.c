@@ -0,0 +1,208 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include "mm-regex.h"
+#include "mm-log.h"
+
+#define CFUN_PATTERN "\\+CFUN: (\\d+)(?:,(?:\\d+))?(?:\\r\\n)?"
+
+/*****************************************************************************/
+
+static const MMRegexStats *
+find_stats (GArray      *stats,
+            const gchar *pattern)
+{
+    guint i;
+
+    for (i = 0; i < stats->len; i++) {
+        MMRegexStats *item;
+
+        item = &g_array_index (stats, MMRegexStats, i);
+        if (g_str_equal (item->pattern, pattern))
+            return item;
+    }
+    return NULL;
+}
+
+static void
+test_shared (void)
+{
+    static MMRegex      first  = MM_REGEX_INIT ("^TEST-SHARED (\\d+)$", 0, 0);
+    static MMRegex      second = MM_REGEX_INIT ("^TEST-SHARED (\\d+)$", 0, 0);
+    static MMRegex      other  = MM_REGEX_INIT ("^TEST-SHARED (\\d+)$", G_REGEX_CASELESS, 0);
+    GMatchInfo         *match_info = NULL;
+    GArray             *stats;
+    const MMRegexStats *item;
+    gchar              *str;
+
+    /* Same pattern and flags share the compiled regex */
+    g_assert (mm_regex_get (&first) == mm_regex_get (&second));
+    g_assert (mm_regex_get (&first) != mm_regex_get (&other));
+
+    g_assert (mm_regex_match (&first, "TEST-SHARED 12", 0, &match_info));
+    str = g_match_info_fetch (match_info, 1);
+    g_assert_cmpstr (str, ==, "12");
+    g_free (str);
+    g_match_info_free (match_info);
+
+    g_assert (!mm_regex_match (&second, "test-shared 12", 0, NULL));
+    g_assert (mm_regex_match (&other, "test-shared 12", 0, NULL));
+
+    stats = mm_regex_registry_get_stats ();
+    item = find_stats (stats, "^TEST-SHARED (\\d+)$");
+    g_assert (item);
+    g_assert_cmpuint (item->n_compilations, ==, 1);
+    g_assert_cmpuint (item->n_handles,      ==, 2);
+    g_assert_cmpuint (item->n_matches,      ==, 2);
+    g_assert_cmpuint (item->n_hits,         ==, 1);
+    g_array_unref (stats);
+}
+
+/*****************************************************************************/
+
+static void
+test_stats (void)
+{
+    static MMRegex      r = MM_REGEX_INIT ("^TEST-STATS$", G_REGEX_RAW, 0);
+    GArray             *stats;
+    const MMRegexStats *item;
+    guint               i;
+
+    for (i = 0; i < 10; i++)
+        mm_regex_match (&r, (i % 2) ? "TEST-STATS" : "NO-MATCH", 0, NULL);
+
+    stats = mm_regex_registry_get_stats ();
+    item = find_stats (stats, "^TEST-STATS$");
+    g_assert (item);
+    g_assert_cmpuint (item->n_compilations, ==, 1);
+    g_assert_cmpuint (item->n_handles,      ==, 1);
+    g_assert_cmpuint (item->n_matches,      ==, 10);
+    g_assert_cmpuint (item->n_hits,         ==, 5);
+
+    /* Most used patterns come first */
+    for (i = 1; i < stats->len; i++)
+        g_assert_cmpuint (g_array_index (stats, MMRegexStats, i - 1).n_matches, >=,
+                          g_array_index (stats, MMRegexStats, i).n_matches);
+    g_array_unref (stats);
+}
+
+/*****************************************************************************/
+
+#define N_THREADS         8
+#define THREAD_ITERATIONS 1000
+
+static MMRegex threads_regex = MM_REGEX_INIT ("^TEST-THREADS (\\d+)$", 0, 0);
+
+static gpointer
+thread_func (gpointer user_data)
+{
+    guint i;
+
+    for (i = 0; i < THREAD_ITERATIONS; i++)
+        g_assert (mm_regex_match (&threads_regex, "TEST-THREADS 1", 0, NULL));
+    return NULL;
+}
+
+static void
+test_threads (void)
+{
+    GThread            *threads[N_THREADS];
+    GArray             *stats;
+    const MMRegexStats *item;
+    guint               i;
+
+    /* All threads race to compile the same handle */
+    for (i = 0; i < N_THREADS; i++)
+        threads[i] = g_thread_new ("test-regex", thread_func, NULL);
+    for (i = 0; i < N_THREADS; i++)
+        g_thread_join (threads[i]);
+
+    stats = mm_regex_registry_get_stats ();
+    item = find_stats (stats, "^TEST-THREADS (\\d+)$");
+    g_assert (item);
+    g_assert_cmpuint (item->n_compilations, ==, 1);
+    g_assert_cmpuint (item->n_handles,      ==, 1);
+    g_assert_cmpuint (item->n_matches,      ==, N_THREADS * THREAD_ITERATIONS);
+    g_assert_cmpuint (item->n_hits,         ==, N_THREADS * THREAD_ITERATIONS);
+    g_array_unref (stats);
+}
+
+/*****************************************************************************/
+
+#define BENCHMARK_ITERATIONS 100000
+
+static void
+test_benchmark (void)
+{
+    static MMRegex  r = MM_REGEX_INIT (CFUN_PATTERN, 0, 0);
+    const gchar    *response = "+CFUN: 1,0\r\n";
+    gdouble         elapsed_compile;
+    gdouble         elapsed_registry;
+    guint           i;
+
+    /* What parsers used to do: compile on every reply */
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        GRegex     *regex;
+        GMatchInfo *match_info = NULL;
+
+        regex = g_regex_new (CFUN_PATTERN, 0, 0, NULL);
+        g_regex_match (regex, response, 0, &match_info);
+        g_match_info_free (match_info);
+        g_regex_unref (regex);
+    }
+    elapsed_compile = g_test_timer_elapsed ();
+
+    g_test_timer_start ();
+    for (i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        GMatchInfo *match_info = NULL;
+
+        mm_regex_match (&r, response, 0, &match_info);
+        g_match_info_free (match_info);
+    }
+    elapsed_registry = g_test_timer_elapsed ();
+
+    g_test_message ("%u matches compiling every time: %.3lf seconds", BENCHMARK_ITERATIONS, elapsed_compile);
+    g_test_minimized_result (elapsed_registry, "%u matches with registry: %.3lf seconds", BENCHMARK_ITERATIONS, elapsed_registry);
+}
+
+/*****************************************************************************/
+
+void
+_mm_log (const char *loc,
+         const char *func,
+         guint32 level,
+         const char *fmt,
+         ...)
+{
+    /* Dummy log function */
+}
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/Regex/shared",  test_shared);
+    g_test_add_func ("/MM/Regex/stats",   test_stats);
+    g_test_add_func ("/MM/Regex/threads", test_threads);
+
+    if (g_test_perf ())
+        g_test_add_func ("/MM/Regex/benchmark", test_benchmark);
+
+    return g_test_run ();
+}
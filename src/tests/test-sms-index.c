@@ -0,0 +1,281 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include <ModemManager.h>
+
+#include "mm-sms-index.h"
+#include "mm-log.h"
+
+/*****************************************************************************/
+
+static void
+test_parts (void)
+{
+    MMSmsIndex *index;
+    gint        a, b;
+
+    index = mm_sms_index_new ();
+
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 1, &a);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_ME, 1, &b);
+
+    /* Same index in different storages are different parts */
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 1) == &a);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_ME, 1) == &b);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_MT, 1) == NULL);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 2) == NULL);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_UNKNOWN, 1) == NULL);
+    g_assert_cmpuint (mm_sms_index_count_parts (index, MM_SMS_STORAGE_SM), ==, 1);
+    g_assert_cmpuint (mm_sms_index_count_parts (index, MM_SMS_STORAGE_MT), ==, 0);
+
+    /* Removal only applies to the item owning the part */
+    mm_sms_index_remove_part (index, MM_SMS_STORAGE_SM, 1, &b);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 1) == &a);
+    mm_sms_index_remove_part (index, MM_SMS_STORAGE_SM, 1, &a);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 1) == NULL);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_ME, 1) == &b);
+    g_assert_cmpuint (mm_sms_index_count_parts (index, MM_SMS_STORAGE_SM), ==, 0);
+
+    mm_sms_index_free (index);
+}
+
+static void
+test_remove_item (void)
+{
+    MMSmsIndex *index;
+    gint        a, b;
+
+    index = mm_sms_index_new ();
+
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 1, &a);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 2, &a);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 3, &b);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_ME, 1, &a);
+
+    /* All the parts of the item in the storage go away, whatever their index */
+    mm_sms_index_remove_item (index, MM_SMS_STORAGE_SM, &a);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 1) == NULL);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 2) == NULL);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 3) == &b);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_ME, 1) == &a);
+    g_assert_cmpuint (mm_sms_index_count_parts (index, MM_SMS_STORAGE_SM), ==, 1);
+
+    /* Unknown storages are ignored */
+    mm_sms_index_remove_item (index, MM_SMS_STORAGE_UNKNOWN, &b);
+    mm_sms_index_remove_item (index, MM_SMS_STORAGE_MT, &b);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 3) == &b);
+
+    /* Parts taken over by another item stay with the new owner */
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 4, &a);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 5, &a);
+    mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, 4, &b);
+    mm_sms_index_remove_part (index, MM_SMS_STORAGE_SM, 5, &a);
+    mm_sms_index_remove_item (index, MM_SMS_STORAGE_SM, &a);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 4) == &b);
+    g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, 5) == NULL);
+    mm_sms_index_remove_item (index, MM_SMS_STORAGE_SM, &b);
+    g_assert_cmpuint (mm_sms_index_count_parts (index, MM_SMS_STORAGE_SM), ==, 0);
+
+    mm_sms_index_free (index);
+}
+
+static void
+test_multiparts (void)
+{
+    MMSmsIndex *index;
+    gint        a, b, c;
+
+    index = mm_sms_index_new ();
+
+    mm_sms_index_add_multipart (index, "+34600000001", 10, &a);
+    mm_sms_index_add_multipart (index, "+34600000002", 10, &b);
+    mm_sms_index_add_multipart (index, NULL, 10, &c);
+
+    /* Same reference from different senders are different messages */
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000001", 10) == &a);
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000002", 10) == &b);
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000001", 11) == NULL);
+    g_assert (mm_sms_index_lookup_multipart (index, NULL, 10) == &c);
+    g_assert (mm_sms_index_lookup_multipart (index, "", 10) == &c);
+
+    mm_sms_index_remove_multipart (index, "+34600000001", 10, &b);
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000001", 10) == &a);
+    mm_sms_index_remove_multipart (index, "+34600000001", 10, &a);
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000001", 10) == NULL);
+    g_assert (mm_sms_index_lookup_multipart (index, "+34600000002", 10) == &b);
+
+    mm_sms_index_free (index);
+}
+
+/*****************************************************************************/
+/* Emulates loading a full storage of multipart messages, with parts found in
+ * random order, the same way MMSmsList groups them */
+
+#define PARTS_PER_MESSAGE 3
+
+typedef struct {
+    gchar *number;
+    guint  reference;
+    guint  n_parts;
+    guint  slots[PARTS_PER_MESSAGE];
+} TestMessage;
+
+typedef struct {
+    guint message;
+    guint sequence;
+} TestPart;
+
+static void
+run_assembly (guint    n_messages,
+              gdouble *elapsed)
+{
+    MMSmsIndex  *index;
+    TestMessage *messages;
+    TestPart    *parts;
+    guint        n_parts;
+    guint        n_created = 0;
+    guint        i;
+
+    index = mm_sms_index_new ();
+    n_parts = n_messages * PARTS_PER_MESSAGE;
+    messages = g_new0 (TestMessage, n_messages);
+    parts = g_new (TestPart, n_parts);
+
+    /* References are 8-bit, so they are shared among senders */
+    for (i = 0; i < n_parts; i++) {
+        parts[i].message = i / PARTS_PER_MESSAGE;
+        parts[i].sequence = 1 + (i % PARTS_PER_MESSAGE);
+    }
+    for (i = n_parts - 1; i > 0; i--) {
+        TestPart tmp;
+        guint    j;
+
+        j = g_test_rand_int_range (0, i + 1);
+        tmp = parts[i];
+        parts[i] = parts[j];
+        parts[j] = tmp;
+    }
+
+    g_test_timer_start ();
+    for (i = 0; i < n_parts; i++) {
+        TestMessage *message;
+        gchar        number[16];
+        guint        reference;
+
+        g_snprintf (number, sizeof (number), "+3460%07u", parts[i].message / 255);
+        reference = parts[i].message % 255;
+
+        g_assert (!mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, i));
+
+        message = mm_sms_index_lookup_multipart (index, number, reference);
+        if (!message) {
+            message = &messages[parts[i].message];
+            g_assert (!message->number);
+            message->number = g_strdup (number);
+            message->reference = reference;
+            mm_sms_index_add_multipart (index, number, reference, message);
+            n_created++;
+        }
+        g_assert (message == &messages[parts[i].message]);
+        g_assert (message->slots[parts[i].sequence - 1] == 0);
+        message->slots[parts[i].sequence - 1] = i + 1;
+        message->n_parts++;
+
+        mm_sms_index_add_part (index, MM_SMS_STORAGE_SM, i, message);
+    }
+    *elapsed = g_test_timer_elapsed ();
+
+    g_assert_cmpuint (n_created, ==, n_messages);
+    for (i = 0; i < n_messages; i++) {
+        guint j;
+
+        g_assert_cmpuint (messages[i].n_parts, ==, PARTS_PER_MESSAGE);
+        for (j = 0; j < PARTS_PER_MESSAGE; j++) {
+            guint storage_index;
+
+            storage_index = messages[i].slots[j] - 1;
+            g_assert_cmpuint (parts[storage_index].message, ==, i);
+            g_assert_cmpuint (parts[storage_index].sequence, ==, j + 1);
+            g_assert (mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, storage_index) == &messages[i]);
+        }
+    }
+
+    /* Remove everything */
+    for (i = 0; i < n_parts; i++)
+        mm_sms_index_remove_part (index, MM_SMS_STORAGE_SM, i, &messages[parts[i].message]);
+    for (i = 0; i < n_messages; i++) {
+        mm_sms_index_remove_multipart (index, messages[i].number, messages[i].reference, &messages[i]);
+        g_assert (!mm_sms_index_lookup_multipart (index, messages[i].number, messages[i].reference));
+        g_assert (!mm_sms_index_lookup_part (index, MM_SMS_STORAGE_SM, messages[i].slots[0] - 1));
+        g_free (messages[i].number);
+    }
+
+    g_free (parts);
+    g_free (messages);
+    mm_sms_index_free (index);
+}
+
+static void
+test_assembly (void)
+{
+    gdouble elapsed;
+
+    run_assembly (5000, &elapsed);
+}
+
+static void
+test_assembly_benchmark (void)
+{
+    static const guint sizes[] = { 1000, 10000, 100000 };
+    guint              i;
+
+    for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+        gdouble elapsed;
+
+        run_assembly (sizes[i], &elapsed);
+        g_test_minimized_result (elapsed, "%u multipart messages (%u parts) grouped in %.3lf seconds",
+                                 sizes[i], sizes[i] * PARTS_PER_MESSAGE, elapsed);
+    }
+}
+
+/*****************************************************************************/
+
+void
+_mm_log (const char *loc,
+         const char *func,
+         guint32 level,
+         const char *fmt,
+         ...)
+{
+    /* Dummy log function */
+}
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/SMS/Index/parts",       test_parts);
+    g_test_add_func ("/MM/SMS/Index/remove-item", test_remove_item);
+    g_test_add_func ("/MM/SMS/Index/multiparts",  test_multiparts);
+    g_test_add_func ("/MM/SMS/Index/assembly",    test_assembly);
+
+    if (g_test_perf ())
+        g_test_add_func ("/MM/SMS/Index/benchmark", test_assembly_benchmark);
+
+    return g_test_run ();
+}
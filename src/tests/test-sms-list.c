@@ -0,0 +1,392 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-base-sms.h"
+#include "mm-sms-list.h"
+#include "mm-sms-part-3gpp.h"
+#include "mm-context.h"
+#include "mm-log.h"
+
+#include "fake-modem.h"
+
+/* No direct delivery of received messages */
+const gchar *
+mm_context_get_sms_sink (void)
+{
+    return NULL;
+}
+
+/*****************************************************************************/
+
+/* Single part, from "InternetSMS", timestamp "110329192004+04" */
+static const gchar *singlepart_pdu =
+    "07919730071111F10414D04937BD2C7797E9D3E614000811309291024061080442043504410442";
+#define SINGLEPART_PDU_UNIX_TIME 1301412004
+
+/* Two parts of the same message; the assembled message takes the timestamp
+ * of the first part, "120425195650-04" */
+static const gchar *multipart_pdu1 =
+    "07912160130320F5440B916171056429F5000021405291650569A00500034C0201A9E8F41C949E"
+    "83C2207B599E07B1DFEE33885E9ED341E4F23C7D7697C920FA1B54C697E5E3F4BC0C6AD7D9F434"
+    "081E96D341E3303C2C4EB3D3F4BC0B94A483E6E8779D4D06CDD1EF3BA80E0785E7A0B7BB0C6A97"
+    "E7F3F0B9CC02B9DF7450780EA2DFDF2C50780EA2A3CBA0BA9B5C96B3F369F71954768FDFE4B4FB"
+    "0C9297E1F2F2BCECA6CF41";
+static const gchar *multipart_pdu2 =
+    "07912160130320F6440B916171056429F5000021405291651569320500034C0202E9E8301D4447"
+    "9741F0B09C3E0785E56590BCCC0ED3CB6410FD0D7ABBCBA0B0FB4D4797E52E10";
+#define MULTIPART_PDU_UNIX_TIME 1335398210
+
+static void
+take_pdu (MMSmsList *list,
+          MMSmsStorage storage,
+          guint index,
+          const gchar *hexpdu)
+{
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    part = mm_sms_part_3gpp_new_from_pdu (index, hexpdu, &error);
+    g_assert_no_error (error);
+    g_assert (part);
+
+    mm_sms_list_take_part (list, part, MM_SMS_STATE_RECEIVED, storage, &error);
+    g_assert_no_error (error);
+}
+
+static void
+async_ready (GObject *source,
+             GAsyncResult *res,
+             GAsyncResult **out)
+{
+    *out = g_object_ref (res);
+}
+
+static GAsyncResult *
+wait_result (GAsyncResult **res)
+{
+    while (!*res)
+        g_main_context_iteration (NULL, TRUE);
+    return *res;
+}
+
+static gboolean
+delete_sms (MMSmsList *list,
+            const gchar *path)
+{
+    GAsyncResult *res = NULL;
+    GError *error = NULL;
+    gboolean deleted;
+
+    mm_sms_list_delete_sms (list, path, (GAsyncReadyCallback) async_ready, &res);
+    deleted = mm_sms_list_delete_sms_finish (list, wait_result (&res), &error);
+    g_clear_error (&error);
+    g_object_unref (res);
+    return deleted;
+}
+
+static void
+test_delete_take_same_index (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GStrv paths;
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 3, singlepart_pdu);
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 3));
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 1);
+
+    /* The same part reported twice is only taken once */
+    part = mm_sms_part_3gpp_new_from_pdu (3, singlepart_pdu, &error);
+    g_assert_no_error (error);
+    g_assert (!mm_sms_list_take_part (list, part, MM_SMS_STATE_RECEIVED, MM_SMS_STORAGE_ME, &error));
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED);
+    g_clear_error (&error);
+    mm_sms_part_free (part);
+
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (g_strv_length (paths), ==, 1);
+    g_assert (delete_sms (list, paths[0]));
+    g_strfreev (paths);
+
+    g_assert (fake_modem_command_sent ("+CMGD=3"));
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 3));
+
+    /* A new message stored in the freed slot must not be ignored */
+    take_pdu (list, MM_SMS_STORAGE_ME, 3, singlepart_pdu);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 1);
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 3));
+
+    /* Same slot in a different storage is a different part */
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_SM, 3));
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static guint
+delete_sms_multiple (MMSmsList *list,
+                     const gchar *const *paths,
+                     gboolean all)
+{
+    GAsyncResult *res = NULL;
+    GError *error = NULL;
+    guint n_deleted = 0;
+
+    if (all) {
+        mm_sms_list_delete_all (list, (GAsyncReadyCallback) async_ready, &res);
+        mm_sms_list_delete_all_finish (list, wait_result (&res), &n_deleted, &error);
+    } else {
+        mm_sms_list_delete_sms_multiple (list, paths, (GAsyncReadyCallback) async_ready, &res);
+        mm_sms_list_delete_sms_multiple_finish (list, wait_result (&res), &n_deleted, &error);
+    }
+    g_assert_no_error (error);
+    g_object_unref (res);
+    return n_deleted;
+}
+
+static gboolean
+bulk_delete_sent (void)
+{
+    guint i;
+
+    for (i = 0; i < at_commands->len; i++) {
+        if (g_str_has_suffix (g_ptr_array_index (at_commands, i), ",4"))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+test_delete_multiple_keeps_unknown (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GStrv paths;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    /* The storage also holds a message at index 7 which was never taken
+     * (e.g. it couldn't be parsed, or its +CMTI wasn't processed yet) */
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, singlepart_pdu);
+
+    /* Deleting all the messages we know about must not clear the storage */
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (delete_sms_multiple (list, (const gchar *const *) paths, FALSE), ==, 2);
+    g_strfreev (paths);
+
+    g_assert (fake_modem_command_sent ("+CMGD=1"));
+    g_assert (fake_modem_command_sent ("+CMGD=2"));
+    g_assert (!bulk_delete_sent ());
+    g_assert_cmpuint (at_commands->len, ==, 2);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static void
+test_delete_multiple_partial_failure (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GStrv paths;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, singlepart_pdu);
+    g_ptr_array_add (failing_commands, g_strdup ("+CMGD=2"));
+
+    paths = mm_sms_list_get_paths (list);
+    g_assert_cmpuint (delete_sms_multiple (list, (const gchar *const *) paths, FALSE), ==, 1);
+    g_strfreev (paths);
+
+    /* The message not deleted is kept, and its part still known */
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 1);
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 1));
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 2));
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static void
+test_delete_multiple_paths (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GStrv paths;
+    const gchar *requested[4];
+    GAsyncResult *res = NULL;
+    GError *error = NULL;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, singlepart_pdu);
+    paths = mm_sms_list_get_paths (list);
+
+    /* Unknown paths fail the whole request before deleting anything */
+    requested[0] = paths[0];
+    requested[1] = "/org/freedesktop/ModemManager1/SMS/9999";
+    requested[2] = NULL;
+    mm_sms_list_delete_sms_multiple (list, requested, (GAsyncReadyCallback) async_ready, &res);
+    g_assert (!mm_sms_list_delete_sms_multiple_finish (list, wait_result (&res), NULL, &error));
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND);
+    g_clear_error (&error);
+    g_object_unref (res);
+    g_assert_cmpuint (at_commands->len, ==, 0);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 2);
+
+    /* Duplicated paths are only deleted once */
+    requested[0] = paths[0];
+    requested[1] = paths[1];
+    requested[2] = paths[0];
+    requested[3] = NULL;
+    g_assert_cmpuint (delete_sms_multiple (list, requested, FALSE), ==, 2);
+    g_assert_cmpuint (at_commands->len, ==, 2);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+    g_strfreev (paths);
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static void
+test_delete_all (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_SM, 1, singlepart_pdu);
+
+    /* Explicitly asked, so each storage is cleared with a single command */
+    g_assert_cmpuint (delete_sms_multiple (list, NULL, TRUE), ==, 3);
+    g_assert_cmpuint (at_commands->len, ==, 2);
+    g_assert (bulk_delete_sent ());
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 1));
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 2));
+    g_assert (!mm_sms_list_has_part (list, MM_SMS_STORAGE_SM, 1));
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static guint
+count_paths_since (MMSmsList *list,
+                   gint64 unix_time)
+{
+    GStrv paths;
+    guint n;
+
+    paths = mm_sms_list_get_paths_since (list, unix_time);
+    n = g_strv_length (paths);
+    g_strfreev (paths);
+    return n;
+}
+
+static void
+test_list_since (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, multipart_pdu1);
+    take_pdu (list, MM_SMS_STORAGE_ME, 3, multipart_pdu2);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 2);
+
+    /* Timestamps equal to the given time are included */
+    g_assert_cmpuint (count_paths_since (list, 0), ==, 2);
+    g_assert_cmpuint (count_paths_since (list, SINGLEPART_PDU_UNIX_TIME), ==, 2);
+    g_assert_cmpuint (count_paths_since (list, SINGLEPART_PDU_UNIX_TIME + 1), ==, 1);
+    g_assert_cmpuint (count_paths_since (list, MULTIPART_PDU_UNIX_TIME), ==, 1);
+    g_assert_cmpuint (count_paths_since (list, MULTIPART_PDU_UNIX_TIME + 1), ==, 0);
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+/*****************************************************************************/
+
+void
+_mm_log (const char *loc,
+         const char *func,
+         guint32 level,
+         const char *fmt,
+         ...)
+{
+#if defined ENABLE_TEST_MESSAGE_TRACES
+    /* Dummy log function */
+    va_list args;
+    gchar *msg;
+
+    va_start (args, fmt);
+    msg = g_strdup_vprintf (fmt, args);
+    va_end (args);
+    g_print ("%s\n", msg);
+    g_free (msg);
+#endif
+}
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    fake_modem_init ();
+
+    g_test_add_func ("/MM/SMS/List/delete-take-same-index",       test_delete_take_same_index);
+    g_test_add_func ("/MM/SMS/List/delete-multiple-keeps-unknown", test_delete_multiple_keeps_unknown);
+    g_test_add_func ("/MM/SMS/List/delete-multiple-partial",       test_delete_multiple_partial_failure);
+    g_test_add_func ("/MM/SMS/List/delete-multiple-paths",         test_delete_multiple_paths);
+    g_test_add_func ("/MM/SMS/List/delete-all",                    test_delete_all);
+    g_test_add_func ("/MM/SMS/List/list-since",                    test_list_since);
+
+    return g_test_run ();
+}
@@ -367,6 +367,188 @@ test_unicode_encoding (void)
         "中國哲學書電子化計劃");
 }
 
+/********************* PDU PARSER FUZZING *********************/
+
+/* Seeds for the mutation fuzzer: valid messages plus the corner cases of
+ * each field decoder (truncated headers, fields overflowing the parameter,
+ * every address mode, every text encoding, cause codes...) */
+static const gchar *fuzz_corpus[] = {
+    /* Valid, ASCII 7-bit text */
+    "00000210020207028CE95DCC65800601FC08150003168D3001061024183060800306101004044847",
+    /* Valid, latin text */
+    "00000210020207028CE95DCC65800601FC081C0003138D20010A40421B0B6B832F9B71080306131023200637080100",
+    /* Valid, unicode text */
+    "00000210020207028CE95DCC65800601FC082800031B73F001162052716AB85AA792DBC337C4B7DADA8298B4504294180306131024104528080100",
+    /* Valid, destination address */
+    "00000210020407028CE95DCC6580080D00032000000106102418306080",
+    /* Broadcast with service category */
+    "0101020001",
+    /* Acknowledge with cause codes, no error and permanent error */
+    "020701FC",
+    "020702FF6C",
+    /* Addresses: ASCII digits, e-mail and IP data network addresses */
+    "00020788821899199A00",
+    "000205D01B0A0310",
+    "000206C82605400008",
+    /* Address with num_fields overflowing the parameter */
+    "000207038CE95DCC6580",
+    /* Address header cut before the number of fields */
+    "000201C0",
+    /* Octet user data */
+    "0008070105001A424A50",
+    /* Extended protocol message user data with truncated text */
+    "00080601040C085208",
+    /* Unicode user data with a surrogate */
+    "00080801062016C0000208",
+    /* 7-bit ASCII user data with num_fields overflowing the subparameter */
+    "0008050103164410",
+    /* Unsupported encoding */
+    "0008050103280A08",
+    /* Unknown parameter and subparameter ids */
+    "00FF010008041F020000",
+};
+
+static guint8 *
+fuzz_corpus_get_pdu (guint i,
+                     gsize *pdu_len)
+{
+    guint8 *pdu;
+
+    pdu = (guint8 *) mm_utils_hexstr2bin (fuzz_corpus[i], pdu_len);
+    g_assert (pdu);
+    return pdu;
+}
+
+static void
+fuzz_parse (const guint8 *pdu,
+            gsize pdu_len)
+{
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    /* Never crash; parsing may or may not fail */
+    part = mm_sms_part_cdma_new_from_binary_pdu (0, pdu, pdu_len, &error);
+    if (part) {
+        g_assert_no_error (error);
+        mm_sms_part_free (part);
+    } else {
+        g_assert (error);
+        g_error_free (error);
+    }
+}
+
+static void
+test_fuzz_truncated (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (fuzz_corpus); i++) {
+        guint8 *pdu;
+        gsize pdu_len;
+        gsize len;
+
+        pdu = fuzz_corpus_get_pdu (i, &pdu_len);
+        for (len = 0; len <= pdu_len; len++) {
+            guint8 *copy;
+
+            /* Exact size copy, so that overreads are caught by valgrind/ASan */
+            copy = g_memdup (pdu, len);
+            fuzz_parse (copy, len);
+            g_free (copy);
+        }
+        g_free (pdu);
+    }
+}
+
+#define FUZZ_ITERATIONS_PER_SEED 2000
+
+static void
+test_fuzz_mutations (void)
+{
+    guint i;
+
+    /* Reproducible with the --seed given in the test log */
+    for (i = 0; i < G_N_ELEMENTS (fuzz_corpus); i++) {
+        guint8 *pdu;
+        gsize pdu_len;
+        guint n;
+
+        pdu = fuzz_corpus_get_pdu (i, &pdu_len);
+        for (n = 0; n < FUZZ_ITERATIONS_PER_SEED; n++) {
+            guint8 *copy;
+            gsize len;
+            guint n_mutations;
+
+            len = pdu_len;
+            copy = g_memdup (pdu, len);
+            for (n_mutations = g_test_rand_int_range (1, 5); n_mutations; n_mutations--) {
+                guint pos;
+
+                pos = g_test_rand_int_range (0, len);
+                switch (g_test_rand_int_range (0, 3)) {
+                case 0:
+                    /* Flip a bit */
+                    copy[pos] ^= 1 << g_test_rand_int_range (0, 8);
+                    break;
+                case 1:
+                    /* Random byte */
+                    copy[pos] = g_test_rand_int_range (0, 256);
+                    break;
+                case 2:
+                    /* Boundary values, likely lengths and num_fields */
+                    copy[pos] = (g_test_rand_bit () ? 0xFF : 0x00);
+                    break;
+                default:
+                    g_assert_not_reached ();
+                }
+            }
+            /* Sometimes also cut the PDU */
+            if (g_test_rand_bit ())
+                len = g_test_rand_int_range (1, len + 1);
+
+            fuzz_parse (copy, len);
+            g_free (copy);
+        }
+        g_free (pdu);
+    }
+}
+
+/********************* PDU PARSER BENCHMARK *********************/
+
+#define BENCHMARK_ITERATIONS 100000
+
+static void
+test_benchmark_parser (void)
+{
+    guint i;
+
+    for (i = 0; i < 3; i++) {
+        guint8 *pdu;
+        gsize pdu_len;
+        guint n;
+        gdouble elapsed;
+
+        /* The three valid seeds: ASCII, latin and unicode text */
+        pdu = fuzz_corpus_get_pdu (i, &pdu_len);
+
+        g_test_timer_start ();
+        for (n = 0; n < BENCHMARK_ITERATIONS; n++) {
+            MMSmsPart *part;
+
+            part = mm_sms_part_cdma_new_from_binary_pdu (0, pdu, pdu_len, NULL);
+            g_assert (part);
+            mm_sms_part_free (part);
+        }
+        elapsed = g_test_timer_elapsed ();
+
+        g_test_minimized_result (elapsed,
+                                 "parsed %u PDUs of %" G_GSIZE_FORMAT " bytes in %.3lf seconds (%.0lf PDUs/s)",
+                                 BENCHMARK_ITERATIONS, pdu_len, elapsed,
+                                 BENCHMARK_ITERATIONS / elapsed);
+        g_free (pdu);
+    }
+}
+
 /********************* PDU CREATOR TESTS *********************/
 
 static void
@@ -538,10 +720,15 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/latin-encoding", test_latin_encoding);
     g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/latin-encoding-2", test_latin_encoding_2);
     g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/unicode-encoding", test_unicode_encoding);
+    g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/fuzz-truncated", test_fuzz_truncated);
+    g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/fuzz-mutations", test_fuzz_mutations);
 
     g_test_add_func ("/MM/SMS/CDMA/PDU-Creator/ascii-encoding", test_create_pdu_text_ascii_encoding);
     g_test_add_func ("/MM/SMS/CDMA/PDU-Creator/latin-encoding", test_create_pdu_text_latin_encoding);
     g_test_add_func ("/MM/SMS/CDMA/PDU-Creator/unicode-encoding", test_create_pdu_text_unicode_encoding);
 
+    if (g_test_perf ())
+        g_test_add_func ("/MM/SMS/CDMA/PDU-Parser/benchmark", test_benchmark_parser);
+
     return g_test_run ();
 }
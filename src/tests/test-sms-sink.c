@@ -0,0 +1,382 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-base-sms.h"
+#include "mm-sms-list.h"
+#include "mm-sms-sink.h"
+#include "mm-sms-part-3gpp.h"
+#include "mm-context.h"
+#include "mm-log.h"
+
+#include "fake-modem.h"
+
+#define MODEM_PATH "/org/freedesktop/ModemManager1/Modem/0"
+
+/*****************************************************************************/
+/* The sink is a unix socket created by the test, the daemon connects to it
+ * when the first message is delivered */
+
+static gchar *sink_dir;
+static gchar *sink_path;
+static gint   listen_fd = -1;
+static gint   reader_fd = -1;
+
+const gchar *
+mm_context_get_sms_sink (void)
+{
+    return sink_path;
+}
+
+static void
+sink_listen (void)
+{
+    struct sockaddr_un addr;
+    GError *error = NULL;
+
+    sink_dir = g_dir_make_tmp ("mm-test-sms-sink-XXXXXX", &error);
+    g_assert_no_error (error);
+    sink_path = g_build_filename (sink_dir, "sink", NULL);
+
+    listen_fd = socket (AF_UNIX, SOCK_STREAM, 0);
+    g_assert_cmpint (listen_fd, >=, 0);
+
+    memset (&addr, 0, sizeof (addr));
+    addr.sun_family = AF_UNIX;
+    g_assert_cmpuint (strlen (sink_path), <, sizeof (addr.sun_path));
+    strcpy (addr.sun_path, sink_path);
+    g_assert_cmpint (bind (listen_fd, (struct sockaddr *)&addr, sizeof (addr)), ==, 0);
+    g_assert_cmpint (listen (listen_fd, 1), ==, 0);
+}
+
+static void
+sink_cleanup (void)
+{
+    if (reader_fd >= 0)
+        close (reader_fd);
+    close (listen_fd);
+    unlink (sink_path);
+    rmdir (sink_dir);
+    g_free (sink_path);
+    g_free (sink_dir);
+}
+
+static gboolean
+reader_has_data (gint timeout_ms)
+{
+    struct pollfd pfd = { .fd = reader_fd, .events = POLLIN };
+
+    return poll (&pfd, 1, timeout_ms) > 0;
+}
+
+static void
+read_exact (guint8 *buffer,
+            gsize len)
+{
+    gsize offset = 0;
+
+    while (offset < len) {
+        gssize n;
+
+        g_assert (reader_has_data (5000));
+        n = read (reader_fd, &buffer[offset], len - offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        g_assert_cmpint (n, >, 0);
+        offset += n;
+    }
+}
+
+static GVariant *
+read_record (void)
+{
+    guint32 size_be;
+    gsize size;
+    guint8 *buffer;
+
+    /* The daemon connected when delivering the first message */
+    if (reader_fd < 0) {
+        reader_fd = accept (listen_fd, NULL, NULL);
+        g_assert_cmpint (reader_fd, >=, 0);
+    }
+
+    read_exact ((guint8 *)&size_be, sizeof (size_be));
+    size = GUINT32_FROM_BE (size_be);
+    buffer = g_malloc (size);
+    read_exact (buffer, size);
+
+    return g_variant_ref_sink (g_variant_new_from_data (G_VARIANT_TYPE_VARDICT,
+                                                        buffer, size, FALSE,
+                                                        g_free, buffer));
+}
+
+/*****************************************************************************/
+
+/* Single part, from "InternetSMS", text "тест" */
+static const gchar *singlepart_pdu =
+    "07919730071111F10414D04937BD2C7797E9D3E614000811309291024061080442043504410442";
+
+/* Two parts of the same message, from "+16175046925" */
+static const gchar *multipart_pdu1 =
+    "07912160130320F5440B916171056429F5000021405291650569A00500034C0201A9E8F41C949E"
+    "83C2207B599E07B1DFEE33885E9ED341E4F23C7D7697C920FA1B54C697E5E3F4BC0C6AD7D9F434"
+    "081E96D341E3303C2C4EB3D3F4BC0B94A483E6E8779D4D06CDD1EF3BA80E0785E7A0B7BB0C6A97"
+    "E7F3F0B9CC02B9DF7450780EA2DFDF2C50780EA2A3CBA0BA9B5C96B3F369F71954768FDFE4B4FB"
+    "0C9297E1F2F2BCECA6CF41";
+static const gchar *multipart_pdu2 =
+    "07912160130320F6440B916171056429F5000021405291651569320500034C0202E9E8301D4447"
+    "9741F0B09C3E0785E56590BCCC0ED3CB6410FD0D7ABBCBA0B0FB4D4797E52E10";
+static const gchar *multipart_text =
+    "This is a very long test designed to exercise multi part capability. It should "
+    "show up as one message, not as two, as the underlying encoding represents "
+    "that the parts are related to one another. ";
+
+static void
+take_pdu (MMSmsList *list,
+          MMSmsStorage storage,
+          guint index,
+          const gchar *hexpdu)
+{
+    MMSmsPart *part;
+    GError *error = NULL;
+
+    part = mm_sms_part_3gpp_new_from_pdu (index, hexpdu, &error);
+    g_assert_no_error (error);
+    g_assert (part);
+
+    mm_sms_list_take_part (list, part, MM_SMS_STATE_RECEIVED, storage, &error);
+    g_assert_no_error (error);
+}
+
+/* Messages delivered to the sink are removed from storage in batches, after
+ * a short timeout */
+static void
+wait_part_removed (MMSmsList *list,
+                   MMSmsStorage storage,
+                   guint index)
+{
+    while (mm_sms_list_has_part (list, storage, index))
+        g_main_context_iteration (NULL, TRUE);
+}
+
+static void
+test_record (void)
+{
+    MMBaseModem *modem;
+    MMBaseSms *sms;
+    MMSmsPart *part;
+    GVariant *record;
+    GVariant *value;
+    const gchar *str;
+    guint32 u;
+    gint32 i;
+    GError *error = NULL;
+
+    modem = fake_modem_new ();
+
+    part = mm_sms_part_3gpp_new_from_pdu (1, singlepart_pdu, &error);
+    g_assert_no_error (error);
+    sms = mm_base_sms_singlepart_new (modem,
+                                      MM_SMS_STATE_RECEIVED,
+                                      MM_SMS_STORAGE_ME,
+                                      part,
+                                      &error);
+    g_assert_no_error (error);
+
+    record = g_variant_ref_sink (mm_sms_sink_build_record (sms, MODEM_PATH));
+    g_assert (g_variant_is_of_type (record, G_VARIANT_TYPE_VARDICT));
+
+    g_assert (g_variant_lookup (record, "modem", "&o", &str));
+    g_assert_cmpstr (str, ==, MODEM_PATH);
+    g_assert (g_variant_lookup (record, "number", "&s", &str));
+    g_assert_cmpstr (str, ==, "InternetSMS");
+    g_assert (g_variant_lookup (record, "text", "&s", &str));
+    g_assert_cmpstr (str, ==, "тест");
+    g_assert (g_variant_lookup (record, "smsc", "&s", &str));
+    g_assert_cmpstr (str, ==, "+79037011111");
+    g_assert (g_variant_lookup (record, "timestamp", "&s", &str));
+    g_assert_cmpstr (str, ==, "110329192004+04");
+    g_assert (g_variant_lookup (record, "storage", "u", &u));
+    g_assert_cmpuint (u, ==, MM_SMS_STORAGE_ME);
+    g_assert (g_variant_lookup (record, "pdu-type", "u", &u));
+    g_assert_cmpuint (u, ==, MM_SMS_PDU_TYPE_DELIVER);
+    g_assert (g_variant_lookup (record, "class", "i", &i));
+    g_assert_cmpint (i, ==, -1);
+
+    /* Text messages have no data, 3GPP messages no teleservice id */
+    value = g_variant_lookup_value (record, "data", NULL);
+    g_assert (!value);
+    value = g_variant_lookup_value (record, "teleservice-id", NULL);
+    g_assert (!value);
+
+    g_variant_unref (record);
+    g_object_unref (sms);
+    g_object_unref (modem);
+}
+
+static void
+test_deliver_singlepart (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GVariant *record;
+    const gchar *str;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 1, singlepart_pdu);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+
+    record = read_record ();
+    g_assert (g_variant_lookup (record, "modem", "&o", &str));
+    g_assert_cmpstr (str, ==, MODEM_PATH);
+    g_assert (g_variant_lookup (record, "text", "&s", &str));
+    g_assert_cmpstr (str, ==, "тест");
+    g_variant_unref (record);
+
+    /* Kept indexed until removed from storage */
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 1));
+    wait_part_removed (list, MM_SMS_STORAGE_ME, 1);
+    g_assert (fake_modem_command_sent ("+CMGD=1"));
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static void
+test_deliver_multipart (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GVariant *record;
+    const gchar *str;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    /* Nothing delivered nor exposed until all parts are received */
+    take_pdu (list, MM_SMS_STORAGE_ME, 2, multipart_pdu1);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+    g_assert (!reader_has_data (0));
+
+    take_pdu (list, MM_SMS_STORAGE_ME, 3, multipart_pdu2);
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 0);
+
+    record = read_record ();
+    g_assert (g_variant_lookup (record, "number", "&s", &str));
+    g_assert_cmpstr (str, ==, "+16175046925");
+    g_assert (g_variant_lookup (record, "text", "&s", &str));
+    g_assert_cmpstr (str, ==, multipart_text);
+    g_variant_unref (record);
+
+    wait_part_removed (list, MM_SMS_STORAGE_ME, 2);
+    wait_part_removed (list, MM_SMS_STORAGE_ME, 3);
+    g_assert (fake_modem_command_sent ("+CMGD=2"));
+    g_assert (fake_modem_command_sent ("+CMGD=3"));
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+static void
+test_reader_gone (void)
+{
+    MMBaseModem *modem;
+    MMSmsList *list;
+    GVariant *record;
+
+    fake_modem_reset ();
+    modem = fake_modem_new ();
+    list = mm_sms_list_new (modem);
+
+    /* The message is exposed as usual, and kept in storage */
+    close (reader_fd);
+    reader_fd = -1;
+    take_pdu (list, MM_SMS_STORAGE_ME, 4, singlepart_pdu);
+    while (mm_sms_list_get_count (list) == 0)
+        g_main_context_iteration (NULL, TRUE);
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 4));
+
+    /* The sink is opened again for the next message */
+    take_pdu (list, MM_SMS_STORAGE_ME, 5, singlepart_pdu);
+    record = read_record ();
+    g_variant_unref (record);
+    wait_part_removed (list, MM_SMS_STORAGE_ME, 5);
+
+    g_assert_cmpuint (mm_sms_list_get_count (list), ==, 1);
+    g_assert (mm_sms_list_has_part (list, MM_SMS_STORAGE_ME, 4));
+    g_assert (!fake_modem_command_sent ("+CMGD=4"));
+
+    g_object_unref (list);
+    g_object_unref (modem);
+}
+
+/*****************************************************************************/
+
+void
+_mm_log (const char *loc,
+         const char *func,
+         guint32 level,
+         const char *fmt,
+         ...)
+{
+#if defined ENABLE_TEST_MESSAGE_TRACES
+    /* Dummy log function */
+    va_list args;
+    gchar *msg;
+
+    va_start (args, fmt);
+    msg = g_strdup_vprintf (fmt, args);
+    va_end (args);
+    g_print ("%s\n", msg);
+    g_free (msg);
+#endif
+}
+
+int main (int argc, char **argv)
+{
+    gint result;
+
+    g_test_init (&argc, &argv, NULL);
+
+    fake_modem_init ();
+    sink_listen ();
+
+    g_test_add_func ("/MM/SMS/Sink/record",             test_record);
+    g_test_add_func ("/MM/SMS/Sink/deliver-singlepart", test_deliver_singlepart);
+    g_test_add_func ("/MM/SMS/Sink/deliver-multipart",  test_deliver_multipart);
+    g_test_add_func ("/MM/SMS/Sink/reader-gone",        test_reader_gone);
+
+    result = g_test_run ();
+    sink_cleanup ();
+    return result;
+}
@@ -0,0 +1,659 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Copyright (C) 2026 agent <agent@local>
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include <ModemManager.h>
+#define _LIBMM_INSIDE_MM
+#include <libmm-glib.h>
+
+#include "mm-snapshot.h"
+#include "mm-log.h"
+
+#define MODEM_A "/org/freedesktop/ModemManager1/Modem/0"
+#define MODEM_B "/org/freedesktop/ModemManager1/Modem/1"
+
+/* Same as in mm-snapshot.c */
+#define MAX_TOMBSTONES 256
+
+/*****************************************************************************/
+/* A fake object, as a list of interface skeletons */
+
+typedef struct {
+    const gchar      *path;
+    MmGdbusModem     *modem;
+    MmGdbusModem3gpp *modem3gpp;
+} TestObject;
+
+static void
+test_object_init (TestObject  *object,
+                  const gchar *path,
+                  const gchar *manufacturer,
+                  const gchar *imei)
+{
+    object->path = path;
+    object->modem = mm_gdbus_modem_skeleton_new ();
+    mm_gdbus_modem_set_manufacturer (object->modem, manufacturer);
+    mm_gdbus_modem_set_model (object->modem, "Model");
+    object->modem3gpp = mm_gdbus_modem3gpp_skeleton_new ();
+    mm_gdbus_modem3gpp_set_imei (object->modem3gpp, imei);
+}
+
+static void
+test_object_clear (TestObject *object)
+{
+    g_clear_object (&object->modem);
+    g_clear_object (&object->modem3gpp);
+}
+
+static void
+add_object (MMSnapshot *snapshot,
+            TestObject *object)
+{
+    GList *skeletons = NULL;
+
+    if (object->modem3gpp)
+        skeletons = g_list_prepend (skeletons, object->modem3gpp);
+    if (object->modem)
+        skeletons = g_list_prepend (skeletons, object->modem);
+    mm_snapshot_add_object (snapshot, object->path, skeletons);
+    g_list_free (skeletons);
+}
+
+/* Builds a snapshot with the given objects; the returned value is owned by
+ * the caller */
+static GVariant *
+build_snapshot (MMSnapshot          *snapshot,
+                TestObject         **objects,
+                const gchar * const *interfaces,
+                const gchar         *since_instance,
+                guint64              since_generation)
+{
+    guint i;
+
+    mm_snapshot_begin (snapshot, interfaces);
+    for (i = 0; objects && objects[i]; i++)
+        add_object (snapshot, objects[i]);
+    return g_variant_ref_sink (mm_snapshot_end (snapshot, since_instance, since_generation));
+}
+
+/*****************************************************************************/
+/* Snapshot contents */
+
+static const gchar *
+snapshot_get_instance (GVariant *snapshot)
+{
+    const gchar *instance = NULL;
+
+    g_assert (g_variant_lookup (snapshot, "instance", "&s", &instance));
+    return instance;
+}
+
+static guint64
+snapshot_get_generation (GVariant *snapshot)
+{
+    guint64 generation = 0;
+
+    g_assert (g_variant_lookup (snapshot, "generation", "t", &generation));
+    return generation;
+}
+
+static gboolean
+snapshot_has_key (GVariant    *snapshot,
+                  const gchar *key)
+{
+    GVariant *value;
+
+    value = g_variant_lookup_value (snapshot, key, NULL);
+    if (!value)
+        return FALSE;
+    g_variant_unref (value);
+    return TRUE;
+}
+
+static gboolean
+snapshot_is_full (GVariant *snapshot)
+{
+    gboolean full = FALSE;
+
+    g_assert (g_variant_lookup (snapshot, "full", "b", &full));
+
+    /* Removals are reported in deltas only */
+    g_assert (snapshot_has_key (snapshot, "removed-objects") == !full);
+    g_assert (snapshot_has_key (snapshot, "removed-interfaces") == !full);
+    return full;
+}
+
+static guint
+snapshot_n_objects (GVariant *snapshot)
+{
+    GVariant *objects;
+    guint     n;
+
+    objects = g_variant_lookup_value (snapshot, "objects", G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
+    g_assert (objects);
+    n = g_variant_n_children (objects);
+    g_variant_unref (objects);
+    return n;
+}
+
+/* Returns the properties of the interface, or NULL if not reported */
+static GVariant *
+snapshot_get_properties (GVariant    *snapshot,
+                         const gchar *path,
+                         const gchar *interface)
+{
+    GVariant *objects;
+    GVariant *interfaces;
+    GVariant *properties = NULL;
+
+    objects = g_variant_lookup_value (snapshot, "objects", G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
+    g_assert (objects);
+    interfaces = g_variant_lookup_value (objects, path, G_VARIANT_TYPE ("a{sa{sv}}"));
+    if (interfaces) {
+        properties = g_variant_lookup_value (interfaces, interface, G_VARIANT_TYPE ("a{sv}"));
+        g_variant_unref (interfaces);
+    }
+    g_variant_unref (objects);
+    return properties;
+}
+
+static gboolean
+snapshot_has_interface (GVariant    *snapshot,
+                        const gchar *path,
+                        const gchar *interface)
+{
+    GVariant *properties;
+
+    properties = snapshot_get_properties (snapshot, path, interface);
+    if (!properties)
+        return FALSE;
+    g_variant_unref (properties);
+    return TRUE;
+}
+
+static void
+assert_string_property (GVariant    *snapshot,
+                        const gchar *path,
+                        const gchar *interface,
+                        const gchar *name,
+                        const gchar *expected)
+{
+    GVariant    *properties;
+    const gchar *value = NULL;
+
+    properties = snapshot_get_properties (snapshot, path, interface);
+    g_assert (properties);
+    g_assert (g_variant_lookup (properties, name, "&s", &value));
+    g_assert_cmpstr (value, ==, expected);
+    g_variant_unref (properties);
+}
+
+static guint
+snapshot_n_properties (GVariant    *snapshot,
+                       const gchar *path,
+                       const gchar *interface)
+{
+    GVariant *properties;
+    guint     n;
+
+    properties = snapshot_get_properties (snapshot, path, interface);
+    g_assert (properties);
+    n = g_variant_n_children (properties);
+    g_variant_unref (properties);
+    return n;
+}
+
+static gboolean
+snapshot_object_removed (GVariant    *snapshot,
+                         const gchar *path)
+{
+    GVariantIter *iter = NULL;
+    const gchar  *removed;
+    gboolean      found = FALSE;
+
+    g_assert (g_variant_lookup (snapshot, "removed-objects", "ao", &iter));
+    while (!found && g_variant_iter_next (iter, "&o", &removed))
+        found = g_str_equal (removed, path);
+    g_variant_iter_free (iter);
+    return found;
+}
+
+static gboolean
+snapshot_interface_removed (GVariant    *snapshot,
+                            const gchar *path,
+                            const gchar *interface)
+{
+    GVariantIter *iter = NULL;
+    const gchar  *removed_path;
+    const gchar  *removed_interface;
+    gboolean      found = FALSE;
+
+    g_assert (g_variant_lookup (snapshot, "removed-interfaces", "a(os)", &iter));
+    while (!found && g_variant_iter_next (iter, "(&o&s)", &removed_path, &removed_interface))
+        found = (g_str_equal (removed_path, path) && g_str_equal (removed_interface, interface));
+    g_variant_iter_free (iter);
+    return found;
+}
+
+/*****************************************************************************/
+
+static void
+test_full (void)
+{
+    MMSnapshot *snapshot;
+    TestObject  a;
+    TestObject  b;
+    TestObject *objects[] = { &a, &b, NULL };
+    GVariant   *first;
+    GVariant   *second;
+    guint32     version = 0;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    test_object_init (&b, MODEM_B, "Vendor B", "222222222222222");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, objects, NULL, NULL, 0);
+    g_assert (g_variant_lookup (first, "version", "u", &version));
+    g_assert_cmpuint (version, ==, 1);
+    g_assert (snapshot_is_full (first));
+    g_assert_cmpuint (snapshot_get_generation (first), ==, 1);
+    g_assert_cmpuint (snapshot_n_objects (first), ==, 2);
+    assert_string_property (first, MODEM_A, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor A");
+    assert_string_property (first, MODEM_B, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor B");
+    assert_string_property (first, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei", "111111111111111");
+
+    /* Without changes, a full snapshot keeps the generation and reports everything */
+    second = build_snapshot (snapshot, objects, NULL, NULL, 0);
+    g_assert (snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, 1);
+    g_assert_cmpstr (snapshot_get_instance (second), ==, snapshot_get_instance (first));
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 2);
+
+    g_variant_unref (second);
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&b);
+    test_object_clear (&a);
+}
+
+static void
+test_delta (void)
+{
+    MMSnapshot *snapshot;
+    TestObject  a;
+    TestObject  b;
+    TestObject *objects[] = { &a, &b, NULL };
+    GVariant   *first;
+    GVariant   *second;
+    GVariant   *third;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    test_object_init (&b, MODEM_B, "Vendor B", "222222222222222");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, objects, NULL, NULL, 0);
+
+    /* Only the changed property of the changed object is reported */
+    mm_gdbus_modem_set_manufacturer (a.modem, "Vendor C");
+    second = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, snapshot_get_generation (first) + 1);
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 1);
+    g_assert_cmpuint (snapshot_n_properties (second, MODEM_A, MM_DBUS_INTERFACE_MODEM), ==, 1);
+    assert_string_property (second, MODEM_A, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor C");
+    g_assert (!snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+
+    /* Without changes, the delta is empty and the generation is kept */
+    third = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (second), snapshot_get_generation (second));
+    g_assert (!snapshot_is_full (third));
+    g_assert_cmpuint (snapshot_get_generation (third), ==, snapshot_get_generation (second));
+    g_assert_cmpuint (snapshot_n_objects (third), ==, 0);
+    g_variant_unref (third);
+
+    /* A delta since an older generation accumulates the changes */
+    mm_gdbus_modem3gpp_set_imei (b.modem3gpp, "333333333333333");
+    third = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (third));
+    g_assert_cmpuint (snapshot_n_objects (third), ==, 2);
+    assert_string_property (third, MODEM_A, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor C");
+    assert_string_property (third, MODEM_B, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei", "333333333333333");
+    g_assert (!snapshot_has_interface (third, MODEM_B, MM_DBUS_INTERFACE_MODEM));
+    g_variant_unref (third);
+
+    /* Generations not yet reported can't be used */
+    third = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first) + 100);
+    g_assert (snapshot_is_full (third));
+    g_assert_cmpuint (snapshot_n_objects (third), ==, 2);
+    g_variant_unref (third);
+
+    g_variant_unref (second);
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&b);
+    test_object_clear (&a);
+}
+
+static void
+test_instance (void)
+{
+    MMSnapshot *previous;
+    MMSnapshot *current;
+    TestObject  a;
+    TestObject *objects[] = { &a, NULL };
+    GVariant   *old;
+    GVariant   *first;
+    GVariant   *second;
+    guint       i;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+
+    /* A client of a previous instance saw a higher generation than the
+     * current instance has reached so far */
+    previous = mm_snapshot_new ();
+    for (i = 0; i < 10; i++) {
+        gchar *manufacturer;
+
+        manufacturer = g_strdup_printf ("Vendor %u", i);
+        mm_gdbus_modem_set_manufacturer (a.modem, manufacturer);
+        g_free (manufacturer);
+        g_variant_unref (build_snapshot (previous, objects, NULL, NULL, 0));
+    }
+    old = build_snapshot (previous, objects, NULL, NULL, 0);
+    g_assert_cmpuint (snapshot_get_generation (old), ==, 10);
+
+    current = mm_snapshot_new ();
+    for (i = 0; i < 20; i++) {
+        gchar *manufacturer;
+
+        manufacturer = g_strdup_printf ("Vendor %u", i);
+        mm_gdbus_modem_set_manufacturer (a.modem, manufacturer);
+        g_free (manufacturer);
+        g_variant_unref (build_snapshot (current, objects, NULL, NULL, 0));
+    }
+    first = build_snapshot (current, objects, NULL, NULL, 0);
+    g_assert_cmpuint (snapshot_get_generation (first), ==, 20);
+    g_assert_cmpstr (snapshot_get_instance (first), !=, snapshot_get_instance (old));
+
+    /* The generation is valid in the current instance, but the instance
+     * doesn't match */
+    second = build_snapshot (current, objects, NULL, snapshot_get_instance (old), snapshot_get_generation (old));
+    g_assert (snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 1);
+    g_variant_unref (second);
+
+    /* A generation without instance is not enough for a delta */
+    second = build_snapshot (current, objects, NULL, NULL, snapshot_get_generation (old));
+    g_assert (snapshot_is_full (second));
+    g_variant_unref (second);
+
+    second = build_snapshot (current, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (old));
+    g_assert (!snapshot_is_full (second));
+    g_variant_unref (second);
+
+    g_variant_unref (first);
+    g_variant_unref (old);
+    mm_snapshot_free (current);
+    mm_snapshot_free (previous);
+    test_object_clear (&a);
+}
+
+static void
+test_removed_object (void)
+{
+    MMSnapshot *snapshot;
+    TestObject  a;
+    TestObject  b;
+    TestObject *both[] = { &a, &b, NULL };
+    TestObject *only_a[] = { &a, NULL };
+    GVariant   *first;
+    GVariant   *second;
+    GVariant   *third;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    test_object_init (&b, MODEM_B, "Vendor B", "222222222222222");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, both, NULL, NULL, 0);
+
+    second = build_snapshot (snapshot, only_a, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, snapshot_get_generation (first) + 1);
+    g_assert (snapshot_object_removed (second, MODEM_B));
+    g_assert (!snapshot_object_removed (second, MODEM_A));
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 0);
+
+    /* The removal is not reported again */
+    third = build_snapshot (snapshot, only_a, NULL, snapshot_get_instance (second), snapshot_get_generation (second));
+    g_assert (!snapshot_object_removed (third, MODEM_B));
+    g_variant_unref (third);
+
+    /* An object added again with the same path is reported in full, after
+     * the removal */
+    third = build_snapshot (snapshot, both, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (third));
+    g_assert (snapshot_object_removed (third, MODEM_B));
+    assert_string_property (third, MODEM_B, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor B");
+    assert_string_property (third, MODEM_B, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei", "222222222222222");
+    g_variant_unref (third);
+
+    g_variant_unref (second);
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&b);
+    test_object_clear (&a);
+}
+
+static void
+test_removed_interface (void)
+{
+    MMSnapshot        *snapshot;
+    TestObject         a;
+    TestObject        *objects[] = { &a, NULL };
+    MmGdbusModem3gpp  *modem3gpp;
+    GVariant          *first;
+    GVariant          *second;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, objects, NULL, NULL, 0);
+    g_assert (snapshot_has_interface (first, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+
+    modem3gpp = a.modem3gpp;
+    a.modem3gpp = NULL;
+    second = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, snapshot_get_generation (first) + 1);
+    g_assert (snapshot_interface_removed (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    g_assert (!snapshot_interface_removed (second, MODEM_A, MM_DBUS_INTERFACE_MODEM));
+    g_assert (!snapshot_object_removed (second, MODEM_A));
+    g_variant_unref (second);
+
+    /* Full snapshots no longer have it */
+    second = build_snapshot (snapshot, objects, NULL, NULL, 0);
+    g_assert (snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM));
+    g_assert (!snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    g_variant_unref (second);
+
+    /* Added back, it's reported in full */
+    a.modem3gpp = modem3gpp;
+    second = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert (snapshot_interface_removed (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    assert_string_property (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei", "111111111111111");
+    g_assert (!snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM));
+    g_variant_unref (second);
+
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&a);
+}
+
+static void
+test_tombstone_expiry (void)
+{
+    MMSnapshot *snapshot;
+    TestObject  a;
+    TestObject  b;
+    TestObject *both[] = { &a, &b, NULL };
+    TestObject *only_a[] = { &a, NULL };
+    GVariant   *first;
+    GVariant   *recent = NULL;
+    GVariant   *second;
+    guint       i;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    test_object_init (&b, MODEM_B, "Vendor B", "222222222222222");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, only_a, NULL, NULL, 0);
+
+    /* Each cycle adds and removes the second object, leaving one tombstone */
+    for (i = 0; i < MAX_TOMBSTONES; i++) {
+        g_variant_unref (build_snapshot (snapshot, both, NULL, NULL, 0));
+        if (recent)
+            g_variant_unref (recent);
+        recent = build_snapshot (snapshot, only_a, NULL, NULL, 0);
+    }
+
+    /* All the removals are still known */
+    second = build_snapshot (snapshot, only_a, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert (snapshot_object_removed (second, MODEM_B));
+    g_variant_unref (second);
+
+    /* One more removal drops the oldest tombstone */
+    g_variant_unref (build_snapshot (snapshot, both, NULL, NULL, 0));
+    g_variant_unref (build_snapshot (snapshot, only_a, NULL, NULL, 0));
+
+    second = build_snapshot (snapshot, only_a, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 1);
+    assert_string_property (second, MODEM_A, MM_DBUS_INTERFACE_MODEM, "Manufacturer", "Vendor A");
+    g_variant_unref (second);
+
+    /* Recent generations still get deltas */
+    second = build_snapshot (snapshot, only_a, NULL, snapshot_get_instance (recent), snapshot_get_generation (recent));
+    g_assert (!snapshot_is_full (second));
+    g_assert (snapshot_object_removed (second, MODEM_B));
+    g_variant_unref (second);
+
+    g_variant_unref (recent);
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&b);
+    test_object_clear (&a);
+}
+
+static void
+test_interface_filter (void)
+{
+    static const gchar *modem_only[] = { MM_DBUS_INTERFACE_MODEM, NULL };
+    MMSnapshot         *snapshot;
+    TestObject          a;
+    TestObject         *objects[] = { &a, NULL };
+    MmGdbusModem3gpp   *modem3gpp;
+    GVariant           *first;
+    GVariant           *second;
+    GVariant           *third;
+
+    test_object_init (&a, MODEM_A, "Vendor A", "111111111111111");
+    snapshot = mm_snapshot_new ();
+
+    first = build_snapshot (snapshot, objects, NULL, NULL, 0);
+    g_assert (snapshot_has_interface (first, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+
+    /* Interfaces not requested are not reported, nor compared */
+    second = build_snapshot (snapshot, objects, modem_only, NULL, 0);
+    g_assert (snapshot_is_full (second));
+    g_assert (snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM));
+    g_assert (!snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    g_variant_unref (second);
+
+    mm_gdbus_modem3gpp_set_imei (a.modem3gpp, "333333333333333");
+    second = build_snapshot (snapshot, objects, modem_only, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, snapshot_get_generation (first));
+    g_assert_cmpuint (snapshot_n_objects (second), ==, 0);
+    g_variant_unref (second);
+
+    /* Requested again, the changes while filtered out are reported */
+    second = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (first), snapshot_get_generation (first));
+    g_assert (!snapshot_is_full (second));
+    g_assert_cmpuint (snapshot_get_generation (second), ==, snapshot_get_generation (first) + 1);
+    g_assert_cmpuint (snapshot_n_properties (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP), ==, 1);
+    assert_string_property (second, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei", "333333333333333");
+    g_assert (!snapshot_has_interface (second, MODEM_A, MM_DBUS_INTERFACE_MODEM));
+
+    /* Removals of interfaces not requested are not reported */
+    modem3gpp = a.modem3gpp;
+    a.modem3gpp = NULL;
+    third = build_snapshot (snapshot, objects, modem_only, snapshot_get_instance (second), snapshot_get_generation (second));
+    g_assert (!snapshot_is_full (third));
+    g_assert (!snapshot_interface_removed (third, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    g_variant_unref (third);
+
+    third = build_snapshot (snapshot, objects, NULL, snapshot_get_instance (second), snapshot_get_generation (second));
+    g_assert (!snapshot_is_full (third));
+    g_assert (snapshot_interface_removed (third, MODEM_A, MM_DBUS_INTERFACE_MODEM_MODEM3GPP));
+    g_variant_unref (third);
+    a.modem3gpp = modem3gpp;
+
+    g_variant_unref (second);
+    g_variant_unref (first);
+    mm_snapshot_free (snapshot);
+    test_object_clear (&a);
+}
+
+/*****************************************************************************/
+
+void
+_mm_log (const char *loc,
+         const char *func,
+         guint32 level,
+         const char *fmt,
+         ...)
+{
+#if defined ENABLE_TEST_MESSAGE_TRACES
+    /* Dummy log function */
+    va_list args;
+    gchar *msg;
+
+    va_start (args, fmt);
+    msg = g_strdup_vprintf (fmt, args);
+    va_end (args);
+    g_print ("%s\n", msg);
+    g_free (msg);
+#endif
+}
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/Snapshot/full",              test_full);
+    g_test_add_func ("/MM/Snapshot/delta",             test_delta);
+    g_test_add_func ("/MM/Snapshot/instance",          test_instance);
+    g_test_add_func ("/MM/Snapshot/removed-object",    test_removed_object);
+    g_test_add_func ("/MM/Snapshot/removed-interface", test_removed_interface);
+    g_test_add_func ("/MM/Snapshot/tombstone-expiry",  test_tombstone_expiry);
+    g_test_add_func ("/MM/Snapshot/interface-filter",  test_interface_filter);
+
+    return g_test_run ();
+}